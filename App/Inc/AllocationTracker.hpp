@@ -0,0 +1,67 @@
+/********************************************************
+* @file     AllocationTracker.hpp
+* @brief    Declare methods and classes related to heap
+*           allocation accounting
+* @details  This file contains class and methods declaration
+*           related to allocation accounting. Built with
+*           DASHBOARD_ALLOC_TRACKING, global operator new is
+*           replaced to count allocations made after startup,
+*           and can stop the program at the first one.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <cstddef>
+
+using namespace std;
+
+/********************************************************
+* @class AllocationTracker
+* @brief Class counts calls of global operator new. Counts
+*        stay zero if the program is built without
+*        DASHBOARD_ALLOC_TRACKING.
+********************************************************/
+class AllocationTracker {
+public:
+    /********************************************************
+    * @brief  Check if operator new is replaced in this build
+    * @param  None
+    * @return bool    Return true if allocations are counted
+    ********************************************************/
+    static bool isEnabled();
+
+    /********************************************************
+    * @brief  Mark end of startup, later allocations are
+    *         counted as allocations after init
+    * @param  abortOnAllocation   Stop the program at the
+    *                             first allocation after init
+    * @return None
+    ********************************************************/
+    static void markInitDone(bool abortOnAllocation);
+
+    /********************************************************
+    * @brief  Get number of allocations since program start
+    * @param  None
+    * @return unsigned long   Return number of allocations
+    ********************************************************/
+    static unsigned long getTotalAllocations();
+
+    /********************************************************
+    * @brief  Get number of allocations after markInitDone
+    * @param  None
+    * @return unsigned long   Return number of allocations
+    ********************************************************/
+    static unsigned long getAllocationsAfterInit();
+
+    /********************************************************
+    * @brief  Count one allocation, called by operator new
+    * @param  size    Requested size (bytes)
+    * @return None
+    ********************************************************/
+    static void recordAllocation(size_t size);
+};
+
+#endif  /* ALLOCATION_TRACKER_HPP */
@@ -0,0 +1,151 @@
+/********************************************************
+* @file     Arena.hpp
+* @brief    Declare classes related to arena memory
+* @details  This file contains class of a bump allocator.
+*           One block is reserved when the arena is created,
+*           objects are placed one after another and are
+*           released together with the arena. The thread that
+*           first writes the block decides where its pages
+*           live, so an arena is filled by the thread that
+*           uses it.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <stdint.h>
+#include <utility>
+
+using namespace std;
+
+/********************************************************
+* @brief Alignment of the block and default alignment of
+*        objects, one cache line
+********************************************************/
+#define ARENA_ALIGNMENT     64
+
+/********************************************************
+* @class Arena
+* @brief Class places objects in one block. Objects made
+*        with create() are destroyed by the arena in
+*        reverse order. Used by one thread at a time.
+********************************************************/
+class Arena {
+private:
+    /********************************************************
+    * @struct ArenaCleanup
+    * @brief  Destructor of one object made by create()
+    ********************************************************/
+    typedef struct ArenaCleanup {
+        void (*destroy)(void* object);  /* Calls destructor of the object */
+        void* object;                   /* Object to destroy */
+        struct ArenaCleanup* next;      /* Object created before this one */
+    } ArenaCleanup;
+
+    unsigned char* block;       /* Reserved memory */
+    size_t capacity;            /* Size of block (bytes) */
+    size_t used;                /* Bytes given out */
+    ArenaCleanup* cleanups;     /* Last created object */
+
+    /* Arena can not be copied */
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /********************************************************
+    * @brief  Call destructor of an object
+    * @param  object  Object of type T
+    * @return None
+    ********************************************************/
+    template <typename T>
+    static void destroyObject(void* object) {
+        static_cast<T*>(object)->~T();
+    }
+
+public:
+    /********************************************************
+    * @brief Constructor, reserves the block
+    * @param bytes    Size of block, rounded up to ARENA_ALIGNMENT
+    ********************************************************/
+    explicit Arena(size_t bytes) : block(NULL), capacity(0), used(0), cleanups(NULL) {
+        size_t rounded = (bytes + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+        if (rounded > 0) {
+            block = static_cast<unsigned char*>(aligned_alloc(ARENA_ALIGNMENT, rounded));
+            capacity = block ? rounded : 0;
+        }
+    }
+
+    /********************************************************
+    * @brief Destructor, destroys created objects and frees
+    *        the block
+    ********************************************************/
+    ~Arena() {
+        while (cleanups) {
+            cleanups->destroy(cleanups->object);
+            cleanups = cleanups->next;
+        }
+        free(block);
+    }
+
+    /********************************************************
+    * @brief  Give out memory from the block
+    * @param  bytes       Size of memory
+    * @param  alignment   Alignment, a power of 2
+    * @return void*       Return memory, NULL if block is full
+    ********************************************************/
+    void* allocate(size_t bytes, size_t alignment = ARENA_ALIGNMENT) {
+        size_t start = (used + alignment - 1) & ~(alignment - 1);
+        if (!block || start + bytes > capacity) {
+            return NULL;
+        }
+        used = start + bytes;
+        return block + start;
+    }
+
+    /********************************************************
+    * @brief  Create an object in the block, starts on a
+    *         cache line so 2 objects never share a line
+    * @param  args    Arguments of constructor of T
+    * @return T*      Return object, NULL if block is full
+    ********************************************************/
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T) > ARENA_ALIGNMENT ? alignof(T) : ARENA_ALIGNMENT);
+        void* record = allocate(sizeof(ArenaCleanup), alignof(ArenaCleanup));
+        if (!memory || !record) {
+            return NULL;
+        }
+
+        T* object = new (memory) T(forward<Args>(args)...);
+        ArenaCleanup* cleanup = static_cast<ArenaCleanup*>(record);
+        cleanup->destroy = &destroyObject<T>;
+        cleanup->object = object;
+        cleanup->next = cleanups;
+        cleanups = cleanup;
+        return object;
+    }
+
+    /********************************************************
+    * @brief  Get bytes given out
+    * @param  None
+    * @return size_t  Return used bytes
+    ********************************************************/
+    size_t getUsed() const {
+        return used;
+    }
+
+    /********************************************************
+    * @brief  Get size of block
+    * @param  None
+    * @return size_t  Return size (bytes)
+    ********************************************************/
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
+
+#endif  /* ARENA_HPP */
@@ -0,0 +1,288 @@
+/********************************************************
+* @file     ArrowWriter.hpp
+* @brief    Declare methods and classes related to Apache
+*           Arrow IPC output of telemetry
+* @details  This file contains classes and methods declaration
+*           related to writing tick history as Arrow IPC
+*           stream or file format without the Arrow library.
+*           Rows are appended into one column buffer per
+*           field, a full batch is written as one record batch
+*           message. Message metadata is a flatbuffer built by
+*           hand in a fixed buffer, column buffers are written
+*           from place and start at 64 byte boundaries of the
+*           file, so pandas, pyarrow and DuckDB can map the file
+*           and read columns without copying or parsing.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef ARROW_WRITER_HPP
+#define ARROW_WRITER_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "DashboardController.hpp"
+
+using namespace std;
+
+/********************************************************
+* Writer limits
+********************************************************/
+#define ARROW_DEFAULT_BATCH_ROWS    4096    /* Rows of one record batch (about 7 minutes of ticks) */
+#define ARROW_METADATA_SIZE         4096    /* Largest message metadata (bytes) */
+#define ARROW_RESERVED_BATCHES      1024    /* Batches indexed by the file footer without allocation */
+#define ARROW_ALIGNMENT             64      /* Alignment of column buffers in file (bytes) */
+#define ARROW_COLUMN_COUNT          9       /* Columns of a telemetry row */
+#define ARROW_STREAM_EXTENSION      ".arrows"
+
+/********************************************************
+* @enum  ArrowFormat
+* @brief This enum contains IPC formats
+********************************************************/
+typedef enum {
+    ARROW_FILE,     /* Random access file with footer, readable after close */
+    ARROW_STREAM    /* Stream of messages, each batch readable when written */
+} ArrowFormat;
+
+/********************************************************
+* @struct TelemetryRow
+* @brief  One row of tick history
+********************************************************/
+typedef struct {
+    uint64_t tick;              /* Tick number from 1 */
+    int64_t timestampUs;        /* Wall clock time (us since 1970, UTC) */
+    uint64_t monotonicNs;       /* Monotonic time (ns) */
+    DashboardState state;       /* Fields of DashboardController */
+} TelemetryRow;
+
+/********************************************************
+* @struct FlatField
+* @brief  One field of a flatbuffer table, size 0 leaves
+*         the field out. An offset field is filled later
+*         with FlatBuilder::setOffset
+********************************************************/
+typedef struct {
+    uint8_t size;           /* Size of scalar (1, 2, 4, 8), 4 for offset */
+    bool isOffset;          /* Field refers to a later table, string or vector */
+    uint64_t value;         /* Value of scalar */
+} FlatField;
+
+/********************************************************
+* @class FlatBuilder
+* @brief Class builds a flatbuffer front to back in a
+*        caller buffer. A parent is written before its
+*        children, so each offset points forward and is
+*        set when the child is written. Nothing is
+*        allocated.
+********************************************************/
+class FlatBuilder {
+private:
+    uint8_t* data;          /* Caller buffer */
+    size_t capacity;        /* Size of buffer */
+    size_t length;          /* Bytes used */
+    bool isOverflow;        /* Buffer was too small */
+
+    /********************************************************
+    * @brief  Make room up to an end position, gap is zeroed
+    * @param  end     End of new content
+    * @return bool    Return false if buffer is too small
+    ********************************************************/
+    bool grow(size_t end);
+
+public:
+    /********************************************************
+    * @brief Constructor, the root offset is at position 0
+    * @param data         Buffer, 8 byte aligned
+    * @param capacity     Size of buffer
+    ********************************************************/
+    FlatBuilder(uint8_t* data, size_t capacity);
+
+    /********************************************************
+    * @brief  Add a table and its vtable
+    * @param  fields      Fields in order of the schema
+    * @param  count       Number of fields
+    * @param  positions   Position of each field, used for
+    *                     offset fields
+    * @return size_t      Return position of table
+    ********************************************************/
+    size_t addTable(const FlatField* fields, size_t count, size_t* positions);
+
+    /********************************************************
+    * @brief  Add a string
+    * @param  text        Text ended by NUL
+    * @return size_t      Return position of string
+    ********************************************************/
+    size_t addString(const char* text);
+
+    /********************************************************
+    * @brief  Add a vector of structs made of 8 byte words
+    * @param  words       Words of all structs, may be NULL if
+    *                     count is 0
+    * @param  count       Number of structs
+    * @param  wordsPerItem    Words of one struct
+    * @return size_t      Return position of vector
+    ********************************************************/
+    size_t addStructVector(const uint64_t* words, size_t count, size_t wordsPerItem);
+
+    /********************************************************
+    * @brief  Add a vector of offsets, each is set later at
+    *         position + 4 + 4 * index
+    * @param  count       Number of offsets
+    * @return size_t      Return position of vector
+    ********************************************************/
+    size_t addOffsetVector(size_t count);
+
+    /********************************************************
+    * @brief  Point an offset field to a later position
+    * @param  position    Position of offset
+    * @param  target      Position of table, string or vector
+    * @return None
+    ********************************************************/
+    void setOffset(size_t position, size_t target);
+
+    /********************************************************
+    * @brief  Get size of flatbuffer
+    * @param  None
+    * @return size_t      Return number of bytes
+    ********************************************************/
+    size_t getLength() const;
+
+    /********************************************************
+    * @brief  Check the flatbuffer fits in the buffer
+    * @param  None
+    * @return bool        Return false if buffer was too small
+    ********************************************************/
+    bool isValid() const;
+};
+
+/********************************************************
+* @class ArrowWriter
+* @brief Class writes telemetry rows into an Arrow IPC
+*        file, used by one thread at a time. Column buffers
+*        are allocated by open(), append() and flush() do
+*        not allocate memory.
+********************************************************/
+class ArrowWriter {
+private:
+    size_t batchRows;           /* Rows of a full batch */
+    size_t rowCount;            /* Rows in current batch */
+    vector<uint8_t> columns[ARROW_COLUMN_COUNT];   /* Values, offsets for string column */
+    vector<char> modeText;      /* Characters of drive mode column */
+
+    ofstream file;
+    ArrowFormat format;
+    uint64_t fileOffset;        /* Bytes written */
+    vector<uint64_t> blocks;    /* Offset, metadata length and body length of each batch */
+    vector<uint8_t> metadata;   /* Flatbuffer of a message */
+
+    /* Counters */
+    uint64_t rows;
+    uint64_t batches;
+
+    /* Writer can not be copied */
+    ArrowWriter(const ArrowWriter&) = delete;
+    ArrowWriter& operator=(const ArrowWriter&) = delete;
+
+    /********************************************************
+    * @brief  Add schema table of telemetry columns
+    * @param  builder     Flatbuffer under construction
+    * @return size_t      Return position of schema
+    ********************************************************/
+    static size_t addSchema(FlatBuilder& builder);
+
+    /********************************************************
+    * @brief  Write bytes and count them
+    * @param  bytes       Content to write
+    * @param  length      Number of bytes
+    * @return None
+    ********************************************************/
+    void writeBytes(const void* bytes, size_t length);
+
+    /********************************************************
+    * @brief  Write a message with metadata padded so the
+    *         body starts at ARROW_ALIGNMENT
+    * @param  length      Length of flatbuffer in metadata
+    * @param  metaDataLength  Length of prefix and padded
+    *                     metadata
+    * @return bool        Return false if a write failed
+    ********************************************************/
+    bool writeMetadata(size_t length, uint32_t& metaDataLength);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param batchRows    Rows of one record batch
+    ********************************************************/
+    explicit ArrowWriter(size_t batchRows = ARROW_DEFAULT_BATCH_ROWS);
+
+    /********************************************************
+    * @brief Destructor, closes file
+    ********************************************************/
+    ~ArrowWriter();
+
+    /********************************************************
+    * @brief  Get format of a path, ARROW_STREAM_EXTENSION
+    *         selects stream format
+    * @param  path        Output path
+    * @return ArrowFormat Return format
+    ********************************************************/
+    static ArrowFormat getFormat(const string& path);
+
+    /********************************************************
+    * @brief  Allocate column buffers, create file and write
+    *         schema
+    * @param  path        Output path, replaced if it exists
+    * @param  format      IPC format
+    * @return bool        Return false if file cannot be
+    *                     written
+    ********************************************************/
+    bool open(const string& path, ArrowFormat format);
+
+    /********************************************************
+    * @brief  Add one row, a full batch is written
+    * @param  row         Row to add
+    * @return bool        Return false if writing failed
+    ********************************************************/
+    bool append(const TelemetryRow& row);
+
+    /********************************************************
+    * @brief  Write rows of current batch as a record batch
+    * @param  None
+    * @return bool        Return false if writing failed
+    ********************************************************/
+    bool flush();
+
+    /********************************************************
+    * @brief  Write last batch, end of stream and footer of
+    *         file format, then close file
+    * @param  None
+    * @return bool        Return false if writing failed
+    ********************************************************/
+    bool close();
+
+    /********************************************************
+    * @brief  Get number of rows written in batches
+    * @param  None
+    * @return uint64_t    Return number
+    ********************************************************/
+    uint64_t getRows() const;
+
+    /********************************************************
+    * @brief  Get number of record batches written
+    * @param  None
+    * @return uint64_t    Return number
+    ********************************************************/
+    uint64_t getBatches() const;
+
+    /********************************************************
+    * @brief  Get number of bytes written
+    * @param  None
+    * @return uint64_t    Return number
+    ********************************************************/
+    uint64_t getBytes() const;
+};
+
+#endif  /* ARROW_WRITER_HPP */
@@ -13,46 +13,64 @@
 #define BATTERY_MANAGER_HPP
 
 #include <iostream>
+#include "FixedPoint.hpp"
+#include "VehicleProfile.hpp"
+#include "BatteryPack.hpp"
 
 using namespace std;
 
 /********************************************************
-* @class BatteryManager
+* @brief Battery level is updated every 100 ms
+********************************************************/
+#define BATTERY_TICKS_PER_SECOND    10
+
+/********************************************************
+* @class BasicBatteryManager
 * @brief Class includes and calculate parameters related  
-*        to battery
+*        to battery. Num is double, Q16_16 or Q32_32, the
+*        methods are instantiated for these types only.
 ********************************************************/
-class BatteryManager {
+template <typename Num>
+class BasicBatteryManager {
 private:
-    int batteryLevel;       /* Current battery level (%) */
-    double batteryCapacity; /* Maximum battery capacity (kWh) */
-    double drainPerKm;      /* Battery consumption per kilometer (kWh/km) */
+    Num batteryLevel;       /* Current battery level (%) */
+    Num batteryCapacity;    /* Maximum battery capacity (kWh) */
+    Num drainPerKm;         /* Battery consumption per kilometer (kWh/km) */
+    BatteryPack* pack;      /* Cell level model, NULL if not used */
     
 public:
     /********************************************************
     * @brief Constructor 
     ********************************************************/
-    BatteryManager();
+    BasicBatteryManager();
 
     /********************************************************
     * @brief Destructor 
     ********************************************************/
-    ~BatteryManager();
+    ~BasicBatteryManager();
+
+    /********************************************************
+    * @brief  Apply parameters of vehicle profile
+    * @param  profile     Parameters of vehicle variant
+    * @return None
+    ********************************************************/
+    void applyProfile(const VehicleProfile& profile);
 
     /********************************************************
     * @brief  Calculate battery drain per 1 second  
     * @param  speed       Current speed
     * @param  acLevel     Current AC temperature
     * @param  windLevel   Current wind level
-    * @return double  Total drain per 1 second
+    * @return Num     Total drain per 1 second
     ********************************************************/
-    double calculateBatteryDrain(int speed, int acLevel, int windLevel);
+    Num calculateBatteryDrain(int speed, int acLevel, int windLevel) const;
 
     /********************************************************
     * @brief   Predict ramaining range
     * @param   None
-    * @return  double  Predicted remaining range 
+    * @return  Num     Predicted remaining range 
     ********************************************************/
-    double calculateRamainingRange() const;
+    Num calculateRamainingRange() const;
 
     /********************************************************
     * @brief  Update battery level
@@ -69,6 +87,41 @@ public:
     * @return int     Return current battery level
     ********************************************************/
     int getBatteryLevel() const;
+
+    /********************************************************
+    * @brief  Get current battery level with fraction
+    * @param  None
+    * @return Num     Return current battery level (%)
+    ********************************************************/
+    Num getStateOfCharge() const;
+
+    /********************************************************
+    * @brief  Get maximum battery capacity
+    * @param  None
+    * @return Num     Return battery capacity (kWh)
+    ********************************************************/
+    Num getBatteryCapacity() const;
+
+    /********************************************************
+    * @brief  Use a cell level pack model, battery level comes
+    *         from its weakest cell
+    * @param  pack    Pointer to pack model, NULL to stop using it
+    * @return None
+    ********************************************************/
+    void attachPack(BatteryPack* pack);
+
+    /********************************************************
+    * @brief  Get cell level pack model
+    * @param  None
+    * @return const BatteryPack*  Return pack model, NULL if not used
+    ********************************************************/
+    const BatteryPack* getPack() const;
 };
 
+/********************************************************
+* @brief Battery model of the dashboard, number type is
+*        selected at build time, see DashboardNum
+********************************************************/
+typedef BasicBatteryManager<DashboardNum> BatteryManager;
+
 #endif  /* BATTERY_MANAGER_HPP */ 
\ No newline at end of file
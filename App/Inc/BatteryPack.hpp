@@ -0,0 +1,163 @@
+/********************************************************
+* @file     BatteryPack.hpp
+* @brief    Declare methods and classes related to cell
+*           level battery pack model
+* @details  This file contains class and methods declaration
+*           related to battery pack model. Each cell has its
+*           own state of charge, internal resistance and
+*           temperature, stored as structure of arrays and
+*           updated 4 cells at a time with vector kernels.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef BATTERY_PACK_HPP
+#define BATTERY_PACK_HPP
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/********************************************************
+* Cell parameters
+********************************************************/
+#define CELL_NOMINAL_VOLTAGE        3.6     /* Nominal voltage (V) */
+#define CELL_INTERNAL_RESISTANCE    0.002   /* Internal resistance at reference temperature (ohm) */
+#define CELL_RESISTANCE_TEMP_COEFF  0.01    /* Resistance change per °C below reference temperature */
+#define CELL_REFERENCE_TEMPERATURE  25.0    /* Reference and ambient temperature (°C) */
+#define CELL_HEAT_CAPACITY          70.0    /* Heat capacity (J/°C) */
+#define CELL_COOLING_RATE           0.05    /* Cooling toward ambient per second */
+#define CELL_CAPACITY_SPREAD        0.02    /* Manufacturing spread of capacity (ratio) */
+#define CELL_RESISTANCE_SPREAD      0.10    /* Manufacturing spread of resistance (ratio) */
+
+/********************************************************
+* @brief Cells updated by one vector operation
+********************************************************/
+#define PACK_LANES                  4
+
+/********************************************************
+* @brief Default pack layout
+********************************************************/
+#define PACK_DEFAULT_LAYOUT         "96s4p"
+
+/********************************************************
+* @class BatteryPack
+* @brief Class models a pack of series groups, each group
+*        has parallel cells. Current of a group is shared by
+*        its cells in proportion to their conductance, pack
+*        state of charge is limited by the weakest cell.
+********************************************************/
+class BatteryPack {
+public:
+    /********************************************************
+    * @brief 4 cells, one per lane
+    ********************************************************/
+    typedef float Lanes __attribute__((vector_size(PACK_LANES * sizeof(float))));
+
+private:
+    unsigned int series;        /* Number of series groups */
+    unsigned int parallel;      /* Cells in each group */
+    unsigned int blocks;        /* Vectors per parallel row, series padded to PACK_LANES */
+
+    /* Cell of group s at row p is lane s % PACK_LANES of vector
+       p * blocks + s / PACK_LANES, so sums over a group are
+       vector sums over rows */
+    vector<Lanes> soc;          /* State of charge (%) */
+    vector<Lanes> capacity;     /* Capacity (A.s) */
+    vector<Lanes> resistance;   /* Resistance at reference temperature (ohm) */
+    vector<Lanes> temperature;  /* Temperature (°C) */
+    vector<Lanes> current;      /* Current of last update (A) */
+    vector<Lanes> groupConductance; /* Sum of conductance of each group (S) */
+
+    double packCapacity;    /* Nominal pack capacity (A.s) */
+    double minSoc;          /* Weakest cell after last update (%) */
+    double maxSoc;          /* Strongest cell after last update (%) */
+    double meanSoc;         /* Mean of all cells after last update (%) */
+    double maxTemperature;  /* Hottest cell after last update (°C) */
+
+    /********************************************************
+    * @brief  Update minSoc, maxSoc, meanSoc, maxTemperature
+    * @param  None
+    * @return None
+    ********************************************************/
+    void updateStatistics();
+
+public:
+    /********************************************************
+    * @brief Constructor, cells start full at reference
+    *        temperature with manufacturing spread
+    * @param series           Number of series groups
+    * @param parallel         Cells in each group
+    * @param capacityKwh      Nominal pack energy (kWh)
+    ********************************************************/
+    BatteryPack(unsigned int series, unsigned int parallel, double capacityKwh);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~BatteryPack();
+
+    /********************************************************
+    * @brief  Parse pack layout such as "96s4p"
+    * @param  text        Layout text
+    * @param  series      Number of series groups
+    * @param  parallel    Cells in each group
+    * @return bool        Return true if layout is valid
+    ********************************************************/
+    static bool parseLayout(const string& text, unsigned int& series, unsigned int& parallel);
+
+    /********************************************************
+    * @brief  Drain the pack for one tick
+    * @param  drainPerSecond  Pack drain per 1 second from
+    *                         BatteryManager (% of pack)
+    * @param  dt              Length of tick (s)
+    * @return None
+    ********************************************************/
+    void update(double drainPerSecond, double dt);
+
+    /********************************************************
+    * @brief  Get pack state of charge, limited by the weakest cell
+    * @param  None
+    * @return double  Return state of charge (%)
+    ********************************************************/
+    double getPackSoc() const;
+
+    /********************************************************
+    * @brief  Get mean state of charge of all cells
+    * @param  None
+    * @return double  Return state of charge (%)
+    ********************************************************/
+    double getMeanSoc() const;
+
+    /********************************************************
+    * @brief  Get difference between strongest and weakest cell
+    * @param  None
+    * @return double  Return imbalance (%)
+    ********************************************************/
+    double getImbalance() const;
+
+    /********************************************************
+    * @brief  Get temperature of the hottest cell
+    * @param  None
+    * @return double  Return temperature (°C)
+    ********************************************************/
+    double getMaxTemperature() const;
+
+    /********************************************************
+    * @brief  Get state of charge of one cell
+    * @param  group   Series group
+    * @param  row     Cell in group
+    * @return double  Return state of charge (%)
+    ********************************************************/
+    double getCellSoc(unsigned int group, unsigned int row) const;
+
+    /********************************************************
+    * @brief  Get number of cells
+    * @param  None
+    * @return unsigned int    Return series * parallel
+    ********************************************************/
+    unsigned int getCellCount() const;
+};
+
+#endif  /* BATTERY_PACK_HPP */
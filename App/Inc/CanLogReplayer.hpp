@@ -0,0 +1,215 @@
+/********************************************************
+* @file     CanLogReplayer.hpp
+* @brief    Declare methods and classes related to CAN log
+*           replay
+* @details  This file contains class and methods declaration
+*           related to replaying CAN traffic recorded by
+*           `candump -l`, decodes frames through a signal map
+*           and updates data to DashboardController.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef CAN_LOG_REPLAYER_HPP
+#define CAN_LOG_REPLAYER_HPP
+
+#include <string>
+#include <stdint.h>
+#include "DashboardController.hpp"
+#include "MappedFile.hpp"
+#include "StateEstimator.hpp"
+
+using namespace std;
+
+/********************************************************
+* The default path to signal map used to decode CAN frames
+********************************************************/
+#define CAN_SIGNAL_MAP_PATH     "./Data/CanSignalMap.csv"
+
+/********************************************************
+* Limits of the decoder, all storage is fixed so decoding
+* does not allocate memory per frame
+********************************************************/
+#define CAN_MAX_SIGNALS         16  /* Maximum signals in signal map */
+#define CAN_MAX_DATA_LENGTH     64  /* Maximum payload (CAN FD) (bytes) */
+#define CAN_REORDER_WINDOW      32  /* Frames buffered to restore timestamp order */
+#define CAN_REPLAY_BATCH        256 /* Frames applied between yields in fast replay */
+
+/********************************************************
+* @enum  CanSignalType
+* @brief This enum contains dashboard values that can be
+*        decoded from CAN frames
+********************************************************/
+typedef enum {
+    CAN_SIGNAL_SPEED,           /* Speed (km/h) */
+    CAN_SIGNAL_BATTERY_LEVEL,   /* Battery level (%) */
+    CAN_SIGNAL_AC_TEMPERATURE,  /* AC temperature (°C) */
+    CAN_SIGNAL_WIND_LEVEL       /* Wind level */
+} CanSignalType;
+
+/********************************************************
+* @enum  ReplayMode
+* @brief This enum contains 2 replay mode (real time and
+*        as fast as possible)
+********************************************************/
+typedef enum {
+    REPLAY_REAL_TIME,   /* Keep original time between frames */
+    REPLAY_FAST         /* Replay frames without waiting */
+} ReplayMode;
+
+/********************************************************
+* @struct CanSignal
+* @brief  Position of a signal inside CAN frame payload,
+*         payload is little-endian (Intel byte order)
+********************************************************/
+typedef struct {
+    CanSignalType type; /* Dashboard value of this signal */
+    uint32_t canId;     /* Identifier of frame carries signal */
+    uint16_t startBit;  /* Position of least significant bit */
+    uint8_t length;     /* Number of bits (1 - 32) */
+    double scale;       /* Physical value = raw * scale + offset */
+    double offset;      /* Physical value = raw * scale + offset */
+} CanSignal;
+
+/********************************************************
+* @struct CanFrame
+* @brief  One decoded line of candump log
+********************************************************/
+typedef struct {
+    int64_t timestampUs;                /* Timestamp of frame (us) */
+    uint32_t canId;                     /* Frame identifier */
+    uint8_t length;                     /* Payload length (bytes) */
+    uint8_t data[CAN_MAX_DATA_LENGTH];  /* Payload */
+} CanFrame;
+
+/********************************************************
+* @class CanLogReplayer
+* @brief Class maps a candump log, decodes frames in
+*        timestamp order and applies decoded signals to
+*        DashboardController
+********************************************************/
+class CanLogReplayer {
+private:
+    /********************************************************
+    * @brief Frame waits in reorder window, sequence keeps
+    *        log order for frames with the same timestamp
+    ********************************************************/
+    typedef struct {
+        CanFrame frame;
+        unsigned long long sequence;
+    } PendingFrame;
+
+    MappedFile logFile;         /* Mapped candump log */
+    const char* cursor;         /* Next byte to parse */
+    const char* logEnd;         /* End of mapped log */
+
+    CanSignal signals[CAN_MAX_SIGNALS]; /* Signal map */
+    int signalCount;                    /* Number of signals in map */
+
+    PendingFrame window[CAN_REORDER_WINDOW];    /* Min-heap ordered by timestamp */
+    int windowCount;                            /* Number of frames in window */
+
+    unsigned long long framesDecoded;   /* Number of valid frames */
+    unsigned long long framesSkipped;   /* Number of malformed lines */
+
+    /********************************************************
+    * @brief  Parse next valid frame in log order
+    * @param  frame   Frame that receive parsed data
+    * @return bool    Return false if end of log is reached
+    ********************************************************/
+    bool readFrame(CanFrame& frame);
+
+    /********************************************************
+    * @brief  Parse one log line
+    * @param  line    Start of line
+    * @param  end     End of line (without new line)
+    * @param  frame   Frame that receive parsed data
+    * @return bool    Return true if line is a valid frame
+    ********************************************************/
+    static bool parseLine(const char* line, const char* end, CanFrame& frame);
+
+    /********************************************************
+    * @brief  Compare 2 pending frames in the window
+    * @return bool    Return true if a must be replayed after b
+    ********************************************************/
+    static bool isLater(const PendingFrame& a, const PendingFrame& b);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    CanLogReplayer();
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~CanLogReplayer();
+
+    /********************************************************
+    * @brief  Load signal map from CSV file, each line has
+    *         format: NAME, CAN ID, START BIT, LENGTH, SCALE, OFFSET
+    * @param  path    Path to signal map file
+    * @return bool    Return true if at least 1 signal is loaded
+    ********************************************************/
+    bool loadSignalMap(const string& path);
+
+    /********************************************************
+    * @brief  Add a signal to signal map
+    * @param  signal  Signal that want to add
+    * @return bool    Return false if signal map is full or
+    *                 signal is invalid
+    ********************************************************/
+    bool addSignal(const CanSignal& signal);
+
+    /********************************************************
+    * @brief  Map candump log and start from the first frame
+    * @param  path    Path to candump log
+    * @return bool    Return true if log is mapped
+    ********************************************************/
+    bool open(const string& path);
+
+    /********************************************************
+    * @brief  Get next frame in timestamp order
+    * @param  frame   Frame that receive data
+    * @return bool    Return false if there is no more frame
+    ********************************************************/
+    bool nextFrame(CanFrame& frame);
+
+    /********************************************************
+    * @brief  Decode physical value of a signal from a frame
+    * @param  signal  Signal to decode
+    * @param  frame   Frame carries the signal
+    * @return double  Physical value of signal
+    ********************************************************/
+    static double decodeSignal(const CanSignal& signal, const CanFrame& frame);
+
+    /********************************************************
+    * @brief  Decode all signals of a frame and update them
+    *         to DashboardController
+    * @param  frame                Frame to decode
+    * @param  dashboardController  Pointer to DashboardController
+    *                              object that receive data
+    * @param  stateEstimator       Pointer to StateEstimator object
+    *                              that filters speed and battery
+    *                              level, NULL sets decoded values
+    * @return None
+    ********************************************************/
+    void applyFrame(const CanFrame& frame, DashboardController* dashboardController,
+        StateEstimator* stateEstimator) const;
+
+    /********************************************************
+    * @brief  Get number of decoded frames
+    * @param  None
+    * @return unsigned long long  Return number of valid frames
+    ********************************************************/
+    unsigned long long getFramesDecoded() const;
+
+    /********************************************************
+    * @brief  Get number of skipped lines
+    * @param  None
+    * @return unsigned long long  Return number of malformed lines
+    ********************************************************/
+    unsigned long long getFramesSkipped() const;
+};
+
+#endif  /* CAN_LOG_REPLAYER_HPP */
@@ -0,0 +1,177 @@
+/********************************************************
+* @file     ChargingStationIndex.hpp
+* @brief    Declare methods and classes related to charging
+*           station search
+* @details  This file contains class and methods declaration
+*           related to charging station search. Stations are
+*           loaded from a local file into an implicit k-d tree
+*           built once, nodes are stored in one array without
+*           pointers, queries find the nearest stations within
+*           a distance without allocating memory.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef CHARGING_STATION_INDEX_HPP
+#define CHARGING_STATION_INDEX_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/********************************************************
+* @brief Path of charging station database
+********************************************************/
+#define CHARGING_STATION_PATH   "./Data/ChargingStations.csv"
+
+/********************************************************
+* @brief Maximum number of stations returned by a query
+********************************************************/
+#define STATION_MAX_RESULTS     8
+
+/********************************************************
+* @brief Mean radius of the Earth (km)
+********************************************************/
+#define EARTH_RADIUS_KM         6371.0
+
+/********************************************************
+* @struct ChargingStation
+* @brief  One charging station of the database
+********************************************************/
+typedef struct {
+    string name;        /* Station name */
+    double latitude;    /* Latitude (degree) */
+    double longitude;   /* Longitude (degree) */
+} ChargingStation;
+
+/********************************************************
+* @struct StationMatch
+* @brief  One station found by a query
+********************************************************/
+typedef struct {
+    const ChargingStation* station; /* Found station */
+    double distanceKm;              /* Great circle distance (km) */
+} StationMatch;
+
+/********************************************************
+* @class ChargingStationIndex
+* @brief Class keeps charging stations in a k-d tree over
+*        points on the unit sphere, so the straight line
+*        distance between points has the same order as the
+*        great circle distance.
+********************************************************/
+class ChargingStationIndex {
+private:
+    /********************************************************
+    * @brief Node of the implicit k-d tree, the node of range
+    *        [begin, end) is at the middle of the range
+    ********************************************************/
+    typedef struct {
+        float point[3];     /* Position on unit sphere */
+        uint32_t station;   /* Index in stations */
+    } Node;
+
+    /********************************************************
+    * @brief Current results of a query, max-heap on distance
+    ********************************************************/
+    typedef struct {
+        float distanceSq;   /* Squared chord distance */
+        uint32_t station;   /* Index in stations */
+    } Candidate;
+
+    vector<ChargingStation> stations;   /* Station data */
+    vector<Node> nodes;                 /* k-d tree */
+
+    /********************************************************
+    * @brief  Order of candidates in the max-heap
+    * @param  a   First candidate
+    * @param  b   Second candidate
+    * @return bool    Return true if a is nearer than b
+    ********************************************************/
+    static bool isNearer(const Candidate& a, const Candidate& b);
+
+    /********************************************************
+    * @brief  Convert latitude and longitude to unit sphere
+    * @param  latitude    Latitude (degree)
+    * @param  longitude   Longitude (degree)
+    * @param  point       Position on unit sphere
+    * @return None
+    ********************************************************/
+    static void toUnitSphere(double latitude, double longitude, float point[3]);
+
+    /********************************************************
+    * @brief  Build subtree of range [begin, end)
+    * @param  begin   First node of range
+    * @param  end     End of range
+    * @param  depth   Depth of subtree root, selects split axis
+    * @return None
+    ********************************************************/
+    void build(size_t begin, size_t end, unsigned int depth);
+
+    /********************************************************
+    * @brief  Search subtree of range [begin, end)
+    * @param  begin       First node of range
+    * @param  end         End of range
+    * @param  depth       Depth of subtree root
+    * @param  query       Position of query on unit sphere
+    * @param  k           Number of wanted stations
+    * @param  radiusSq    Squared chord distance limit
+    * @param  heap        Current results
+    * @param  count       Number of current results
+    * @return None
+    ********************************************************/
+    void search(size_t begin, size_t end, unsigned int depth, const float query[3],
+        size_t k, float radiusSq, Candidate* heap, size_t& count) const;
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    ChargingStationIndex();
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~ChargingStationIndex();
+
+    /********************************************************
+    * @brief  Load stations from CSV file and build the tree,
+    *         each line is "NAME, LATITUDE, LONGITUDE", lines
+    *         start with '#' are comments
+    * @param  path    Path to station file
+    * @return bool    Return true if at least 1 station is loaded
+    ********************************************************/
+    bool load(const string& path);
+
+    /********************************************************
+    * @brief  Replace stations and build the tree
+    * @param  list    New stations
+    * @return None
+    ********************************************************/
+    void build(const vector<ChargingStation>& list);
+
+    /********************************************************
+    * @brief  Find nearest stations within a distance
+    * @param  latitude        Latitude of vehicle (degree)
+    * @param  longitude       Longitude of vehicle (degree)
+    * @param  k               Number of wanted stations, at
+    *                         most STATION_MAX_RESULTS
+    * @param  maxDistanceKm   Distance limit (km)
+    * @param  results         Filled with found stations,
+    *                         nearest first
+    * @return size_t          Return number of found stations
+    ********************************************************/
+    size_t findNearest(double latitude, double longitude, size_t k, double maxDistanceKm,
+        StationMatch* results) const;
+
+    /********************************************************
+    * @brief  Get number of stations
+    * @param  None
+    * @return size_t  Return number of stations
+    ********************************************************/
+    size_t size() const;
+};
+
+#endif  /* CHARGING_STATION_INDEX_HPP */
@@ -0,0 +1,132 @@
+/********************************************************
+* @file     ClimateAdvisor.hpp
+* @brief    Declare methods and classes related to climate
+*           and speed advice
+* @details  This file contains class and methods declaration
+*           related to what-if range advice. Every tick the
+*           drain model of BatteryManager is evaluated for all
+*           AC temperatures and wind levels, with the current
+*           speed and with each candidate speed cap, in one
+*           batch over flat arrays. The alternatives that give
+*           the most range over the current settings are kept
+*           for the display.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef CLIMATE_ADVISOR_HPP
+#define CLIMATE_ADVISOR_HPP
+
+#include <cstddef>
+#include "BatteryManager.hpp"
+
+using namespace std;
+
+/********************************************************
+* Settings evaluated by the advisor
+********************************************************/
+#define ADVISOR_MIN_AC_TEMP     16      /* Lowest AC temperature (°C) */
+#define ADVISOR_MAX_AC_TEMP     30      /* Highest AC temperature (°C) */
+#define ADVISOR_MIN_WIND        0       /* Lowest wind level, AC fan off */
+#define ADVISOR_MAX_WIND        5       /* Highest wind level */
+#define ADVISOR_CAP_COUNT       4       /* Number of candidate speed caps */
+#define ADVISOR_TOP_COUNT       3       /* Alternatives kept for the display */
+#define ADVISOR_MIN_GAIN_KM     0.5     /* Smaller gains are not advised (km) */
+
+/********************************************************
+* Size of the climate grid, rows of the batch are padded
+* to a multiple of 4 values so they start on 32 bytes
+********************************************************/
+#define ADVISOR_CLIMATE_COUNT   ((ADVISOR_MAX_AC_TEMP - ADVISOR_MIN_AC_TEMP + 1) * (ADVISOR_MAX_WIND - ADVISOR_MIN_WIND + 1))
+#define ADVISOR_ROW_STRIDE      ((ADVISOR_CLIMATE_COUNT + 3) / 4 * 4)
+#define ADVISOR_SPEED_COUNT     (ADVISOR_CAP_COUNT + 1)
+
+/********************************************************
+* @struct ClimateAlternative
+* @brief  One advised setting and its range
+********************************************************/
+typedef struct {
+    int acTemp;         /* AC temperature (°C) */
+    int windLevel;      /* Wind level */
+    int speedCap;       /* Speed cap, 0 keeps current speed (km/h) */
+    double rangeKm;     /* Range with this setting (km) */
+    double gainKm;      /* Range over current settings (km) */
+} ClimateAlternative;
+
+/********************************************************
+* @class ClimateAdvisor
+* @brief Class finds settings that give more range. The
+*        drain model is a product of a speed factor and a
+*        climate factor, so climate factors are sampled
+*        from BatteryManager once and the drain at each
+*        speed is read every tick. Advice does not allocate
+*        memory.
+********************************************************/
+class ClimateAdvisor {
+private:
+    const BatteryManager* batteryManager;   /* Drain model and state of charge */
+
+    alignas(32) double climateFactors[ADVISOR_ROW_STRIDE];             /* Range relative to reference climate */
+    alignas(32) double ranges[ADVISOR_SPEED_COUNT * ADVISOR_ROW_STRIDE]; /* Range of each speed and climate (km) */
+    int speeds[ADVISOR_SPEED_COUNT];            /* Speed of each row (km/h) */
+    int speedCaps[ADVISOR_SPEED_COUNT];         /* Speed cap of each row, 0 for current speed */
+    int speedCount;                             /* Rows used this tick */
+
+    ClimateAlternative alternatives[ADVISOR_TOP_COUNT];    /* Best alternatives, most gain first */
+    size_t alternativeCount;
+    double currentRange;                        /* Range with current settings (km) */
+
+    /********************************************************
+    * @brief  Insert an alternative if it is among the best
+    * @param  alternative     Alternative to insert
+    * @return None
+    ********************************************************/
+    void insertAlternative(const ClimateAlternative& alternative);
+
+public:
+    /********************************************************
+    * @brief Constructor, samples climate factors of the
+    *        drain model
+    * @param batteryManager   Pointer to battery manager with
+    *                         the drain model and capacity
+    ********************************************************/
+    explicit ClimateAdvisor(const BatteryManager* batteryManager);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~ClimateAdvisor();
+
+    /********************************************************
+    * @brief  Evaluate all settings against the current ones,
+    *         one alternative is kept for each speed choice
+    * @param  speed       Current speed (km/h)
+    * @param  acTemp      Current AC temperature (°C)
+    * @param  windLevel   Current wind level
+    * @return None
+    ********************************************************/
+    void advise(int speed, int acTemp, int windLevel);
+
+    /********************************************************
+    * @brief  Get range with current settings
+    * @param  None
+    * @return double  Return range (km)
+    ********************************************************/
+    double getCurrentRange() const;
+
+    /********************************************************
+    * @brief  Get number of advised alternatives
+    * @param  None
+    * @return size_t  Return number, at most ADVISOR_TOP_COUNT
+    ********************************************************/
+    size_t getAlternativeCount() const;
+
+    /********************************************************
+    * @brief  Get an advised alternative, most gain first
+    * @param  index   Index of alternative
+    * @return const ClimateAlternative&   Return alternative
+    ********************************************************/
+    const ClimateAlternative& getAlternative(size_t index) const;
+};
+
+#endif  /* CLIMATE_ADVISOR_HPP */
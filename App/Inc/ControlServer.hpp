@@ -0,0 +1,166 @@
+/********************************************************
+* @file     ControlServer.hpp
+* @brief    Declare methods and classes related to the
+*           control socket
+* @details  This file contains class and methods declaration
+*           related to a Unix domain socket that takes
+*           commands from test automation. Each connection
+*           sends "KEY, value" command lines. The server runs
+*           its own epoll loop on a separate thread and pushes
+*           commands into CommandQueue, so a client sending
+*           thousands of commands per second never waits for
+*           the control loop. Nothing is sent back, except
+*           "ERROR" for a line that is not a command and
+*           "FULL" for a command lost because the queue was
+*           full. Only available on Linux.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef CONTROL_SERVER_HPP
+#define CONTROL_SERVER_HPP
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <stdint.h>
+#include "VehicleCommand.hpp"
+
+using namespace std;
+
+/********************************************************
+* Server limits
+********************************************************/
+#define CONTROL_MAX_CLIENTS     16      /* Connected clients */
+#define CONTROL_LINE_SIZE       128     /* Longest command line (bytes) */
+#define CONTROL_POLL_MS         500     /* Longest wait of the loop (ms) */
+
+/********************************************************
+* @struct ControlClient
+* @brief  Connection of one client
+********************************************************/
+typedef struct {
+    int fd;                         /* Socket, -1 if slot is free */
+    char line[CONTROL_LINE_SIZE];   /* Received part of current line */
+    size_t lineLength;              /* Bytes in line */
+    bool isLineTooLong;             /* Rest of line is skipped */
+    uint32_t generation;            /* Grows when slot is freed */
+} ControlClient;
+
+/********************************************************
+* @struct ControlServerStats
+* @brief  Counters of the server
+********************************************************/
+typedef struct {
+    unsigned long accepted;     /* Accepted connections */
+    unsigned long commands;     /* Queued commands */
+    unsigned long invalid;      /* Lines that are not commands */
+    unsigned long dropped;      /* Commands lost because queue was full */
+} ControlServerStats;
+
+/********************************************************
+* @class ControlServer
+* @brief Class reads commands from the control socket on
+*        its own thread. Only start() and stop() are called
+*        by other threads.
+********************************************************/
+class ControlServer {
+private:
+    string path;                /* Socket path */
+    CommandQueue* commandQueue; /* Queue of the control tick */
+
+    atomic<bool> isStopRequested;
+    thread worker;
+
+    /* Used by server thread only */
+    int listenFd;
+    int epollFd;
+    int wakeFd;                 /* eventfd written by stop() */
+    ControlClient clients[CONTROL_MAX_CLIENTS];
+
+    /* Counters, written by server thread */
+    atomic<unsigned long> accepted;
+    atomic<unsigned long> commands;
+    atomic<unsigned long> invalid;
+    atomic<unsigned long> dropped;
+
+    /* Server can not be copied */
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    /********************************************************
+    * @brief  Body of server thread
+    * @param  None
+    * @return None
+    ********************************************************/
+    void run();
+
+    /********************************************************
+    * @brief  Accept all pending connections
+    * @param  None
+    * @return None
+    ********************************************************/
+    void acceptClients();
+
+    /********************************************************
+    * @brief  Read command lines and queue the commands
+    * @param  index   Index of client
+    * @return None
+    ********************************************************/
+    void readCommands(int index);
+
+    /********************************************************
+    * @brief  Parse one line and queue its command
+    * @param  client  Client that sent the line
+    * @param  line    Start of line
+    * @param  end     End of line (without new line)
+    * @return None
+    ********************************************************/
+    void handleLine(ControlClient& client, const char* line, const char* end);
+
+    /********************************************************
+    * @brief  Close connection
+    * @param  index   Index of client
+    * @return None
+    ********************************************************/
+    void closeClient(int index);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param path             Socket path
+    * @param commandQueue     Pointer to CommandQueue object
+    *                         that receives commands
+    ********************************************************/
+    ControlServer(const string& path, CommandQueue* commandQueue);
+
+    /********************************************************
+    * @brief Destructor, stops the server
+    ********************************************************/
+    ~ControlServer();
+
+    /********************************************************
+    * @brief  Open socket and start server thread, an old
+    *         socket file at path is replaced
+    * @param  None
+    * @return bool        Return false if server cannot start
+    ********************************************************/
+    bool start();
+
+    /********************************************************
+    * @brief  Close all connections, stop server thread and
+    *         remove socket file
+    * @param  None
+    * @return None
+    ********************************************************/
+    void stop();
+
+    /********************************************************
+    * @brief  Get counters of the server
+    * @param  None
+    * @return ControlServerStats  Return counters
+    ********************************************************/
+    ControlServerStats getStats() const;
+};
+
+#endif  /* CONTROL_SERVER_HPP */
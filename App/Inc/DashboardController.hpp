@@ -4,7 +4,7 @@
 *           controller
 * @details  This file contains classes and methods declaration
 *           related to dashboard controller, stores system 
-*           parameters, use observe pattern to update data
+*           parameters, use typed signals to publish data
 *           to other classes.
 * @version  1.0
 * @date     2024-11-10
@@ -18,15 +18,22 @@
 #include <sstream>
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <memory>
+#include <stdint.h>
+#include "SignalBus.hpp"
 
 using namespace std;
 
 /********************************************************
 * The database path to CSV file that stores system information
 ********************************************************/
-#define DATABASE_PATH   ".\\Data\\Database.csv"
+#define DATABASE_PATH   "./Data/Database.csv"
+
+/********************************************************
+* @brief Maximum size of database file, it is read into a
+*        buffer of this size
+********************************************************/
+#define DATABASE_MAX_SIZE   1024
 
 /********************************************************
 * @enum  DriveMode
@@ -38,21 +45,48 @@ typedef enum {
 } DriveMode;
 
 /********************************************************
-* @class Observer
-* @brief Interface for observes
+* @struct DashboardState
+* @brief  Values of all system parameters at one time
 ********************************************************/
-class Observer {
-public:
-    /********************************************************
-    * @brief Virtual function use for objects 
-    ********************************************************/
-    virtual void update() = 0;
-};
+typedef struct {
+    int speed;              /* Speed (km/h) */
+    DriveMode driveMode;    /* Drive mode (ECO or SPORT) */
+    int batteryLevel;       /* Battery level (0 - 100 %) */
+    double remainingRange;  /* Ramaining range (km) */
+    int acTemp;             /* Air Conditioner temperature (16 - 30 °C) */
+    int windLevel;          /* Wind level (1 - 5) */
+} DashboardState;
+
+/********************************************************
+* @struct SpeedChanged
+* @brief  Event emitted when speed is changed
+********************************************************/
+typedef struct {
+    int oldSpeed;           /* Speed before change (km/h) */
+    int newSpeed;           /* Speed after change (km/h) */
+    uint64_t tickTimeUs;    /* Time of change (us, monotonic) */
+} SpeedChanged;
+
+/********************************************************
+* @struct StateSnapshot
+* @brief  Event emitted when system parameters are
+*         published, subscribers get all values at once
+********************************************************/
+typedef struct {
+    DashboardState oldState;    /* State at previous publish */
+    DashboardState newState;    /* State at this publish */
+    uint64_t tickTimeUs;        /* Time of publish (us, monotonic) */
+} StateSnapshot;
+
+/********************************************************
+* @brief Clock used for time of events (us, monotonic)
+********************************************************/
+typedef uint64_t (*TickClock)();
 
 /********************************************************
 * @class DashboardController
-* @brief Class includes system parameters, is the subject
-*        that keep the list of registered observers
+* @brief Class includes system parameters, publishes
+*        changes through typed signals
 ********************************************************/
 class DashboardController {
 private:
@@ -63,8 +97,13 @@ private:
     int acTemp;             /* Air Conditioner temperature (16 - 30 °C) */
     int windLevel;          /* Wind level (1 - 5) */
 
-    /* List of observers */ 
-    vector<Observer*> observers;
+    DashboardState publishedState;  /* State passed with last StateSnapshot */
+    bool hasPublishedState;         /* publishedState is valid */
+    TickClock tickClock;            /* Clock for time of events */
+
+    /* Signals to subscribers */
+    Signal<SpeedChanged> speedChanged;
+    Signal<StateSnapshot> stateChanged;
 
 public:
     /********************************************************
@@ -169,26 +208,56 @@ public:
     void updateData();
 
     /********************************************************
-    * @brief  Register observer to the list of observes
-    * @param  observer  Pointer to object to register observer  
-    * @return None
+    * @brief  Get all system parameters at once
+    * @param  None
+    * @return DashboardState  Return current state
+    ********************************************************/
+    DashboardState getState() const;
+
+    /********************************************************
+    * @brief  Get signal emitted when speed is changed
+    * @param  None
+    * @return Signal<SpeedChanged>&   Return signal to subscribe
+    ********************************************************/
+    Signal<SpeedChanged>& onSpeedChanged();
+
+    /********************************************************
+    * @brief  Get signal emitted when state is published
+    * @param  None
+    * @return Signal<StateSnapshot>&  Return signal to subscribe
     ********************************************************/
-    void registerObserver(Observer* observer); 
+    Signal<StateSnapshot>& onStateChanged();
 
     /********************************************************
-    * @brief  Remove observer from the list of observes
-    * @param  observer  Pointer to object to remove observer  
+    * @brief  Publish current state with previous published
+    *         state to all subscribers of onStateChanged
+    * @param  None  
     * @return None
-    ********************************************************/   
-    void removeObserver(Observer* observer);
+    ********************************************************/
+    void publishState();
 
     /********************************************************
-    * @brief  Notify to all observes in the list about new 
-    *         updated data
+    * @brief  Get current monotonic time used in events
     * @param  None  
+    * @return uint64_t    Return time (us)
+    ********************************************************/
+    static uint64_t getTickTimeUs();
+
+    /********************************************************
+    * @brief  Get time of the clock used for events
+    * @param  None
+    * @return uint64_t    Return time (us)
+    ********************************************************/
+    uint64_t getTickTime() const;
+
+    /********************************************************
+    * @brief  Replace clock used for time of events, such as
+    *         a virtual clock in benchmarks
+    * @param  clock   Clock function, NULL restores
+    *                 getTickTimeUs
     * @return None
     ********************************************************/
-    void notifyObservers() const;
+    void setTickClock(TickClock clock);
 };
 
 #endif  /* DASHBOARD_CONTROLLER_HPP */
\ No newline at end of file
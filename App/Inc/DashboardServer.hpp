@@ -0,0 +1,281 @@
+/********************************************************
+* @file     DashboardServer.hpp
+* @brief    Declare methods and classes related to the HTTP
+*           dashboard
+* @details  This file contains classes and methods declaration
+*           related to a small HTTP/1.1 server. It serves one
+*           static page and streams system parameters with
+*           Server-Sent Events. The server runs its own epoll
+*           loop on a separate thread. The control loop only
+*           stores the latest state and wakes the server, each
+*           update is serialized once into a shared frame that
+*           is written to all viewers, so the number of viewers
+*           does not change the cost of the control loop.
+*           Only available on Linux.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef DASHBOARD_SERVER_HPP
+#define DASHBOARD_SERVER_HPP
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+#include "DashboardController.hpp"
+#include "SeqLock.hpp"
+
+using namespace std;
+
+/********************************************************
+* Server limits
+********************************************************/
+#define HTTP_DEFAULT_ADDRESS    "127.0.0.1" /* Address used when only port is given */
+#define HTTP_MAX_CLIENTS        1024        /* Connected viewers and requests */
+#define HTTP_REQUEST_SIZE       1024        /* Longest request header (bytes) */
+#define HTTP_FRAME_SIZE         256         /* Longest serialized event (bytes) */
+#define HTTP_FRAME_POOL         16          /* Events kept for clients still sending */
+#define HTTP_MAX_SEGMENTS       3           /* Queued writes of one client */
+#define HTTP_SLOW_CLIENT_MS     3000        /* Client without progress is dropped (ms) */
+#define HTTP_POLL_MS            500         /* Longest wait of the loop (ms) */
+
+/********************************************************
+* @enum  HttpClientState
+* @brief State of one connection
+********************************************************/
+typedef enum {
+    HTTP_CLIENT_FREE,       /* Slot not used */
+    HTTP_CLIENT_REQUEST,    /* Reading request header */
+    HTTP_CLIENT_RESPONSE,   /* Sending a response, closed after it */
+    HTTP_CLIENT_STREAM      /* Receiving events */
+} HttpClientState;
+
+/********************************************************
+* @struct HttpSegment
+* @brief  One queued write, static data or a shared frame
+********************************************************/
+typedef struct {
+    const char* data;       /* Start of data */
+    size_t length;          /* Length of data (bytes) */
+    int frame;              /* Index of frame, -1 for static data */
+} HttpSegment;
+
+/********************************************************
+* @struct HttpClient
+* @brief  Connection of one viewer
+********************************************************/
+typedef struct {
+    int fd;                             /* Socket */
+    HttpClientState state;              /* State of connection */
+    char request[HTTP_REQUEST_SIZE];    /* Received request header */
+    size_t requestLength;               /* Bytes in request */
+    HttpSegment segments[HTTP_MAX_SEGMENTS];  /* Queued writes */
+    int segmentCount;                   /* Number of queued writes */
+    size_t sentOffset;                  /* Bytes sent of first segment */
+    uint64_t stalledSinceMs;            /* Time of last progress while waiting, 0 if none wait */
+    bool isWaitingWritable;             /* Socket waited for EPOLLOUT */
+    uint32_t generation;                /* Grows when slot is freed */
+} HttpClient;
+
+/********************************************************
+* @struct HttpFrame
+* @brief  One serialized event, shared by all clients
+********************************************************/
+typedef struct {
+    char data[HTTP_FRAME_SIZE];     /* Event text */
+    size_t length;                  /* Length of event (bytes) */
+    uint64_t version;               /* Version of state in event */
+    int references;                 /* Clients and server using it */
+} HttpFrame;
+
+/********************************************************
+* @struct DashboardServerStats
+* @brief  Counters of the server
+********************************************************/
+typedef struct {
+    unsigned long accepted;     /* Accepted connections */
+    unsigned long streams;      /* Connections that received events */
+    unsigned long frames;       /* Serialized events */
+    unsigned long coalesced;    /* Queued events replaced by a newer one */
+    unsigned long dropped;      /* Clients dropped as too slow */
+} DashboardServerStats;
+
+/********************************************************
+* @class DashboardServer
+* @brief Class serves the dashboard page and events. update()
+*        is called on the control loop thread, everything
+*        else runs on the server thread.
+********************************************************/
+class DashboardServer {
+private:
+    string address;             /* Listen address */
+    uint16_t port;              /* Listen port */
+
+    /* Shared with control loop */
+    SeqLock<DashboardState> latestState;
+    atomic<bool> isNotified;    /* Wake up is pending */
+    atomic<bool> isStopRequested;
+    thread worker;
+
+    /* Used by server thread only */
+    int listenFd;
+    int epollFd;
+    int wakeFd;                 /* eventfd written by update() */
+    vector<HttpClient> clients;
+    HttpFrame frames[HTTP_FRAME_POOL];
+    int latestFrame;            /* Frame of latest state, -1 before first */
+    uint64_t latestVersion;     /* Version of latest serialized state */
+    int activeClients;          /* Slots not free */
+
+    /* Counters, written by server thread */
+    atomic<unsigned long> accepted;
+    atomic<unsigned long> streams;
+    atomic<unsigned long> frameCount;
+    atomic<unsigned long> coalesced;
+    atomic<unsigned long> dropped;
+
+    /* Server can not be copied */
+    DashboardServer(const DashboardServer&) = delete;
+    DashboardServer& operator=(const DashboardServer&) = delete;
+
+    /********************************************************
+    * @brief  Body of server thread
+    * @param  None
+    * @return None
+    ********************************************************/
+    void run();
+
+    /********************************************************
+    * @brief  Accept all pending connections
+    * @param  nowMs   Current time (ms)
+    * @return None
+    ********************************************************/
+    void acceptClients(uint64_t nowMs);
+
+    /********************************************************
+    * @brief  Serialize latest state and queue it to streams
+    * @param  nowMs   Current time (ms)
+    * @return None
+    ********************************************************/
+    void broadcastLatest(uint64_t nowMs);
+
+    /********************************************************
+    * @brief  Read request header and queue the response
+    * @param  index   Index of client
+    * @param  nowMs   Current time (ms)
+    * @return None
+    ********************************************************/
+    void readRequest(int index, uint64_t nowMs);
+
+    /********************************************************
+    * @brief  Write queued segments with one writev
+    * @param  index   Index of client
+    * @param  nowMs   Current time (ms)
+    * @return None
+    ********************************************************/
+    void flushClient(int index, uint64_t nowMs);
+
+    /********************************************************
+    * @brief  Queue a segment, a frame not started yet is
+    *         replaced by a newer frame
+    * @param  client  Client to write to
+    * @param  data    Start of data
+    * @param  length  Length of data
+    * @param  frame   Index of frame, -1 for static data
+    * @return None
+    ********************************************************/
+    void queueSegment(HttpClient& client, const char* data, size_t length, int frame);
+
+    /********************************************************
+    * @brief  Close connection and release its frames
+    * @param  index   Index of client
+    * @return None
+    ********************************************************/
+    void closeClient(int index);
+
+    /********************************************************
+    * @brief  Drop clients without progress for too long
+    * @param  nowMs   Current time (ms)
+    * @return None
+    ********************************************************/
+    void dropSlowClients(uint64_t nowMs);
+
+    /********************************************************
+    * @brief  Get a free frame, clients holding the oldest
+    *         frame are dropped if none is free
+    * @param  None
+    * @return int     Return index of frame
+    ********************************************************/
+    int acquireFrame();
+
+    /********************************************************
+    * @brief  Release one reference to a frame
+    * @param  frame   Index of frame, -1 is ignored
+    * @return None
+    ********************************************************/
+    void releaseFrame(int frame);
+
+    /********************************************************
+    * @brief  Get monotonic time of the server loop
+    * @param  None
+    * @return uint64_t    Return time (ms)
+    ********************************************************/
+    static uint64_t nowMs();
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param address  Listen address
+    * @param port     Listen port
+    ********************************************************/
+    DashboardServer(const string& address, uint16_t port);
+
+    /********************************************************
+    * @brief Destructor, stops the server
+    ********************************************************/
+    ~DashboardServer();
+
+    /********************************************************
+    * @brief  Parse listen option
+    * @param  text        "<port>" or "<address>:<port>"
+    * @param  address     Parsed address
+    * @param  port        Parsed port
+    * @return bool        Return false if text is invalid
+    ********************************************************/
+    static bool parseListen(const string& text, string& address, uint16_t& port);
+
+    /********************************************************
+    * @brief  Open listen socket and start server thread
+    * @param  None
+    * @return bool        Return false if server cannot start
+    ********************************************************/
+    bool start();
+
+    /********************************************************
+    * @brief  Close all connections and stop server thread
+    * @param  None
+    * @return None
+    ********************************************************/
+    void stop();
+
+    /********************************************************
+    * @brief  Handle published state, stores it and wakes up
+    *         the server, does not block and does not allocate
+    *         memory. This method will be called when
+    *         DashboardController publishes new state
+    * @param  snapshot    State published by DashboardController
+    * @return None
+    ********************************************************/
+    void update(const StateSnapshot& snapshot);
+
+    /********************************************************
+    * @brief  Get counters of the server
+    * @param  None
+    * @return DashboardServerStats    Return counters
+    ********************************************************/
+    DashboardServerStats getStats() const;
+};
+
+#endif  /* DASHBOARD_SERVER_HPP */
@@ -20,21 +20,27 @@ using namespace std;
 /********************************************************
 * @class DisplayManager
 * @brief Class includes methods display data, its object 
-*        is the observer that must register to list of 
-*        observers
+*        must subscribe to state changes of 
+*        DashboardController
 ********************************************************/
-class DisplayManager : public Observer {
+class DisplayManager {
 private:
     /********************************************************
-    * @brief Pointer to DashboardController to get data
+    * @brief State received with the last update to display
     ********************************************************/
-    DashboardController* dashboardController;
+    DashboardState state;
+
+    /********************************************************
+    * @brief Stream to display on
+    ********************************************************/
+    ostream* output;
 
 public:
     /********************************************************
     * @brief Constructor 
+    * @param output   Stream to display on, console by default
     ********************************************************/
-    DisplayManager(DashboardController* dashboardController);
+    DisplayManager(ostream& output = cout);
 
     /********************************************************
     * @brief Destructor 
@@ -92,10 +98,10 @@ public:
     
     /********************************************************
     * @brief  Update data 
-    * @param  None
+    * @param  snapshot    State published by DashboardController
     * @return None
     ********************************************************/
-    void update();
+    void update(const StateSnapshot& snapshot);
 };
 
 #endif  /* DISPLAY_MANAGER_HPP */
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 #include <string>
 #include "DashboardController.hpp"
+#include "VehicleProfile.hpp"
 
 using namespace std;
 
@@ -40,6 +41,13 @@ public:
     ********************************************************/
     ~DriveModeManager();
 
+    /********************************************************
+    * @brief  Apply parameters of vehicle profile
+    * @param  profile     Parameters of vehicle variant
+    * @return None
+    ********************************************************/
+    void applyProfile(const VehicleProfile& profile);
+
     /********************************************************
     * @brief  Set drive mode
     * @param  mode    Mode that want to set drive mode
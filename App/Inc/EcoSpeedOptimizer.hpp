@@ -0,0 +1,199 @@
+/********************************************************
+* @file     EcoSpeedOptimizer.hpp
+* @brief    Declare methods and classes related to eco
+*           driving speed advice
+* @details  This file contains class and methods declaration
+*           related to planning the speed profile of a route
+*           that uses the least energy and still arrives
+*           within a time budget. The route is cut into
+*           short steps, dynamic programming runs over a
+*           (position, speed) grid with speed limits and
+*           acceleration limits, and the time budget is met
+*           by a Lagrange multiplier found by bisection. The
+*           speeds of each step are split between several
+*           threads, all threads wait at a barrier before the
+*           next step.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef ECO_SPEED_OPTIMIZER_HPP
+#define ECO_SPEED_OPTIMIZER_HPP
+
+#include <vector>
+#include <stdint.h>
+#include "BatteryManager.hpp"
+#include "RoutePredictor.hpp"
+
+using namespace std;
+
+/********************************************************
+* Grid and vehicle limits of the optimizer
+********************************************************/
+#define ECO_STEP_KM             0.1     /* Longest distance between 2 grid positions (km) */
+#define ECO_SPEED_STEP          1.0     /* Distance between 2 grid speeds (km/h) */
+#define ECO_MIN_SPEED           10      /* Lowest speed after start (km/h) */
+#define ECO_MAX_ACCEL           1.0     /* Strongest acceleration (m/s^2) */
+#define ECO_MAX_DECEL           1.5     /* Strongest deceleration (m/s^2) */
+#define ECO_BISECT_ITERATIONS   40      /* Most dynamic programming runs of one plan */
+#define ECO_TIME_TOLERANCE      0.001   /* Relative error of duration that stops bisection */
+#define ECO_LAMBDA_TOLERANCE    0.001   /* Relative width of multiplier range that stops bisection */
+#define ECO_SPEEDS_PER_WORKER   32      /* Fewest grid speeds given to one thread */
+#define ECO_CACHE_LINE_COSTS    8       /* Costs in one cache line, blocks start on a line */
+#define ECO_MAX_LAMBDA          1e6     /* Highest price of one hour, budget cannot be met above it (kWh/h) */
+
+/********************************************************
+* @struct EcoQuery
+* @brief  Route and conditions of one plan
+********************************************************/
+typedef struct {
+    const RouteSegment* segments;   /* Segments of the route */
+    size_t segmentCount;            /* Number of segments */
+    double budgetHours;             /* Latest arrival, from start (h) */
+    double startSoc;                /* State of charge at start (%) */
+    int startSpeed;                 /* Speed at start (km/h) */
+    int acTemp;                     /* AC temperature (°C) */
+    int windLevel;                  /* Wind level */
+} EcoQuery;
+
+/********************************************************
+* @struct EcoPlan
+* @brief  Result of one plan
+********************************************************/
+typedef struct {
+    double energyKwh;       /* Energy used (kWh) */
+    double durationHours;   /* Driving time (h) */
+    double distanceKm;      /* Route length (km) */
+    double finalSoc;        /* State of charge at destination (%) */
+    double lambda;          /* Price of one hour in kWh */
+    int iterations;         /* Dynamic programming runs */
+    bool isFeasible;        /* Budget is met, otherwise the fastest profile is given */
+} EcoPlan;
+
+/********************************************************
+* @class EcoSpeedOptimizer
+* @brief Class plans speed profiles with the drain model of
+*        BatteryManager, like RoutePredictor. Buffers are
+*        kept between plans, so planning the same route
+*        again does not allocate grid memory.
+********************************************************/
+class EcoSpeedOptimizer {
+private:
+    const BatteryManager* batteryManager;   /* Drain model */
+
+    /* Grid of the current plan */
+    vector<double> columnKm;        /* Length of step before each position (km) */
+    vector<double> columnGrade;     /* Grade factor of step before each position */
+    vector<uint16_t> columnLimit;   /* Highest speed index at each position */
+    vector<uint32_t> columnSegment; /* Segment of step before each position */
+    vector<double> speeds;          /* Speed of each index (km/h) */
+    vector<double> costs;           /* Costs of 2 positions, previous and current */
+    size_t costOffset;              /* First cost on a cache line boundary */
+    vector<double> stepCosts;       /* Cost of step to current position by sum of speed indexes */
+    vector<uint16_t> previous;      /* Best speed index at previous position */
+    vector<uint16_t> profile;       /* Speed index at each position of best plan */
+    vector<uint16_t> bestProfile;   /* Profile of best plan that meets budget */
+    size_t columnCount;             /* Number of positions, start included */
+    size_t startIndex;              /* Speed index at start */
+    size_t speedCount;              /* Number of grid speeds */
+    size_t rowStride;               /* Costs of one position, rounded to cache lines */
+    double drainBase;               /* Drain at speed 0 (kWh/km) */
+    double drainSlope;              /* Drain per km/h (kWh/km) */
+
+    /* Search state, changed only between 2 barriers */
+    double lambda;                  /* Multiplier of this run */
+    double lambdaLow;               /* Highest multiplier known too slow */
+    double lambdaHigh;              /* Lowest multiplier known in budget, < 0 if none */
+    size_t column;                  /* Position computed by workers */
+    bool isDone;
+    EcoPlan plan;
+    double budgetHours;
+
+    /********************************************************
+    * @brief  Compute costs of the current position for a
+    *         block of speeds
+    * @param  begin   First speed index
+    * @param  end     Speed index after the last one
+    * @return None
+    ********************************************************/
+    void relaxColumn(size_t begin, size_t end);
+
+    /********************************************************
+    * @brief  Fill cost of the step before current position
+    * @param  None
+    * @return None
+    ********************************************************/
+    void prepareColumn();
+
+    /********************************************************
+    * @brief  Go to next position, or finish a run and pick
+    *         the next multiplier. Called by one thread while
+    *         others wait at the barrier
+    * @param  None
+    * @return None
+    ********************************************************/
+    void advance();
+
+    /********************************************************
+    * @brief  Follow best predecessors back from destination
+    *         and measure energy and time of the profile
+    * @param  energyKwh       Energy of profile (kWh)
+    * @param  durationHours   Time of profile (h)
+    * @return None
+    ********************************************************/
+    void traceProfile(double& energyKwh, double& durationHours);
+
+    /********************************************************
+    * @brief  Start a run with a new multiplier
+    * @param  value   Multiplier (kWh/h)
+    * @return None
+    ********************************************************/
+    void startRun(double value);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param batteryManager   Pointer to battery manager with
+    *                         the drain model and capacity
+    ********************************************************/
+    explicit EcoSpeedOptimizer(const BatteryManager* batteryManager);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~EcoSpeedOptimizer();
+
+    /********************************************************
+    * @brief  Plan speed profile with least energy within the
+    *         time budget
+    * @param  query       Route, budget and conditions
+    * @param  workers     Number of threads (0 use hardware
+    *                     threads, limited by grid size)
+    * @return EcoPlan     Return energy and time of the plan
+    ********************************************************/
+    EcoPlan optimize(const EcoQuery& query, unsigned int workers);
+
+    /********************************************************
+    * @brief  Get number of positions of last plan
+    * @param  None
+    * @return size_t  Return number of positions, start included
+    ********************************************************/
+    size_t getPositionCount() const;
+
+    /********************************************************
+    * @brief  Get planned speed at a position of last plan
+    * @param  position    Index of position
+    * @return double      Return speed (km/h)
+    ********************************************************/
+    double getSpeed(size_t position) const;
+
+    /********************************************************
+    * @brief  Get average planned speed of one segment of
+    *         last plan, the speed advised to the driver
+    * @param  segment     Index of segment
+    * @return double      Return speed (km/h)
+    ********************************************************/
+    double getSegmentSpeed(size_t segment) const;
+};
+
+#endif  /* ECO_SPEED_OPTIMIZER_HPP */
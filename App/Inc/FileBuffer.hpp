@@ -0,0 +1,41 @@
+/********************************************************
+* @file     FileBuffer.hpp
+* @brief    Declare methods related to whole file read and
+*           write with caller buffers
+* @details  This file contains methods declaration related
+*           to reading a small file into a caller buffer and
+*           writing a buffer to a file. They use native file
+*           handles and do not allocate memory, unlike file
+*           streams, so they can run in every tick.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef FILE_BUFFER_HPP
+#define FILE_BUFFER_HPP
+
+#include <cstddef>
+
+using namespace std;
+
+/********************************************************
+* @brief  Read whole file into a buffer
+* @param  path        Path to file
+* @param  buffer      Buffer to fill
+* @param  capacity    Size of buffer (bytes)
+* @param  length      Number of bytes read
+* @return bool        Return true if file is read and fits
+*                     in the buffer
+********************************************************/
+bool readFileToBuffer(const char* path, char* buffer, size_t capacity, size_t& length);
+
+/********************************************************
+* @brief  Replace content of a file with a buffer
+* @param  path        Path to file
+* @param  data        Content to write
+* @param  length      Number of bytes to write
+* @return bool        Return true if all bytes are written
+********************************************************/
+bool writeBufferToFile(const char* path, const char* data, size_t length);
+
+#endif  /* FILE_BUFFER_HPP */
@@ -0,0 +1,245 @@
+/********************************************************
+* @file     FixedPoint.hpp
+* @brief    Declare classes related to fixed-point numbers
+* @details  This file contains template class of signed
+*           fixed-point numbers used by energy and speed
+*           models on targets without FPU. Arithmetic uses
+*           integer instructions only, constants written as
+*           double are converted at compile time.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef FIXED_POINT_HPP
+#define FIXED_POINT_HPP
+
+#include <stdint.h>
+#include <type_traits>
+
+using namespace std;
+
+/********************************************************
+* @class FixedPoint
+* @brief Class keeps value * 2^FracBits in a signed integer
+*        of type Raw. Products and quotients are rounded to
+*        nearest, sums and differences are exact.
+********************************************************/
+template <typename Raw, int FracBits>
+class FixedPoint {
+private:
+    typedef typename make_unsigned<Raw>::type URaw;
+
+    Raw raw;    /* Value * 2^FracBits */
+
+    static constexpr Raw ONE = (Raw)1 << FracBits;
+
+    /********************************************************
+    * @brief  Multiply 2 raw values and scale back
+    * @param  a   First raw value
+    * @param  b   Second raw value
+    * @return Raw     Return a * b / 2^FracBits
+    ********************************************************/
+    static constexpr Raw multiply(Raw a, Raw b) {
+        if constexpr (sizeof(Raw) <= 4) {
+            int64_t product = (int64_t)a * b;
+            return (Raw)((product + ((int64_t)1 << (FracBits - 1))) >> FracBits);
+        } else {
+#ifdef __SIZEOF_INT128__
+            __int128 product = (__int128)a * b;
+            return (Raw)((product + ((__int128)1 << (FracBits - 1))) >> FracBits);
+#else
+            // 64 x 64 bit product from 32 bit halves, bits 32..95
+            // are kept, higher bits are overflow anyway
+            static_assert(FracBits == 32, "Portable product supports 32 fraction bits only");
+            bool isNegative = (a < 0) != (b < 0);
+            URaw ua = (a < 0) ? (URaw)0 - (URaw)a : (URaw)a;
+            URaw ub = (b < 0) ? (URaw)0 - (URaw)b : (URaw)b;
+            URaw aHigh = ua >> 32, aLow = ua & 0xFFFFFFFFu;
+            URaw bHigh = ub >> 32, bLow = ub & 0xFFFFFFFFu;
+
+            URaw low = aLow * bLow;
+            URaw result = ((aHigh * bHigh) << 32) + aHigh * bLow + aLow * bHigh
+                + (low >> 32) + ((low >> 31) & 1);
+            return isNegative ? (Raw)((URaw)0 - result) : (Raw)result;
+#endif
+        }
+    }
+
+    /********************************************************
+    * @brief  Divide integers, rounded to nearest
+    * @param  a   Dividend
+    * @param  b   Divisor, not zero
+    * @return Wide    Return a / b
+    ********************************************************/
+    template <typename Wide>
+    static constexpr Wide roundedQuotient(Wide a, Wide b) {
+        Wide half = ((b < 0) ? -b : b) / 2;
+        return ((a < 0) ? a - half : a + half) / b;
+    }
+
+    /********************************************************
+    * @brief  Divide 2 raw values and scale back
+    * @param  a   Dividend raw value
+    * @param  b   Divisor raw value, not zero
+    * @return Raw     Return a * 2^FracBits / b
+    ********************************************************/
+    static constexpr Raw divide(Raw a, Raw b) {
+        if constexpr (sizeof(Raw) <= 4) {
+            return (Raw)roundedQuotient((int64_t)a * ONE, (int64_t)b);
+        } else {
+#ifdef __SIZEOF_INT128__
+            return (Raw)roundedQuotient((__int128)a * ONE, (__int128)b);
+#else
+            bool isNegative = (a < 0) != (b < 0);
+            URaw ua = (a < 0) ? (URaw)0 - (URaw)a : (URaw)a;
+            URaw ub = (b < 0) ? (URaw)0 - (URaw)b : (URaw)b;
+
+            // Integer part, then one quotient bit per fraction bit
+            URaw quotient = ua / ub;
+            URaw remainder = ua % ub;
+            for (int bit = 0; bit < FracBits; bit++) {
+                remainder <<= 1;
+                quotient <<= 1;
+                if (remainder >= ub) {
+                    remainder -= ub;
+                    quotient |= 1;
+                }
+            }
+
+            // Round to nearest
+            if (remainder >= ub - remainder) {
+                quotient++;
+            }
+            return isNegative ? (Raw)((URaw)0 - quotient) : (Raw)quotient;
+#endif
+        }
+    }
+
+public:
+    /********************************************************
+    * @brief Constructor, value is zero
+    ********************************************************/
+    constexpr FixedPoint() : raw(0) {}
+
+    /********************************************************
+    * @brief Constructor from integer
+    * @param value    Integer value
+    ********************************************************/
+    constexpr FixedPoint(int value) : raw((Raw)value * ONE) {}
+
+    /********************************************************
+    * @brief Constructor from double, rounded to nearest. Use
+    *        in constant expressions on targets without FPU
+    * @param value    Double value
+    ********************************************************/
+    constexpr explicit FixedPoint(double value)
+        : raw((Raw)(value * (double)ONE + (value < 0 ? -0.5 : 0.5))) {}
+
+    /********************************************************
+    * @brief  Build from raw value
+    * @param  value   Value * 2^FracBits
+    * @return FixedPoint  Return number
+    ********************************************************/
+    static constexpr FixedPoint fromRaw(Raw value) {
+        FixedPoint number;
+        number.raw = value;
+        return number;
+    }
+
+    /********************************************************
+    * @brief  Get raw value
+    * @param  None
+    * @return Raw     Return value * 2^FracBits
+    ********************************************************/
+    constexpr Raw getRaw() const {
+        return raw;
+    }
+
+    /********************************************************
+    * @brief  Convert to integer, rounded toward zero
+    * @param  None
+    * @return int     Return integer part
+    ********************************************************/
+    constexpr int toInt() const {
+        return (int)(raw / ONE);
+    }
+
+    /********************************************************
+    * @brief  Convert to double, for display only
+    * @param  None
+    * @return double  Return value
+    ********************************************************/
+    constexpr double toDouble() const {
+        return (double)raw / (double)ONE;
+    }
+
+    constexpr FixedPoint operator-() const { return fromRaw(-raw); }
+    constexpr FixedPoint operator+(FixedPoint other) const { return fromRaw(raw + other.raw); }
+    constexpr FixedPoint operator-(FixedPoint other) const { return fromRaw(raw - other.raw); }
+    constexpr FixedPoint operator*(FixedPoint other) const { return fromRaw(multiply(raw, other.raw)); }
+    constexpr FixedPoint operator/(FixedPoint other) const { return fromRaw(divide(raw, other.raw)); }
+
+    /* Integer operands need no scaling */
+    constexpr FixedPoint operator*(int value) const { return fromRaw(raw * value); }
+    constexpr FixedPoint operator/(int value) const { return fromRaw(roundedQuotient<Raw>(raw, value)); }
+
+    FixedPoint& operator+=(FixedPoint other) { raw += other.raw; return *this; }
+    FixedPoint& operator-=(FixedPoint other) { raw -= other.raw; return *this; }
+
+    constexpr bool operator==(FixedPoint other) const { return raw == other.raw; }
+    constexpr bool operator!=(FixedPoint other) const { return raw != other.raw; }
+    constexpr bool operator<(FixedPoint other) const { return raw < other.raw; }
+    constexpr bool operator<=(FixedPoint other) const { return raw <= other.raw; }
+    constexpr bool operator>(FixedPoint other) const { return raw > other.raw; }
+    constexpr bool operator>=(FixedPoint other) const { return raw >= other.raw; }
+};
+
+/********************************************************
+* @brief Fixed-point types of the models
+********************************************************/
+typedef FixedPoint<int32_t, 16> Q16_16;     /* Range ±32767, step 1.5e-5 */
+typedef FixedPoint<int64_t, 32> Q32_32;     /* Range ±2.1e9, step 2.3e-10 */
+
+/********************************************************
+* @brief Number type of the dashboard models, fixed-point
+*        for a target without FPU is selected at build
+*        time with NUMERIC=q16 or NUMERIC=q32 of makefile
+********************************************************/
+#if defined(DASHBOARD_NUMERIC_Q16_16)
+typedef Q16_16 DashboardNum;
+#elif defined(DASHBOARD_NUMERIC_Q32_32)
+typedef Q32_32 DashboardNum;
+#else
+typedef double DashboardNum;
+#endif
+
+/********************************************************
+* @brief  Convert number of a model to integer, rounded
+*         toward zero
+* @param  value   Double or fixed-point number
+* @return int     Return integer part
+********************************************************/
+inline int numericToInt(double value) {
+    return (int)value;
+}
+
+template <typename Raw, int FracBits>
+inline int numericToInt(FixedPoint<Raw, FracBits> value) {
+    return value.toInt();
+}
+
+/********************************************************
+* @brief  Convert number of a model to double
+* @param  value   Double or fixed-point number
+* @return double  Return value
+********************************************************/
+inline double numericToDouble(double value) {
+    return value;
+}
+
+template <typename Raw, int FracBits>
+inline double numericToDouble(FixedPoint<Raw, FracBits> value) {
+    return value.toDouble();
+}
+
+#endif  /* FIXED_POINT_HPP */
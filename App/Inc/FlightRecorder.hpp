@@ -0,0 +1,202 @@
+/********************************************************
+* @file     FlightRecorder.hpp
+* @brief    Declare methods and classes related to the
+*           flight recorder
+* @details  This file contains class and methods declaration
+*           related to an always-on record of the last ticks.
+*           Each control tick stores its full state, held
+*           controls and commands into a fixed ring, the
+*           oldest tick is overwritten. A crash (SIGSEGV,
+*           SIGABRT) or SIGUSR2 writes the ring into a binary
+*           file from the signal handler, without lock and
+*           without heap, so the ticks before a fault can be
+*           read after it with FlightDecoder. Signal handlers
+*           are only available on Linux.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef FLIGHT_RECORDER_HPP
+#define FLIGHT_RECORDER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "DashboardController.hpp"
+#include "VehicleCommand.hpp"
+
+using namespace std;
+
+/********************************************************
+* Recorder limits
+********************************************************/
+#define FLIGHT_RECORDER_PATH        "./Data/FlightRecorder.bin"
+#define FLIGHT_RECORDER_TICKS       4096    /* Ticks kept, power of 2 (about 7 minutes) */
+#define FLIGHT_EVENTS_PER_TICK      7       /* Commands kept of each tick */
+#define FLIGHT_PATH_SIZE            256     /* Longest dump path (bytes) */
+#define FLIGHT_DUMP_MAGIC           "FLIGHT01"
+#define FLIGHT_DUMP_VERSION         1
+
+/********************************************************
+* @enum  FlightInput
+* @brief This enum contains bits of held driver controls
+********************************************************/
+typedef enum {
+    FLIGHT_INPUT_ACCELERATOR = 1 << 0,
+    FLIGHT_INPUT_BRAKE = 1 << 1,
+    FLIGHT_INPUT_MODE = 1 << 2,
+    FLIGHT_INPUT_AC_UP = 1 << 3,
+    FLIGHT_INPUT_AC_DOWN = 1 << 4,
+    FLIGHT_INPUT_WIND_UP = 1 << 5,
+    FLIGHT_INPUT_WIND_DOWN = 1 << 6,
+    FLIGHT_INPUT_TRIP_RESET = 1 << 7,
+    FLIGHT_INPUT_CRUISE = 1 << 8,
+    FLIGHT_INPUT_CRUISE_UP = 1 << 9,
+    FLIGHT_INPUT_CRUISE_DOWN = 1 << 10
+} FlightInput;
+
+/********************************************************
+* @struct FlightEvent
+* @brief  One command applied in a tick
+********************************************************/
+typedef struct {
+    uint8_t type;           /* CommandType */
+    uint8_t source;         /* CommandSource */
+    uint16_t latencyUs;     /* Time from submit to tick (us), 65535 if longer */
+    int32_t value;          /* Value of command */
+} FlightEvent;
+
+/********************************************************
+* @struct FlightRecord
+* @brief  State of one tick, as written in the dump. The
+*         tick number is written first into tickEnd and
+*         last into tick, a record with different numbers
+*         was being written during the dump
+********************************************************/
+typedef struct {
+    uint64_t tick;              /* Tick number from 1, 0 if slot is empty */
+    uint64_t timestampNs;       /* Monotonic time of tick (ns) */
+    double remainingRange;      /* Remaining range (km) */
+    int32_t speed;              /* Speed (km/h) */
+    int32_t batteryLevel;       /* Battery level (%) */
+    int32_t acTemp;             /* AC temperature (°C) */
+    int32_t windLevel;          /* Wind level */
+    int32_t cruiseSpeed;        /* Cruise set speed (km/h), 0 if off */
+    uint32_t commandCount;      /* Commands applied, more than kept in events */
+    uint8_t driveMode;          /* DriveMode */
+    uint8_t reserved;
+    uint16_t inputs;            /* FlightInput bits of held controls */
+    FlightEvent events[FLIGHT_EVENTS_PER_TICK];
+    uint64_t tickEnd;           /* Tick number, written before other fields */
+} FlightRecord;
+
+/********************************************************
+* @struct FlightDumpHeader
+* @brief  Start of a dump file, records follow in ring
+*         order
+********************************************************/
+typedef struct {
+    char magic[8];              /* FLIGHT_DUMP_MAGIC */
+    uint32_t version;           /* FLIGHT_DUMP_VERSION */
+    uint32_t recordSize;        /* sizeof(FlightRecord) */
+    uint32_t recordCount;       /* Number of records in file */
+    int32_t signal;             /* Signal that caused the dump */
+    uint64_t ticks;             /* Ticks recorded since start */
+    uint64_t dumpTimeNs;        /* Monotonic time of dump (ns) */
+} FlightDumpHeader;
+
+/********************************************************
+* @class FlightRecorder
+* @brief Class keeps the last FLIGHT_RECORDER_TICKS ticks.
+*        record() is called by the control tick only, dump
+*        may run at any time from a signal handler.
+********************************************************/
+class FlightRecorder {
+private:
+    FlightRecord records[FLIGHT_RECORDER_TICKS];
+    atomic<uint64_t> ticks;             /* Ticks recorded, written by the control tick only */
+    char dumpPath[FLIGHT_PATH_SIZE];    /* File written by the signal handler */
+
+    /* Recorder can not be copied */
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /********************************************************
+    * @brief  Handle SIGSEGV, SIGABRT and SIGUSR2
+    * @param  signal  Received signal
+    * @return None
+    ********************************************************/
+    static void handleSignal(int signal);
+
+public:
+    /********************************************************
+    * @brief Constructor, all slots are empty
+    ********************************************************/
+    FlightRecorder();
+
+    /********************************************************
+    * @brief Destructor, removes signal handlers
+    ********************************************************/
+    ~FlightRecorder();
+
+    /********************************************************
+    * @brief  Store one tick over the oldest record, does
+    *         not lock and does not allocate memory
+    * @param  state           State after the tick
+    * @param  cruiseSpeed     Cruise set speed (km/h), 0 if off
+    * @param  inputs          FlightInput bits of held controls
+    * @param  commands        Commands applied, may be NULL
+    * @param  count           Number of commands
+    * @param  timestampNs     Monotonic time of tick (ns)
+    * @return None
+    ********************************************************/
+    void record(const DashboardState& state, int cruiseSpeed, uint16_t inputs,
+        const VehicleCommand* commands, size_t count, uint64_t timestampNs);
+
+    /********************************************************
+    * @brief  Dump to path on SIGSEGV, SIGABRT and SIGUSR2,
+    *         one recorder is installed at a time
+    * @param  path    Dump file, replaced by each dump
+    * @return bool    Return false if handlers cannot be set
+    ********************************************************/
+    bool install(const string& path);
+
+    /********************************************************
+    * @brief  Remove signal handlers of this recorder
+    * @param  None
+    * @return None
+    ********************************************************/
+    void uninstall();
+
+    /********************************************************
+    * @brief  Write header and all records to an open file,
+    *         async-signal-safe
+    * @param  fd      Open file
+    * @param  signal  Signal written in header
+    * @return bool    Return false if a write failed
+    ********************************************************/
+    bool dump(int fd, int signal) const;
+
+    /********************************************************
+    * @brief  Get number of ticks recorded since start
+    * @param  None
+    * @return uint64_t    Return number
+    ********************************************************/
+    uint64_t getTicks() const;
+
+    /********************************************************
+    * @brief  Read a dump file, records are sorted by tick
+    *         and empty or torn records are left out
+    * @param  path        Dump file
+    * @param  header      Header of dump
+    * @param  records     Complete records, oldest first
+    * @param  torn        Number of torn records
+    * @return bool        Return false if file is not a dump
+    ********************************************************/
+    static bool readDump(const string& path, FlightDumpHeader& header, vector<FlightRecord>& records,
+        size_t& torn);
+};
+
+#endif  /* FLIGHT_RECORDER_HPP */
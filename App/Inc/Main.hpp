@@ -5,7 +5,7 @@
 *           main program, include DashboardController, 
 *           DisplayManager, BatteryManager, DriveModeManager,
 *           SpeedCalculator, SafetyManager and functions that 
-*           create thread for multithreading. 
+*           run as cooperative tasks on one thread. 
 * @version  1.0
 * @date     2024-11-10
 * @author   Tran Quang Khai
@@ -13,6 +13,11 @@
 #ifndef MAIN_HPP
 #define MAIN_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include "DashboardController.hpp"
 #include "DisplayManager.hpp"
@@ -20,48 +25,253 @@
 #include "DriveModeManager.hpp"
 #include "SpeedCalculator.hpp"
 #include "SafetyManager.hpp"
-#include <thread>
-#include <mutex>
-#include <atomic>
-#include <condition_variable>
-#include <future>
-#include <unordered_map>
+#include "CanLogReplayer.hpp"
+#include "TelemetryParser.hpp"
+#include "TripComputer.hpp"
+#include "TaskExecutor.hpp"
+#include "VehicleProfile.hpp"
+#include "RoutePredictor.hpp"
+#include "ChargingStationIndex.hpp"
+#include "PositionSimulator.hpp"
+#include "AllocationTracker.hpp"
+#include "FileBuffer.hpp"
+#include "PersistenceWriter.hpp"
+#include "VehiclePipeline.hpp"
+#include "DashboardServer.hpp"
+#include "RuleEngine.hpp"
+#include "StateEstimator.hpp"
+#include "VehicleCommand.hpp"
+#include "ControlServer.hpp"
+#include "FlightRecorder.hpp"
+#include "TelemetryExporter.hpp"
+
+#ifdef _WIN32
 #include <windows.h>
+#endif
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+/********************************************************
+* @brief Number of charging stations shown with low battery
+*        warning
+********************************************************/
+#define LOW_BATTERY_STATIONS    3
+
+/********************************************************
+* @brief Cruise loop limits
+********************************************************/
+#define CRUISE_MAX_CATCH_UP     10      /* Late steps run at once, older ones are skipped */
+#define CRUISE_IDLE_MS          100     /* Check period while cruise control is off (ms) */
+
+/********************************************************
+* @struct CruiseLoopStats
+* @brief  Timing of the cruise loop
+********************************************************/
+typedef struct {
+    unsigned long steps;        /* Steps run */
+    unsigned long skipped;      /* Steps skipped because loop was too late */
+    uint64_t maxLatenessUs;     /* Latest wake up after a deadline (us) */
+} CruiseLoopStats;
+
+/********************************************************
+* @brief Size of a command script
+********************************************************/
+#define COMMAND_SCRIPT_MAX_SIZE 65536
+
+/********************************************************
+* @brief Command lines of the console (stdin)
+********************************************************/
+#define CONSOLE_LINE_SIZE       128     /* Longest command line (bytes) */
+#define CONSOLE_POLL_MS         100     /* Longest wait, to see the end of run (ms) */
+
+/********************************************************
+* @struct CommandStats
+* @brief  Commands applied by the control tick
+********************************************************/
+typedef struct {
+    unsigned long applied;      /* Commands applied */
+    unsigned long batches;      /* Ticks with at least one command */
+    size_t largestBatch;        /* Most commands of one tick */
+    uint64_t maxLatencyUs;      /* Longest time from submit to apply (us) */
+} CommandStats;
 
 /********************************************************
 * @brief  readCSV
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
 * @param  dashboardController Pointer to DashboardController 
 *                             object that receive updated data
-* @return None 
+* @param  stateEstimator      Pointer to StateEstimator object
+*                             that filters samples, NULL sets
+*                             samples as read
+* @return Task 
 ********************************************************/
-void readCSV(DashboardController* dashboardController);
+Task readCSV(TaskExecutor* executor, DashboardController* dashboardController, StateEstimator* stateEstimator);
+
+/********************************************************
+* @brief  replayCAN
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
+* @param  dashboardController Pointer to DashboardController 
+*                             object that receive replayed data
+* @param  canLogReplayer      Pointer to CanLogReplayer object
+*                             with opened log and signal map
+* @param  mode                Real time or fast replay
+* @param  stateEstimator      Pointer to StateEstimator object
+*                             that filters samples, NULL sets
+*                             samples as decoded
+* @return Task 
+********************************************************/
+Task replayCAN(TaskExecutor* executor, DashboardController* dashboardController,
+    CanLogReplayer* canLogReplayer, ReplayMode mode, StateEstimator* stateEstimator);
 
 /********************************************************
 * @brief  keyboardInputHandler
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
 * @param  dashboardController Pointer to DashboardController object
 * @param  speedCalculator     Pointer to SpeedCalculator object    
 * @param  driveMode           Pointer to DriveModeManager object
 * @param  safetyManager       Pointer to SafetyManager object    
 * @param  batteryManager      Pointer to BatteryManager object
+* @param  tripComputer        Pointer to TripComputer object
+* @param  profileStore        Pointer to VehicleProfileStore object
+*                             that publishes vehicle parameters
+* @param  persistenceWriter   Pointer to PersistenceWriter object
+*                             that saves data to CSV file
+* @param  climateAdvisor      Pointer to ClimateAdvisor object
+*                             run after each tick
+* @param  ruleEngine          Pointer to RuleEngine object
+*                             evaluated each tick
+* @param  commandQueue        Pointer to CommandQueue object
+*                             with commands of all producers
+* @param  commandStats        Pointer to counters of applied
+*                             commands
+* @return Task
+********************************************************/
+Task keyboardInputHandler(TaskExecutor* executor, DashboardController* dashboardController,
+    SpeedCalculator* speedCalculator, DriveModeManager* driveMode, SafetyManager* safetyManager,
+    BatteryManager* batteryManager, TripComputer* tripComputer, const VehicleProfileStore* profileStore,
+    PersistenceWriter* persistenceWriter, ClimateAdvisor* climateAdvisor, RuleEngine* ruleEngine,
+    CommandQueue* commandQueue, CommandStats* commandStats);
+
+/********************************************************
+* @brief  readKeys
+* @return DriverInput
+********************************************************/
+DriverInput readKeys();
+
+/********************************************************
+* @brief  submitKeyCommands
+* @param  commandQueue        Pointer to CommandQueue object
+* @param  keys                Keys held now
+* @param  previousKeys        Keys held at previous poll
 * @return None
 ********************************************************/
-void keyboardInputHandler(DashboardController* dashboardController, SpeedCalculator* speedCalculator,
-    DriveModeManager* driveMode, SafetyManager* safetyManager, BatteryManager* batteryManager);
+void submitKeyCommands(CommandQueue* commandQueue, const DriverInput& keys, const DriverInput& previousKeys);
+
+/********************************************************
+* @brief  runScript
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
+* @param  commandQueue        Pointer to CommandQueue object
+*                             that receives commands
+* @param  path                Path to script of command lines
+* @return Task
+********************************************************/
+Task runScript(TaskExecutor* executor, CommandQueue* commandQueue, const string* path);
+
+#ifdef __linux__
+/********************************************************
+* @brief  readConsole
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
+* @param  commandQueue        Pointer to CommandQueue object
+*                             that receives commands
+* @return Task
+********************************************************/
+Task readConsole(TaskExecutor* executor, CommandQueue* commandQueue);
+#endif
+
+/********************************************************
+* @brief  cruiseControl
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
+* @param  speedCalculator     Pointer to SpeedCalculator object
+*                             with cruise control
+* @param  driveMode           Pointer to DriveModeManager object
+* @param  stats               Pointer to timing of the loop
+* @return Task
+********************************************************/
+Task cruiseControl(TaskExecutor* executor, SpeedCalculator* speedCalculator,
+    const DriveModeManager* driveMode, CruiseLoopStats* stats);
+
+/********************************************************
+* @brief  watchProfile
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
+* @param  profileStore        Pointer to VehicleProfileStore
+*                             object to reload
+* @return Task
+********************************************************/
+Task watchProfile(TaskExecutor* executor, VehicleProfileStore* profileStore);
 
 /********************************************************
 * @brief  display 
+* @param  executor            Pointer to TaskExecutor object
+*                             that runs this task
 * @param  dashboardController Pointer to DashboardController 
 *                             object to display updated data
+* @param  tripComputer        Pointer to TripComputer object
+*                             to display trip values
+* @param  routePredictor      Pointer to RoutePredictor object
+* @param  route               Pointer to route to predict,
+*                             prediction is skipped if empty
+* @param  stationIndex        Pointer to ChargingStationIndex
+*                             object to find charging stations
+* @param  positionSimulator   Pointer to PositionSimulator
+*                             object with vehicle position
+* @param  batteryManager      Pointer to BatteryManager object
+*                             to display cell level pack model
+* @param  speedCalculator     Pointer to SpeedCalculator object
+*                             to display cruise control
+* @param  ruleEngine          Pointer to RuleEngine object with
+*                             derived signals and alarms
+* @param  climateAdvisor      Pointer to ClimateAdvisor object
+*                             with range advice
+* @param  stateEstimator      Pointer to StateEstimator object
+*                             with filtered values, NULL when
+*                             samples are not filtered
+* @return Task
+********************************************************/
+Task display(TaskExecutor* executor, DashboardController* dashboardController, TripComputer* tripComputer,
+    const RoutePredictor* routePredictor, const vector<RouteSegment>* route,
+    const ChargingStationIndex* stationIndex, const PositionSimulator* positionSimulator,
+    const BatteryManager* batteryManager, const SpeedCalculator* speedCalculator, RuleEngine* ruleEngine,
+    const ClimateAdvisor* climateAdvisor, const StateEstimator* stateEstimator);
+
+/********************************************************
+* @brief  startSteadyState
+* @param  isAllocationCheck   Count allocations instead of
+*                             stopping the program
 * @return None
 ********************************************************/
-void display(DashboardController* dashboardController);
+void startSteadyState(bool isAllocationCheck);
 
 /********************************************************
-* @brief  saveToCSV
-* @param  dashboardController Pointer to DashboardController 
-*                             object to read and save data
+* @brief  reportAllocations
+* @param  isAllocationCheck   Allocation check is requested
+* @return bool    Return false if check found allocations
+********************************************************/
+bool reportAllocations(bool isAllocationCheck);
+
+/********************************************************
+* @brief  stopDashboardServer
+* @param  dashboardServer     Pointer to DashboardServer object
 * @return None
 ********************************************************/
-void saveToCSV(DashboardController* dashboardController);
+void stopDashboardServer(DashboardServer* dashboardServer);
 
 #endif  /* MAIN_HPP */
@@ -0,0 +1,85 @@
+/********************************************************
+* @file     MappedFile.hpp
+* @brief    Declare methods and classes related to read-only
+*           memory mapped files
+* @details  This file contains class and methods declaration
+*           related to mapping a whole file into memory, so
+*           large logs can be parsed in place without copying
+*           them into stream buffers.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+/********************************************************
+* @class MappedFile
+* @brief Class maps a file read-only into memory and
+*        unmaps it when destroyed
+********************************************************/
+class MappedFile {
+private:
+    const char* mappedData; /* Start of mapped file content */
+    size_t mappedSize;      /* Size of mapped file (bytes) */
+    void* fileHandle;       /* Native file handle (Windows only) */
+    void* mappingHandle;    /* Native mapping handle (Windows only) */
+
+    /* Mapped file can not be copied */
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    MappedFile();
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~MappedFile();
+
+    /********************************************************
+    * @brief  Map a file into memory
+    * @param  path    Path to file that want to map
+    * @return bool    Return true if file is mapped, else
+    *                 return false
+    ********************************************************/
+    bool open(const string& path);
+
+    /********************************************************
+    * @brief  Unmap current file
+    * @param  None
+    * @return None
+    ********************************************************/
+    void close();
+
+    /********************************************************
+    * @brief  Get start of mapped content
+    * @param  None
+    * @return const char*     Return pointer to first byte
+    ********************************************************/
+    const char* data() const;
+
+    /********************************************************
+    * @brief  Get size of mapped content
+    * @param  None
+    * @return size_t  Return size of file (bytes)
+    ********************************************************/
+    size_t size() const;
+
+    /********************************************************
+    * @brief  Check if a file is mapped
+    * @param  None
+    * @return bool    Return true if a file is mapped
+    ********************************************************/
+    bool isOpen() const;
+};
+
+#endif  /* MAPPED_FILE_HPP */
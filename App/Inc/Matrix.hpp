@@ -0,0 +1,205 @@
+/********************************************************
+* @file     Matrix.hpp
+* @brief    Declare classes related to small matrices
+* @details  This file contains template class of a matrix
+*           whose size is set at compile time. Elements are
+*           part of the object, so matrices never use the
+*           heap. Loops have constant bounds and are fully
+*           unrolled, a product of 3x3 matrices is straight
+*           line code.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef MATRIX_HPP
+#define MATRIX_HPP
+
+#include <cstddef>
+
+using namespace std;
+
+/********************************************************
+* @brief Unroll the next loop, loops of small matrices
+*        are cheaper as straight line code
+********************************************************/
+#if defined(__GNUC__) && !defined(__clang__)
+#define MATRIX_UNROLL   _Pragma("GCC unroll 16")
+#elif defined(__clang__)
+#define MATRIX_UNROLL   _Pragma("unroll")
+#else
+#define MATRIX_UNROLL
+#endif
+
+/********************************************************
+* @class Matrix
+* @brief Class keeps Rows x Cols doubles in row order.
+*        Operators return new matrices by value, the
+*        compiler keeps them in registers.
+********************************************************/
+template <size_t Rows, size_t Cols>
+class Matrix {
+private:
+    double items[Rows][Cols];   /* Elements, row by row */
+
+public:
+    /********************************************************
+    * @brief Constructor, all elements are 0
+    ********************************************************/
+    Matrix() {
+        MATRIX_UNROLL
+        for (size_t r = 0; r < Rows; r++) {
+            MATRIX_UNROLL
+            for (size_t c = 0; c < Cols; c++) {
+                items[r][c] = 0.0;
+            }
+        }
+    }
+
+    /********************************************************
+    * @brief  Create identity matrix, square matrices only
+    * @param  None
+    * @return Matrix  Return identity
+    ********************************************************/
+    static Matrix identity() {
+        static_assert(Rows == Cols, "identity needs a square matrix");
+        Matrix result;
+        MATRIX_UNROLL
+        for (size_t i = 0; i < Rows; i++) {
+            result.items[i][i] = 1.0;
+        }
+        return result;
+    }
+
+    /********************************************************
+    * @brief  Get an element
+    * @param  row     Row index
+    * @param  col     Column index
+    * @return double& Return element
+    ********************************************************/
+    double& operator()(size_t row, size_t col) {
+        return items[row][col];
+    }
+
+    /********************************************************
+    * @brief  Get an element
+    * @param  row     Row index
+    * @param  col     Column index
+    * @return double  Return element
+    ********************************************************/
+    double operator()(size_t row, size_t col) const {
+        return items[row][col];
+    }
+
+    /********************************************************
+    * @brief  Add 2 matrices
+    * @param  other   Matrix to add
+    * @return Matrix  Return sum
+    ********************************************************/
+    Matrix operator+(const Matrix& other) const {
+        Matrix result;
+        MATRIX_UNROLL
+        for (size_t r = 0; r < Rows; r++) {
+            MATRIX_UNROLL
+            for (size_t c = 0; c < Cols; c++) {
+                result.items[r][c] = items[r][c] + other.items[r][c];
+            }
+        }
+        return result;
+    }
+
+    /********************************************************
+    * @brief  Subtract 2 matrices
+    * @param  other   Matrix to subtract
+    * @return Matrix  Return difference
+    ********************************************************/
+    Matrix operator-(const Matrix& other) const {
+        Matrix result;
+        MATRIX_UNROLL
+        for (size_t r = 0; r < Rows; r++) {
+            MATRIX_UNROLL
+            for (size_t c = 0; c < Cols; c++) {
+                result.items[r][c] = items[r][c] - other.items[r][c];
+            }
+        }
+        return result;
+    }
+
+    /********************************************************
+    * @brief  Multiply by a number
+    * @param  factor  Number to multiply by
+    * @return Matrix  Return product
+    ********************************************************/
+    Matrix operator*(double factor) const {
+        Matrix result;
+        MATRIX_UNROLL
+        for (size_t r = 0; r < Rows; r++) {
+            MATRIX_UNROLL
+            for (size_t c = 0; c < Cols; c++) {
+                result.items[r][c] = items[r][c] * factor;
+            }
+        }
+        return result;
+    }
+
+    /********************************************************
+    * @brief  Multiply 2 matrices, sizes are checked when
+    *         compiling
+    * @param  other               Right matrix, Cols x Other
+    * @return Matrix<Rows,Other>  Return product
+    ********************************************************/
+    template <size_t Other>
+    Matrix<Rows, Other> operator*(const Matrix<Cols, Other>& other) const {
+        Matrix<Rows, Other> result;
+        MATRIX_UNROLL
+        for (size_t r = 0; r < Rows; r++) {
+            MATRIX_UNROLL
+            for (size_t c = 0; c < Other; c++) {
+                double sum = 0.0;
+                MATRIX_UNROLL
+                for (size_t k = 0; k < Cols; k++) {
+                    sum += items[r][k] * other(k, c);
+                }
+                result(r, c) = sum;
+            }
+        }
+        return result;
+    }
+
+    /********************************************************
+    * @brief  Swap rows and columns
+    * @param  None
+    * @return Matrix<Cols,Rows>   Return transpose
+    ********************************************************/
+    Matrix<Cols, Rows> transpose() const {
+        Matrix<Cols, Rows> result;
+        MATRIX_UNROLL
+        for (size_t r = 0; r < Rows; r++) {
+            MATRIX_UNROLL
+            for (size_t c = 0; c < Cols; c++) {
+                result(c, r) = items[r][c];
+            }
+        }
+        return result;
+    }
+
+    /********************************************************
+    * @brief  Make a square matrix exactly symmetric, rounding
+    *         errors of covariance updates are removed
+    * @param  None
+    * @return None
+    ********************************************************/
+    void symmetrize() {
+        static_assert(Rows == Cols, "symmetrize needs a square matrix");
+        MATRIX_UNROLL
+        for (size_t r = 0; r < Rows; r++) {
+            MATRIX_UNROLL
+            for (size_t c = r + 1; c < Cols; c++) {
+                double mean = 0.5 * (items[r][c] + items[c][r]);
+                items[r][c] = mean;
+                items[c][r] = mean;
+            }
+        }
+    }
+};
+
+#endif  /* MATRIX_HPP */
@@ -0,0 +1,163 @@
+/********************************************************
+* @file     MpscQueue.hpp
+* @brief    Declare classes related to multi producer queue
+* @details  This file contains template class of a bounded
+*           queue after Dmitry Vyukov. Each slot has a sequence
+*           number that tells producers and the consumer whose
+*           turn it is. Producers claim a slot with one
+*           compare-and-swap and never wait for each other or
+*           for the consumer, the consumer takes items without
+*           any atomic read-modify-write. Push and pop never
+*           allocate memory.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+/********************************************************
+* @brief Size of a cache line, producer and consumer
+*        positions are kept on separate lines
+********************************************************/
+#define QUEUE_CACHE_LINE    64
+
+/********************************************************
+* @class MpscQueue
+* @brief Class keeps up to capacity items of type T in
+*        order of push, the capacity is rounded up to a
+*        power of 2 when the queue is created. Any thread
+*        may push, one thread pops.
+********************************************************/
+template <typename T>
+class MpscQueue {
+private:
+    static_assert(is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    /********************************************************
+    * @struct QueueSlot
+    * @brief  One item and the turn of its slot. Sequence is
+    *         position when slot is free for a producer and
+    *         position + 1 when item is ready to pop
+    ********************************************************/
+    typedef struct {
+        atomic<size_t> sequence;
+        T item;
+    } QueueSlot;
+
+    alignas(QUEUE_CACHE_LINE) atomic<size_t> pushPosition;  /* Next slot to claim by producers */
+    alignas(QUEUE_CACHE_LINE) size_t popPosition;           /* Next slot of the consumer */
+    alignas(QUEUE_CACHE_LINE) vector<QueueSlot> slots;      /* Ring storage */
+    size_t mask;
+
+    /* Queue can not be copied */
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /********************************************************
+    * @brief  Round capacity up to a power of 2
+    * @param  capacity    Wanted capacity
+    * @return size_t      Return capacity, at least 2
+    ********************************************************/
+    static size_t roundCapacity(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+public:
+    /********************************************************
+    * @brief Constructor, queue is empty
+    * @param capacity     Most items kept at the same time
+    ********************************************************/
+    explicit MpscQueue(size_t capacity)
+        : pushPosition(0), popPosition(0), slots(roundCapacity(capacity)), mask(roundCapacity(capacity) - 1) {
+        for (size_t i = 0; i < slots.size(); i++) {
+            slots[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    /********************************************************
+    * @brief  Add an item at the end, called by any thread
+    * @param  item    Item to add
+    * @return bool    Return false if queue is full
+    ********************************************************/
+    bool push(const T& item) {
+        size_t position = pushPosition.load(memory_order_relaxed);
+
+        while (true) {
+            QueueSlot& slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(memory_order_acquire);
+            intptr_t turn = (intptr_t)sequence - (intptr_t)position;
+
+            if (turn == 0) {
+                // Slot is free, claim it before writing
+                if (pushPosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(position + 1, memory_order_release);
+                    return true;
+                }
+            } else if (turn < 0) {
+                // Consumer has not taken the item a lap ago
+                return false;
+            } else {
+                // Another producer claimed the slot first
+                position = pushPosition.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    /********************************************************
+    * @brief  Remove oldest item, called by the consumer only
+    * @param  item    Removed item
+    * @return bool    Return false if queue is empty or the
+    *                 oldest claimed item is still written
+    ********************************************************/
+    bool pop(T& item) {
+        QueueSlot& slot = slots[popPosition & mask];
+        if (slot.sequence.load(memory_order_acquire) != popPosition + 1) {
+            return false;
+        }
+
+        item = slot.item;
+        slot.sequence.store(popPosition + slots.size(), memory_order_release);
+        popPosition++;
+        return true;
+    }
+
+    /********************************************************
+    * @brief  Remove oldest items in order, called by the
+    *         consumer only
+    * @param  items       Array for removed items
+    * @param  maxCount    Size of array
+    * @return size_t      Return number of removed items
+    ********************************************************/
+    size_t popBatch(T* items, size_t maxCount) {
+        size_t count = 0;
+        while (count < maxCount && pop(items[count])) {
+            count++;
+        }
+        return count;
+    }
+
+    /********************************************************
+    * @brief  Get number of slots
+    * @param  None
+    * @return size_t  Return capacity
+    ********************************************************/
+    size_t capacity() const {
+        return slots.size();
+    }
+};
+
+#endif  /* MPSC_QUEUE_HPP */
@@ -0,0 +1,72 @@
+/********************************************************
+* @file     ParallelFor.hpp
+* @brief    Declare functions related to splitting work
+*           across threads
+* @details  This file contains template functions that split
+*           a range of independent items into contiguous
+*           chunks and process each chunk on its own thread.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef PARALLEL_FOR_HPP
+#define PARALLEL_FOR_HPP
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/********************************************************
+* @brief  Get number of worker threads to use by default
+* @param  None
+* @return unsigned int    Return number of hardware threads,
+*                         at least 1
+********************************************************/
+inline unsigned int defaultWorkerCount() {
+    unsigned int count = thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+/********************************************************
+* @brief  Process items [0, count) on several threads, each
+*         worker gets one contiguous chunk, the calling
+*         thread processes the first chunk
+* @param  count       Number of items
+* @param  workers     Number of threads (0 use default)
+* @param  function    Called as function(begin, end, worker)
+* @return None
+********************************************************/
+template <typename Function>
+void parallelFor(size_t count, unsigned int workers, Function function) {
+    if (workers == 0) {
+        workers = defaultWorkerCount();
+    }
+    if (workers > count) {
+        workers = (unsigned int)count;
+    }
+    if (workers <= 1) {
+        if (count > 0) {
+            function((size_t)0, count, 0u);
+        }
+        return;
+    }
+
+    vector<thread> threads;
+    threads.reserve(workers - 1);
+
+    for (unsigned int worker = 1; worker < workers; worker++) {
+        size_t begin = count * worker / workers;
+        size_t end = count * (worker + 1) / workers;
+        threads.push_back(thread(function, begin, end, worker));
+    }
+
+    function((size_t)0, count / workers, 0u);
+
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+#endif  /* PARALLEL_FOR_HPP */
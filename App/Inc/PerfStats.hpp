@@ -0,0 +1,193 @@
+/********************************************************
+* @file     PerfStats.hpp
+* @brief    Declare methods and classes related to timing
+*           of processing stages
+* @details  This file contains class and methods declaration
+*           related to performance statistics. Each stage of
+*           a tick adds its elapsed time, the table of stages
+*           is printed at the end of a run. Memory used by
+*           the process is read from the operating system.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef PERF_STATS_HPP
+#define PERF_STATS_HPP
+
+#include <iostream>
+#include <stdint.h>
+
+using namespace std;
+
+/********************************************************
+* @brief Maximum number of stages in one PerfStats object
+********************************************************/
+#define PERF_MAX_STAGES     12
+
+/********************************************************
+* @enum  PerfCounter
+* @brief Hardware and software counters read around stages
+********************************************************/
+typedef enum {
+    PERF_CYCLES,            /* CPU cycles in user space */
+    PERF_INSTRUCTIONS,      /* Instructions retired in user space */
+    PERF_CACHE_MISSES,      /* Last level cache misses in user space */
+    PERF_BRANCH_MISSES,     /* Mispredicted branches in user space */
+    PERF_CONTEXT_SWITCHES,  /* Context switches of the thread */
+    PERF_COUNTER_COUNT
+} PerfCounter;
+
+/********************************************************
+* @struct PerfStage
+* @brief  Time and counters spent in one stage
+********************************************************/
+typedef struct {
+    const char* name;   /* Name of stage */
+    uint64_t totalNs;   /* Sum of elapsed time (ns) */
+    uint64_t maxNs;     /* Longest elapsed time (ns) */
+    uint64_t calls;     /* Number of recorded runs */
+    uint64_t counts[PERF_COUNTER_COUNT];    /* Sum of counter deltas */
+} PerfStage;
+
+/********************************************************
+* @struct PerfMark
+* @brief  Time and counter values at the start of a stage
+********************************************************/
+typedef struct {
+    uint64_t ns;                            /* Monotonic time (ns) */
+    uint64_t counts[PERF_COUNTER_COUNT];    /* Counter values, 0 if not open */
+} PerfMark;
+
+/********************************************************
+* @class PerfStats
+* @brief Class sums elapsed time of named stages, used by
+*        one thread. Counters are optional, they count the
+*        thread that opened them. Recording does not
+*        allocate memory.
+********************************************************/
+class PerfStats {
+private:
+    PerfStage stages[PERF_MAX_STAGES];  /* Registered stages */
+    int stageCount;                     /* Number of registered stages */
+
+    /* Counter group, read with one system call */
+    int groupFd;                            /* Leader of group, -1 if not open */
+    int counterFds[PERF_COUNTER_COUNT];     /* File of each counter, -1 if not available */
+    int counterSlots[PERF_COUNTER_COUNT];   /* Position of each counter in a group read */
+    int openCount;                          /* Number of counters in group */
+    uint64_t timeEnabledNs;                 /* Group time enabled at last read (ns) */
+    uint64_t timeRunningNs;                 /* Group time on the PMU at last read (ns) */
+
+    /* PerfStats can not be copied, it owns counter files */
+    PerfStats(const PerfStats&) = delete;
+    PerfStats& operator=(const PerfStats&) = delete;
+
+public:
+    /********************************************************
+    * @brief Constructor, no stage is registered and no
+    *        counter is open
+    ********************************************************/
+    PerfStats();
+
+    /********************************************************
+    * @brief Destructor, closes counters
+    ********************************************************/
+    ~PerfStats();
+
+    /********************************************************
+    * @brief  Open counter group for the calling thread,
+    *         counters the CPU or kernel does not offer are
+    *         left out
+    * @param  None
+    * @return bool    Return false if no counter could be opened
+    ********************************************************/
+    bool openCounters();
+
+    /********************************************************
+    * @brief  Check a counter is open
+    * @param  counter     Counter to check
+    * @return bool        Return true if counter is counted
+    ********************************************************/
+    bool hasCounter(PerfCounter counter) const;
+
+    /********************************************************
+    * @brief  Read time and counters at start of a stage
+    * @param  mark    Mark to fill
+    * @return None
+    ********************************************************/
+    void mark(PerfMark& mark);
+
+    /********************************************************
+    * @brief  Add time and counters since mark as one run of
+    *         a stage, then move mark to now
+    * @param  stage   Index returned by addStage
+    * @param  mark    Mark of stage start, set to now
+    * @return None
+    ********************************************************/
+    void record(int stage, PerfMark& mark);
+
+    /********************************************************
+    * @brief  Register a stage
+    * @param  name    Name of stage, must outlive this object
+    * @return int     Return index of stage, -1 if table is full
+    ********************************************************/
+    int addStage(const char* name);
+
+    /********************************************************
+    * @brief  Add elapsed time of one run of a stage
+    * @param  stage   Index returned by addStage
+    * @param  ns      Elapsed time (ns)
+    * @return None
+    ********************************************************/
+    void record(int stage, uint64_t ns);
+
+    /********************************************************
+    * @brief  Clear recorded time of all stages, stages stay
+    *         registered
+    * @param  None
+    * @return None
+    ********************************************************/
+    void reset();
+
+    /********************************************************
+    * @brief  Get number of registered stages
+    * @param  None
+    * @return int     Return number of stages
+    ********************************************************/
+    int getStageCount() const;
+
+    /********************************************************
+    * @brief  Get recorded time of a stage
+    * @param  stage           Index of stage
+    * @return const PerfStage&    Return stage
+    ********************************************************/
+    const PerfStage& getStage(int stage) const;
+
+    /********************************************************
+    * @brief  Print table of stages with time per tick and
+    *         share of total time, and table of counters per
+    *         tick with instructions per cycle if counters
+    *         are open
+    * @param  output  Stream to print on
+    * @param  ticks   Number of ticks the time is spread over
+    * @return None
+    ********************************************************/
+    void dump(ostream& output, uint64_t ticks) const;
+
+    /********************************************************
+    * @brief  Get monotonic time to measure a stage
+    * @param  None
+    * @return uint64_t    Return time (ns)
+    ********************************************************/
+    static uint64_t nowNs();
+
+    /********************************************************
+    * @brief  Get resident memory of this process
+    * @param  None
+    * @return long    Return resident set size (KB), -1 if
+    *                 not available
+    ********************************************************/
+    static long getResidentKb();
+};
+
+#endif  /* PERF_STATS_HPP */
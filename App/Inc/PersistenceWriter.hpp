@@ -0,0 +1,205 @@
+/********************************************************
+* @file     PersistenceWriter.hpp
+* @brief    Declare methods and classes related to write
+*           behind persistence of system parameters
+* @details  This file contains classes and methods declaration
+*           related to saving system parameters on a separate
+*           thread. The control loop only pushes a snapshot to
+*           a lock-free queue, the writer thread keeps the
+*           latest snapshot and writes it through io_uring, or
+*           pwrite if io_uring is not available, so a slow disk
+*           never delays the control loop.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef PERSISTENCE_WRITER_HPP
+#define PERSISTENCE_WRITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include "DashboardController.hpp"
+#include "SpscQueue.hpp"
+#include "UringFile.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Number of snapshots the control loop can queue
+*        before the writer thread takes them
+********************************************************/
+#define PERSIST_QUEUE_CAPACITY      16
+
+/********************************************************
+* @brief Size of io_uring submission ring, a write and its
+*        data sync use 2 entries
+********************************************************/
+#define PERSIST_URING_ENTRIES       4
+
+/********************************************************
+* @brief Durability used without --durability option
+********************************************************/
+#define PERSIST_DEFAULT_DURABILITY  "none"
+
+/********************************************************
+* @enum  DurabilityMode
+* @brief When written data is synced to disk
+********************************************************/
+typedef enum {
+    DURABILITY_NONE,        /* Never sync, operating system flushes */
+    DURABILITY_WRITES,      /* Sync after every N writes */
+    DURABILITY_INTERVAL     /* Sync written data every interval */
+} DurabilityMode;
+
+/********************************************************
+* @struct DurabilityPolicy
+* @brief  Durability mode and its parameter
+********************************************************/
+typedef struct {
+    DurabilityMode mode;        /* When to sync */
+    unsigned int writesPerSync; /* Writes between syncs (DURABILITY_WRITES) */
+    unsigned int intervalMs;    /* Time between syncs (DURABILITY_INTERVAL) */
+} DurabilityPolicy;
+
+/********************************************************
+* @struct PersistenceStats
+* @brief  Counters of the writer
+********************************************************/
+typedef struct {
+    unsigned long submitted;    /* Snapshots queued by control loop */
+    unsigned long dropped;      /* Snapshots dropped, queue was full */
+    unsigned long coalesced;    /* Snapshots replaced by a newer one */
+    unsigned long writes;       /* Records written to file */
+    unsigned long syncs;        /* Data syncs */
+    unsigned long errors;       /* Failed writes or syncs */
+} PersistenceStats;
+
+/********************************************************
+* @class PersistenceWriter
+* @brief Class saves snapshots of system parameters to a
+*        file on its own thread. submit() is called by one
+*        producer thread only and never blocks.
+********************************************************/
+class PersistenceWriter {
+private:
+    string path;                /* File to write */
+    DurabilityPolicy policy;    /* When to sync */
+    SpscQueue<DashboardState, PERSIST_QUEUE_CAPACITY> queue;
+    counting_semaphore<> wakeup;    /* Released once per queued snapshot */
+    atomic<bool> isStopRequested;
+    thread worker;
+
+    /* Counters, written by one thread, read at any time */
+    atomic<unsigned long> submitted;
+    atomic<unsigned long> dropped;
+    atomic<unsigned long> coalesced;
+    atomic<unsigned long> writes;
+    atomic<unsigned long> syncs;
+    atomic<unsigned long> errors;
+
+    /* Used by producer thread only */
+    DashboardState latestDropped;   /* Last snapshot dropped by submit() */
+    bool isLatestDropped;           /* Latest snapshot was dropped */
+
+    /* Used by writer thread only */
+    UringFile uring;
+    bool isUringUsed;
+    size_t fileLength;          /* Length of content in file */
+    char buffer[DATABASE_MAX_SIZE];
+#ifdef _WIN32
+    void* fileHandle;
+#else
+    int fileFd;
+#endif
+
+    /* Writer can not be copied */
+    PersistenceWriter(const PersistenceWriter&) = delete;
+    PersistenceWriter& operator=(const PersistenceWriter&) = delete;
+
+    /********************************************************
+    * @brief  Body of writer thread
+    * @param  None
+    * @return None
+    ********************************************************/
+    void run();
+
+    /********************************************************
+    * @brief  Replace file content with a snapshot
+    * @param  state       Snapshot to write
+    * @param  isSync      Sync data after the write
+    * @return bool        Return true if written and synced
+    ********************************************************/
+    bool writeState(const DashboardState& state, bool isSync);
+
+    /********************************************************
+    * @brief  Sync data of file
+    * @param  None
+    * @return bool        Return true if synced
+    ********************************************************/
+    bool syncFile();
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param path     File to write
+    * @param policy   When written data is synced
+    ********************************************************/
+    PersistenceWriter(const string& path, const DurabilityPolicy& policy);
+
+    /********************************************************
+    * @brief Destructor, stops the writer thread
+    ********************************************************/
+    ~PersistenceWriter();
+
+    /********************************************************
+    * @brief  Parse durability option
+    * @param  text        "none", "writes:<N>" or
+    *                     "interval:<milliseconds>"
+    * @param  policy      Parsed policy
+    * @return bool        Return false if text is invalid
+    ********************************************************/
+    static bool parseDurability(const string& text, DurabilityPolicy& policy);
+
+    /********************************************************
+    * @brief  Open file and start writer thread
+    * @param  None
+    * @return bool        Return false if file cannot be opened
+    ********************************************************/
+    bool start();
+
+    /********************************************************
+    * @brief  Queue a snapshot to write, does not block and
+    *         does not allocate memory
+    * @param  state       Snapshot of system parameters
+    * @return bool        Return false if snapshot is dropped
+    ********************************************************/
+    bool submit(const DashboardState& state);
+
+    /********************************************************
+    * @brief  Write queued snapshot, sync if policy needs it
+    *         and stop writer thread
+    * @param  None
+    * @return None
+    ********************************************************/
+    void stop();
+
+    /********************************************************
+    * @brief  Get counters of the writer
+    * @param  None
+    * @return PersistenceStats    Return counters
+    ********************************************************/
+    PersistenceStats getStats() const;
+
+    /********************************************************
+    * @brief  Get name of write backend, call after stop()
+    * @param  None
+    * @return const char*     Return "io_uring", "pwrite" or
+    *                         "WriteFile"
+    ********************************************************/
+    const char* getBackendName() const;
+};
+
+#endif  /* PERSISTENCE_WRITER_HPP */
@@ -0,0 +1,86 @@
+/********************************************************
+* @file     PositionSimulator.hpp
+* @brief    Declare methods and classes related to simulated
+*           vehicle position
+* @details  This file contains class and methods declaration
+*           related to simulated vehicle position, the vehicle
+*           moves from a start point on a constant heading
+*           with the speed published by DashboardController.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef POSITION_SIMULATOR_HPP
+#define POSITION_SIMULATOR_HPP
+
+#include <stdint.h>
+#include "DashboardController.hpp"
+
+using namespace std;
+
+/********************************************************
+* Start point and heading of simulated vehicle (degree)
+********************************************************/
+#define SIMULATED_START_LATITUDE    21.0285
+#define SIMULATED_START_LONGITUDE   105.8542
+#define SIMULATED_HEADING           180.0
+
+/********************************************************
+* @class PositionSimulator
+* @brief Class keeps simulated vehicle position, its object
+*        must subscribe to state changes of DashboardController
+********************************************************/
+class PositionSimulator {
+private:
+    double latitude;        /* Current latitude (degree) */
+    double longitude;       /* Current longitude (degree) */
+    double heading;         /* Heading, 0 is north, 90 is east (degree) */
+
+    bool hasPreviousUpdate;         /* previousTickTimeUs is valid */
+    uint64_t previousTickTimeUs;    /* Time of previous update (us) */
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param latitude     Start latitude (degree)
+    * @param longitude    Start longitude (degree)
+    * @param heading      Heading (degree)
+    ********************************************************/
+    PositionSimulator(double latitude = SIMULATED_START_LATITUDE,
+        double longitude = SIMULATED_START_LONGITUDE, double heading = SIMULATED_HEADING);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~PositionSimulator();
+
+    /********************************************************
+    * @brief  Move vehicle on its heading
+    * @param  distanceKm  Driven distance (km)
+    * @return None
+    ********************************************************/
+    void advance(double distanceKm);
+
+    /********************************************************
+    * @brief  Get current latitude
+    * @param  None
+    * @return double  Return latitude (degree)
+    ********************************************************/
+    double getLatitude() const;
+
+    /********************************************************
+    * @brief  Get current longitude
+    * @param  None
+    * @return double  Return longitude (degree)
+    ********************************************************/
+    double getLongitude() const;
+
+    /********************************************************
+    * @brief  Update data
+    * @param  snapshot    State published by DashboardController
+    * @return None
+    ********************************************************/
+    void update(const StateSnapshot& snapshot);
+};
+
+#endif  /* POSITION_SIMULATOR_HPP */
@@ -0,0 +1,205 @@
+/********************************************************
+* @file     RcuPointer.hpp
+* @brief    Declare classes related to read-copy-update
+*           publication of shared data
+* @details  This file contains template class that publishes
+*           an immutable object through an atomic pointer.
+*           Readers never lock or wait, writers build a new
+*           object and swap it in, old objects are deleted
+*           once all readers that could see them are done.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef RCU_POINTER_HPP
+#define RCU_POINTER_HPP
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/********************************************************
+* @class RcuPointer
+* @brief Class publishes immutable objects of type T.
+*        Readers are counted in one of 2 counters selected
+*        by current epoch. Retired objects wait for the
+*        counter of the previous epoch to drop to zero, so
+*        reclamation always makes progress under load.
+********************************************************/
+template <typename T>
+class RcuPointer {
+private:
+    atomic<const T*> current;                   /* Published object */
+    mutable atomic<unsigned int> epoch;         /* Selects counter of new readers (0 or 1) */
+    mutable atomic<unsigned int> readers[2];    /* Active readers of each epoch */
+
+    mutex writerMutex;          /* Serialize writers */
+    vector<const T*> fresh;     /* Retired in current epoch */
+    vector<const T*> waiting;   /* Retired before last epoch change */
+
+    /* Published object can not be copied */
+    RcuPointer(const RcuPointer&) = delete;
+    RcuPointer& operator=(const RcuPointer&) = delete;
+
+    /********************************************************
+    * @brief  Delete all objects in a list
+    * @param  objects     List of retired objects
+    * @return None
+    ********************************************************/
+    static void deleteAll(vector<const T*>& objects) {
+        for (size_t i = 0; i < objects.size(); i++) {
+            delete objects[i];
+        }
+        objects.clear();
+    }
+
+    /********************************************************
+    * @brief  Delete retired objects no reader can still see,
+    *         writerMutex must be locked
+    * @param  None
+    * @return None
+    ********************************************************/
+    void reclaim() {
+        for (int pass = 0; pass < 2; pass++) {
+            unsigned int previous = epoch.load() ^ 1;
+
+            // Readers of previous epoch are still running
+            if (readers[previous].load() != 0) {
+                return;
+            }
+            deleteAll(waiting);
+
+            if (fresh.empty()) {
+                return;
+            }
+
+            // New readers go to the other counter, objects retired
+            // so far wait for the readers counted until now
+            waiting.swap(fresh);
+            epoch.store(previous);
+        }
+    }
+
+public:
+    /********************************************************
+    * @class ReadGuard
+    * @brief Class keeps the published object alive while
+    *        it is in scope, lock-free and wait-free
+    ********************************************************/
+    class ReadGuard {
+    private:
+        const RcuPointer& owner;    /* Publisher of the object */
+        unsigned int readerEpoch;   /* Counter that counts this reader */
+        const T* object;            /* Object seen by this reader */
+
+        /* Guard can not be copied */
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    public:
+        /********************************************************
+        * @brief Constructor, start reading
+        ********************************************************/
+        explicit ReadGuard(const RcuPointer& owner) : owner(owner) {
+            readerEpoch = owner.epoch.load();
+            owner.readers[readerEpoch].fetch_add(1);
+            object = owner.current.load();
+        }
+
+        /********************************************************
+        * @brief Destructor, end reading
+        ********************************************************/
+        ~ReadGuard() {
+            owner.readers[readerEpoch].fetch_sub(1, memory_order_release);
+        }
+
+        /********************************************************
+        * @brief  Get object seen by this reader
+        * @param  None
+        * @return const T*    Return published object
+        ********************************************************/
+        const T* get() const {
+            return object;
+        }
+
+        const T& operator*() const {
+            return *object;
+        }
+
+        const T* operator->() const {
+            return object;
+        }
+    };
+
+    /********************************************************
+    * @brief Constructor
+    * @param initial  First published object, owned by this
+    ********************************************************/
+    explicit RcuPointer(const T* initial) : current(initial), epoch(0) {
+        readers[0] = 0;
+        readers[1] = 0;
+    }
+
+    /********************************************************
+    * @brief Destructor, there must be no reader left
+    ********************************************************/
+    ~RcuPointer() {
+        delete current.load();
+        deleteAll(fresh);
+        deleteAll(waiting);
+    }
+
+    /********************************************************
+    * @brief  Publish a new object, the old one is deleted
+    *         when no reader can see it anymore
+    * @param  next    New object, owned by this
+    * @return None
+    ********************************************************/
+    void publish(const T* next) {
+        lock_guard<mutex> lock(writerMutex);
+        fresh.push_back(current.exchange(next));
+        reclaim();
+    }
+
+    /********************************************************
+    * @brief  Copy current object, modify the copy and
+    *         publish it, writers are serialized so no
+    *         modification is lost
+    * @param  modify  Called as modify(T& copy)
+    * @return None
+    ********************************************************/
+    template <typename Modify>
+    void update(Modify modify) {
+        lock_guard<mutex> lock(writerMutex);
+        T* next = new T(*current.load());
+        modify(*next);
+        fresh.push_back(current.exchange(next));
+        reclaim();
+    }
+
+    /********************************************************
+    * @brief  Wait until all readers that started before this
+    *         call are done, must not be called by a reader
+    * @param  None
+    * @return None
+    ********************************************************/
+    void synchronize() {
+        lock_guard<mutex> lock(writerMutex);
+
+        // Readers of both counters are drained one after the other
+        for (int pass = 0; pass < 2; pass++) {
+            unsigned int previous = epoch.load() ^ 1;
+            while (readers[previous].load() != 0) {
+                this_thread::yield();
+            }
+            deleteAll(waiting);
+            waiting.swap(fresh);
+            epoch.store(previous);
+        }
+    }
+};
+
+#endif  /* RCU_POINTER_HPP */
@@ -0,0 +1,153 @@
+/********************************************************
+* @file     RoutePredictor.hpp
+* @brief    Declare methods and classes related to route
+*           based battery prediction
+* @details  This file contains class and methods declaration
+*           related to predicting state of charge along a
+*           route, a route is a sequence of segments with
+*           length, speed limit and grade. Battery drain is
+*           integrated segment by segment, many routes or
+*           climate settings are evaluated on several threads.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef ROUTE_PREDICTOR_HPP
+#define ROUTE_PREDICTOR_HPP
+
+#include <string>
+#include <vector>
+#include "BatteryManager.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Path of default route file
+********************************************************/
+#define ROUTE_PATH              "./Data/Route.csv"
+
+/********************************************************
+* Grade model: each percent of grade changes drain by
+* ROUTE_GRADE_FACTOR, downhill drain does not go below
+* ROUTE_MIN_GRADE_FACTOR times the flat road drain
+********************************************************/
+#define ROUTE_GRADE_FACTOR      0.1
+#define ROUTE_MIN_GRADE_FACTOR  0.0
+
+/********************************************************
+* @struct RouteSegment
+* @brief  One segment of a route, between 2 waypoints
+********************************************************/
+typedef struct {
+    double lengthKm;        /* Length of segment (km) */
+    int speedLimit;         /* Speed limit (km/h) */
+    double gradePercent;    /* Grade, positive is uphill (%) */
+} RouteSegment;
+
+/********************************************************
+* @struct RouteScenario
+* @brief  Driving conditions used for the whole route
+********************************************************/
+typedef struct {
+    int acTemp;     /* AC temperature (°C) */
+    int windLevel;  /* Wind level */
+    int speedCap;   /* Maximum speed, 0 drives at speed limits (km/h) */
+} RouteScenario;
+
+/********************************************************
+* @struct RouteQuery
+* @brief  One prediction request of a batch
+********************************************************/
+typedef struct {
+    const RouteSegment* segments;   /* Segments of the route */
+    size_t segmentCount;            /* Number of segments */
+    double startSoc;                /* State of charge at start (%) */
+    RouteScenario scenario;         /* Driving conditions */
+} RouteQuery;
+
+/********************************************************
+* @struct RoutePrediction
+* @brief  Result of one prediction
+********************************************************/
+typedef struct {
+    double finalSoc;        /* State of charge at destination, can be negative (%) */
+    double minSoc;          /* Lowest state of charge on the route (%) */
+    double energyKwh;       /* Energy used (kWh) */
+    double distanceKm;      /* Route length (km) */
+    double durationHours;   /* Driving time (h) */
+    long emptySegment;      /* First segment where battery is empty, -1 if none */
+    bool isReachable;       /* Destination is reached before battery is empty */
+} RoutePrediction;
+
+/********************************************************
+* @brief  Load route from CSV file, each line is
+*         "LENGTH KM, SPEED LIMIT, GRADE", lines start with
+*         '#' are comments
+* @param  path    Path to route file
+* @param  route   Loaded segments
+* @return bool    Return true if at least 1 segment is loaded
+********************************************************/
+bool loadRoute(const string& path, vector<RouteSegment>& route);
+
+/********************************************************
+* @class RoutePredictor
+* @brief Class predicts state of charge along routes with
+*        the drain model of BatteryManager. Predictions do
+*        not allocate memory and do not modify the predictor,
+*        so batches run on several threads.
+********************************************************/
+class RoutePredictor {
+private:
+    const BatteryManager* batteryManager;   /* Drain model */
+
+    /********************************************************
+    * @brief  Predict state of charge along a route
+    * @param  query           Route, start and conditions
+    * @param  socAtWaypoint   Filled with segmentCount + 1
+    *                         values, can be NULL
+    * @return RoutePrediction Return prediction
+    ********************************************************/
+    RoutePrediction integrate(const RouteQuery& query, double* socAtWaypoint) const;
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param batteryManager   Pointer to battery manager with
+    *                         the drain model and capacity
+    ********************************************************/
+    explicit RoutePredictor(const BatteryManager* batteryManager);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~RoutePredictor();
+
+    /********************************************************
+    * @brief  Predict result of a route
+    * @param  query           Route, start and conditions
+    * @return RoutePrediction Return prediction
+    ********************************************************/
+    RoutePrediction predict(const RouteQuery& query) const;
+
+    /********************************************************
+    * @brief  Predict state of charge at every waypoint
+    * @param  query           Route, start and conditions
+    * @param  socAtWaypoint   Filled with segmentCount + 1
+    *                         values, first is start (%)
+    * @return RoutePrediction Return prediction
+    ********************************************************/
+    RoutePrediction predictWaypoints(const RouteQuery& query, double* socAtWaypoint) const;
+
+    /********************************************************
+    * @brief  Predict many queries on several threads
+    * @param  queries     Queries to predict
+    * @param  count       Number of queries
+    * @param  results     Filled with count predictions
+    * @param  workers     Number of threads (0 use hardware threads)
+    * @return None
+    ********************************************************/
+    void predictBatch(const RouteQuery* queries, size_t count, RoutePrediction* results,
+        unsigned int workers) const;
+};
+
+#endif  /* ROUTE_PREDICTOR_HPP */
@@ -0,0 +1,367 @@
+/********************************************************
+* @file     RuleEngine.hpp
+* @brief    Declare methods and classes related to derived
+*           signals and alarms
+* @details  This file contains class and methods declaration
+*           related to rules written as expressions over the
+*           dashboard fields. Rules are compiled once into a
+*           register based bytecode, one flat program for all
+*           rules, then a small interpreter runs it each
+*           control tick. Alarms have a debounce time,
+*           a separate clear condition for hysteresis and
+*           raise/clear events.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef RULE_ENGINE_HPP
+#define RULE_ENGINE_HPP
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "DashboardController.hpp"
+
+using namespace std;
+
+/********************************************************
+* The default path to rule file
+********************************************************/
+#define RULES_PATH              "./Data/Rules.txt"
+
+/********************************************************
+* @brief Rule used when rule file cannot be loaded, same
+*        as the fixed warning before rules
+********************************************************/
+#define RULE_DEFAULT_LOW_BATTERY    "alarm LOW_BATTERY = battery <= 20 : Low Battery. Find a Charging Station!"
+
+/********************************************************
+* @brief Alarm that also shows nearest charging stations
+********************************************************/
+#define RULE_LOW_BATTERY_ALARM  "LOW_BATTERY"
+
+/********************************************************
+* Limits of the engine
+********************************************************/
+#define RULE_MAX_TEMPS          32      /* Registers of one expression */
+#define RULE_MAX_VALUES         65535   /* Fields, registers, signals and constants */
+#define RULE_MAX_EVENTS         64      /* Events kept until taken */
+
+/********************************************************
+* @enum  RuleOpcode
+* @brief Operation of one instruction, dst = a op b
+********************************************************/
+typedef enum {
+    RULE_OP_MOV,    /* dst = a */
+    RULE_OP_ADD,
+    RULE_OP_SUB,
+    RULE_OP_MUL,
+    RULE_OP_DIV,    /* Division by 0 gives 0 */
+    RULE_OP_MIN,
+    RULE_OP_MAX,
+    RULE_OP_LT,
+    RULE_OP_LE,
+    RULE_OP_GT,
+    RULE_OP_GE,
+    RULE_OP_EQ,
+    RULE_OP_NE,
+    RULE_OP_AND,
+    RULE_OP_OR,
+    RULE_OP_NOT,    /* dst = !a */
+    RULE_OP_NEG,    /* dst = -a */
+    RULE_OP_ABS     /* dst = |a| */
+} RuleOpcode;
+
+/********************************************************
+* @struct RuleInstruction
+* @brief  One instruction, operands are indexes of values
+*         (fields, registers, signals or constants)
+********************************************************/
+typedef struct {
+    uint16_t op;        /* RuleOpcode */
+    uint16_t dst;       /* Index of result */
+    uint16_t a;         /* Index of first operand */
+    uint16_t b;         /* Index of second operand */
+} RuleInstruction;
+
+/********************************************************
+* @enum  RuleNotify
+* @brief Edges of an alarm that produce events
+********************************************************/
+typedef enum {
+    RULE_NOTIFY_NONE = 0,
+    RULE_NOTIFY_RISE = 1,   /* Alarm is raised */
+    RULE_NOTIFY_FALL = 2,   /* Alarm is cleared */
+    RULE_NOTIFY_BOTH = 3
+} RuleNotify;
+
+/********************************************************
+* @struct RuleSignal
+* @brief  Derived signal, value is kept in values
+********************************************************/
+typedef struct {
+    string name;        /* Name used by other rules */
+    uint16_t slot;      /* Index of value */
+} RuleSignal;
+
+/********************************************************
+* @struct RuleAlarm
+* @brief  Alarm and its state
+********************************************************/
+typedef struct {
+    string name;            /* Name of alarm */
+    string message;         /* Text shown while active */
+    uint16_t conditionSlot; /* Index of raise condition */
+    int clearSlot;          /* Index of clear condition, -1 clears when condition is false */
+    double delaySeconds;    /* Time condition must hold before raise (s) */
+    int notify;             /* RuleNotify edges that produce events */
+    bool isActive;          /* Alarm is raised */
+    double heldSeconds;     /* Time condition has held (s) */
+} RuleAlarm;
+
+/********************************************************
+* @enum  RuleEventType
+* @brief Edge of an alarm
+********************************************************/
+typedef enum {
+    RULE_EVENT_RAISED,
+    RULE_EVENT_CLEARED
+} RuleEventType;
+
+/********************************************************
+* @struct RuleEvent
+* @brief  Alarm raised or cleared
+********************************************************/
+typedef struct {
+    RuleEventType type;     /* Edge */
+    size_t alarm;           /* Index of alarm */
+    uint64_t tickTimeUs;    /* Time of publish (us, monotonic) */
+} RuleEvent;
+
+/********************************************************
+* @class RuleEngine
+* @brief Class compiles rules and evaluates them each
+*        control tick, or on each published state when CAN
+*        frames are replayed. Rules are added at startup,
+*        the evaluation does not allocate memory.
+********************************************************/
+class RuleEngine {
+private:
+    vector<RuleInstruction> program;    /* Instructions of all rules in order */
+    vector<double> values;              /* Fields, registers, signals, constants */
+    vector<char> isConstantSlot;        /* Value never changes */
+    vector<RuleSignal> signals;
+    vector<RuleAlarm> alarms;
+    vector<uint16_t> previousSlots;     /* prev() values, updated after each run */
+    vector<uint16_t> previousSources;   /* Value copied into previousSlots */
+    vector<uint64_t> sharedKeys;        /* Operation and operands of shared results */
+    vector<uint16_t> sharedSlots;       /* Results computed once for all rules */
+    RuleEvent events[RULE_MAX_EVENTS];  /* Events not taken yet */
+    size_t eventCount;
+    unsigned long droppedEvents;        /* Events lost because list was full */
+    uint64_t lastTickTimeUs;            /* Time of last published state */
+    bool hasLastTick;
+    bool hasEvaluated;                  /* prev() values are set */
+
+    /* Compiler state of the current rule */
+    const char* cursor;
+    int tempTop;                        /* Next free register */
+    string compileError;
+
+    /********************************************************
+    * @brief  Skip spaces and check next character
+    * @param  ch      Character to match
+    * @return bool    Return true and skip it if it matches
+    ********************************************************/
+    bool accept(char ch);
+
+    /********************************************************
+    * @brief  Skip spaces and check next 2 characters
+    * @param  text    2 characters to match
+    * @return bool    Return true and skip them if they match
+    ********************************************************/
+    bool acceptPair(const char* text);
+
+    /********************************************************
+    * @brief  Read a name
+    * @param  name    Read name, empty if none
+    * @return bool    Return false if there is no name
+    ********************************************************/
+    bool readName(string& name);
+
+    /********************************************************
+    * @brief  Check next word without moving the cursor
+    * @param  word    Word to match
+    * @return bool    Return true and skip it if it matches
+    ********************************************************/
+    bool acceptWord(const char* word);
+
+    /* Recursive descent, each returns index of result or -1 */
+    int parseOr();
+    int parseAnd();
+    int parseEquality();
+    int parseRelational();
+    int parseAdditive();
+    int parseMultiplicative();
+    int parseUnary();
+    int parsePrimary();
+
+    /********************************************************
+    * @brief  Emit one instruction, operations on constants
+    *         are done at compile time, operations on fields,
+    *         signals and constants are computed once for all
+    *         rules
+    * @param  op      Operation
+    * @param  base    First register free before operands
+    * @param  a       Index of first operand
+    * @param  b       Index of second operand
+    * @return int     Return index of result
+    ********************************************************/
+    int emit(RuleOpcode op, int base, int a, int b);
+
+    /********************************************************
+    * @brief  Compile an expression, result is kept in a slot
+    *         not reused by other rules
+    * @param  None
+    * @return int     Return index of result, -1 on error
+    ********************************************************/
+    int compileExpression();
+
+    /********************************************************
+    * @brief  Get index of a constant, adds it if needed
+    * @param  value   Constant
+    * @return int     Return index of value
+    ********************************************************/
+    int addConstant(double value);
+
+    /********************************************************
+    * @brief  Add a value
+    * @param  value   Initial value
+    * @return int     Return index of value, -1 if full
+    ********************************************************/
+    int addValue(double value);
+
+    /********************************************************
+    * @brief  Find a field or signal by name
+    * @param  name    Name of field or signal
+    * @return int     Return index of value, -1 if not found
+    ********************************************************/
+    int findVariable(const string& name) const;
+
+    /********************************************************
+    * @brief  Store an alarm edge if it is notified
+    * @param  alarm       Index of alarm
+    * @param  type        Edge
+    * @param  tickTimeUs  Time of publish
+    * @return None
+    ********************************************************/
+    void pushEvent(size_t alarm, RuleEventType type, uint64_t tickTimeUs);
+
+public:
+    /********************************************************
+    * @brief Constructor, engine has no rule
+    ********************************************************/
+    RuleEngine();
+
+    /********************************************************
+    * @brief  Load rules from file
+    * @param  path    Path to rule file
+    * @return bool    Return true if at least 1 rule is loaded
+    ********************************************************/
+    bool load(const string& path);
+
+    /********************************************************
+    * @brief  Compile one rule and add it after other rules
+    * @param  text    "signal <name> = <expression>" or
+    *                 "alarm <name> = <condition> [for <N>s]
+    *                 [clear <condition>] [notify rise|fall|
+    *                 both|none] : <message>"
+    * @return bool    Return false if rule is invalid
+    ********************************************************/
+    bool addRule(const string& text);
+
+    /********************************************************
+    * @brief  Run all rules on a state
+    * @param  state       State to evaluate
+    * @param  dtSeconds   Time since last evaluation (s)
+    * @param  tickTimeUs  Time of state, kept in events
+    * @return None
+    ********************************************************/
+    void evaluate(const DashboardState& state, double dtSeconds, uint64_t tickTimeUs);
+
+    /********************************************************
+    * @brief  Handle published state and run all rules. This
+    *         method will be called when DashboardController
+    *         publishes new state, used only when there is no
+    *         control tick
+    * @param  snapshot    State published by DashboardController
+    * @return None
+    ********************************************************/
+    void update(const StateSnapshot& snapshot);
+
+    /********************************************************
+    * @brief  Move events out of the engine
+    * @param  out         Array to copy events into
+    * @param  maxEvents   Size of out
+    * @return size_t      Return number of events copied
+    ********************************************************/
+    size_t takeEvents(RuleEvent* out, size_t maxEvents);
+
+    /********************************************************
+    * @brief  Find an alarm by name
+    * @param  name    Name of alarm
+    * @return int     Return index of alarm, -1 if not found
+    ********************************************************/
+    int findAlarm(const string& name) const;
+
+    /********************************************************
+    * @brief  Get number of alarms
+    * @param  None
+    * @return size_t  Return number of alarms
+    ********************************************************/
+    size_t getAlarmCount() const;
+
+    /********************************************************
+    * @brief  Get one alarm
+    * @param  index   Index of alarm
+    * @return const RuleAlarm&    Return alarm
+    ********************************************************/
+    const RuleAlarm& getAlarm(size_t index) const;
+
+    /********************************************************
+    * @brief  Get number of derived signals
+    * @param  None
+    * @return size_t  Return number of signals
+    ********************************************************/
+    size_t getSignalCount() const;
+
+    /********************************************************
+    * @brief  Get name of a derived signal
+    * @param  index   Index of signal
+    * @return const string&   Return name
+    ********************************************************/
+    const string& getSignalName(size_t index) const;
+
+    /********************************************************
+    * @brief  Get value of a derived signal at last evaluation
+    * @param  index   Index of signal
+    * @return double  Return value
+    ********************************************************/
+    double getSignalValue(size_t index) const;
+
+    /********************************************************
+    * @brief  Get number of instructions of all rules
+    * @param  None
+    * @return size_t  Return number of instructions
+    ********************************************************/
+    size_t getInstructionCount() const;
+
+    /********************************************************
+    * @brief  Get number of events lost because nobody took them
+    * @param  None
+    * @return unsigned long   Return number of events
+    ********************************************************/
+    unsigned long getDroppedEvents() const;
+};
+
+#endif  /* RULE_ENGINE_HPP */
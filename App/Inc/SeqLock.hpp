@@ -0,0 +1,101 @@
+/********************************************************
+* @file     SeqLock.hpp
+* @brief    Declare classes related to latest value shared
+*           between threads
+* @details  This file contains template class of a sequence
+*           lock. One writer replaces the value without
+*           waiting, readers retry if the value changed while
+*           they copied it. Readers only need the latest
+*           value, older values are overwritten.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef SEQ_LOCK_HPP
+#define SEQ_LOCK_HPP
+
+#include <atomic>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+
+using namespace std;
+
+/********************************************************
+* @class SeqLock
+* @brief Class keeps the latest value of type T. The value
+*        is stored in atomic words, so a reader racing with
+*        the writer reads a torn copy and retries, never
+*        undefined data. store() is called by one thread.
+********************************************************/
+template <typename T>
+class SeqLock {
+private:
+    static_assert(is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    static const size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    atomic<uint64_t> sequence;      /* Odd while the writer copies */
+    atomic<uint64_t> words[WORDS];  /* Value */
+
+    /* Lock can not be copied */
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+public:
+    /********************************************************
+    * @brief Constructor, value is zero
+    ********************************************************/
+    SeqLock() : sequence(0) {
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(0, memory_order_relaxed);
+        }
+    }
+
+    /********************************************************
+    * @brief  Replace value, called by the writer only, does
+    *         not wait
+    * @param  value   New value
+    * @return None
+    ********************************************************/
+    void store(const T& value) {
+        uint64_t buffer[WORDS] = {};
+        memcpy(buffer, &value, sizeof(T));
+
+        uint64_t current = sequence.load(memory_order_relaxed);
+        sequence.store(current + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(buffer[i], memory_order_relaxed);
+        }
+        sequence.store(current + 2, memory_order_release);
+    }
+
+    /********************************************************
+    * @brief  Copy the latest value, retries while the writer
+    *         replaces it
+    * @param  value   Copied value
+    * @return uint64_t    Return version of the value, it
+    *                     grows with each store()
+    ********************************************************/
+    uint64_t load(T& value) const {
+        uint64_t buffer[WORDS];
+        uint64_t before;
+        uint64_t after;
+
+        do {
+            before = sequence.load(memory_order_acquire);
+            for (size_t i = 0; i < WORDS; i++) {
+                buffer[i] = words[i].load(memory_order_relaxed);
+            }
+            atomic_thread_fence(memory_order_acquire);
+            after = sequence.load(memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        memcpy(&value, buffer, sizeof(T));
+        return before / 2;
+    }
+};
+
+#endif  /* SEQ_LOCK_HPP */
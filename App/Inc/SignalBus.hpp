@@ -0,0 +1,143 @@
+/********************************************************
+* @file     SignalBus.hpp
+* @brief    Declare classes related to typed publish and
+*           subscribe signals
+* @details  This file contains template class of a typed
+*           signal. Each event type has its own signal, the
+*           event is passed by reference to all subscribers
+*           in one pass, without virtual calls and without
+*           allocating memory per event.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef SIGNAL_BUS_HPP
+#define SIGNAL_BUS_HPP
+
+#include <vector>
+#include "RcuPointer.hpp"
+#include "StaticVector.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Maximum number of subscribers of one signal in
+*        the static allocation build
+********************************************************/
+#define SIGNAL_MAX_SLOTS    8
+
+/********************************************************
+* @class Signal
+* @brief Class keeps subscribers of one event type. The
+*        subscriber list is published through RcuPointer,
+*        so subscribers can be added or removed while
+*        events are emitted from another thread.
+********************************************************/
+template <typename Event>
+class Signal {
+private:
+    /********************************************************
+    * @brief Handler calls the subscribed member function
+    ********************************************************/
+    typedef void (*Handler)(void* receiver, const Event& event);
+
+    /********************************************************
+    * @brief One subscriber
+    ********************************************************/
+    typedef struct {
+        void* receiver;     /* Object that receives events */
+        Handler handler;    /* Calls member function of receiver */
+    } Slot;
+
+    /********************************************************
+    * @brief Subscriber list, fixed capacity in the static
+    *        allocation build
+    ********************************************************/
+#ifdef DASHBOARD_STATIC_ALLOC
+    typedef StaticVector<Slot, SIGNAL_MAX_SLOTS> SlotList;
+#else
+    typedef vector<Slot> SlotList;
+#endif
+
+    RcuPointer<SlotList> slots;   /* Subscribers */
+
+    /********************************************************
+    * @brief  Call member function of receiver, generated for
+    *         each subscribed member function
+    * @param  receiver    Object that receives event
+    * @param  event       Emitted event
+    * @return None
+    ********************************************************/
+    template <typename Receiver, void (Receiver::*Method)(const Event&)>
+    static void invoke(void* receiver, const Event& event) {
+        (static_cast<Receiver*>(receiver)->*Method)(event);
+    }
+
+    /* Signal can not be copied */
+    Signal(const Signal&) = delete;
+    Signal& operator=(const Signal&) = delete;
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    Signal() : slots(new SlotList()) {}
+
+    /********************************************************
+    * @brief  Subscribe a member function to this signal
+    * @param  receiver    Object that receives events
+    * @return None
+    ********************************************************/
+    template <typename Receiver, void (Receiver::*Method)(const Event&)>
+    void subscribe(Receiver* receiver) {
+        Slot slot;
+        slot.receiver = receiver;
+        slot.handler = &Signal::invoke<Receiver, Method>;
+
+        slots.update([slot](SlotList& list) {
+            list.push_back(slot);
+        });
+    }
+
+    /********************************************************
+    * @brief  Unsubscribe a member function, waits for events
+    *         in progress so the receiver can be destroyed
+    *         after return. Must not be called by a handler.
+    * @param  receiver    Object that receives events
+    * @return None
+    ********************************************************/
+    template <typename Receiver, void (Receiver::*Method)(const Event&)>
+    void unsubscribe(Receiver* receiver) {
+        void* target = receiver;
+        Handler handler = &Signal::invoke<Receiver, Method>;
+
+        slots.update([target, handler](SlotList& list) {
+            for (size_t i = 0; i < list.size(); ) {
+                if (list[i].receiver == target && list[i].handler == handler) {
+                    list.erase(list.begin() + i);
+                } else {
+                    i++;
+                }
+            }
+        });
+
+        slots.synchronize();
+    }
+
+    /********************************************************
+    * @brief  Pass event to all subscribers in subscription
+    *         order
+    * @param  event   Event to emit
+    * @return None
+    ********************************************************/
+    void emit(const Event& event) const {
+        typename RcuPointer<SlotList>::ReadGuard list(slots);
+
+        for (size_t i = 0; i < list->size(); i++) {
+            const Slot& slot = (*list)[i];
+            slot.handler(slot.receiver, event);
+        }
+    }
+};
+
+#endif  /* SIGNAL_BUS_HPP */
@@ -4,7 +4,7 @@
 *           calculation
 * @details  This file contains class and methods declaration
 *           related to speed calculation, include calculate 
-*           speed and adjust speed.
+*           speed, adjust speed and cruise control.
 * @version  1.0
 * @date     2024-11-10
 * @author   Tran Quang Khai
@@ -13,31 +13,79 @@
 #define SPEED_CALCULATOR_HPP
 
 #include "DriveModeManager.hpp"
+#include "FixedPoint.hpp"
+#include "VehicleProfile.hpp"
 #include <string>
 
 using namespace std;
 
 /********************************************************
-* @class SpeedCalculator
+* Cruise control, speeds in km/h, accelerations in km/h/s
+********************************************************/
+#define CRUISE_KP               3.0     /* Proportional gain (1/s) */
+#define CRUISE_KI               0.5     /* Integral gain (1/s^2) */
+#define CRUISE_KD               0.1     /* Derivative gain on measured speed */
+#define CRUISE_MAX_ACCEL        20      /* Strongest drive command, same as accelerator */
+#define CRUISE_MAX_DECEL        20      /* Strongest brake command, same as brake */
+#define CRUISE_MAX_JERK         40      /* Change of command per second (km/h/s^2) */
+#define CRUISE_COAST_DECEL      10      /* Speed lost without drive, same as coasting */
+#define CRUISE_MIN_SPEED        30      /* Lowest set speed */
+#define CRUISE_SPEED_STEP       5       /* Change of set speed per key press */
+#define CRUISE_DEFAULT_RATE_HZ  1000    /* Steps of cruise loop per second */
+#define CRUISE_MAX_RATE_HZ      1000    /* Fastest cruise loop */
+
+/********************************************************
+* @class BasicSpeedCalculator
 * @brief Class includes current speed, calculate speed
-*        and adjust speed.
+*        and adjust speed. Num is double, Q16_16 or Q32_32,
+*        the methods are instantiated for these types only.
+*        While cruise control is active, a fixed rate loop
+*        calls stepCruise() and a PI-D controller holds the
+*        set speed against coasting loss.
 ********************************************************/
-class SpeedCalculator {
+template <typename Num>
+class BasicSpeedCalculator {
 private:
-    int currentSpeed;   /* Vehicle's current speed */
-    int maxSpeedSport;  /* Maximum speed for Sport mode */
-    int maxSpeedEco;    /* Maximum speed for Eco mode */
+    Num currentSpeed;   /* Vehicle's current speed */
+    Num maxSpeedSport;  /* Maximum speed for Sport mode */
+    Num maxSpeedEco;    /* Maximum speed for Eco mode */
+
+    /* Cruise control */
+    bool isCruiseOn;        /* Set speed is held */
+    bool isCruiseOverridden;/* Accelerator is pressed, controller waits */
+    Num cruiseSetSpeed;     /* Speed to hold */
+    Num cruiseIntegral;     /* Integral term, limited for anti-windup */
+    Num cruiseCommand;      /* Acceleration after rate limit */
+    Num cruiseLastSpeed;    /* Speed at previous step */
+    Num cruiseDt;           /* Time of one step (s) */
+    Num cruiseKiDt;         /* CRUISE_KI * dt */
+    Num cruiseJerkDt;       /* Largest command change of one step */
+    int cruiseRateHz;       /* Steps per second */
+
+    /********************************************************
+    * @brief  Get max speed base on drive mode
+    * @param  driveMode   Drive mode to get max speed
+    * @return Num     Max speed
+    ********************************************************/
+    Num getMaxSpeedNum(const DriveMode driveMode) const;
 
 public:
     /********************************************************
     * @brief Constructor 
     ********************************************************/
-    SpeedCalculator();
+    BasicSpeedCalculator();
 
     /********************************************************
     * @brief Destructor 
     ********************************************************/
-    ~SpeedCalculator();
+    ~BasicSpeedCalculator();
+
+    /********************************************************
+    * @brief  Apply parameters of vehicle profile
+    * @param  profile     Parameters of vehicle variant
+    * @return None
+    ********************************************************/
+    void applyProfile(const VehicleProfile& profile);
 
     /********************************************************
     * @brief  Calculate speed base on brake and accelerator state
@@ -69,12 +117,84 @@ public:
     ********************************************************/
     int getCurrentSpeed() const; 
 
+    /********************************************************
+    * @brief  Get current speed without rounding
+    * @param  None
+    * @return Num     Return current speed
+    ********************************************************/
+    Num getSpeedValue() const;
+
     /********************************************************
     * @brief  Set current speed
     * @param  newSpeed    Value to set speed
     * @return None
     ********************************************************/
     void setCurrentSpeed(int newSpeed);  
+
+    /********************************************************
+    * @brief  Set rate of cruise loop, dt of each step
+    * @param  rateHz      Steps per second (1 - CRUISE_MAX_RATE_HZ)
+    * @return bool        Return false if rate is invalid
+    ********************************************************/
+    bool setCruiseRate(int rateHz);
+
+    /********************************************************
+    * @brief  Get rate of cruise loop
+    * @param  None
+    * @return int     Return steps per second
+    ********************************************************/
+    int getCruiseRate() const;
+
+    /********************************************************
+    * @brief  Hold current speed
+    * @param  driveMode   Drive mode to limit set speed
+    * @return bool        Return false if speed is below
+    *                     CRUISE_MIN_SPEED
+    ********************************************************/
+    bool engageCruise(const DriveMode driveMode);
+
+    /********************************************************
+    * @brief  Change set speed
+    * @param  delta       Change of set speed (km/h)
+    * @param  driveMode   Drive mode to limit set speed
+    * @return None
+    ********************************************************/
+    void adjustCruiseSpeed(int delta, const DriveMode driveMode);
+
+    /********************************************************
+    * @brief  Stop holding speed
+    * @param  None
+    * @return None
+    ********************************************************/
+    void cancelCruise();
+
+    /********************************************************
+    * @brief  Check cruise control is holding speed
+    * @param  None
+    * @return bool    Return true if active
+    ********************************************************/
+    bool isCruiseActive() const;
+
+    /********************************************************
+    * @brief  Get set speed
+    * @param  None
+    * @return int     Return set speed
+    ********************************************************/
+    int getCruiseSpeed() const;
+
+    /********************************************************
+    * @brief  Run one step of cruise control, does nothing
+    *         if it is not active
+    * @param  driveMode   Drive mode to limit speed
+    * @return None
+    ********************************************************/
+    void stepCruise(const DriveMode driveMode);
 };
 
+/********************************************************
+* @brief Speed model of the dashboard, number type is
+*        selected at build time, see DashboardNum
+********************************************************/
+typedef BasicSpeedCalculator<DashboardNum> SpeedCalculator;
+
 #endif  /* SPEED_CALCULATOR_HPP */
\ No newline at end of file
@@ -0,0 +1,86 @@
+/********************************************************
+* @file     SpscQueue.hpp
+* @brief    Declare classes related to single producer
+*           single consumer queue
+* @details  This file contains template class of a bounded
+*           lock-free queue between one producer thread and
+*           one consumer thread. Push and pop never block and
+*           never allocate memory.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+/********************************************************
+* @brief Size of a cache line, producer and consumer
+*        indexes are kept on separate lines
+********************************************************/
+#define SPSC_CACHE_LINE     64
+
+/********************************************************
+* @class SpscQueue
+* @brief Class keeps up to Capacity items of type T in a
+*        ring. Capacity must be a power of 2. Indexes run
+*        freely and are masked when used, head is written
+*        only by the consumer and tail only by the producer.
+********************************************************/
+template <typename T, size_t Capacity>
+class SpscQueue {
+private:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+    alignas(SPSC_CACHE_LINE) atomic<size_t> head;   /* Next item to pop */
+    alignas(SPSC_CACHE_LINE) atomic<size_t> tail;   /* Next free slot */
+    alignas(SPSC_CACHE_LINE) T items[Capacity];     /* Ring storage */
+
+    /* Queue can not be copied */
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+public:
+    /********************************************************
+    * @brief Constructor, queue is empty
+    ********************************************************/
+    SpscQueue() : head(0), tail(0) {}
+
+    /********************************************************
+    * @brief  Add an item, called by the producer only
+    * @param  item    Item to add
+    * @return bool    Return false if queue is full
+    ********************************************************/
+    bool tryPush(const T& item) {
+        size_t position = tail.load(memory_order_relaxed);
+        if (position - head.load(memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        items[position & (Capacity - 1)] = item;
+        tail.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    /********************************************************
+    * @brief  Remove oldest item, called by the consumer only
+    * @param  item    Removed item
+    * @return bool    Return false if queue is empty
+    ********************************************************/
+    bool tryPop(T& item) {
+        size_t position = head.load(memory_order_relaxed);
+        if (position == tail.load(memory_order_acquire)) {
+            return false;
+        }
+
+        item = items[position & (Capacity - 1)];
+        head.store(position + 1, memory_order_release);
+        return true;
+    }
+};
+
+#endif  /* SPSC_QUEUE_HPP */
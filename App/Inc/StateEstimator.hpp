@@ -0,0 +1,182 @@
+/********************************************************
+* @file     StateEstimator.hpp
+* @brief    Declare methods and classes related to speed and
+*           state of charge estimation
+* @details  This file contains class and methods declaration
+*           related to a Kalman filter that smooths noisy
+*           samples of speed and battery level. State of
+*           charge is predicted from the drain model of
+*           BatteryManager between samples and corrected by
+*           each battery sample. Samples may arrive at any
+*           time, the filter is moved to the time of each
+*           sample before it is used.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef STATE_ESTIMATOR_HPP
+#define STATE_ESTIMATOR_HPP
+
+#include "Matrix.hpp"
+#include "BatteryManager.hpp"
+
+using namespace std;
+
+/********************************************************
+* Noise of the model and of the samples
+********************************************************/
+#define ESTIMATOR_JERK_NOISE        4.0     /* Change of acceleration ((km/h/s)^2 per s) */
+#define ESTIMATOR_SOC_DRIFT         0.01    /* Error of drain model (%^2 per s) */
+#define ESTIMATOR_SPEED_NOISE       4.0     /* Variance of speed samples ((km/h)^2) */
+#define ESTIMATOR_SOC_NOISE         0.25    /* Variance of battery samples (%^2) */
+#define ESTIMATOR_INITIAL_ACCEL     25.0    /* Variance of acceleration at start ((km/h/s)^2) */
+
+/********************************************************
+* Limits of the filter
+********************************************************/
+#define ESTIMATOR_MAX_GAP_S         10.0    /* Longer gaps restart the filter (s) */
+#define ESTIMATOR_GATE_SIGMA        5.0     /* Samples further away are outliers */
+#define ESTIMATOR_MAX_REJECTS       3       /* Outliers in a row taken as a real step */
+
+/********************************************************
+* @brief Index of each value in the state
+********************************************************/
+typedef enum {
+    ESTIMATE_SPEED = 0,     /* Speed (km/h) */
+    ESTIMATE_ACCEL,         /* Acceleration (km/h per s) */
+    ESTIMATE_SOC,           /* State of charge (%) */
+    ESTIMATE_COUNT
+} EstimateIndex;
+
+/********************************************************
+* @class StateEstimator
+* @brief Class keeps a Kalman filter of speed, acceleration
+*        and state of charge. Samples are used one by one
+*        as scalar updates, so no matrix is inverted. All
+*        matrices are members of fixed size, a step does
+*        not allocate memory.
+********************************************************/
+class StateEstimator {
+private:
+    const BatteryManager* batteryManager;   /* Drain model, NULL predicts no drain */
+
+    Matrix<ESTIMATE_COUNT, 1> state;                /* Estimated values */
+    Matrix<ESTIMATE_COUNT, ESTIMATE_COUNT> covariance;  /* Uncertainty of estimate */
+    double stateTime;           /* Time of estimate (s) */
+    bool hasTime;               /* A sample was used */
+    bool hasSpeed;              /* Speed was sampled since start */
+    bool hasSoc;                /* State of charge was sampled since start */
+    int rejectCount[ESTIMATE_COUNT];    /* Outliers in a row of each value */
+
+    int acTemp;                 /* AC temperature of drain model (°C) */
+    int windLevel;              /* Wind level of drain model */
+
+    unsigned long samples;      /* Samples used */
+    unsigned long outliers;     /* Samples rejected as outliers */
+
+    /********************************************************
+    * @brief  Move estimate to time of a sample, older samples
+    *         are used at time of estimate
+    * @param  time    Time of sample (s)
+    * @return None
+    ********************************************************/
+    void predict(double time);
+
+    /********************************************************
+    * @brief  Correct estimate with one sample
+    * @param  index       Value that is sampled
+    * @param  value       Sampled value
+    * @param  variance    Variance of sample
+    * @return None
+    ********************************************************/
+    void correct(EstimateIndex index, double value, double variance);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param batteryManager   Pointer to battery manager with
+    *                         the drain model
+    ********************************************************/
+    explicit StateEstimator(const BatteryManager* batteryManager);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~StateEstimator();
+
+    /********************************************************
+    * @brief  Set climate used to predict drain
+    * @param  acTemp      AC temperature (°C)
+    * @param  windLevel   Wind level
+    * @return None
+    ********************************************************/
+    void setClimate(int acTemp, int windLevel);
+
+    /********************************************************
+    * @brief  Use a speed sample
+    * @param  time    Time of sample (s)
+    * @param  speed   Sampled speed (km/h)
+    * @return None
+    ********************************************************/
+    void updateSpeed(double time, double speed);
+
+    /********************************************************
+    * @brief  Use a battery level sample
+    * @param  time    Time of sample (s)
+    * @param  soc     Sampled battery level (%)
+    * @return None
+    ********************************************************/
+    void updateSoc(double time, double soc);
+
+    /********************************************************
+    * @brief  Check if both speed and battery were sampled
+    * @param  None
+    * @return bool    Return true if estimate is usable
+    ********************************************************/
+    bool isReady() const;
+
+    /********************************************************
+    * @brief  Get estimated speed
+    * @param  None
+    * @return double  Return speed (km/h)
+    ********************************************************/
+    double getSpeed() const;
+
+    /********************************************************
+    * @brief  Get estimated state of charge
+    * @param  None
+    * @return double  Return state of charge (%)
+    ********************************************************/
+    double getSoc() const;
+
+    /********************************************************
+    * @brief  Get standard deviation of estimated speed
+    * @param  None
+    * @return double  Return uncertainty (km/h)
+    ********************************************************/
+    double getSpeedUncertainty() const;
+
+    /********************************************************
+    * @brief  Get standard deviation of estimated state of
+    *         charge
+    * @param  None
+    * @return double  Return uncertainty (%)
+    ********************************************************/
+    double getSocUncertainty() const;
+
+    /********************************************************
+    * @brief  Get number of used samples
+    * @param  None
+    * @return unsigned long   Return number
+    ********************************************************/
+    unsigned long getSamples() const;
+
+    /********************************************************
+    * @brief  Get number of samples rejected as outliers
+    * @param  None
+    * @return unsigned long   Return number
+    ********************************************************/
+    unsigned long getOutliers() const;
+};
+
+#endif  /* STATE_ESTIMATOR_HPP */
@@ -0,0 +1,145 @@
+/********************************************************
+* @file     StaticVector.hpp
+* @brief    Declare classes related to fixed capacity
+*           containers
+* @details  This file contains template class of a vector
+*           whose storage is part of the object, capacity is
+*           set at compile time. It replaces vector in the
+*           static allocation build (DASHBOARD_STATIC_ALLOC),
+*           where the heap must not be used after startup.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef STATIC_VECTOR_HPP
+#define STATIC_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+using namespace std;
+
+/********************************************************
+* @class StaticVector
+* @brief Class keeps up to Capacity elements of type T in
+*        place. It has the members of vector used by the
+*        dashboard, so code builds with both containers.
+*        Elements are default constructed with the vector.
+*        Capacity is chosen at build time, going past it is
+*        a bug and stops the program.
+********************************************************/
+template <typename T, size_t Capacity>
+class StaticVector {
+private:
+    T items[Capacity];  /* Storage */
+    size_t count;       /* Number of elements in use */
+
+    /********************************************************
+    * @brief  Stop the program when capacity is too small
+    * @param  None
+    * @return None
+    ********************************************************/
+    static void overflow() {
+        fputs("StaticVector capacity exceeded\n", stderr);
+        abort();
+    }
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    /********************************************************
+    * @brief Constructor, vector is empty
+    ********************************************************/
+    StaticVector() : count(0) {}
+
+    /********************************************************
+    * @brief  Storage is fixed, only checks requested size
+    * @param  size    Number of elements that will be used
+    * @return None
+    ********************************************************/
+    void reserve(size_t size) {
+        if (size > Capacity) {
+            overflow();
+        }
+    }
+
+    /********************************************************
+    * @brief  Append an element
+    * @param  item    Element to append
+    * @return None
+    ********************************************************/
+    void push_back(const T& item) {
+        if (count == Capacity) {
+            overflow();
+        }
+        items[count++] = item;
+    }
+
+    /********************************************************
+    * @brief  Remove last element
+    * @param  None
+    * @return None
+    ********************************************************/
+    void pop_back() {
+        count--;
+    }
+
+    /********************************************************
+    * @brief  Remove one element, later elements move down
+    * @param  position    Element to remove
+    * @return iterator    Return element after removed one
+    ********************************************************/
+    iterator erase(iterator position) {
+        for (iterator it = position; it + 1 < end(); it++) {
+            *it = *(it + 1);
+        }
+        count--;
+        return position;
+    }
+
+    /********************************************************
+    * @brief  Remove all elements
+    * @param  None
+    * @return None
+    ********************************************************/
+    void clear() {
+        count = 0;
+    }
+
+    /********************************************************
+    * @brief  Exchange elements with another vector
+    * @param  other   Vector to exchange with
+    * @return None
+    ********************************************************/
+    void swap(StaticVector& other) {
+        size_t larger = (count > other.count) ? count : other.count;
+        for (size_t i = 0; i < larger; i++) {
+            std::swap(items[i], other.items[i]);
+        }
+        std::swap(count, other.count);
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return Capacity; }
+    bool empty() const { return count == 0; }
+
+    T* data() { return items; }
+    const T* data() const { return items; }
+
+    iterator begin() { return items; }
+    iterator end() { return items + count; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + count; }
+
+    T& front() { return items[0]; }
+    const T& front() const { return items[0]; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+};
+
+#endif  /* STATIC_VECTOR_HPP */
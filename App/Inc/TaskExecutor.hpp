@@ -0,0 +1,317 @@
+/********************************************************
+* @file     TaskExecutor.hpp
+* @brief    Declare classes related to cooperative tasks
+* @details  This file contains coroutine task type and a
+*           single-threaded executor. Tasks wait on timers
+*           or on file descriptor readiness with co_await,
+*           all tasks run on the thread that calls run(), so
+*           data shared by tasks needs no locking.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef TASK_EXECUTOR_HPP
+#define TASK_EXECUTOR_HPP
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+#include "StaticVector.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Number of tasks and timers the executor reserves
+*        memory for at construction, the limit in the static
+*        allocation build
+********************************************************/
+#define EXECUTOR_RESERVED_TASKS     16
+
+/********************************************************
+* @brief Clock of all executor timers
+********************************************************/
+typedef chrono::steady_clock TaskClock;
+
+#ifdef __linux__
+/********************************************************
+* @enum  WaitResult
+* @brief This enum contains results of waiting for a file
+*        descriptor
+********************************************************/
+typedef enum {
+    WAIT_READABLE,  /* File descriptor can be read */
+    WAIT_TIMEOUT,   /* Time limit passed first */
+    WAIT_ERROR      /* File descriptor cannot be waited */
+} WaitResult;
+#endif
+
+/********************************************************
+* @class Task
+* @brief Coroutine started by TaskExecutor::spawn. Task
+*        starts suspended and is owned by the executor
+*        once spawned.
+********************************************************/
+class Task {
+public:
+    /********************************************************
+    * @brief Promise type required by C++20 coroutines
+    ********************************************************/
+    struct promise_type {
+        Task get_return_object() {
+            return Task(coroutine_handle<promise_type>::from_promise(*this));
+        }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    explicit Task(coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    /********************************************************
+    * @brief Move constructor
+    ********************************************************/
+    Task(Task&& other) noexcept : handle(exchange(other.handle, nullptr)) {}
+
+    /********************************************************
+    * @brief Destructor, destroys task that was not spawned
+    ********************************************************/
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    /********************************************************
+    * @brief  Give up ownership of the coroutine
+    * @param  None
+    * @return coroutine_handle<>  Return coroutine of this task
+    ********************************************************/
+    coroutine_handle<> release() {
+        return exchange(handle, nullptr);
+    }
+
+private:
+    coroutine_handle<promise_type> handle;  /* Coroutine of this task */
+
+    /* Task can not be copied */
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+};
+
+/********************************************************
+* @class TaskExecutor
+* @brief Class runs tasks on one thread. Ready tasks run in
+*        the order they became ready, timers with the same
+*        deadline expire in the order they were set, so a
+*        run with the same inputs is always the same.
+********************************************************/
+class TaskExecutor {
+private:
+    /********************************************************
+    * @brief Task waiting for a deadline
+    ********************************************************/
+    typedef struct {
+        TaskClock::time_point due;  /* Deadline */
+        uint64_t sequence;          /* Order timers were set */
+        coroutine_handle<> handle;  /* Task to resume */
+    } Timer;
+
+    /********************************************************
+    * @brief Lists of tasks and timers, fixed capacity in the
+    *        static allocation build
+    ********************************************************/
+#ifdef DASHBOARD_STATIC_ALLOC
+    typedef StaticVector<coroutine_handle<>, EXECUTOR_RESERVED_TASKS> TaskList;
+    typedef StaticVector<Timer, EXECUTOR_RESERVED_TASKS> TimerList;
+#else
+    typedef vector<coroutine_handle<> > TaskList;
+    typedef vector<Timer> TimerList;
+#endif
+
+    TaskList tasks;         /* Spawned tasks not finished */
+    TaskList ready;         /* Tasks to resume now */
+    TaskList running;       /* Tasks resumed in current pass */
+    TimerList timers;       /* Min-heap of deadlines */
+    uint64_t timerSequence;                 /* Sequence of next timer */
+    bool isStopRequested;                   /* run() returns after current pass */
+
+#ifdef __linux__
+    int epollFd;            /* Waited file descriptors */
+    int timerFd;            /* Armed to earliest deadline */
+    unsigned int ioWaiters; /* Tasks waiting for a file descriptor */
+#endif
+
+    /* Executor can not be copied */
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    /********************************************************
+    * @brief  Order of timers in the min-heap
+    * @param  a   First timer
+    * @param  b   Second timer
+    * @return bool    Return true if a expires after b
+    ********************************************************/
+    static bool isLater(const Timer& a, const Timer& b);
+
+    /********************************************************
+    * @brief  Remove the timer of a task before it expires
+    * @param  handle  Task of the timer
+    * @return bool    Return false if task has no timer
+    ********************************************************/
+    bool removeTimer(coroutine_handle<> handle);
+
+    /********************************************************
+    * @brief  Resume a task, destroys it when it finishes
+    * @param  handle  Task to resume
+    * @return None
+    ********************************************************/
+    void resume(coroutine_handle<> handle);
+
+    /********************************************************
+    * @brief  Move expired timers to ready list
+    * @param  now     Current time
+    * @return None
+    ********************************************************/
+    void expireTimers(TaskClock::time_point now);
+
+    /********************************************************
+    * @brief  Block until earliest deadline or until a waited
+    *         file descriptor is ready
+    * @param  None
+    * @return None
+    ********************************************************/
+    void waitForEvents();
+
+public:
+    /********************************************************
+    * @brief Awaitable, resumes task at a deadline
+    ********************************************************/
+    struct TimerAwaiter {
+        TaskExecutor* executor;         /* Owner of the timer */
+        TaskClock::time_point due;      /* Deadline */
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(coroutine_handle<> handle) { executor->addTimer(due, handle); }
+        void await_resume() const noexcept {}
+    };
+
+#ifdef __linux__
+    /********************************************************
+    * @brief Awaitable, resumes task when file descriptor
+    *        can be read or when its time limit passes
+    ********************************************************/
+    struct ReadableAwaiter {
+        TaskExecutor* executor;     /* Owner of the wait */
+        int fd;                     /* Waited file descriptor */
+        int milliseconds;           /* Time limit (ms), negative waits forever */
+        bool isWaiting;             /* fd was added to epoll */
+        bool isReadable;            /* Set by executor when fd is ready */
+        coroutine_handle<> handle;  /* Waiting task */
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(coroutine_handle<> handle) { return isWaiting = executor->addReader(this, handle); }
+        WaitResult await_resume() { return executor->removeReader(this); }
+    };
+#endif
+
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    TaskExecutor();
+
+    /********************************************************
+    * @brief Destructor, destroys tasks not finished
+    ********************************************************/
+    ~TaskExecutor();
+
+    /********************************************************
+    * @brief  Add a task, it starts on next pass of run()
+    * @param  task    Task to run
+    * @return None
+    ********************************************************/
+    void spawn(Task task);
+
+    /********************************************************
+    * @brief  Run tasks until all tasks finished or stop()
+    *         is called
+    * @param  None
+    * @return None
+    ********************************************************/
+    void run();
+
+    /********************************************************
+    * @brief  Request run() to return, can be called by a task
+    * @param  None
+    * @return None
+    ********************************************************/
+    void stop();
+
+    /********************************************************
+    * @brief  Resume the calling task at a deadline
+    * @param  due     Deadline
+    * @return TimerAwaiter    Return awaitable
+    ********************************************************/
+    TimerAwaiter sleepUntil(TaskClock::time_point due);
+
+    /********************************************************
+    * @brief  Resume the calling task after a delay
+    * @param  milliseconds    Delay (ms)
+    * @return TimerAwaiter    Return awaitable
+    ********************************************************/
+    TimerAwaiter sleepFor(int milliseconds);
+
+    /********************************************************
+    * @brief  Let other ready tasks run before the calling
+    *         task continues
+    * @param  None
+    * @return TimerAwaiter    Return awaitable
+    ********************************************************/
+    TimerAwaiter yield();
+
+    /********************************************************
+    * @brief  Set a timer, used by TimerAwaiter
+    * @param  due     Deadline
+    * @param  handle  Task to resume
+    * @return None
+    ********************************************************/
+    void addTimer(TaskClock::time_point due, coroutine_handle<> handle);
+
+#ifdef __linux__
+    /********************************************************
+    * @brief  Resume the calling task when file descriptor can
+    *         be read or after a time limit, co_await returns
+    *         a WaitResult
+    * @param  fd              File descriptor
+    * @param  milliseconds    Time limit (ms), negative waits
+    *                         forever
+    * @return ReadableAwaiter Return awaitable
+    ********************************************************/
+    ReadableAwaiter waitReadable(int fd, int milliseconds = -1);
+
+    /********************************************************
+    * @brief  Add file descriptor to epoll and set the time
+    *         limit, used by ReadableAwaiter
+    * @param  awaiter     Wait of the task
+    * @param  handle      Task to resume
+    * @return bool        Return true if task must be suspended
+    ********************************************************/
+    bool addReader(ReadableAwaiter* awaiter, coroutine_handle<> handle);
+
+    /********************************************************
+    * @brief  Remove file descriptor from epoll, used by
+    *         ReadableAwaiter
+    * @param  awaiter     Wait of the task
+    * @return WaitResult  Return why the task was resumed
+    ********************************************************/
+    WaitResult removeReader(ReadableAwaiter* awaiter);
+#endif
+};
+
+#endif  /* TASK_EXECUTOR_HPP */
@@ -0,0 +1,137 @@
+/********************************************************
+* @file     TelemetryExporter.hpp
+* @brief    Declare methods and classes related to export
+*           of tick history
+* @details  This file contains class and methods declaration
+*           related to exporting every tick of DashboardController
+*           as Apache Arrow IPC for analysis tools. The control
+*           loop only stamps a row and pushes it to a lock-free
+*           queue, the exporter thread builds record batches
+*           with ArrowWriter and writes them, so the disk never
+*           delays the control loop.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef TELEMETRY_EXPORTER_HPP
+#define TELEMETRY_EXPORTER_HPP
+
+#include <atomic>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include "ArrowWriter.hpp"
+#include "SpscQueue.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Number of rows the control loop can queue before
+*        the exporter thread takes them
+********************************************************/
+#define EXPORT_QUEUE_CAPACITY   1024
+
+/********************************************************
+* @struct TelemetryExportStats
+* @brief  Counters of the exporter
+********************************************************/
+typedef struct {
+    unsigned long submitted;    /* Rows queued by control loop */
+    unsigned long dropped;      /* Rows dropped, queue was full */
+    unsigned long rows;         /* Rows written in batches */
+    unsigned long batches;      /* Record batches written */
+    unsigned long bytes;        /* Bytes of file */
+    unsigned long errors;       /* Failed writes */
+} TelemetryExportStats;
+
+/********************************************************
+* @class TelemetryExporter
+* @brief Class writes tick history to an Arrow file on its
+*        own thread. submit() and update() are called by one
+*        producer thread only and never block.
+********************************************************/
+class TelemetryExporter {
+private:
+    string path;                /* File to write */
+    ArrowWriter arrowWriter;    /* Used by exporter thread only while it runs */
+    SpscQueue<TelemetryRow, EXPORT_QUEUE_CAPACITY> queue;
+    counting_semaphore<> wakeup;    /* Released once per queued row */
+    atomic<bool> isStopRequested;
+    thread worker;
+
+    /* Counters, written by one thread, read at any time */
+    atomic<unsigned long> submitted;
+    atomic<unsigned long> dropped;
+    atomic<unsigned long> errors;
+
+    /* Used by producer thread only */
+    uint64_t ticks;             /* Rows stamped */
+
+    /* Exporter can not be copied */
+    TelemetryExporter(const TelemetryExporter&) = delete;
+    TelemetryExporter& operator=(const TelemetryExporter&) = delete;
+
+    /********************************************************
+    * @brief  Body of exporter thread
+    * @param  None
+    * @return None
+    ********************************************************/
+    void run();
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param path         File to write, ARROW_STREAM_EXTENSION
+    *                     selects stream format
+    * @param batchRows    Rows of one record batch
+    ********************************************************/
+    TelemetryExporter(const string& path, size_t batchRows = ARROW_DEFAULT_BATCH_ROWS);
+
+    /********************************************************
+    * @brief Destructor, stops the exporter thread
+    ********************************************************/
+    ~TelemetryExporter();
+
+    /********************************************************
+    * @brief  Create file, write schema and start exporter
+    *         thread
+    * @param  None
+    * @return bool        Return false if file cannot be written
+    ********************************************************/
+    bool start();
+
+    /********************************************************
+    * @brief  Stamp a state with tick number and time and
+    *         queue it, does not block and does not allocate
+    *         memory
+    * @param  state       State of this tick
+    * @return bool        Return false if row is dropped
+    ********************************************************/
+    bool submit(const DashboardState& state);
+
+    /********************************************************
+    * @brief  Queue a published state, subscriber of
+    *         DashboardController
+    * @param  snapshot    State published by DashboardController
+    * @return None
+    ********************************************************/
+    void update(const StateSnapshot& snapshot);
+
+    /********************************************************
+    * @brief  Write queued rows and the last batch, close file
+    *         and stop exporter thread
+    * @param  None
+    * @return None
+    ********************************************************/
+    void stop();
+
+    /********************************************************
+    * @brief  Get counters of the exporter, rows, batches and
+    *         bytes are read after stop()
+    * @param  None
+    * @return TelemetryExportStats    Return counters
+    ********************************************************/
+    TelemetryExportStats getStats() const;
+};
+
+#endif  /* TELEMETRY_EXPORTER_HPP */
@@ -0,0 +1,92 @@
+/********************************************************
+* @file     TelemetryParser.hpp
+* @brief    Declare functions related to parsing telemetry
+*           records
+* @details  This file contains functions declaration related
+*           to parsing "KEY, value" lines as written into
+*           Database.csv, shared by the dashboard and the
+*           offline log analysis tools.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef TELEMETRY_PARSER_HPP
+#define TELEMETRY_PARSER_HPP
+
+#include <cstddef>
+#include "DashboardController.hpp"
+
+using namespace std;
+
+/********************************************************
+* @enum  TelemetryField
+* @brief This enum contains keys of a telemetry record
+********************************************************/
+typedef enum {
+    FIELD_DRIVE_MODE,       /* "DRIVE MODE", ECO or SPORT */
+    FIELD_SPEED,            /* "SPEED" (km/h) */
+    FIELD_BATTERY_LEVEL,    /* "BATTERY LEVEL" (%) */
+    FIELD_AC_TEMPERATURE,   /* "AC TEMPERATURE" (°C) */
+    FIELD_WIND_LEVEL,       /* "WIND LEVEL" */
+    FIELD_REMAINING_RANGE,  /* "REMAINING RANGE" (km) */
+    FIELD_TIMESTAMP         /* "TIMESTAMP" (ms), optional in logs */
+} TelemetryField;
+
+/********************************************************
+* @struct TelemetryValue
+* @brief  One parsed line of telemetry record
+********************************************************/
+typedef struct {
+    TelemetryField field;   /* Key of the line */
+    double value;           /* Numeric value, unused for drive mode */
+    DriveMode driveMode;    /* Drive mode, used for FIELD_DRIVE_MODE */
+} TelemetryValue;
+
+/********************************************************
+* @brief  Convert decimal number with optional sign and
+*         fraction
+* @param  begin   Start of number
+* @param  end     End of number
+* @param  value   Converted number
+* @return bool    Return true if whole text is a number
+********************************************************/
+bool parseNumber(const char* begin, const char* end, double& value);
+
+/********************************************************
+* @brief  Split one "KEY, value" line and find the key in
+*         a list of known keys, does not allocate memory
+* @param  line        Start of line
+* @param  end         End of line (without new line)
+* @param  keys        Known keys
+* @param  keyCount    Number of known keys
+* @param  key         Index of the key in keys
+* @param  valueBegin  Start of value
+* @param  valueEnd    End of value
+* @return bool        Return true if key is known
+********************************************************/
+bool splitKeyValueLine(const char* line, const char* end, const char* const keys[], size_t keyCount,
+    size_t& key, const char*& valueBegin, const char*& valueEnd);
+
+/********************************************************
+* @brief  Parse one "KEY, value" line, does not allocate
+*         memory and does not need a terminated string
+* @param  line    Start of line
+* @param  end     End of line (without new line)
+* @param  result  Parsed key and value
+* @return bool    Return true if key is known and value
+*                 is valid
+********************************************************/
+bool parseTelemetryLine(const char* line, const char* end, TelemetryValue& result);
+
+/********************************************************
+* @brief  Write system parameters as "KEY, value" lines,
+*         does not allocate memory
+* @param  state       System parameters
+* @param  buffer      Buffer to fill
+* @param  capacity    Size of buffer (bytes)
+* @return size_t      Return length of record, 0 if buffer
+*                     is too small
+********************************************************/
+size_t formatTelemetryRecord(const DashboardState& state, char* buffer, size_t capacity);
+
+#endif  /* TELEMETRY_PARSER_HPP */
@@ -0,0 +1,156 @@
+/********************************************************
+* @file     TripAnalyzer.hpp
+* @brief    Declare methods and classes related to offline
+*           trip analysis
+* @details  This file contains class and methods declaration
+*           related to analysing large telemetry logs in the
+*           Database.csv format, the log is split at record
+*           boundaries and analysed on several threads.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef TRIP_ANALYZER_HPP
+#define TRIP_ANALYZER_HPP
+
+#include <iostream>
+#include <string>
+#include "DashboardController.hpp"
+#include "BatteryManager.hpp"
+#include "MappedFile.hpp"
+
+using namespace std;
+
+/********************************************************
+* Parameters of trip analysis
+********************************************************/
+#define SPEED_HISTOGRAM_BIN_WIDTH   10  /* Width of histogram bin (km/h) */
+#define SPEED_HISTOGRAM_BINS        21  /* Last bin counts all speeds >= 200 km/h */
+#define LOW_BATTERY_LEVEL           20  /* Battery level of low battery warning (%) */
+#define DEFAULT_TICK_PERIOD_MS      100 /* Time between records without TIMESTAMP (ms) */
+
+/********************************************************
+* @struct TripRecord
+* @brief  One record of telemetry log, a record starts at
+*         its DRIVE MODE line
+********************************************************/
+typedef struct {
+    DriveMode driveMode;    /* Drive mode (ECO or SPORT) */
+    int speed;              /* Speed (km/h) */
+    int batteryLevel;       /* Battery level (%) */
+    int acTemp;             /* AC temperature (°C) */
+    int windLevel;          /* Wind level */
+    double timestampMs;     /* Timestamp (ms), valid if hasTimestamp */
+    bool hasTimestamp;      /* Record has TIMESTAMP line */
+} TripRecord;
+
+/********************************************************
+* @struct TripStatistics
+* @brief  Aggregated statistics of a part of a log. The
+*         first record of a part is only counted when the
+*         part is merged after the previous one, because
+*         its interval depends on the previous record.
+********************************************************/
+typedef struct {
+    unsigned long long records;                     /* Number of records */
+    double durationSec;                             /* Total time (s) */
+    double distanceKm;                              /* Distance (km) */
+    double energyUsed;                              /* Battery drain (% of battery) */
+    double timeInModeSec[2];                        /* Time in each DriveMode (s) */
+    double speedHistogramSec[SPEED_HISTOGRAM_BINS]; /* Time in each speed bin (s) */
+    unsigned long long lowBatteryEvents;            /* Times battery drops to low level */
+
+    bool hasRecords;    /* first and last are valid */
+    TripRecord first;   /* First record, not counted yet */
+    TripRecord last;    /* Last record */
+} TripStatistics;
+
+/********************************************************
+* @class TripAnalyzer
+* @brief Class maps a telemetry log and computes trip
+*        statistics in parallel
+********************************************************/
+class TripAnalyzer {
+private:
+    MappedFile logFile; /* Mapped telemetry log */
+
+    /********************************************************
+    * @brief  Add one record to statistics
+    * @param  stats           Statistics that receive record
+    * @param  record          Record to add
+    * @param  previous        Record before it, NULL if none
+    * @param  batteryManager  Drain model
+    * @return None
+    ********************************************************/
+    static void addRecord(TripStatistics& stats, const TripRecord& record,
+        const TripRecord* previous, const BatteryManager& batteryManager);
+
+    /********************************************************
+    * @brief  Find start of first record at or after offset
+    * @param  data    Start of log
+    * @param  size    Size of log
+    * @param  offset  Offset to start search
+    * @return size_t  Return offset of record start, size if
+    *                 there is no more record
+    ********************************************************/
+    static size_t findRecordStart(const char* data, size_t size, size_t offset);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    TripAnalyzer();
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~TripAnalyzer();
+
+    /********************************************************
+    * @brief  Map telemetry log
+    * @param  path    Path to telemetry log
+    * @return bool    Return true if log is mapped
+    ********************************************************/
+    bool open(const string& path);
+
+    /********************************************************
+    * @brief  Analyse whole log on several threads
+    * @param  workers         Number of threads (0 use default)
+    * @return TripStatistics  Return statistics of whole log
+    ********************************************************/
+    TripStatistics analyze(unsigned int workers);
+
+    /********************************************************
+    * @brief  Reset statistics to empty
+    * @param  stats   Statistics to reset
+    * @return None
+    ********************************************************/
+    static void resetStatistics(TripStatistics& stats);
+
+    /********************************************************
+    * @brief  Analyse a part of a log that starts at a record
+    * @param  begin   Start of part
+    * @param  end     End of part
+    * @param  stats   Statistics of part
+    * @return None
+    ********************************************************/
+    static void analyzeRange(const char* begin, const char* end, TripStatistics& stats);
+
+    /********************************************************
+    * @brief  Merge statistics of the next part of a log
+    * @param  total   Statistics of previous parts
+    * @param  part    Statistics of next part
+    * @return None
+    ********************************************************/
+    static void mergeStatistics(TripStatistics& total, const TripStatistics& part);
+
+    /********************************************************
+    * @brief  Print statistics as text report
+    * @param  out     Stream to print
+    * @param  stats   Statistics to print
+    * @return None
+    ********************************************************/
+    static void printStatistics(ostream& out, const TripStatistics& stats);
+};
+
+#endif  /* TRIP_ANALYZER_HPP */
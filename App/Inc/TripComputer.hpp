@@ -0,0 +1,162 @@
+/********************************************************
+* @file     TripComputer.hpp
+* @brief    Declare methods and classes related to trip
+*           computer
+* @details  This file contains class and methods declaration
+*           related to trip computer, keeps running trip
+*           aggregates that are updated in constant time
+*           from each sample, without storing history.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef TRIP_COMPUTER_HPP
+#define TRIP_COMPUTER_HPP
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include "DashboardController.hpp"
+#include "BatteryManager.hpp"
+
+using namespace std;
+
+/********************************************************
+* @class KahanSum
+* @brief Compensated sum, keeps the rounding error of each
+*        addition so long sums of small values stay exact
+********************************************************/
+class KahanSum {
+private:
+    double sum;             /* Running sum */
+    double compensation;    /* Lost low-order bits of sum */
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    KahanSum() : sum(0.0), compensation(0.0) {}
+
+    /********************************************************
+    * @brief  Add a value to the sum
+    * @param  value   Value to add
+    * @return None
+    ********************************************************/
+    void add(double value) {
+        double corrected = value - compensation;
+        double newSum = sum + corrected;
+        compensation = (newSum - sum) - corrected;
+        sum = newSum;
+    }
+
+    /********************************************************
+    * @brief  Get current sum
+    * @param  None
+    * @return double  Return current sum
+    ********************************************************/
+    double value() const {
+        return sum;
+    }
+
+    /********************************************************
+    * @brief  Reset sum to 0
+    * @param  None
+    * @return None
+    ********************************************************/
+    void reset() {
+        sum = 0.0;
+        compensation = 0.0;
+    }
+};
+
+/********************************************************
+* @struct TripSnapshot
+* @brief  Trip values at the last update
+********************************************************/
+typedef struct {
+    double distanceKm;          /* Trip distance (km) */
+    double durationSec;         /* Trip time (s) */
+    double averageSpeed;        /* Average speed (km/h) */
+    int maxSpeed;               /* Maximum speed (km/h) */
+    double energyUsed;          /* Battery drain (% of battery) */
+    double averageConsumption;  /* Battery drain per distance (%/km) */
+    double timeInModeSec[2];    /* Time in each DriveMode (s) */
+} TripSnapshot;
+
+/********************************************************
+* @class TripComputer
+* @brief Class keeps trip aggregates, VehiclePipeline adds
+*        a sample each control tick. When CAN frames are
+*        replayed there is no control tick, its object
+*        subscribes to state changes of DashboardController
+********************************************************/
+class TripComputer {
+private:
+    const BatteryManager* batteryManager;   /* Drain model */
+
+    KahanSum distanceKm;        /* Trip distance (km) */
+    KahanSum durationSec;       /* Trip time (s) */
+    KahanSum energyUsed;        /* Battery drain (% of battery) */
+    KahanSum timeInModeSec[2];  /* Time in each DriveMode (s) */
+    int maxSpeed;               /* Maximum speed (km/h) */
+
+    bool hasPreviousUpdate;         /* previousTickTimeUs is valid */
+    uint64_t previousTickTimeUs;    /* Time of previous published state (us) */
+
+    atomic<bool> isResetRequested;  /* Reset is done by the updating thread */
+
+    mutable mutex snapshotMutex;    /* Protect published snapshot */
+    TripSnapshot snapshot;          /* Published snapshot */
+
+    /********************************************************
+    * @brief  Reset all aggregates
+    * @param  None
+    * @return None
+    ********************************************************/
+    void clearAggregates();
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    TripComputer(const BatteryManager* batteryManager);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~TripComputer();
+
+    /********************************************************
+    * @brief  Add one sample to trip aggregates
+    * @param  speed   Speed during the sample (km/h)
+    * @param  drain   Battery drain per 1 second during the sample
+    * @param  mode    Drive mode during the sample
+    * @param  dt      Length of the sample (s)
+    * @return None
+    ********************************************************/
+    void addSample(int speed, double drain, DriveMode mode, double dt);
+
+    /********************************************************
+    * @brief  Start a new trip, done on next sample
+    * @param  None
+    * @return None
+    ********************************************************/
+    void resetTrip();
+
+    /********************************************************
+    * @brief  Get trip values at the last update
+    * @param  None
+    * @return TripSnapshot    Return copy of trip values
+    ********************************************************/
+    TripSnapshot getSnapshot() const;
+
+    /********************************************************
+    * @brief  Update data from a published state, used only
+    *         when there is no control tick
+    * @param  snapshot    State published by DashboardController
+    * @return None
+    ********************************************************/
+    void update(const StateSnapshot& snapshot);
+};
+
+#endif  /* TRIP_COMPUTER_HPP */
@@ -0,0 +1,105 @@
+/********************************************************
+* @file     UringFile.hpp
+* @brief    Declare methods and classes related to file
+*           writes through io_uring
+* @details  This file contains class and methods declaration
+*           related to io_uring. The ring is set up with raw
+*           system calls, without liburing. A write and the
+*           data sync after it are submitted together with
+*           one system call. Only available on Linux, setup
+*           fails on other systems.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef URING_FILE_HPP
+#define URING_FILE_HPP
+
+#include <cstddef>
+#include <stdint.h>
+
+using namespace std;
+
+/********************************************************
+* @class UringFile
+* @brief Class owns one io_uring submission and completion
+*        ring used by one thread. Each request waits for
+*        its completions before return.
+********************************************************/
+class UringFile {
+private:
+    int ringFd;             /* io_uring file descriptor, -1 if not set up */
+    void* sqRing;           /* Mapped submission ring */
+    size_t sqRingSize;      /* Size of submission ring mapping */
+    void* cqRing;           /* Mapped completion ring, same as sqRing if single mapping */
+    size_t cqRingSize;      /* Size of completion ring mapping */
+    void* sqes;             /* Mapped submission entries */
+    size_t sqesSize;        /* Size of submission entries mapping */
+
+    /* Fields of the mapped rings */
+    unsigned int* sqTail;
+    unsigned int* sqMask;
+    unsigned int* sqArray;
+    unsigned int* cqHead;
+    unsigned int* cqTail;
+    unsigned int* cqMask;
+    void* cqes;
+
+    /* Ring can not be copied */
+    UringFile(const UringFile&) = delete;
+    UringFile& operator=(const UringFile&) = delete;
+
+    /********************************************************
+    * @brief  Submit queued entries and wait for completions
+    * @param  count   Number of queued entries
+    * @return bool    Return true if all requests succeeded
+    ********************************************************/
+    bool submitAndWait(unsigned int count);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    UringFile();
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~UringFile();
+
+    /********************************************************
+    * @brief  Create the ring
+    * @param  entries     Size of submission ring
+    * @return bool        Return true if io_uring is available
+    ********************************************************/
+    bool setup(unsigned int entries);
+
+    /********************************************************
+    * @brief  Destroy the ring
+    * @param  None
+    * @return None
+    ********************************************************/
+    void close();
+
+    /********************************************************
+    * @brief  Write a buffer at an offset, then sync data if
+    *         requested, the sync runs only after the write
+    * @param  fd          File descriptor
+    * @param  data        Content to write
+    * @param  length      Number of bytes to write
+    * @param  offset      Offset in file
+    * @param  isSync      Sync data after the write
+    * @return bool        Return true if all bytes are written
+    *                     and synced
+    ********************************************************/
+    bool write(int fd, const char* data, size_t length, uint64_t offset, bool isSync);
+
+    /********************************************************
+    * @brief  Sync data of a file
+    * @param  fd      File descriptor
+    * @return bool    Return true if data is synced
+    ********************************************************/
+    bool sync(int fd);
+};
+
+#endif  /* URING_FILE_HPP */
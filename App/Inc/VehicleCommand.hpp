@@ -0,0 +1,154 @@
+/********************************************************
+* @file     VehicleCommand.hpp
+* @brief    Declare methods and classes related to driver
+*           commands
+* @details  This file contains class and methods declaration
+*           related to typed commands that change speed
+*           inputs, drive mode, climate, cruise control and
+*           trip. Keyboard, the control socket and scripts
+*           push commands into one queue from any thread, the
+*           control tick takes all queued commands in one
+*           batch and applies them in order. Commands are
+*           written as "KEY, value" lines like Database.csv.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef VEHICLE_COMMAND_HPP
+#define VEHICLE_COMMAND_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+#include "MpscQueue.hpp"
+
+using namespace std;
+
+/********************************************************
+* Queue limits
+********************************************************/
+#define COMMAND_QUEUE_SIZE      8192    /* Commands kept between 2 ticks */
+#define COMMAND_BATCH_SIZE      1024    /* Most commands applied in one tick */
+
+/********************************************************
+* @enum  CommandType
+* @brief This enum contains kinds of command, value of
+*        each kind is given in comment
+********************************************************/
+typedef enum {
+    COMMAND_ACCELERATOR,    /* "ACCELERATOR", 1 pressed, 0 released */
+    COMMAND_BRAKE,          /* "BRAKE", 1 pressed, 0 released */
+    COMMAND_DRIVE_MODE,     /* "DRIVE MODE", ECO or SPORT */
+    COMMAND_MODE_TOGGLE,    /* "MODE TOGGLE", value ignored */
+    COMMAND_AC_TEMP,        /* "AC TEMPERATURE", temperature (°C) */
+    COMMAND_AC_STEP,        /* "AC STEP", change of temperature (°C) */
+    COMMAND_WIND_LEVEL,     /* "WIND LEVEL", wind level */
+    COMMAND_WIND_STEP,      /* "WIND STEP", change of wind level */
+    COMMAND_CRUISE,         /* "CRUISE", 1 engage, 0 cancel */
+    COMMAND_CRUISE_TOGGLE,  /* "CRUISE TOGGLE", value ignored */
+    COMMAND_CRUISE_ADJUST,  /* "CRUISE ADJUST", change of set speed (km/h) */
+    COMMAND_TRIP_RESET,     /* "TRIP RESET", value ignored */
+    COMMAND_TYPE_COUNT
+} CommandType;
+
+/********************************************************
+* @enum  CommandSource
+* @brief This enum contains producers of commands
+********************************************************/
+typedef enum {
+    COMMAND_SOURCE_KEYBOARD,
+    COMMAND_SOURCE_SOCKET,
+    COMMAND_SOURCE_SCRIPT,
+    COMMAND_SOURCE_COUNT
+} CommandSource;
+
+/********************************************************
+* @struct VehicleCommand
+* @brief  One command and when it was pushed
+********************************************************/
+typedef struct {
+    CommandType type;       /* Kind of command */
+    int value;              /* Value, drive mode for COMMAND_DRIVE_MODE */
+    CommandSource source;   /* Producer */
+    uint64_t timestampNs;   /* Monotonic time of push (ns) */
+} VehicleCommand;
+
+/********************************************************
+* @brief  Parse one "KEY, value" command line, does not
+*         allocate memory
+* @param  line        Start of line
+* @param  end         End of line (without new line)
+* @param  type        Parsed kind of command
+* @param  value       Parsed value
+* @return bool        Return true if key is known and value
+*                     is valid
+********************************************************/
+bool parseCommand(const char* line, const char* end, CommandType& type, int& value);
+
+/********************************************************
+* @brief  Get key of a kind of command
+* @param  type        Kind of command
+* @return const char* Return key, "UNKNOWN" if type is
+*                     invalid
+********************************************************/
+const char* getCommandKey(CommandType type);
+
+/********************************************************
+* @class CommandQueue
+* @brief Class keeps commands from all producers until the
+*        control tick takes them. submit() may be called
+*        from any thread, drain() from the control tick
+*        only.
+********************************************************/
+class CommandQueue {
+private:
+    MpscQueue<VehicleCommand> queue;
+    atomic<unsigned long> submitted[COMMAND_SOURCE_COUNT];  /* Queued commands of each producer */
+    atomic<unsigned long> dropped;      /* Commands refused because queue was full */
+
+    /* Queue can not be copied */
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param capacity     Most commands kept at the same time
+    ********************************************************/
+    explicit CommandQueue(size_t capacity = COMMAND_QUEUE_SIZE);
+
+    /********************************************************
+    * @brief  Stamp a command with current time and queue it,
+    *         does not block and does not allocate memory
+    * @param  type    Kind of command
+    * @param  value   Value of command
+    * @param  source  Producer
+    * @return bool    Return false if queue is full
+    ********************************************************/
+    bool submit(CommandType type, int value, CommandSource source);
+
+    /********************************************************
+    * @brief  Take queued commands in order of submit
+    * @param  commands    Array for commands
+    * @param  maxCount    Size of array
+    * @return size_t      Return number of commands
+    ********************************************************/
+    size_t drain(VehicleCommand* commands, size_t maxCount);
+
+    /********************************************************
+    * @brief  Get number of queued commands of a producer
+    * @param  source  Producer
+    * @return unsigned long   Return number
+    ********************************************************/
+    unsigned long getSubmitted(CommandSource source) const;
+
+    /********************************************************
+    * @brief  Get number of commands refused because queue
+    *         was full
+    * @param  None
+    * @return unsigned long   Return number
+    ********************************************************/
+    unsigned long getDropped() const;
+};
+
+#endif  /* VEHICLE_COMMAND_HPP */
@@ -0,0 +1,238 @@
+/********************************************************
+* @file     VehiclePipeline.hpp
+* @brief    Declare methods and classes related to one
+*           control tick of the vehicle
+* @details  This file contains class and methods declaration
+*           related to the vehicle pipeline. One tick takes
+*           driver input, computes speed, drive mode, climate,
+*           battery level and range, then updates
+*           DashboardController. The keyboard task and the
+*           pipeline benchmark run the same tick, the keyboard
+*           task gives driver input as a batch of commands.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef VEHICLE_PIPELINE_HPP
+#define VEHICLE_PIPELINE_HPP
+
+#include "DashboardController.hpp"
+#include "BatteryManager.hpp"
+#include "DriveModeManager.hpp"
+#include "SpeedCalculator.hpp"
+#include "SafetyManager.hpp"
+#include "TripComputer.hpp"
+#include "VehicleProfile.hpp"
+#include "PerfStats.hpp"
+#include "ClimateAdvisor.hpp"
+#include "VehicleCommand.hpp"
+#include "FlightRecorder.hpp"
+#include "RuleEngine.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Limits of values changed by driver
+********************************************************/
+#define PIPELINE_AC_TEMP_MIN    16  /* Lowest AC temperature (°C) */
+#define PIPELINE_AC_TEMP_MAX    30  /* Highest AC temperature (°C) */
+#define PIPELINE_WIND_MIN       1   /* Lowest wind level set by driver */
+#define PIPELINE_WIND_MAX       5   /* Highest wind level */
+
+/********************************************************
+* @struct DriverInput
+* @brief  State of driver controls in one tick, true
+*         while the control is held
+********************************************************/
+typedef struct {
+    bool isAccelerating;    /* Accelerator is pressed */
+    bool isBraking;         /* Brake is pressed */
+    bool isModeToggled;     /* Drive mode toggles every tick while held */
+    bool isAcUp;            /* AC temperature up, once per press */
+    bool isAcDown;          /* AC temperature down, once per press */
+    bool isWindUp;          /* Wind level up, once per press */
+    bool isWindDown;        /* Wind level down, once per press */
+    bool isTripReset;       /* Reset trip, once per press */
+    bool isCruiseToggled;   /* Engage or cancel cruise control, once per press */
+    bool isCruiseUp;        /* Cruise set speed up, once per press */
+    bool isCruiseDown;      /* Cruise set speed down, once per press */
+} DriverInput;
+
+/********************************************************
+* @class VehiclePipeline
+* @brief Class runs one control tick over the managers
+*        given at construction, keeps values between ticks
+*        like the keyboard task did
+********************************************************/
+class VehiclePipeline {
+private:
+    DashboardController* dashboardController;
+    SpeedCalculator* speedCalculator;
+    DriveModeManager* driveMode;
+    SafetyManager* safetyManager;
+    BatteryManager* batteryManager;
+    TripComputer* tripComputer;
+    const VehicleProfileStore* profileStore;
+    unsigned long profileVersion; /* Version of parameter block applied to managers */
+
+    DriverInput previousInput;  /* Input of previous tick, to find new presses */
+    DriverInput commandInput;   /* Pedals held by commands */
+    int acTemp;                 /* AC temperature (°C) */
+    int windLevel;              /* Wind level */
+    int speed;                  /* Speed (km/h) */
+    DriveMode mode;             /* Drive mode */
+
+    /* Optional what-if advice of climate and speed */
+    ClimateAdvisor* climateAdvisor;
+
+    /* Optional record of last ticks for post-mortem */
+    FlightRecorder* flightRecorder;
+
+    /* Optional signals and alarms of each tick */
+    RuleEngine* ruleEngine;
+
+    /* Optional timing of stages */
+    PerfStats* perfStats;
+    int stageProfile;
+    int stageInput;
+    int stageBattery;
+    int stageTrip;
+    int stageAdvisor;
+    int stageController;
+    int stageRules;
+    int stageRecorder;
+
+    /********************************************************
+    * @brief  Record time and counters since last mark as
+    *         one stage
+    * @param  stage       Index of stage in perfStats
+    * @param  mark        Last mark, set to now
+    * @return None
+    ********************************************************/
+    void markStage(int stage, PerfMark& mark);
+
+    /********************************************************
+    * @brief  Run one tick, commands are applied in the input
+    *         stage before held controls
+    * @param  input       State of driver controls
+    * @param  commands    Commands to apply in order, may be NULL
+    * @param  count       Number of commands
+    * @return None
+    ********************************************************/
+    void runTick(const DriverInput& input, const VehicleCommand* commands, size_t count);
+
+public:
+    /********************************************************
+    * @brief Constructor
+    * @param dashboardController  Pointer to DashboardController object
+    * @param speedCalculator      Pointer to SpeedCalculator object
+    * @param driveMode            Pointer to DriveModeManager object
+    * @param safetyManager        Pointer to SafetyManager object
+    * @param batteryManager       Pointer to BatteryManager object
+    * @param tripComputer         Pointer to TripComputer object
+    * @param profileStore         Pointer to VehicleProfileStore object
+    *                             that publishes vehicle parameters
+    ********************************************************/
+    VehiclePipeline(DashboardController* dashboardController, SpeedCalculator* speedCalculator,
+        DriveModeManager* driveMode, SafetyManager* safetyManager, BatteryManager* batteryManager,
+        TripComputer* tripComputer, const VehicleProfileStore* profileStore);
+
+    /********************************************************
+    * @brief  Check all managers are given
+    * @param  None
+    * @return bool    Return false if a pointer is NULL
+    ********************************************************/
+    bool isValid() const;
+
+    /********************************************************
+    * @brief  Take initial values from DashboardController
+    * @param  None
+    * @return None
+    ********************************************************/
+    void start();
+
+    /********************************************************
+    * @brief  Run one 100 ms tick
+    * @param  input   State of driver controls
+    * @return None
+    ********************************************************/
+    void tick(const DriverInput& input);
+
+    /********************************************************
+    * @brief  Run one 100 ms tick with a batch of commands,
+    *         pedals stay as the last commands left them
+    * @param  commands    Commands to apply in order
+    * @param  count       Number of commands
+    * @return None
+    ********************************************************/
+    void tick(const VehicleCommand* commands, size_t count);
+
+    /********************************************************
+    * @brief  Apply one command at once
+    * @param  command     Command to apply
+    * @return None
+    ********************************************************/
+    void applyCommand(const VehicleCommand& command);
+
+    /********************************************************
+    * @brief  Time stages of each tick, registers the stages
+    * @param  stats   Pointer to PerfStats object, NULL stops
+    *                 timing
+    * @return None
+    ********************************************************/
+    void setPerfStats(PerfStats* stats);
+
+    /********************************************************
+    * @brief  Run climate advice each tick
+    * @param  advisor     Pointer to ClimateAdvisor object,
+    *                     NULL stops advice
+    * @return None
+    ********************************************************/
+    void setClimateAdvisor(ClimateAdvisor* advisor);
+
+    /********************************************************
+    * @brief  Record state, held controls and commands of
+    *         each tick
+    * @param  recorder    Pointer to FlightRecorder object,
+    *                     NULL stops recording
+    * @return None
+    ********************************************************/
+    void setFlightRecorder(FlightRecorder* recorder);
+
+    /********************************************************
+    * @brief  Evaluate signals and alarms each tick
+    * @param  engine      Pointer to RuleEngine object, NULL
+    *                     stops evaluation
+    * @return None
+    ********************************************************/
+    void setRuleEngine(RuleEngine* engine);
+};
+
+/********************************************************
+* @brief  Apply current vehicle parameters to managers
+* @param  profileStore        Pointer to VehicleProfileStore
+*                             object that publishes parameters
+* @param  speedCalculator     Pointer to SpeedCalculator object
+* @param  driveMode           Pointer to DriveModeManager object
+* @param  batteryManager      Pointer to BatteryManager object
+* @return unsigned long       Return version of applied block
+********************************************************/
+unsigned long applyVehicleProfile(const VehicleProfileStore* profileStore, SpeedCalculator* speedCalculator,
+    DriveModeManager* driveMode, BatteryManager* batteryManager);
+
+/********************************************************
+* @brief  Apply current vehicle parameters to managers if
+*         a new block was published
+* @param  profileStore        Pointer to VehicleProfileStore
+*                             object that publishes parameters
+* @param  speedCalculator     Pointer to SpeedCalculator object
+* @param  driveMode           Pointer to DriveModeManager object
+* @param  batteryManager      Pointer to BatteryManager object
+* @param  appliedVersion      Version applied before, set to
+*                             version of current block
+* @return bool                Return true if a block is applied
+********************************************************/
+bool updateVehicleProfile(const VehicleProfileStore* profileStore, SpeedCalculator* speedCalculator,
+    DriveModeManager* driveMode, BatteryManager* batteryManager, unsigned long& appliedVersion);
+
+#endif  /* VEHICLE_PIPELINE_HPP */
@@ -0,0 +1,139 @@
+/********************************************************
+* @file     VehicleProfile.hpp
+* @brief    Declare methods and classes related to vehicle
+*           profile
+* @details  This file contains parameters of a vehicle variant
+*           and the store that loads them from a profile file.
+*           Each load builds a new immutable parameter block
+*           and publishes it through RcuPointer, so the control
+*           loop reads parameters without locking while the
+*           file is reloaded.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef VEHICLE_PROFILE_HPP
+#define VEHICLE_PROFILE_HPP
+
+#include <string>
+#include <time.h>
+#include "RcuPointer.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Path of vehicle profile file
+********************************************************/
+#define VEHICLE_PROFILE_PATH        "./Data/VehicleProfile.csv"
+
+/********************************************************
+* @brief Period to check vehicle profile file for changes
+********************************************************/
+#define PROFILE_CHECK_PERIOD_MS     1000
+
+/********************************************************
+* Parameters used when profile file does not set them
+********************************************************/
+#define DEFAULT_BATTERY_CAPACITY    90.0    /* Maximum battery capacity (kWh) */
+#define DEFAULT_DRAIN_PER_KM        0.2     /* Battery consumption per kilometer (kWh/km) */
+#define DEFAULT_MAX_SPEED_SPORT     200     /* Maximum speed for Sport mode (km/h) */
+#define DEFAULT_MAX_SPEED_ECO       150     /* Maximum speed for Eco mode (km/h) */
+#define DEFAULT_POWER_OUTPUT_SPORT  300     /* Output power for Sport mode (kW) */
+#define DEFAULT_POWER_OUTPUT_ECO    220     /* Output power for Eco mode (kW) */
+#define DEFAULT_MAX_ECO_SPEED       150     /* Speed limit of Eco mode (km/h) */
+
+/********************************************************
+* @struct VehicleProfile
+* @brief  Parameters of one vehicle variant
+********************************************************/
+typedef struct {
+    double batteryCapacity; /* Maximum battery capacity (kWh) */
+    double drainPerKm;      /* Battery consumption per kilometer (kWh/km) */
+    int maxSpeedSport;      /* Maximum speed for Sport mode (km/h) */
+    int maxSpeedEco;        /* Maximum speed for Eco mode (km/h) */
+    int powerOutputSport;   /* Output power for Sport mode (kW) */
+    int powerOutputEco;     /* Output power for Eco mode (kW) */
+    int maxEcoSpeed;        /* Speed limit of Eco mode (km/h) */
+    unsigned long version;  /* Number of the published block, 0 for defaults */
+} VehicleProfile;
+
+/********************************************************
+* @brief  Get parameters used when profile file does not
+*         set them
+* @param  None
+* @return VehicleProfile  Return default parameters
+********************************************************/
+VehicleProfile getDefaultVehicleProfile();
+
+/********************************************************
+* @class VehicleProfileStore
+* @brief Class loads vehicle profile file and publishes
+*        the current parameter block. Readers never lock,
+*        a block stays valid while a Reader holds it.
+********************************************************/
+class VehicleProfileStore {
+private:
+    string path;                        /* Profile file */
+    RcuPointer<VehicleProfile> profile; /* Current parameter block */
+
+    bool hasFileState;      /* fileModifiedTime and fileSize are valid */
+    time_t fileModifiedTime;/* Modified time of the loaded file */
+    long long fileSize;     /* Size of the loaded file */
+    unsigned long publishCount; /* Blocks published by load */
+
+    /* Store can not be copied */
+    VehicleProfileStore(const VehicleProfileStore&) = delete;
+    VehicleProfileStore& operator=(const VehicleProfileStore&) = delete;
+
+    /********************************************************
+    * @brief  Parse profile file
+    * @param  result  Parameters read from file, starts from
+    *                 default parameters
+    * @return bool    Return true if file is valid
+    ********************************************************/
+    bool parse(VehicleProfile& result) const;
+
+public:
+    /********************************************************
+    * @class Reader
+    * @brief Class keeps the current parameter block alive
+    *        while it is in scope, must not be kept across
+    *        co_await
+    ********************************************************/
+    class Reader : public RcuPointer<VehicleProfile>::ReadGuard {
+    public:
+        /********************************************************
+        * @brief Constructor, start reading
+        ********************************************************/
+        explicit Reader(const VehicleProfileStore& store)
+            : RcuPointer<VehicleProfile>::ReadGuard(store.profile) {}
+    };
+
+    /********************************************************
+    * @brief Constructor, publishes default parameters
+    * @param path     Profile file
+    ********************************************************/
+    explicit VehicleProfileStore(const string& path);
+
+    /********************************************************
+    * @brief Destructor
+    ********************************************************/
+    ~VehicleProfileStore();
+
+    /********************************************************
+    * @brief  Load profile file and publish its parameters,
+    *         current parameters are kept if file is invalid
+    * @param  None
+    * @return bool    Return true if new parameters are published
+    ********************************************************/
+    bool load();
+
+    /********************************************************
+    * @brief  Load profile file if it changed since last load
+    * @param  None
+    * @return bool    Return true if new parameters are published
+    ********************************************************/
+    bool reloadIfChanged();
+};
+
+#endif  /* VEHICLE_PROFILE_HPP */
@@ -0,0 +1,153 @@
+/********************************************************
+* @file     WorkStealingDeque.hpp
+* @brief    Declare classes related to work stealing queue
+* @details  This file contains template class of a bounded
+*           Chase-Lev deque. The owner thread pushes and pops
+*           items at the bottom without locks, other threads
+*           steal the oldest item at the top with one
+*           compare-and-swap. Push, pop and steal never
+*           allocate memory.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#ifndef WORK_STEALING_DEQUE_HPP
+#define WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+/********************************************************
+* @brief Size of a cache line, top and bottom are kept on
+*        separate lines
+********************************************************/
+#define DEQUE_CACHE_LINE    64
+
+/********************************************************
+* @class WorkStealingDeque
+* @brief Class keeps up to capacity items of type T, the
+*        capacity is rounded up to a power of 2 when the
+*        deque is created. Bottom is written only by the
+*        owner, top is moved by thieves and by the owner
+*        when it takes the last item.
+********************************************************/
+template <typename T>
+class WorkStealingDeque {
+private:
+    static_assert(is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    alignas(DEQUE_CACHE_LINE) atomic<int64_t> top;      /* Oldest item, next to steal */
+    alignas(DEQUE_CACHE_LINE) atomic<int64_t> bottom;   /* Next free slot of the owner */
+    alignas(DEQUE_CACHE_LINE) vector<atomic<T> > items; /* Ring storage */
+    size_t mask;
+
+    /* Deque can not be copied */
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /********************************************************
+    * @brief  Round capacity up to a power of 2
+    * @param  capacity    Wanted capacity
+    * @return size_t      Return capacity, at least 1
+    ********************************************************/
+    static size_t roundCapacity(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+public:
+    /********************************************************
+    * @brief Constructor, deque is empty
+    * @param capacity     Most items kept at the same time
+    ********************************************************/
+    explicit WorkStealingDeque(size_t capacity)
+        : top(0), bottom(0), items(roundCapacity(capacity)), mask(roundCapacity(capacity) - 1) {}
+
+    /********************************************************
+    * @brief  Add an item at the bottom, called by the owner
+    *         only
+    * @param  item    Item to add
+    * @return bool    Return false if deque is full
+    ********************************************************/
+    bool push(const T& item) {
+        int64_t position = bottom.load(memory_order_relaxed);
+        if (position - top.load(memory_order_acquire) >= (int64_t)items.size()) {
+            return false;
+        }
+
+        items[position & mask].store(item, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(position + 1, memory_order_relaxed);
+        return true;
+    }
+
+    /********************************************************
+    * @brief  Remove newest item, called by the owner only
+    * @param  item    Removed item
+    * @return bool    Return false if deque is empty or a
+    *                 thief took the last item
+    ********************************************************/
+    bool pop(T& item) {
+        int64_t position = bottom.load(memory_order_relaxed) - 1;
+        bottom.store(position, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t oldest = top.load(memory_order_relaxed);
+
+        if (oldest > position) {
+            bottom.store(position + 1, memory_order_relaxed);
+            return false;
+        }
+
+        item = items[position & mask].load(memory_order_relaxed);
+        if (oldest < position) {
+            return true;
+        }
+
+        // Last item, race with thieves for it
+        bool isTaken = top.compare_exchange_strong(oldest, oldest + 1, memory_order_seq_cst,
+            memory_order_relaxed);
+        bottom.store(position + 1, memory_order_relaxed);
+        return isTaken;
+    }
+
+    /********************************************************
+    * @brief  Remove oldest item, called by any thread
+    * @param  item    Removed item
+    * @return bool    Return false if deque is empty or
+    *                 another thread took the item first
+    ********************************************************/
+    bool steal(T& item) {
+        int64_t oldest = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t position = bottom.load(memory_order_acquire);
+
+        if (oldest >= position) {
+            return false;
+        }
+
+        item = items[oldest & mask].load(memory_order_relaxed);
+        return top.compare_exchange_strong(oldest, oldest + 1, memory_order_seq_cst,
+            memory_order_relaxed);
+    }
+
+    /********************************************************
+    * @brief  Get number of items, only exact when no other
+    *         thread uses the deque
+    * @param  None
+    * @return size_t  Return number of items
+    ********************************************************/
+    size_t size() const {
+        int64_t count = bottom.load(memory_order_relaxed) - top.load(memory_order_relaxed);
+        return count > 0 ? (size_t)count : 0;
+    }
+};
+
+#endif  /* WORK_STEALING_DEQUE_HPP */
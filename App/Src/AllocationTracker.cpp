@@ -0,0 +1,238 @@
+/********************************************************
+* @file     AllocationTracker.cpp
+* @brief    Define methods related to heap allocation
+*           accounting
+* @details  This file contains methods definition related
+*           to allocation accounting, and the replacement of
+*           global operator new and delete when built with
+*           DASHBOARD_ALLOC_TRACKING.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "AllocationTracker.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Counters, updated from any thread
+********************************************************/
+static atomic<unsigned long> totalAllocations(0);
+static atomic<unsigned long> allocationsAfterInit(0);
+static atomic<bool> isInitDone(false);
+static atomic<bool> isAbortOnAllocation(false);
+
+/********************************************************
+* @brief    isEnabled
+* @details  This method checks if operator new is replaced
+*           in this build.
+* @param    None
+* @return   bool    Return true if allocations are counted
+********************************************************/
+bool AllocationTracker::isEnabled() {
+#ifdef DASHBOARD_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    markInitDone
+* @details  This method marks end of startup, allocations
+*           from now on are counted separately.
+* @param    abortOnAllocation   Stop the program at the
+*                               first allocation after init
+* @return   None
+********************************************************/
+void AllocationTracker::markInitDone(bool abortOnAllocation) {
+    allocationsAfterInit.store(0);
+    isAbortOnAllocation.store(abortOnAllocation);
+    isInitDone.store(true);
+}
+
+/********************************************************
+* @brief    getTotalAllocations
+* @details  This method gets number of allocations since
+*           program start.
+* @param    None
+* @return   unsigned long   Return number of allocations
+********************************************************/
+unsigned long AllocationTracker::getTotalAllocations() {
+    return totalAllocations.load();
+}
+
+/********************************************************
+* @brief    getAllocationsAfterInit
+* @details  This method gets number of allocations after
+*           markInitDone.
+* @param    None
+* @return   unsigned long   Return number of allocations
+********************************************************/
+unsigned long AllocationTracker::getAllocationsAfterInit() {
+    return allocationsAfterInit.load();
+}
+
+/********************************************************
+* @brief    recordAllocation
+* @details  This method counts one allocation. The message
+*           before abort is written without allocating.
+* @param    size    Requested size (bytes)
+* @return   None
+********************************************************/
+void AllocationTracker::recordAllocation(size_t size) {
+    totalAllocations.fetch_add(1, memory_order_relaxed);
+
+    if (!isInitDone.load(memory_order_relaxed)) {
+        return;
+    }
+    allocationsAfterInit.fetch_add(1, memory_order_relaxed);
+
+    if (isAbortOnAllocation.load(memory_order_relaxed)) {
+        fprintf(stderr, "Heap allocation of %lu bytes after init\n", (unsigned long)size);
+        abort();
+    }
+}
+
+#ifdef DASHBOARD_ALLOC_TRACKING
+
+/********************************************************
+* @brief    allocateAligned
+* @details  This function allocates memory for types with
+*           alignment above the default of operator new,
+*           size is rounded up to a multiple of alignment
+*           as aligned_alloc requires.
+* @param    size        Requested size (bytes)
+* @param    alignment   Alignment, power of 2 (bytes)
+* @return   void*       Return memory, NULL if out of memory
+********************************************************/
+static void* allocateAligned(size_t size, size_t alignment) {
+    size_t roundedSize = (size + alignment - 1) & ~(alignment - 1);
+    if (roundedSize == 0) {
+        roundedSize = alignment;
+    }
+#ifdef _WIN32
+    return _aligned_malloc(roundedSize, alignment);
+#else
+    return aligned_alloc(alignment, roundedSize);
+#endif
+}
+
+/********************************************************
+* @brief    freeAligned
+* @details  This function frees memory of allocateAligned.
+* @param    memory      Memory to free, may be NULL
+* @return   None
+********************************************************/
+static void freeAligned(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+/********************************************************
+* Global operator new and delete, other forms without
+* alignment call these
+********************************************************/
+void* operator new(size_t size) {
+    AllocationTracker::recordAllocation(size);
+
+    void* memory = malloc(size > 0 ? size : 1);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    AllocationTracker::recordAllocation(size);
+    return malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return operator new(size, nothrow);
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    free(memory);
+}
+
+/********************************************************
+* Aligned forms for types declared with alignas above the
+* default alignment (SpscQueue, MpscQueue, ...), the
+* library would serve them without the forms above
+********************************************************/
+void* operator new(size_t size, align_val_t alignment) {
+    AllocationTracker::recordAllocation(size);
+
+    void* memory = allocateAligned(size, (size_t)alignment);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size, align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    AllocationTracker::recordAllocation(size);
+    return allocateAligned(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return operator new(size, alignment, nothrow);
+}
+
+void operator delete(void* memory, align_val_t) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete[](void* memory, align_val_t) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete(void* memory, size_t, align_val_t) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete[](void* memory, size_t, align_val_t) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete(void* memory, align_val_t, const nothrow_t&) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete[](void* memory, align_val_t, const nothrow_t&) noexcept {
+    freeAligned(memory);
+}
+
+#endif  /* DASHBOARD_ALLOC_TRACKING */
@@ -0,0 +1,730 @@
+/********************************************************
+* @file     ArrowWriter.cpp
+* @brief    Define methods related to Apache Arrow IPC
+*           output of telemetry
+* @details  This file contains methods definition related to
+*           building flatbuffers, the schema and record batch
+*           messages, and writing the Arrow IPC stream and
+*           file formats.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "ArrowWriter.hpp"
+#include <bit>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+/********************************************************
+* @brief Values are written from memory as they are, the
+*        schema tells readers they are little endian
+********************************************************/
+static_assert(endian::native == endian::little, "Arrow output needs a little endian host");
+
+/********************************************************
+* Values of the Arrow flatbuffer schema (Schema.fbs,
+* Message.fbs, File.fbs)
+********************************************************/
+#define ARROW_METADATA_V5       4       /* MetadataVersion.V5 */
+#define ARROW_HEADER_SCHEMA     1       /* MessageHeader.Schema */
+#define ARROW_HEADER_BATCH      3       /* MessageHeader.RecordBatch */
+#define ARROW_TYPE_INT          2       /* Type.Int */
+#define ARROW_TYPE_FLOAT        3       /* Type.FloatingPoint */
+#define ARROW_TYPE_UTF8         5       /* Type.Utf8 */
+#define ARROW_TYPE_TIMESTAMP    10      /* Type.Timestamp */
+#define ARROW_PRECISION_DOUBLE  2       /* Precision.DOUBLE */
+#define ARROW_UNIT_MICROSECOND  2       /* TimeUnit.MICROSECOND */
+#define ARROW_CONTINUATION      0xFFFFFFFFu
+#define ARROW_MAGIC             "ARROW1"
+#define ARROW_MODE_TEXT_SIZE    5       /* Longest drive mode name */
+#define ARROW_BLOCK_WORDS       3       /* Words of a footer Block */
+
+/********************************************************
+* @enum  ArrowType
+* @brief This enum contains types of telemetry columns
+********************************************************/
+typedef enum {
+    ARROW_INT32,
+    ARROW_INT64,
+    ARROW_FLOAT64,
+    ARROW_TIMESTAMP_US,
+    ARROW_UTF8
+} ArrowType;
+
+/********************************************************
+* @enum  ArrowColumnIndex
+* @brief This enum contains telemetry columns, same order
+*        as arrowColumns
+********************************************************/
+typedef enum {
+    COLUMN_TICK,
+    COLUMN_TIMESTAMP,
+    COLUMN_MONOTONIC,
+    COLUMN_SPEED,
+    COLUMN_DRIVE_MODE,
+    COLUMN_BATTERY_LEVEL,
+    COLUMN_REMAINING_RANGE,
+    COLUMN_AC_TEMP,
+    COLUMN_WIND_LEVEL
+} ArrowColumnIndex;
+
+/********************************************************
+* @struct ArrowColumn
+* @brief  Name, type and value size of a column
+********************************************************/
+typedef struct {
+    const char* name;
+    ArrowType type;
+    size_t width;           /* Bytes of a value, of an offset for strings */
+} ArrowColumn;
+
+static const ArrowColumn arrowColumns[ARROW_COLUMN_COUNT] = {
+    { "tick", ARROW_INT64, 8 },
+    { "timestamp", ARROW_TIMESTAMP_US, 8 },
+    { "monotonic_ns", ARROW_INT64, 8 },
+    { "speed", ARROW_INT32, 4 },
+    { "drive_mode", ARROW_UTF8, 4 },
+    { "battery_level", ARROW_INT32, 4 },
+    { "remaining_range", ARROW_FLOAT64, 8 },
+    { "ac_temp", ARROW_INT32, 4 },
+    { "wind_level", ARROW_INT32, 4 }
+};
+
+/********************************************************
+* @brief Zero bytes of padding
+********************************************************/
+static const char zeroPadding[ARROW_ALIGNMENT] = {};
+
+/********************************************************
+* @brief    alignUp
+* @details  This function rounds a position up to a multiple
+*           of a power of 2.
+* @param    position    Position
+* @param    alignment   Power of 2
+* @return   size_t      Return rounded position
+********************************************************/
+static size_t alignUp(size_t position, size_t alignment) {
+    return (position + alignment - 1) & ~(alignment - 1);
+}
+
+/********************************************************
+* @brief    storeValue
+* @details  This function stores a value into a column
+*           buffer.
+* @param    column      Column buffer
+* @param    row         Index of row
+* @param    value       Value to store
+* @return   None
+********************************************************/
+template <typename T>
+static void storeValue(vector<uint8_t>& column, size_t row, T value) {
+    memcpy(column.data() + row * sizeof(T), &value, sizeof(T));
+}
+
+/********************************************************
+* @brief Constructor, the root offset is at position 0
+* @param data         Buffer, 8 byte aligned
+* @param capacity     Size of buffer
+********************************************************/
+FlatBuilder::FlatBuilder(uint8_t* data, size_t capacity)
+    : data(data), capacity(capacity), length(0), isOverflow(false) {
+    grow(sizeof(uint32_t));
+}
+
+/********************************************************
+* @brief    grow
+* @details  This method makes room up to an end position
+*           and zeroes the gap, which is padding.
+* @param    end     End of new content
+* @return   bool    Return false if buffer is too small
+********************************************************/
+bool FlatBuilder::grow(size_t end) {
+    if (isOverflow || end > capacity) {
+        isOverflow = true;
+        return false;
+    }
+    if (end > length) {
+        memset(data + length, 0, end - length);
+        length = end;
+    }
+    return true;
+}
+
+/********************************************************
+* @brief    addTable
+* @details  This method writes a vtable and its table right
+*           after it. Fields are placed from the largest to
+*           the smallest so each one is aligned to its size,
+*           offset fields are left zero.
+* @param    fields      Fields in order of the schema
+* @param    count       Number of fields
+* @param    positions   Position of each field, used for
+*                       offset fields
+* @return   size_t      Return position of table
+********************************************************/
+size_t FlatBuilder::addTable(const FlatField* fields, size_t count, size_t* positions) {
+    uint16_t offsets[16] = {};
+    if (count > sizeof(offsets) / sizeof(offsets[0])) {
+        isOverflow = true;
+        return 0;
+    }
+
+    // Table starts with offset to its vtable
+    size_t tableSize = sizeof(int32_t);
+    size_t tableAlignment = sizeof(int32_t);
+    for (size_t size = 8; size >= 1; size /= 2) {
+        for (size_t i = 0; i < count; i++) {
+            if (fields[i].size == size) {
+                tableSize = alignUp(tableSize, size);
+                offsets[i] = (uint16_t)tableSize;
+                tableSize += size;
+                tableAlignment = size > tableAlignment ? size : tableAlignment;
+            }
+        }
+    }
+
+    size_t vtableSize = 2 * sizeof(uint16_t) + count * sizeof(uint16_t);
+    size_t table = alignUp(length + vtableSize, tableAlignment);
+    size_t vtable = table - vtableSize;
+    if (!grow(table + tableSize)) {
+        return 0;
+    }
+
+    uint16_t header[2] = { (uint16_t)vtableSize, (uint16_t)tableSize };
+    memcpy(data + vtable, header, sizeof(header));
+    memcpy(data + vtable + sizeof(header), offsets, count * sizeof(uint16_t));
+
+    int32_t vtableOffset = (int32_t)(table - vtable);
+    memcpy(data + table, &vtableOffset, sizeof(vtableOffset));
+
+    for (size_t i = 0; i < count; i++) {
+        positions[i] = table + offsets[i];
+        if (fields[i].size > 0 && !fields[i].isOffset) {
+            memcpy(data + positions[i], &fields[i].value, fields[i].size);
+        }
+    }
+    return table;
+}
+
+/********************************************************
+* @brief    addString
+* @details  This method writes length, characters and the
+*           NUL that flatbuffers keep after a string.
+* @param    text        Text ended by NUL
+* @return   size_t      Return position of string
+********************************************************/
+size_t FlatBuilder::addString(const char* text) {
+    uint32_t textLength = (uint32_t)strlen(text);
+    size_t position = alignUp(length, sizeof(uint32_t));
+    if (!grow(position + sizeof(uint32_t) + textLength + 1)) {
+        return 0;
+    }
+
+    memcpy(data + position, &textLength, sizeof(textLength));
+    memcpy(data + position + sizeof(uint32_t), text, textLength);
+    return position;
+}
+
+/********************************************************
+* @brief    addStructVector
+* @details  This method writes count and structs, structs
+*           start at an 8 byte boundary.
+* @param    words       Words of all structs, may be NULL if
+*                       count is 0
+* @param    count       Number of structs
+* @param    wordsPerItem    Words of one struct
+* @return   size_t      Return position of vector
+********************************************************/
+size_t FlatBuilder::addStructVector(const uint64_t* words, size_t count, size_t wordsPerItem) {
+    size_t position = alignUp(length, sizeof(uint32_t));
+    if ((position + sizeof(uint32_t)) % sizeof(uint64_t) != 0) {
+        position += sizeof(uint32_t);
+    }
+    size_t bytes = count * wordsPerItem * sizeof(uint64_t);
+    if (!grow(position + sizeof(uint32_t) + bytes)) {
+        return 0;
+    }
+
+    uint32_t vectorLength = (uint32_t)count;
+    memcpy(data + position, &vectorLength, sizeof(vectorLength));
+    if (bytes > 0) {
+        memcpy(data + position + sizeof(uint32_t), words, bytes);
+    }
+    return position;
+}
+
+/********************************************************
+* @brief    addOffsetVector
+* @details  This method writes count and zero offsets.
+* @param    count       Number of offsets
+* @return   size_t      Return position of vector
+********************************************************/
+size_t FlatBuilder::addOffsetVector(size_t count) {
+    size_t position = alignUp(length, sizeof(uint32_t));
+    if (!grow(position + sizeof(uint32_t) * (count + 1))) {
+        return 0;
+    }
+
+    uint32_t vectorLength = (uint32_t)count;
+    memcpy(data + position, &vectorLength, sizeof(vectorLength));
+    return position;
+}
+
+/********************************************************
+* @brief    setOffset
+* @details  This method writes the distance from an offset
+*           field to its target.
+* @param    position    Position of offset
+* @param    target      Position of table, string or vector
+* @return   None
+********************************************************/
+void FlatBuilder::setOffset(size_t position, size_t target) {
+    if (isOverflow || target <= position) {
+        isOverflow = true;
+        return;
+    }
+
+    uint32_t offset = (uint32_t)(target - position);
+    memcpy(data + position, &offset, sizeof(offset));
+}
+
+/********************************************************
+* @brief    getLength
+* @details  This method gets size of the flatbuffer.
+* @param    None
+* @return   size_t      Return number of bytes
+********************************************************/
+size_t FlatBuilder::getLength() const {
+    return length;
+}
+
+/********************************************************
+* @brief    isValid
+* @details  This method checks that all content fit in the
+*           buffer.
+* @param    None
+* @return   bool        Return false if buffer was too small
+********************************************************/
+bool FlatBuilder::isValid() const {
+    return !isOverflow;
+}
+
+/********************************************************
+* @brief Constructor
+* @param batchRows    Rows of one record batch
+********************************************************/
+ArrowWriter::ArrowWriter(size_t batchRows)
+    : batchRows(batchRows > 0 ? batchRows : 1), rowCount(0), format(ARROW_FILE), fileOffset(0),
+      rows(0), batches(0) {}
+
+/********************************************************
+* @brief Destructor, closes file
+********************************************************/
+ArrowWriter::~ArrowWriter() {
+    close();
+}
+
+/********************************************************
+* @brief    getFormat
+* @details  This method selects stream format for a path
+*           ending with ARROW_STREAM_EXTENSION, file format
+*           otherwise.
+* @param    path        Output path
+* @return   ArrowFormat Return format
+********************************************************/
+ArrowFormat ArrowWriter::getFormat(const string& path) {
+    size_t extensionLength = sizeof(ARROW_STREAM_EXTENSION) - 1;
+    if (path.size() >= extensionLength
+        && path.compare(path.size() - extensionLength, extensionLength, ARROW_STREAM_EXTENSION) == 0) {
+        return ARROW_STREAM;
+    }
+    return ARROW_FILE;
+}
+
+/********************************************************
+* @brief    addSchema
+* @details  This method adds Schema table with one Field of
+*           each telemetry column. Columns have no nulls.
+* @param    builder     Flatbuffer under construction
+* @return   size_t      Return position of schema
+********************************************************/
+size_t ArrowWriter::addSchema(FlatBuilder& builder) {
+    // endianness (Little is default), fields
+    FlatField schemaFields[2] = { { 0, false, 0 }, { 4, true, 0 } };
+    size_t schemaPositions[2];
+    size_t schema = builder.addTable(schemaFields, 2, schemaPositions);
+
+    size_t fieldVector = builder.addOffsetVector(ARROW_COLUMN_COUNT);
+    builder.setOffset(schemaPositions[1], fieldVector);
+
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        const ArrowColumn& column = arrowColumns[i];
+        uint8_t typeId = column.type == ARROW_FLOAT64 ? ARROW_TYPE_FLOAT
+            : column.type == ARROW_UTF8 ? ARROW_TYPE_UTF8
+            : column.type == ARROW_TIMESTAMP_US ? ARROW_TYPE_TIMESTAMP : ARROW_TYPE_INT;
+
+        // name, nullable (false), type_type, type, dictionary, children
+        FlatField fieldFields[6] = {
+            { 4, true, 0 }, { 0, false, 0 }, { 1, false, typeId }, { 4, true, 0 }, { 0, false, 0 }, { 4, true, 0 }
+        };
+        size_t fieldPositions[6];
+        size_t field = builder.addTable(fieldFields, 6, fieldPositions);
+        builder.setOffset(fieldVector + sizeof(uint32_t) * (i + 1), field);
+        builder.setOffset(fieldPositions[0], builder.addString(column.name));
+
+        size_t type;
+        size_t typePositions[2];
+        if (column.type == ARROW_INT32 || column.type == ARROW_INT64) {
+            // bitWidth, is_signed
+            FlatField intFields[2] = { { 4, false, column.width * 8 }, { 1, false, 1 } };
+            type = builder.addTable(intFields, 2, typePositions);
+        } else if (column.type == ARROW_FLOAT64) {
+            // precision
+            FlatField floatFields[1] = { { 2, false, ARROW_PRECISION_DOUBLE } };
+            type = builder.addTable(floatFields, 1, typePositions);
+        } else if (column.type == ARROW_TIMESTAMP_US) {
+            // unit, timezone
+            FlatField timestampFields[2] = { { 2, false, ARROW_UNIT_MICROSECOND }, { 4, true, 0 } };
+            type = builder.addTable(timestampFields, 2, typePositions);
+            builder.setOffset(typePositions[1], builder.addString("UTC"));
+        } else {
+            type = builder.addTable(NULL, 0, typePositions);
+        }
+        builder.setOffset(fieldPositions[3], type);
+        builder.setOffset(fieldPositions[5], builder.addOffsetVector(0));
+    }
+
+    return schema;
+}
+
+/********************************************************
+* @brief    open
+* @details  This method allocates column buffers, creates the
+*           file, writes the magic of file format, then the
+*           schema message.
+* @param    path        Output path, replaced if it exists
+* @param    format      IPC format
+* @return   bool        Return false if file cannot be
+*                       written
+********************************************************/
+bool ArrowWriter::open(const string& path, ArrowFormat format) {
+    close();
+
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        // String column keeps one offset more than rows
+        size_t values = arrowColumns[i].type == ARROW_UTF8 ? batchRows + 1 : batchRows;
+        columns[i].assign(values * arrowColumns[i].width, 0);
+    }
+    modeText.resize(batchRows * ARROW_MODE_TEXT_SIZE);
+
+    // Footer lists all batches, room for it is kept now
+    blocks.reserve(ARROW_RESERVED_BATCHES * ARROW_BLOCK_WORDS);
+    metadata.resize(ARROW_METADATA_SIZE + ARROW_RESERVED_BATCHES * ARROW_BLOCK_WORDS * sizeof(uint64_t));
+
+    file.open(path.c_str(), ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        cerr << "Failed to open " << path << " for writing." << endl;
+        return false;
+    }
+
+    this->format = format;
+    fileOffset = 0;
+    rowCount = 0;
+    rows = 0;
+    batches = 0;
+    blocks.clear();
+
+    // Magic is padded to 8 bytes
+    if (format == ARROW_FILE) {
+        char magic[8] = ARROW_MAGIC;
+        writeBytes(magic, sizeof(magic));
+    }
+
+    // version, header_type, header, bodyLength
+    FlatBuilder builder(metadata.data(), ARROW_METADATA_SIZE);
+    FlatField messageFields[4] = {
+        { 2, false, ARROW_METADATA_V5 }, { 1, false, ARROW_HEADER_SCHEMA }, { 4, true, 0 }, { 8, false, 0 }
+    };
+    size_t messagePositions[4];
+    builder.setOffset(0, builder.addTable(messageFields, 4, messagePositions));
+    builder.setOffset(messagePositions[2], addSchema(builder));
+
+    uint32_t metaDataLength;
+    if (!builder.isValid() || !writeMetadata(builder.getLength(), metaDataLength)) {
+        cerr << "Failed to write schema to " << path << endl;
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+/********************************************************
+* @brief    append
+* @details  This method stores one row into the column
+*           buffers, then writes the batch if it is full.
+* @param    row         Row to add
+* @return   bool        Return false if writing failed
+********************************************************/
+bool ArrowWriter::append(const TelemetryRow& row) {
+    if (!file.is_open()) {
+        return false;
+    }
+
+    size_t index = rowCount;
+    storeValue(columns[COLUMN_TICK], index, (int64_t)row.tick);
+    storeValue(columns[COLUMN_TIMESTAMP], index, row.timestampUs);
+    storeValue(columns[COLUMN_MONOTONIC], index, (int64_t)row.monotonicNs);
+    storeValue(columns[COLUMN_SPEED], index, (int32_t)row.state.speed);
+    storeValue(columns[COLUMN_BATTERY_LEVEL], index, (int32_t)row.state.batteryLevel);
+    storeValue(columns[COLUMN_REMAINING_RANGE], index, row.state.remainingRange);
+    storeValue(columns[COLUMN_AC_TEMP], index, (int32_t)row.state.acTemp);
+    storeValue(columns[COLUMN_WIND_LEVEL], index, (int32_t)row.state.windLevel);
+
+    // Offsets of string column, value i is text[offset i, offset i + 1)
+    int32_t textStart;
+    memcpy(&textStart, columns[COLUMN_DRIVE_MODE].data() + index * sizeof(int32_t), sizeof(textStart));
+    const char* mode = row.state.driveMode == SPORT ? "SPORT" : "ECO";
+    size_t modeLength = strlen(mode);
+    memcpy(modeText.data() + textStart, mode, modeLength);
+    storeValue(columns[COLUMN_DRIVE_MODE], index + 1, (int32_t)(textStart + modeLength));
+
+    rowCount++;
+    if (rowCount < batchRows) {
+        return true;
+    }
+    return flush();
+}
+
+/********************************************************
+* @brief    flush
+* @details  This method writes the record batch message of
+*           current rows. Each column has an empty validity
+*           buffer (no nulls) and its values, the string
+*           column has offsets and characters. Buffers start
+*           at ARROW_ALIGNMENT in the body.
+* @param    None
+* @return   bool        Return false if writing failed
+********************************************************/
+bool ArrowWriter::flush() {
+    if (!file.is_open()) {
+        return false;
+    }
+    if (rowCount == 0) {
+        return true;
+    }
+
+#ifdef DASHBOARD_STATIC_ALLOC
+    // Footer index can not grow without heap
+    if (blocks.size() + ARROW_BLOCK_WORDS > blocks.capacity()) {
+        cerr << "Arrow file has " << ARROW_RESERVED_BATCHES << " batches, rows are dropped" << endl;
+        rowCount = 0;
+        return false;
+    }
+#endif
+
+    // Body layout, 3 buffers of string column and 2 of others
+    const uint8_t* bufferData[ARROW_COLUMN_COUNT * 3];
+    uint64_t bufferWords[ARROW_COLUMN_COUNT * 3 * 2];
+    uint64_t nodeWords[ARROW_COLUMN_COUNT * 2];
+    size_t bufferCount = 0;
+    uint64_t bodyLength = 0;
+
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        nodeWords[i * 2] = rowCount;
+        nodeWords[i * 2 + 1] = 0;
+
+        // Validity bitmap is left out
+        bufferData[bufferCount] = NULL;
+        bufferWords[bufferCount * 2] = bodyLength;
+        bufferWords[bufferCount * 2 + 1] = 0;
+        bufferCount++;
+
+        size_t valueLength = rowCount * arrowColumns[i].width;
+        if (arrowColumns[i].type == ARROW_UTF8) {
+            valueLength += arrowColumns[i].width;
+        }
+        bufferData[bufferCount] = columns[i].data();
+        bufferWords[bufferCount * 2] = bodyLength;
+        bufferWords[bufferCount * 2 + 1] = valueLength;
+        bodyLength = alignUp(bodyLength + valueLength, ARROW_ALIGNMENT);
+        bufferCount++;
+
+        if (arrowColumns[i].type == ARROW_UTF8) {
+            int32_t textLength;
+            memcpy(&textLength, columns[i].data() + rowCount * sizeof(int32_t), sizeof(textLength));
+            bufferData[bufferCount] = (const uint8_t*)modeText.data();
+            bufferWords[bufferCount * 2] = bodyLength;
+            bufferWords[bufferCount * 2 + 1] = (uint64_t)textLength;
+            bodyLength = alignUp(bodyLength + (uint64_t)textLength, ARROW_ALIGNMENT);
+            bufferCount++;
+        }
+    }
+
+    // version, header_type, header, bodyLength
+    FlatBuilder builder(metadata.data(), ARROW_METADATA_SIZE);
+    FlatField messageFields[4] = {
+        { 2, false, ARROW_METADATA_V5 }, { 1, false, ARROW_HEADER_BATCH }, { 4, true, 0 }, { 8, false, bodyLength }
+    };
+    size_t messagePositions[4];
+    builder.setOffset(0, builder.addTable(messageFields, 4, messagePositions));
+
+    // length, nodes, buffers
+    FlatField batchFields[3] = { { 8, false, rowCount }, { 4, true, 0 }, { 4, true, 0 } };
+    size_t batchPositions[3];
+    builder.setOffset(messagePositions[2], builder.addTable(batchFields, 3, batchPositions));
+    builder.setOffset(batchPositions[1], builder.addStructVector(nodeWords, ARROW_COLUMN_COUNT, 2));
+    builder.setOffset(batchPositions[2], builder.addStructVector(bufferWords, bufferCount, 2));
+
+    uint64_t messageOffset = fileOffset;
+    uint32_t metaDataLength;
+    if (!builder.isValid() || !writeMetadata(builder.getLength(), metaDataLength)) {
+        rowCount = 0;
+        return false;
+    }
+
+    uint64_t written = 0;
+    for (size_t i = 0; i < bufferCount; i++) {
+        uint64_t offset = bufferWords[i * 2];
+        uint64_t length = bufferWords[i * 2 + 1];
+        if (offset > written) {
+            writeBytes(zeroPadding, (size_t)(offset - written));
+        }
+        if (length > 0) {
+            writeBytes(bufferData[i], (size_t)length);
+        }
+        written = offset + length;
+    }
+    writeBytes(zeroPadding, (size_t)(bodyLength - written));
+
+    blocks.push_back(messageOffset);
+    blocks.push_back(metaDataLength);
+    blocks.push_back(bodyLength);
+    rows += rowCount;
+    batches++;
+    rowCount = 0;
+    return file.good();
+}
+
+/********************************************************
+* @brief    close
+* @details  This method writes the last batch and the end of
+*           stream marker. File format adds the footer, a
+*           copy of the schema and the place of each batch,
+*           followed by its length and the magic.
+* @param    None
+* @return   bool        Return false if writing failed
+********************************************************/
+bool ArrowWriter::close() {
+    if (!file.is_open()) {
+        return true;
+    }
+
+    bool isWritten = flush();
+
+    uint32_t endOfStream[2] = { ARROW_CONTINUATION, 0 };
+    writeBytes(endOfStream, sizeof(endOfStream));
+
+    if (format == ARROW_FILE) {
+        size_t batchCount = blocks.size() / ARROW_BLOCK_WORDS;
+        size_t footerSize = ARROW_METADATA_SIZE + blocks.size() * sizeof(uint64_t);
+        if (metadata.size() < footerSize) {
+            metadata.resize(footerSize);
+        }
+
+        // version, schema, dictionaries, recordBatches
+        FlatBuilder builder(metadata.data(), metadata.size());
+        FlatField footerFields[4] = { { 2, false, ARROW_METADATA_V5 }, { 4, true, 0 }, { 4, true, 0 }, { 4, true, 0 } };
+        size_t footerPositions[4];
+        builder.setOffset(0, builder.addTable(footerFields, 4, footerPositions));
+        builder.setOffset(footerPositions[1], addSchema(builder));
+        builder.setOffset(footerPositions[2], builder.addStructVector(NULL, 0, ARROW_BLOCK_WORDS));
+        builder.setOffset(footerPositions[3], builder.addStructVector(blocks.data(), batchCount, ARROW_BLOCK_WORDS));
+
+        if (builder.isValid()) {
+            int32_t footerLength = (int32_t)builder.getLength();
+            writeBytes(metadata.data(), builder.getLength());
+            writeBytes(&footerLength, sizeof(footerLength));
+            writeBytes(ARROW_MAGIC, sizeof(ARROW_MAGIC) - 1);
+        } else {
+            isWritten = false;
+        }
+    }
+
+    file.close();
+    isWritten = isWritten && !file.fail();
+    if (!isWritten) {
+        cerr << "Failed to write Arrow file" << endl;
+    }
+    return isWritten;
+}
+
+/********************************************************
+* @brief    writeBytes
+* @details  This method writes bytes and adds them to the
+*           file offset.
+* @param    bytes       Content to write
+* @param    length      Number of bytes
+* @return   None
+********************************************************/
+void ArrowWriter::writeBytes(const void* bytes, size_t length) {
+    file.write(static_cast<const char*>(bytes), (streamsize)length);
+    fileOffset += length;
+}
+
+/********************************************************
+* @brief    writeMetadata
+* @details  This method writes continuation marker, length
+*           and the flatbuffer in metadata. Metadata is padded
+*           so the body that follows starts at a multiple of
+*           ARROW_ALIGNMENT in the file.
+* @param    length      Length of flatbuffer in metadata
+* @param    metaDataLength  Length of prefix and padded
+*                       metadata
+* @return   bool        Return false if a write failed
+********************************************************/
+bool ArrowWriter::writeMetadata(size_t length, uint32_t& metaDataLength) {
+    size_t prefixLength = 2 * sizeof(uint32_t);
+    size_t paddedLength = alignUp(fileOffset + prefixLength + length, ARROW_ALIGNMENT) - fileOffset - prefixLength;
+
+    uint32_t prefix[2] = { ARROW_CONTINUATION, (uint32_t)paddedLength };
+    writeBytes(prefix, sizeof(prefix));
+    writeBytes(metadata.data(), length);
+    writeBytes(zeroPadding, paddedLength - length);
+
+    metaDataLength = (uint32_t)(prefixLength + paddedLength);
+    return file.good();
+}
+
+/********************************************************
+* @brief    getRows
+* @details  This method gets number of rows written in
+*           batches.
+* @param    None
+* @return   uint64_t    Return number
+********************************************************/
+uint64_t ArrowWriter::getRows() const {
+    return rows;
+}
+
+/********************************************************
+* @brief    getBatches
+* @details  This method gets number of record batches
+*           written.
+* @param    None
+* @return   uint64_t    Return number
+********************************************************/
+uint64_t ArrowWriter::getBatches() const {
+    return batches;
+}
+
+/********************************************************
+* @brief    getBytes
+* @details  This method gets number of bytes written.
+* @param    None
+* @return   uint64_t    Return number
+********************************************************/
+uint64_t ArrowWriter::getBytes() const {
+    return fileOffset;
+}
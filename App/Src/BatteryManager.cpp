@@ -5,6 +5,8 @@
 * @details  This file contains methods definition related 
 *           to battery management, includes calculate drain,
 *           calculate remaining range, update battery level.
+*           Methods are instantiated for double and fixed-point
+*           numbers at the end of this file.
 * @version  1.0
 * @date     2024-11-10
 * @author   Tran Quang Khai
@@ -16,12 +18,28 @@ using namespace std;
 /********************************************************
 * @brief Constructor
 ********************************************************/
-BatteryManager::BatteryManager() : batteryLevel(100), batteryCapacity(90), drainPerKm(0.2) {}
+template <typename Num>
+BasicBatteryManager<Num>::BasicBatteryManager() : batteryLevel(100), batteryCapacity(DEFAULT_BATTERY_CAPACITY),
+    drainPerKm(DEFAULT_DRAIN_PER_KM), pack(NULL) {}
 
 /********************************************************
 * @brief Destructor
 ********************************************************/
-BatteryManager::~BatteryManager() {}
+template <typename Num>
+BasicBatteryManager<Num>::~BasicBatteryManager() {}
+
+/********************************************************
+* @brief    applyProfile
+* @details  This method applies battery parameters of
+*           vehicle profile, battery level is kept.
+* @param    profile     Parameters of vehicle variant
+* @return   None
+********************************************************/
+template <typename Num>
+void BasicBatteryManager<Num>::applyProfile(const VehicleProfile& profile) {
+    batteryCapacity = Num(profile.batteryCapacity);
+    drainPerKm = Num(profile.drainPerKm);
+}
 
 /********************************************************
 * @brief    calculateBatteryDrain
@@ -30,20 +48,24 @@ BatteryManager::~BatteryManager() {}
 * @param    speed       Current speed
 * @param    acLevel     Current AC temperature
 * @param    windLevel   Current wind level
-* @return   double  Total drain per 1 second
+* @return   Num     Total drain per 1 second
 ********************************************************/
-double BatteryManager::calculateBatteryDrain(int speed, int acLevel, int windLevel) {
+template <typename Num>
+Num BasicBatteryManager<Num>::calculateBatteryDrain(int speed, int acLevel, int windLevel) const {
+    // Factors are written as integer ratios, fixed-point
+    // numbers divide by an integer without scaling
+
     // Basic drain
-    double baseDrain = drainPerKm; 
+    Num baseDrain = drainPerKm; 
 
     // Drain related to speed
-    double speedFactor = 1.0 + (speed / 100.0); 
+    Num speedFactor = Num(100 + speed) / 100; 
 
      // Drain related to AC, increase 5% if increase AC temperature 1 °C
-    double acFactor = 1.0 + ((acLevel - 15) * 0.05);    
+    Num acFactor = Num(20 + (acLevel - 15)) / 20;    
 
     // Drain related to wind level, increase 2% if  increase wind 1 level  
-    double windFactor = 1.0 + (windLevel * 0.02);   
+    Num windFactor = Num(50 + windLevel) / 50;   
 
     // Total drain per 1 second
     return baseDrain * speedFactor * acFactor * windFactor;
@@ -54,14 +76,15 @@ double BatteryManager::calculateBatteryDrain(int speed, int acLevel, int windLev
 * @details  This method predicts ramaining range base on
 *           battery level and battery drain.
 * @param    None
-* @return   double  Predicted remaining range 
+* @return   Num     Predicted remaining range 
 ********************************************************/
-double BatteryManager::calculateRamainingRange() const {
-    if (drainPerKm <= 0) {
-        return 0.0;
+template <typename Num>
+Num BasicBatteryManager<Num>::calculateRamainingRange() const {
+    if (drainPerKm <= Num(0)) {
+        return Num(0);
     } 
 
-    return (batteryLevel / 100.0) * (batteryCapacity / drainPerKm);
+    return (batteryLevel / 100) * (batteryCapacity / drainPerKm);
 }
 
 /********************************************************
@@ -73,11 +96,21 @@ double BatteryManager::calculateRamainingRange() const {
 * @param    windLevel   Current wind level
 * @return   None
 ********************************************************/
-void BatteryManager::updateBatteryLevel(int speed, int acLevel, int windLevel) {
-    double drainPerSecond = calculateBatteryDrain(speed, acLevel, windLevel);
+template <typename Num>
+void BasicBatteryManager<Num>::updateBatteryLevel(int speed, int acLevel, int windLevel) {
+    Num drainPerSecond = calculateBatteryDrain(speed, acLevel, windLevel);
 
-    // Decrease battery level per 100 ms, battery level alway >= 0
-    batteryLevel = max(0.0, batteryLevel - drainPerSecond * 0.1);   
+    // Pack is empty when its weakest cell is empty
+    if (pack) {
+        pack->update(numericToDouble(drainPerSecond), 1.0 / BATTERY_TICKS_PER_SECOND);
+        batteryLevel = Num(pack->getPackSoc());
+        return;
+    }
+
+    // Decrease battery level per 100 ms, fraction of 1 % is
+    // kept so small drains add up, battery level alway >= 0
+    Num drainPerTick = drainPerSecond / BATTERY_TICKS_PER_SECOND;
+    batteryLevel = (batteryLevel > drainPerTick) ? batteryLevel - drainPerTick : Num(0);
 }
 
 /********************************************************
@@ -86,6 +119,60 @@ void BatteryManager::updateBatteryLevel(int speed, int acLevel, int windLevel) {
 * @param    None
 * @return   int     Return current battery level
 ********************************************************/
-int BatteryManager::getBatteryLevel() const {
+template <typename Num>
+int BasicBatteryManager<Num>::getBatteryLevel() const {
+    return numericToInt(batteryLevel);
+}
+
+/********************************************************
+* @brief    getStateOfCharge
+* @details  This method gets current battery level with
+*           fraction of 1 %.
+* @param    None
+* @return   Num     Return current battery level (%)
+********************************************************/
+template <typename Num>
+Num BasicBatteryManager<Num>::getStateOfCharge() const {
     return batteryLevel;
-}
\ No newline at end of file
+}
+
+/********************************************************
+* @brief    getBatteryCapacity
+* @details  This method gets maximum battery capacity.
+* @param    None
+* @return   Num     Return battery capacity (kWh)
+********************************************************/
+template <typename Num>
+Num BasicBatteryManager<Num>::getBatteryCapacity() const {
+    return batteryCapacity;
+}
+
+/********************************************************
+* @brief    attachPack
+* @details  This method sets cell level pack model, battery
+*           level is updated from its weakest cell.
+* @param    pack    Pointer to pack model, NULL to stop using it
+* @return   None
+********************************************************/
+template <typename Num>
+void BasicBatteryManager<Num>::attachPack(BatteryPack* pack) {
+    this->pack = pack;
+}
+
+/********************************************************
+* @brief    getPack
+* @details  This method gets cell level pack model.
+* @param    None
+* @return   const BatteryPack*  Return pack model, NULL if not used
+********************************************************/
+template <typename Num>
+const BatteryPack* BasicBatteryManager<Num>::getPack() const {
+    return pack;
+}
+
+/********************************************************
+* Numeric types of the battery model
+********************************************************/
+template class BasicBatteryManager<double>;
+template class BasicBatteryManager<Q16_16>;
+template class BasicBatteryManager<Q32_32>;
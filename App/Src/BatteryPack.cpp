@@ -0,0 +1,307 @@
+/********************************************************
+* @file     BatteryPack.cpp
+* @brief    Define methods related to cell level battery
+*           pack model
+* @details  This file contains methods definition related
+*           to battery pack model, includes build cells with
+*           manufacturing spread, share current across cells,
+*           update state of charge and temperature, and pack
+*           statistics.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "BatteryPack.hpp"
+#include <cstdlib>
+#include <stdint.h>
+
+using namespace std;
+
+/********************************************************
+* @brief Added to group conductance so padding lanes, which
+*        have no conductance, get no current
+********************************************************/
+static const float MIN_GROUP_CONDUCTANCE = 1e-30f;
+
+/********************************************************
+* @brief    spread
+* @details  This function returns a repeatable pseudo random
+*           value in [-1, 1], the pack is the same at every
+*           start.
+* @param    state   Generator state
+* @return   float   Random value
+********************************************************/
+static float spread(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+/********************************************************
+* @brief    splat
+* @details  This function fills all lanes with one value.
+* @param    value   Value of lanes
+* @return   Lanes   Vector of value
+********************************************************/
+static inline BatteryPack::Lanes splat(float value) {
+    BatteryPack::Lanes lanes = { value, value, value, value };
+    return lanes;
+}
+
+/********************************************************
+* @brief Constructor
+* @param series           Number of series groups
+* @param parallel         Cells in each group
+* @param capacityKwh      Nominal pack energy (kWh)
+********************************************************/
+BatteryPack::BatteryPack(unsigned int series, unsigned int parallel, double capacityKwh)
+    : series(series > 0 ? series : 1), parallel(parallel > 0 ? parallel : 1) {
+    blocks = (this->series + PACK_LANES - 1) / PACK_LANES;
+    size_t vectors = (size_t)blocks * this->parallel;
+
+    soc.assign(vectors, splat(100.0f));
+    capacity.assign(vectors, splat(1.0f));
+    resistance.assign(vectors, splat(0.0f));
+    temperature.assign(vectors, splat((float)CELL_REFERENCE_TEMPERATURE));
+    current.assign(vectors, splat(0.0f));
+    groupConductance.assign(blocks, splat(0.0f));
+
+    // Charge of the series string (A.s)
+    packCapacity = capacityKwh * 1000.0 * 3600.0 / (this->series * CELL_NOMINAL_VOLTAGE);
+    double cellCapacity = packCapacity / this->parallel;
+
+    // Real cells get manufacturing spread, padding lanes keep
+    // zero resistance which marks them as not connected
+    uint32_t state = 12345u;
+    for (unsigned int row = 0; row < this->parallel; row++) {
+        for (unsigned int group = 0; group < this->series; group++) {
+            Lanes& cap = capacity[row * blocks + group / PACK_LANES];
+            Lanes& res = resistance[row * blocks + group / PACK_LANES];
+            unsigned int lane = group % PACK_LANES;
+
+            cap[lane] = (float)(cellCapacity * (1.0 + CELL_CAPACITY_SPREAD * spread(state)));
+            res[lane] = (float)(CELL_INTERNAL_RESISTANCE * (1.0 + CELL_RESISTANCE_SPREAD * spread(state)));
+        }
+    }
+
+    updateStatistics();
+}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+BatteryPack::~BatteryPack() {}
+
+/********************************************************
+* @brief    parseLayout
+* @details  This method parses pack layout such as "96s4p".
+* @param    text        Layout text
+* @param    series      Number of series groups
+* @param    parallel    Cells in each group
+* @return   bool        Return true if layout is valid
+********************************************************/
+bool BatteryPack::parseLayout(const string& text, unsigned int& series, unsigned int& parallel) {
+    const char* p = text.c_str();
+    char* end;
+
+    unsigned long s = strtoul(p, &end, 10);
+    if (end == p || (*end != 's' && *end != 'S')) {
+        return false;
+    }
+
+    p = end + 1;
+    unsigned long q = strtoul(p, &end, 10);
+    if (end == p || (*end != 'p' && *end != 'P') || end[1] != '\0') {
+        return false;
+    }
+
+    if (s == 0 || q == 0 || s * q > 100000) {
+        return false;
+    }
+
+    series = (unsigned int)s;
+    parallel = (unsigned int)q;
+    return true;
+}
+
+/********************************************************
+* @brief    update
+* @details  This method drains the pack for one tick. The
+*           string current is shared by the cells of each
+*           group in proportion to their conductance, which
+*           falls when a cell is cold. Each cell loses charge
+*           for its current and heats with I^2 R.
+* @param    drainPerSecond  Pack drain per 1 second from
+*                           BatteryManager (% of pack)
+* @param    dt              Length of tick (s)
+* @return   None
+********************************************************/
+void BatteryPack::update(double drainPerSecond, double dt) {
+    if (dt <= 0.0) {
+        return;
+    }
+
+    const size_t vectors = soc.size();
+    const Lanes zero = splat(0.0f);
+    const Lanes one = splat(1.0f);
+    const Lanes minFactor = splat(0.5f);
+    const Lanes tempCoeff = splat((float)CELL_RESISTANCE_TEMP_COEFF);
+    const Lanes reference = splat((float)CELL_REFERENCE_TEMPERATURE);
+
+    // Conductance of each cell at its temperature, kept in current
+    for (size_t i = 0; i < vectors; i++) {
+        Lanes factor = one + tempCoeff * (reference - temperature[i]);
+        factor = (factor < minFactor) ? minFactor : factor;
+        Lanes r = resistance[i] * factor;
+
+        // Padding lanes have no resistance and no conductance
+        auto isCell = r > zero;
+        current[i] = isCell ? one / (isCell ? r : one) : zero;
+    }
+
+    // Sum of conductance of each group
+    for (unsigned int b = 0; b < blocks; b++) {
+        Lanes sum = splat(MIN_GROUP_CONDUCTANCE);
+        for (unsigned int row = 0; row < parallel; row++) {
+            sum += current[row * blocks + b];
+        }
+        groupConductance[b] = sum;
+    }
+
+    // Share string current, drain charge and heat cells
+    const Lanes stringCurrent = splat((float)(drainPerSecond / 100.0 * packCapacity));
+    const Lanes step = splat((float)dt);
+    const Lanes percent = splat(100.0f);
+    const Lanes heatStep = splat((float)(dt / CELL_HEAT_CAPACITY));
+    const Lanes coolStep = splat((float)(CELL_COOLING_RATE * dt));
+
+    for (unsigned int row = 0; row < parallel; row++) {
+        for (unsigned int b = 0; b < blocks; b++) {
+            size_t i = (size_t)row * blocks + b;
+            Lanes conductance = current[i];
+            Lanes cellCurrent = stringCurrent * conductance / groupConductance[b];
+
+            Lanes next = soc[i] - cellCurrent * step / capacity[i] * percent;
+            soc[i] = (next < zero) ? zero : next;
+
+            // I^2 R heating, R = 1 / conductance
+            auto isCell = conductance > zero;
+            Lanes heat = isCell ? cellCurrent * cellCurrent / (isCell ? conductance : one) : zero;
+            temperature[i] += heat * heatStep - (temperature[i] - reference) * coolStep;
+
+            current[i] = cellCurrent;
+        }
+    }
+
+    updateStatistics();
+}
+
+/********************************************************
+* @brief    updateStatistics
+* @details  This method finds weakest, strongest and hottest
+*           cell and mean state of charge, padding lanes are
+*           skipped.
+* @param    None
+* @return   None
+********************************************************/
+void BatteryPack::updateStatistics() {
+    const Lanes zero = splat(0.0f);
+    Lanes low = splat(1e30f);
+    Lanes high = splat(-1e30f);
+    Lanes hot = splat(-1e30f);
+    Lanes sum = zero;
+
+    for (size_t i = 0; i < soc.size(); i++) {
+        // Real cells have resistance
+        auto isCell = resistance[i] > zero;
+        Lanes value = soc[i];
+
+        low = (isCell & (value < low)) ? value : low;
+        high = (isCell & (value > high)) ? value : high;
+        hot = (isCell & (temperature[i] > hot)) ? temperature[i] : hot;
+        sum += isCell ? value : zero;
+    }
+
+    minSoc = low[0];
+    maxSoc = high[0];
+    maxTemperature = hot[0];
+    double total = 0.0;
+    for (unsigned int lane = 0; lane < PACK_LANES; lane++) {
+        if (low[lane] < minSoc) {
+            minSoc = low[lane];
+        }
+        if (high[lane] > maxSoc) {
+            maxSoc = high[lane];
+        }
+        if (hot[lane] > maxTemperature) {
+            maxTemperature = hot[lane];
+        }
+        total += sum[lane];
+    }
+    meanSoc = total / getCellCount();
+}
+
+/********************************************************
+* @brief    getPackSoc
+* @details  This method gets pack state of charge, the pack
+*           is empty when its weakest cell is empty.
+* @param    None
+* @return   double  Return state of charge (%)
+********************************************************/
+double BatteryPack::getPackSoc() const {
+    return minSoc;
+}
+
+/********************************************************
+* @brief    getMeanSoc
+* @details  This method gets mean state of charge of all cells.
+* @param    None
+* @return   double  Return state of charge (%)
+********************************************************/
+double BatteryPack::getMeanSoc() const {
+    return meanSoc;
+}
+
+/********************************************************
+* @brief    getImbalance
+* @details  This method gets difference between strongest
+*           and weakest cell.
+* @param    None
+* @return   double  Return imbalance (%)
+********************************************************/
+double BatteryPack::getImbalance() const {
+    return maxSoc - minSoc;
+}
+
+/********************************************************
+* @brief    getMaxTemperature
+* @details  This method gets temperature of the hottest cell.
+* @param    None
+* @return   double  Return temperature (°C)
+********************************************************/
+double BatteryPack::getMaxTemperature() const {
+    return maxTemperature;
+}
+
+/********************************************************
+* @brief    getCellSoc
+* @details  This method gets state of charge of one cell.
+* @param    group   Series group
+* @param    row     Cell in group
+* @return   double  Return state of charge (%)
+********************************************************/
+double BatteryPack::getCellSoc(unsigned int group, unsigned int row) const {
+    if (group >= series || row >= parallel) {
+        return 0.0;
+    }
+    return soc[(size_t)row * blocks + group / PACK_LANES][group % PACK_LANES];
+}
+
+/********************************************************
+* @brief    getCellCount
+* @details  This method gets number of cells.
+* @param    None
+* @return   unsigned int    Return series * parallel
+********************************************************/
+unsigned int BatteryPack::getCellCount() const {
+    return series * parallel;
+}
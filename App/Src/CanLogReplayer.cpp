@@ -0,0 +1,483 @@
+/********************************************************
+* @file     CanLogReplayer.cpp
+* @brief    Define methods related to CAN log replay
+* @details  This file contains methods definition related
+*           to CAN log replay, includes parse candump log
+*           lines, restore timestamp order, decode signals
+*           and update decoded data to DashboardController.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "CanLogReplayer.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+/********************************************************
+* @brief    hexValue
+* @details  This function converts a hexadecimal digit.
+* @param    c       Character to convert
+* @return   int     Return value of digit, -1 if c is not
+*                   a hexadecimal digit
+********************************************************/
+static inline int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+
+    c |= 0x20;  // Lower case
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+/********************************************************
+* @brief    roundSignal
+* @details  This function rounds a decoded value to nearest
+*           integer. Values that are not finite or out of
+*           int range, from a large scale or a corrupt
+*           frame, are rejected before the conversion.
+* @param    value   Decoded value to round
+* @param    rounded Reference to receive rounded value
+* @return   bool    Return true if value is in int range
+********************************************************/
+static inline bool roundSignal(double value, int& rounded) {
+    double nearest = floor(value + 0.5);
+    if (!(nearest >= (double)INT_MIN && nearest <= (double)INT_MAX)) {
+        return false;
+    }
+    rounded = (int)nearest;
+    return true;
+}
+
+/********************************************************
+* @brief Constructor
+********************************************************/
+CanLogReplayer::CanLogReplayer() : cursor(NULL), logEnd(NULL), signalCount(0),
+    windowCount(0), framesDecoded(0), framesSkipped(0) {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+CanLogReplayer::~CanLogReplayer() {}
+
+/********************************************************
+* @brief    loadSignalMap
+* @details  This method loads signal map from CSV file,
+*           names are the same as Database.csv (SPEED,
+*           BATTERY LEVEL, AC TEMPERATURE, WIND LEVEL),
+*           lines start with '#' are comments.
+* @param    path    Path to signal map file
+* @return   bool    Return true if at least 1 signal is loaded
+********************************************************/
+bool CanLogReplayer::loadSignalMap(const string& path) {
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        cerr << "Cannot open file " << path << endl;
+        return false;
+    }
+
+    signalCount = 0;
+    string line, name, field;
+
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        stringstream ss(line);
+        if (!getline(ss, name, ',')) {
+            continue;
+        }
+
+        CanSignal signal;
+        if (name == "SPEED") {
+            signal.type = CAN_SIGNAL_SPEED;
+        } else if (name == "BATTERY LEVEL") {
+            signal.type = CAN_SIGNAL_BATTERY_LEVEL;
+        } else if (name == "AC TEMPERATURE") {
+            signal.type = CAN_SIGNAL_AC_TEMPERATURE;
+        } else if (name == "WIND LEVEL") {
+            signal.type = CAN_SIGNAL_WIND_LEVEL;
+        } else {
+            cerr << "Unknown signal " << name << " in " << path << endl;
+            continue;
+        }
+
+        // CAN ID, start bit, length, scale, offset
+        double values[5];
+        int count = 0;
+        while (count < 5 && getline(ss, field, ',')) {
+            try {
+                // Base 0 accepts both decimal and 0x prefixed identifiers
+                values[count] = (count == 0) ? (double)stoul(field, NULL, 0) : stod(field);
+            } catch (...) {
+                break;
+            }
+            count++;
+        }
+
+        if (count < 5) {
+            cerr << "Invalid signal " << name << " in " << path << endl;
+            continue;
+        }
+
+        signal.canId = (uint32_t)values[0];
+        signal.startBit = (uint16_t)values[1];
+        signal.length = (uint8_t)values[2];
+        signal.scale = values[3];
+        signal.offset = values[4];
+
+        if (!addSignal(signal)) {
+            cerr << "Cannot add signal " << name << " from " << path << endl;
+        }
+    }
+
+    return signalCount > 0;
+}
+
+/********************************************************
+* @brief    addSignal
+* @details  This method adds a signal to signal map.
+* @param    signal  Signal that want to add
+* @return   bool    Return false if signal map is full or
+*                   signal is invalid
+********************************************************/
+bool CanLogReplayer::addSignal(const CanSignal& signal) {
+    if (signalCount >= CAN_MAX_SIGNALS) {
+        return false;
+    }
+
+    if (signal.length < 1 || signal.length > 32 || signal.startBit >= CAN_MAX_DATA_LENGTH * 8) {
+        return false;
+    }
+
+    signals[signalCount++] = signal;
+    return true;
+}
+
+/********************************************************
+* @brief    open
+* @details  This method maps candump log and resets replay
+*           to the first frame.
+* @param    path    Path to candump log
+* @return   bool    Return true if log is mapped
+********************************************************/
+bool CanLogReplayer::open(const string& path) {
+    windowCount = 0;
+    framesDecoded = 0;
+    framesSkipped = 0;
+
+    if (!logFile.open(path)) {
+        cerr << "Cannot open file " << path << endl;
+        cursor = NULL;
+        logEnd = NULL;
+        return false;
+    }
+
+    cursor = logFile.data();
+    logEnd = logFile.data() + logFile.size();
+    return true;
+}
+
+/********************************************************
+* @brief    parseLine
+* @details  This method parses one candump log line, format:
+*           (seconds.micros) interface ID#DATA for classic
+*           frames, ID##F DATA for CAN FD, ID#R for remote
+*           frames.
+* @param    line    Start of line
+* @param    end     End of line (without new line)
+* @param    frame   Frame that receive parsed data
+* @return   bool    Return true if line is a valid frame
+********************************************************/
+bool CanLogReplayer::parseLine(const char* line, const char* end, CanFrame& frame) {
+    const char* p = line;
+
+    // Timestamp "(seconds.fraction)"
+    if (p >= end || *p != '(') {
+        return false;
+    }
+    p++;
+
+    int64_t seconds = 0;
+    const char* digits = p;
+    while (p < end && *p >= '0' && *p <= '9') {
+        seconds = seconds * 10 + (*p - '0');
+        p++;
+    }
+    if (p == digits || p >= end || *p != '.') {
+        return false;
+    }
+    p++;
+
+    // Keep microsecond resolution whatever number of digits is logged
+    int64_t micros = 0;
+    int fractionDigits = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (fractionDigits < 6) {
+            micros = micros * 10 + (*p - '0');
+            fractionDigits++;
+        }
+        p++;
+    }
+    while (fractionDigits < 6) {
+        micros *= 10;
+        fractionDigits++;
+    }
+    if (p >= end || *p != ')') {
+        return false;
+    }
+    p++;
+    frame.timestampUs = seconds * 1000000 + micros;
+
+    // Interface name
+    while (p < end && *p == ' ') {
+        p++;
+    }
+    while (p < end && *p != ' ') {
+        p++;
+    }
+    while (p < end && *p == ' ') {
+        p++;
+    }
+
+    // Identifier (3 digits standard, 8 digits extended)
+    uint32_t canId = 0;
+    int idDigits = 0;
+    int value;
+    while (p < end && (value = hexValue(*p)) >= 0) {
+        canId = (canId << 4) | (uint32_t)value;
+        idDigits++;
+        p++;
+    }
+    if (idDigits == 0 || idDigits > 8 || p >= end || *p != '#') {
+        return false;
+    }
+    p++;
+    frame.canId = canId;
+    frame.length = 0;
+
+    // CAN FD frame has a second '#' and one flags digit
+    if (p < end && *p == '#') {
+        p++;
+        if (p >= end || hexValue(*p) < 0) {
+            return false;
+        }
+        p++;
+    }
+
+    // Remote frame has no payload
+    if (p < end && (*p == 'R' || *p == 'r')) {
+        return true;
+    }
+
+    // Payload as hexadecimal byte pairs
+    int high;
+    while (p < end && (high = hexValue(*p)) >= 0) {
+        if (p + 1 >= end || frame.length >= CAN_MAX_DATA_LENGTH) {
+            return false;
+        }
+
+        int low = hexValue(p[1]);
+        if (low < 0) {
+            return false;
+        }
+
+        frame.data[frame.length++] = (uint8_t)((high << 4) | low);
+        p += 2;
+    }
+
+    // Only white space or direction flags may follow payload
+    return p == end || *p == ' ' || *p == '\t' || *p == '\r';
+}
+
+/********************************************************
+* @brief    readFrame
+* @details  This method parses next valid frame in log
+*           order, malformed lines are counted and skipped.
+* @param    frame   Frame that receive parsed data
+* @return   bool    Return false if end of log is reached
+********************************************************/
+bool CanLogReplayer::readFrame(CanFrame& frame) {
+    while (cursor != NULL && cursor < logEnd) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', logEnd - cursor));
+        if (lineEnd == NULL) {
+            lineEnd = logEnd;
+        }
+
+        const char* line = cursor;
+        cursor = (lineEnd < logEnd) ? lineEnd + 1 : logEnd;
+
+        if (line == lineEnd || (lineEnd - line == 1 && *line == '\r')) {
+            continue;   // Empty line
+        }
+
+        if (parseLine(line, lineEnd, frame)) {
+            framesDecoded++;
+            return true;
+        }
+        framesSkipped++;
+    }
+    return false;
+}
+
+/********************************************************
+* @brief    isLater
+* @details  This method compares 2 pending frames, used as
+*           heap order so the earliest frame is on top.
+* @param    a       First frame
+* @param    b       Second frame
+* @return   bool    Return true if a must be replayed after b
+********************************************************/
+bool CanLogReplayer::isLater(const PendingFrame& a, const PendingFrame& b) {
+    if (a.frame.timestampUs != b.frame.timestampUs) {
+        return a.frame.timestampUs > b.frame.timestampUs;
+    }
+    return a.sequence > b.sequence;
+}
+
+/********************************************************
+* @brief    nextFrame
+* @details  This method gets next frame in timestamp order.
+*           Frames from several interfaces may be logged
+*           slightly out of order, so a small window of
+*           frames is kept and the earliest one is returned.
+* @param    frame   Frame that receive data
+* @return   bool    Return false if there is no more frame
+********************************************************/
+bool CanLogReplayer::nextFrame(CanFrame& frame) {
+    // Fill reorder window
+    while (windowCount < CAN_REORDER_WINDOW) {
+        PendingFrame& pending = window[windowCount];
+        if (!readFrame(pending.frame)) {
+            break;
+        }
+        pending.sequence = framesDecoded;
+        windowCount++;
+        push_heap(window, window + windowCount, isLater);
+    }
+
+    if (windowCount == 0) {
+        return false;
+    }
+
+    pop_heap(window, window + windowCount, isLater);
+    windowCount--;
+    frame = window[windowCount].frame;
+    return true;
+}
+
+/********************************************************
+* @brief    decodeSignal
+* @details  This method decodes physical value of a signal,
+*           payload bytes after frame length read as 0.
+* @param    signal  Signal to decode
+* @param    frame   Frame carries the signal
+* @return   double  Physical value of signal
+********************************************************/
+double CanLogReplayer::decodeSignal(const CanSignal& signal, const CanFrame& frame) {
+    int firstByte = signal.startBit / 8;
+    uint64_t word = 0;
+
+    // Load up to 8 bytes little-endian, enough for 32 bits at any bit offset
+    for (int i = 0; i < 8; i++) {
+        int index = firstByte + i;
+        if (index >= frame.length) {
+            break;
+        }
+        word |= (uint64_t)frame.data[index] << (8 * i);
+    }
+
+    uint64_t raw = (word >> (signal.startBit % 8)) & ((1ULL << signal.length) - 1);
+    return raw * signal.scale + signal.offset;
+}
+
+/********************************************************
+* @brief    applyFrame
+* @details  This method decodes all signals of a frame and
+*           updates them to DashboardController, values are
+*           rounded to nearest integer and values out of
+*           int range are skipped. Speed and battery
+*           level are filtered at the time of the frame.
+* @param    frame                Frame to decode
+* @param    dashboardController  Pointer to DashboardController
+*                                object that receive data
+* @param    stateEstimator       Pointer to StateEstimator object
+*                                that filters speed and battery
+*                                level, NULL sets decoded values
+* @return   None
+********************************************************/
+void CanLogReplayer::applyFrame(const CanFrame& frame, DashboardController* dashboardController,
+    StateEstimator* stateEstimator) const {
+    double frameTime = frame.timestampUs / 1e6;
+
+    for (int i = 0; i < signalCount; i++) {
+        const CanSignal& signal = signals[i];
+        if (signal.canId != frame.canId) {
+            continue;
+        }
+
+        double decoded = decodeSignal(signal, frame);
+        int value;
+        if (!roundSignal(decoded, value)) {
+            continue;
+        }
+
+        switch (signal.type) {
+        case CAN_SIGNAL_SPEED:
+            if (stateEstimator) {
+                stateEstimator->updateSpeed(frameTime, decoded);
+                if (!roundSignal(stateEstimator->getSpeed(), value)) {
+                    break;
+                }
+            }
+            dashboardController->setSpeed(value);
+            break;
+        case CAN_SIGNAL_BATTERY_LEVEL:
+            if (stateEstimator) {
+                stateEstimator->updateSoc(frameTime, decoded);
+                if (!roundSignal(stateEstimator->getSoc(), value)) {
+                    break;
+                }
+            }
+            dashboardController->setBatteryLevel(value);
+            break;
+        case CAN_SIGNAL_AC_TEMPERATURE:
+            dashboardController->setAcTemp(value);
+            break;
+        case CAN_SIGNAL_WIND_LEVEL:
+            dashboardController->setWindLevel(value);
+            break;
+        }
+    }
+
+    if (stateEstimator) {
+        stateEstimator->setClimate(dashboardController->getAcTemp(), dashboardController->getWindLevel());
+    }
+}
+
+/********************************************************
+* @brief    getFramesDecoded
+* @details  This method gets number of decoded frames.
+* @param    None
+* @return   unsigned long long  Return number of valid frames
+********************************************************/
+unsigned long long CanLogReplayer::getFramesDecoded() const {
+    return framesDecoded;
+}
+
+/********************************************************
+* @brief    getFramesSkipped
+* @details  This method gets number of skipped lines.
+* @param    None
+* @return   unsigned long long  Return number of malformed lines
+********************************************************/
+unsigned long long CanLogReplayer::getFramesSkipped() const {
+    return framesSkipped;
+}
@@ -0,0 +1,312 @@
+/********************************************************
+* @file     ChargingStationIndex.cpp
+* @brief    Define methods related to charging station
+*           search
+* @details  This file contains methods definition related
+*           to charging station search, includes load station
+*           file, bulk-load the k-d tree and find nearest
+*           stations within a distance.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "ChargingStationIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+/********************************************************
+* @brief Degree to radian
+********************************************************/
+static const double DEGREE_TO_RADIAN = 3.14159265358979323846 / 180.0;
+
+/********************************************************
+* @brief    greatCircleKm
+* @details  This function calculates great circle distance
+*           with haversine formula.
+* @param    lat1    Latitude of first point (degree)
+* @param    lon1    Longitude of first point (degree)
+* @param    lat2    Latitude of second point (degree)
+* @param    lon2    Longitude of second point (degree)
+* @return   double  Distance (km)
+********************************************************/
+static double greatCircleKm(double lat1, double lon1, double lat2, double lon2) {
+    double dLat = (lat2 - lat1) * DEGREE_TO_RADIAN;
+    double dLon = (lon2 - lon1) * DEGREE_TO_RADIAN;
+    double a = sin(dLat / 2) * sin(dLat / 2)
+        + cos(lat1 * DEGREE_TO_RADIAN) * cos(lat2 * DEGREE_TO_RADIAN) * sin(dLon / 2) * sin(dLon / 2);
+    return 2.0 * EARTH_RADIUS_KM * asin(min(1.0, sqrt(a)));
+}
+
+/********************************************************
+* @brief Constructor
+********************************************************/
+ChargingStationIndex::ChargingStationIndex() {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+ChargingStationIndex::~ChargingStationIndex() {}
+
+/********************************************************
+* @brief    isNearer
+* @details  This method orders candidates by distance, the
+*           farthest candidate is on top of the heap.
+* @param    a   First candidate
+* @param    b   Second candidate
+* @return   bool    Return true if a is nearer than b
+********************************************************/
+bool ChargingStationIndex::isNearer(const Candidate& a, const Candidate& b) {
+    return a.distanceSq < b.distanceSq;
+}
+
+/********************************************************
+* @brief    toUnitSphere
+* @details  This method converts latitude and longitude to
+*           a point on the unit sphere.
+* @param    latitude    Latitude (degree)
+* @param    longitude   Longitude (degree)
+* @param    point       Position on unit sphere
+* @return   None
+********************************************************/
+void ChargingStationIndex::toUnitSphere(double latitude, double longitude, float point[3]) {
+    double lat = latitude * DEGREE_TO_RADIAN;
+    double lon = longitude * DEGREE_TO_RADIAN;
+
+    point[0] = (float)(cos(lat) * cos(lon));
+    point[1] = (float)(cos(lat) * sin(lon));
+    point[2] = (float)sin(lat);
+}
+
+/********************************************************
+* @brief    load
+* @details  This method loads stations from CSV file, invalid
+*           lines are reported and skipped, then builds the
+*           tree.
+* @param    path    Path to station file
+* @return   bool    Return true if at least 1 station is loaded
+********************************************************/
+bool ChargingStationIndex::load(const string& path) {
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        cerr << "Cannot open file " << path << endl;
+        return false;
+    }
+
+    vector<ChargingStation> list;
+    string line, field;
+    int lineNumber = 0;
+
+    while (getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // Name, latitude, longitude
+        ChargingStation station;
+        stringstream ss(line);
+        bool isValid = getline(ss, station.name, ',') && getline(ss, field, ',');
+        if (isValid) {
+            try {
+                station.latitude = stod(field);
+                isValid = getline(ss, field, ',') ? true : false;
+                station.longitude = isValid ? stod(field) : 0.0;
+            } catch (...) {
+                isValid = false;
+            }
+        }
+
+        if (!isValid || fabs(station.latitude) > 90.0 || fabs(station.longitude) > 180.0) {
+            cerr << "Invalid station at line " << lineNumber << " in " << path << endl;
+            continue;
+        }
+
+        list.push_back(station);
+    }
+
+    build(list);
+    return !stations.empty();
+}
+
+/********************************************************
+* @brief    build
+* @details  This method replaces stations and bulk-loads
+*           the tree.
+* @param    list    New stations
+* @return   None
+********************************************************/
+void ChargingStationIndex::build(const vector<ChargingStation>& list) {
+    stations = list;
+    nodes.resize(stations.size());
+
+    for (size_t i = 0; i < stations.size(); i++) {
+        toUnitSphere(stations[i].latitude, stations[i].longitude, nodes[i].point);
+        nodes[i].station = (uint32_t)i;
+    }
+
+    build(0, nodes.size(), 0);
+}
+
+/********************************************************
+* @brief    build
+* @details  This method puts the median of range [begin, end)
+*           on the split axis at the middle of the range,
+*           smaller values before it, then builds both halves.
+* @param    begin   First node of range
+* @param    end     End of range
+* @param    depth   Depth of subtree root, selects split axis
+* @return   None
+********************************************************/
+void ChargingStationIndex::build(size_t begin, size_t end, unsigned int depth) {
+    if (end - begin <= 1) {
+        return;
+    }
+
+    unsigned int axis = depth % 3;
+    size_t middle = begin + (end - begin) / 2;
+
+    nth_element(nodes.begin() + begin, nodes.begin() + middle, nodes.begin() + end,
+        [axis](const Node& a, const Node& b) { return a.point[axis] < b.point[axis]; });
+
+    build(begin, middle, depth + 1);
+    build(middle + 1, end, depth + 1);
+}
+
+/********************************************************
+* @brief    search
+* @details  This method checks the node of range [begin, end),
+*           searches the half that contains the query first,
+*           and the other half only if the split plane is
+*           closer than the current k-th result.
+* @param    begin       First node of range
+* @param    end         End of range
+* @param    depth       Depth of subtree root
+* @param    query       Position of query on unit sphere
+* @param    k           Number of wanted stations
+* @param    radiusSq    Squared chord distance limit
+* @param    heap        Current results
+* @param    count       Number of current results
+* @return   None
+********************************************************/
+void ChargingStationIndex::search(size_t begin, size_t end, unsigned int depth, const float query[3],
+    size_t k, float radiusSq, Candidate* heap, size_t& count) const {
+    if (begin >= end) {
+        return;
+    }
+
+    size_t middle = begin + (end - begin) / 2;
+    const Node& node = nodes[middle];
+
+    // Check node
+    float dx = node.point[0] - query[0];
+    float dy = node.point[1] - query[1];
+    float dz = node.point[2] - query[2];
+    float distanceSq = dx * dx + dy * dy + dz * dz;
+
+    if (distanceSq <= radiusSq) {
+        if (count < k) {
+            heap[count].distanceSq = distanceSq;
+            heap[count].station = node.station;
+            count++;
+            push_heap(heap, heap + count, isNearer);
+        } else if (distanceSq < heap[0].distanceSq) {
+            pop_heap(heap, heap + count, isNearer);
+            heap[count - 1].distanceSq = distanceSq;
+            heap[count - 1].station = node.station;
+            push_heap(heap, heap + count, isNearer);
+        }
+    }
+
+    // Search near half first
+    unsigned int axis = depth % 3;
+    float diff = query[axis] - node.point[axis];
+    bool isLeftFirst = (diff < 0.0f);
+
+    if (isLeftFirst) {
+        search(begin, middle, depth + 1, query, k, radiusSq, heap, count);
+    } else {
+        search(middle + 1, end, depth + 1, query, k, radiusSq, heap, count);
+    }
+
+    // Far half can only contain results closer than the split plane
+    float limitSq = (count < k) ? radiusSq : heap[0].distanceSq;
+    if (diff * diff <= limitSq) {
+        if (isLeftFirst) {
+            search(middle + 1, end, depth + 1, query, k, radiusSq, heap, count);
+        } else {
+            search(begin, middle, depth + 1, query, k, radiusSq, heap, count);
+        }
+    }
+}
+
+/********************************************************
+* @brief    findNearest
+* @details  This method finds nearest stations within a
+*           distance. Distance limit is converted to a chord
+*           of the unit sphere, results are sorted nearest
+*           first with great circle distance.
+* @param    latitude        Latitude of vehicle (degree)
+* @param    longitude       Longitude of vehicle (degree)
+* @param    k               Number of wanted stations, at
+*                           most STATION_MAX_RESULTS
+* @param    maxDistanceKm   Distance limit (km)
+* @param    results         Filled with found stations,
+*                           nearest first
+* @return   size_t          Return number of found stations
+********************************************************/
+size_t ChargingStationIndex::findNearest(double latitude, double longitude, size_t k, double maxDistanceKm,
+    StationMatch* results) const {
+    if (k > STATION_MAX_RESULTS) {
+        k = STATION_MAX_RESULTS;
+    }
+    if (k == 0 || maxDistanceKm < 0.0 || nodes.empty()) {
+        return 0;
+    }
+
+    // Chord of the distance limit, whole sphere if limit is
+    // more than half of the circumference
+    double angle = maxDistanceKm / EARTH_RADIUS_KM;
+    double chord = (angle >= 3.14159265358979323846) ? 2.0 : 2.0 * sin(angle / 2.0);
+    float radiusSq = (float)(chord * chord) * 1.0001f;
+
+    float query[3];
+    toUnitSphere(latitude, longitude, query);
+
+    Candidate heap[STATION_MAX_RESULTS];
+    size_t count = 0;
+    search(0, nodes.size(), 0, query, k, radiusSq, heap, count);
+
+    // Nearest first
+    sort_heap(heap, heap + count, isNearer);
+
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        const ChargingStation& station = stations[heap[i].station];
+        double distance = greatCircleKm(latitude, longitude, station.latitude, station.longitude);
+
+        // Chord limit is slightly larger to absorb float rounding
+        if (distance > maxDistanceKm) {
+            continue;
+        }
+        results[found].station = &station;
+        results[found].distanceKm = distance;
+        found++;
+    }
+
+    return found;
+}
+
+/********************************************************
+* @brief    size
+* @details  This method gets number of stations.
+* @param    None
+* @return   size_t  Return number of stations
+********************************************************/
+size_t ChargingStationIndex::size() const {
+    return stations.size();
+}
@@ -0,0 +1,209 @@
+/********************************************************
+* @file     ClimateAdvisor.cpp
+* @brief    Define methods related to climate and speed
+*           advice
+* @details  This file contains methods definition related to
+*           what-if range advice, includes sampling the
+*           climate factors of the drain model, the batch of
+*           ranges of every setting and choosing the best
+*           alternatives.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "ClimateAdvisor.hpp"
+#include <algorithm>
+
+using namespace std;
+
+/********************************************************
+* @brief Candidate speed caps, a cap is only tried below
+*        the current speed (km/h)
+********************************************************/
+static const int SPEED_CAPS[ADVISOR_CAP_COUNT] = { 110, 90, 70, 50 };
+
+/********************************************************
+* @brief Constructor, samples climate factors of the
+*        drain model
+* @param batteryManager   Pointer to battery manager with
+*                         the drain model and capacity
+********************************************************/
+ClimateAdvisor::ClimateAdvisor(const BatteryManager* batteryManager)
+    : batteryManager(batteryManager), speedCount(0), alternativeCount(0), currentRange(0.0) {
+    // Range factor of each climate is reference drain over its
+    // drain, base drain cancels out. Padding keeps factor 0
+    for (int i = 0; i < ADVISOR_ROW_STRIDE; i++) {
+        climateFactors[i] = 0.0;
+    }
+    for (int i = 0; i < ADVISOR_SPEED_COUNT * ADVISOR_ROW_STRIDE; i++) {
+        ranges[i] = 0.0;
+    }
+    if (!batteryManager) {
+        return;
+    }
+
+    double reference = numericToDouble(
+        batteryManager->calculateBatteryDrain(0, ADVISOR_MIN_AC_TEMP, ADVISOR_MIN_WIND));
+    int index = 0;
+    for (int acTemp = ADVISOR_MIN_AC_TEMP; acTemp <= ADVISOR_MAX_AC_TEMP; acTemp++) {
+        for (int windLevel = ADVISOR_MIN_WIND; windLevel <= ADVISOR_MAX_WIND; windLevel++) {
+            double drain = numericToDouble(batteryManager->calculateBatteryDrain(0, acTemp, windLevel));
+            climateFactors[index++] = (reference > 0.0 && drain > 0.0) ? reference / drain : 1.0;
+        }
+    }
+}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+ClimateAdvisor::~ClimateAdvisor() {}
+
+/********************************************************
+* @brief    insertAlternative
+* @details  This method keeps the alternatives with the most
+*           gain, sorted with most gain first.
+* @param    alternative     Alternative to insert
+* @return   None
+********************************************************/
+void ClimateAdvisor::insertAlternative(const ClimateAlternative& alternative) {
+    size_t position = alternativeCount;
+    while (position > 0 && alternatives[position - 1].gainKm < alternative.gainKm) {
+        position--;
+    }
+    if (position >= ADVISOR_TOP_COUNT) {
+        return;
+    }
+
+    size_t last = alternativeCount < ADVISOR_TOP_COUNT ? alternativeCount : ADVISOR_TOP_COUNT - 1;
+    for (size_t i = last; i > position; i--) {
+        alternatives[i] = alternatives[i - 1];
+    }
+    alternatives[position] = alternative;
+    if (alternativeCount < ADVISOR_TOP_COUNT) {
+        alternativeCount++;
+    }
+}
+
+/********************************************************
+* @brief    advise
+* @details  This method reads the drain of each speed choice
+*           at the reference climate, one call per row, then
+*           fills the range of every climate of every row in
+*           one loop over flat arrays that the compiler turns
+*           into vector instructions. The best climate of each
+*           row is an alternative if it gains enough range.
+* @param    speed       Current speed (km/h)
+* @param    acTemp      Current AC temperature (°C)
+* @param    windLevel   Current wind level
+* @return   None
+********************************************************/
+void ClimateAdvisor::advise(int speed, int acTemp, int windLevel) {
+    alternativeCount = 0;
+    currentRange = 0.0;
+    speedCount = 0;
+    if (!batteryManager) {
+        return;
+    }
+
+    double energy = numericToDouble(batteryManager->getStateOfCharge()) / 100.0
+        * numericToDouble(batteryManager->getBatteryCapacity());
+    double currentDrain = numericToDouble(batteryManager->calculateBatteryDrain(speed, acTemp, windLevel));
+    if (energy <= 0.0 || currentDrain <= 0.0) {
+        return;
+    }
+    currentRange = energy / currentDrain;
+
+    // Current speed, then each cap below it
+    speeds[speedCount] = speed;
+    speedCaps[speedCount++] = 0;
+    for (int i = 0; i < ADVISOR_CAP_COUNT; i++) {
+        if (SPEED_CAPS[i] < speed) {
+            speeds[speedCount] = SPEED_CAPS[i];
+            speedCaps[speedCount++] = SPEED_CAPS[i];
+        }
+    }
+
+    // Range at reference climate of each speed
+    double scales[ADVISOR_SPEED_COUNT];
+    for (int row = 0; row < speedCount; row++) {
+        double drain = numericToDouble(
+            batteryManager->calculateBatteryDrain(speeds[row], ADVISOR_MIN_AC_TEMP, ADVISOR_MIN_WIND));
+        scales[row] = drain > 0.0 ? energy / drain : 0.0;
+    }
+
+    // Range of every climate at every speed, no call in the
+    // loop so it is vectorized
+    for (int row = 0; row < speedCount; row++) {
+        double scale = scales[row];
+        int offset = row * ADVISOR_ROW_STRIDE;
+
+        for (int i = 0; i < ADVISOR_ROW_STRIDE; i++) {
+            ranges[offset + i] = scale * climateFactors[i];
+        }
+    }
+
+    // Best climate of each speed choice
+    const int windCount = ADVISOR_MAX_WIND - ADVISOR_MIN_WIND + 1;
+    for (int row = 0; row < speedCount; row++) {
+        const double* rowRanges = ranges + row * ADVISOR_ROW_STRIDE;
+
+        // Longest range in 4 independent lanes, padding is 0 and
+        // never wins, then first climate with that range
+        double lanes[4] = { rowRanges[0], rowRanges[1], rowRanges[2], rowRanges[3] };
+        for (int i = 4; i < ADVISOR_ROW_STRIDE; i += 4) {
+            for (int lane = 0; lane < 4; lane++) {
+                lanes[lane] = rowRanges[i + lane] > lanes[lane] ? rowRanges[i + lane] : lanes[lane];
+            }
+        }
+        double bestRange = max(max(lanes[0], lanes[1]), max(lanes[2], lanes[3]));
+        int best = 0;
+        while (best < ADVISOR_CLIMATE_COUNT - 1 && rowRanges[best] < bestRange) {
+            best++;
+        }
+
+        ClimateAlternative alternative;
+        alternative.acTemp = ADVISOR_MIN_AC_TEMP + best / windCount;
+        alternative.windLevel = ADVISOR_MIN_WIND + best % windCount;
+        alternative.speedCap = speedCaps[row];
+        alternative.rangeKm = rowRanges[best];
+        alternative.gainKm = rowRanges[best] - currentRange;
+
+        bool isCurrent = alternative.speedCap == 0 && alternative.acTemp == acTemp
+            && alternative.windLevel == windLevel;
+        if (!isCurrent && alternative.gainKm >= ADVISOR_MIN_GAIN_KM) {
+            insertAlternative(alternative);
+        }
+    }
+}
+
+/********************************************************
+* @brief    getCurrentRange
+* @details  This method gets range with current settings of
+*           last advice.
+* @param    None
+* @return   double  Return range (km)
+********************************************************/
+double ClimateAdvisor::getCurrentRange() const {
+    return currentRange;
+}
+
+/********************************************************
+* @brief    getAlternativeCount
+* @details  This method gets number of advised alternatives.
+* @param    None
+* @return   size_t  Return number, at most ADVISOR_TOP_COUNT
+********************************************************/
+size_t ClimateAdvisor::getAlternativeCount() const {
+    return alternativeCount;
+}
+
+/********************************************************
+* @brief    getAlternative
+* @details  This method gets an advised alternative, most
+*           gain first.
+* @param    index   Index of alternative
+* @return   const ClimateAlternative&   Return alternative
+********************************************************/
+const ClimateAlternative& ClimateAdvisor::getAlternative(size_t index) const {
+    return alternatives[index];
+}
@@ -0,0 +1,414 @@
+/********************************************************
+* @file     ControlServer.cpp
+* @brief    Define methods related to the control socket
+* @details  This file contains methods definition related to
+*           the control socket, includes the epoll loop,
+*           accepting connections and splitting received data
+*           into command lines.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "ControlServer.hpp"
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <errno.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Epoll ids of listen socket and wake up eventfd,
+*        clients use (generation << 32) | index
+********************************************************/
+#define CONTROL_LISTEN_ID       0xFFFFFFFFFFFFFFFFull
+#define CONTROL_WAKE_ID         0xFFFFFFFFFFFFFFFEull
+#define CONTROL_EPOLL_EVENTS    32
+#define CONTROL_READ_SIZE       4096    /* Bytes read from a client at once */
+
+/********************************************************
+* Replies
+********************************************************/
+static const char errorReply[] = "ERROR\n";
+static const char fullReply[] = "FULL\n";
+
+/********************************************************
+* @brief Constructor
+* @param path             Socket path
+* @param commandQueue     Pointer to CommandQueue object
+*                         that receives commands
+********************************************************/
+ControlServer::ControlServer(const string& path, CommandQueue* commandQueue)
+    : path(path), commandQueue(commandQueue), isStopRequested(false), listenFd(-1), epollFd(-1), wakeFd(-1),
+      accepted(0), commands(0), invalid(0), dropped(0) {
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        clients[i].fd = -1;
+        clients[i].lineLength = 0;
+        clients[i].isLineTooLong = false;
+        clients[i].generation = 0;
+    }
+}
+
+/********************************************************
+* @brief Destructor, stops the server
+********************************************************/
+ControlServer::~ControlServer() {
+    stop();
+}
+
+/********************************************************
+* @brief    start
+* @details  This method replaces an old socket file, opens
+*           listen socket, epoll and the wake up eventfd, then
+*           starts server thread. Nothing is allocated after
+*           start.
+* @param    None
+* @return   bool        Return false if server cannot start
+********************************************************/
+bool ControlServer::start() {
+#ifdef __linux__
+    if (worker.joinable()) {
+        return true;
+    }
+    if (!commandQueue) {
+        return false;
+    }
+
+    // A client closing its connection must not stop the program
+    signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un socketAddress;
+    memset(&socketAddress, 0, sizeof(socketAddress));
+    socketAddress.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(socketAddress.sun_path)) {
+        cerr << "Invalid control socket path " << path << endl;
+        return false;
+    }
+    memcpy(socketAddress.sun_path, path.c_str(), path.size());
+    unlink(path.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0
+        || bind(listenFd, (sockaddr*)&socketAddress, sizeof(socketAddress)) != 0
+        || listen(listenFd, SOMAXCONN) != 0) {
+        cerr << "Cannot listen on " << path << ": " << strerror(errno) << endl;
+        stop();
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        cerr << "Cannot create epoll: " << strerror(errno) << endl;
+        stop();
+        return false;
+    }
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = CONTROL_LISTEN_ID;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.u64 = CONTROL_WAKE_ID;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    isStopRequested.store(false);
+    worker = thread(&ControlServer::run, this);
+    cout << "Control socket at " << path << endl;
+    return true;
+#else
+    cerr << "Control socket is only available on Linux" << endl;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    stop
+* @details  This method wakes server thread to exit, then
+*           closes all connections and descriptors and
+*           removes socket file.
+* @param    None
+* @return   None
+********************************************************/
+void ControlServer::stop() {
+#ifdef __linux__
+    if (worker.joinable()) {
+        isStopRequested.store(true);
+        uint64_t one = 1;
+        ssize_t result = write(wakeFd, &one, sizeof(one));
+        (void)result;
+        worker.join();
+    }
+
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        if (clients[i].fd >= 0) {
+            closeClient(i);
+        }
+    }
+
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+        unlink(path.c_str());
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+#endif
+}
+
+/********************************************************
+* @brief    getStats
+* @details  This method reads counters of the server.
+* @param    None
+* @return   ControlServerStats  Return counters
+********************************************************/
+ControlServerStats ControlServer::getStats() const {
+    ControlServerStats stats;
+    stats.accepted = accepted.load(memory_order_relaxed);
+    stats.commands = commands.load(memory_order_relaxed);
+    stats.invalid = invalid.load(memory_order_relaxed);
+    stats.dropped = dropped.load(memory_order_relaxed);
+    return stats;
+}
+
+/********************************************************
+* @brief    handleLine
+* @details  This method parses one line and queues its
+*           command, empty lines and lines starting with '#'
+*           are ignored.
+* @param    client  Client that sent the line
+* @param    line    Start of line
+* @param    end     End of line (without new line)
+* @return   None
+********************************************************/
+void ControlServer::handleLine(ControlClient& client, const char* line, const char* end) {
+    if (end > line && end[-1] == '\r') {
+        end--;
+    }
+    if (line == end || *line == '#') {
+        return;
+    }
+
+    CommandType type;
+    int value;
+    const char* reply = NULL;
+    size_t replyLength = 0;
+
+    if (!parseCommand(line, end, type, value)) {
+        invalid.fetch_add(1, memory_order_relaxed);
+        reply = errorReply;
+        replyLength = sizeof(errorReply) - 1;
+    } else if (!commandQueue->submit(type, value, COMMAND_SOURCE_SOCKET)) {
+        dropped.fetch_add(1, memory_order_relaxed);
+        reply = fullReply;
+        replyLength = sizeof(fullReply) - 1;
+    } else {
+        commands.fetch_add(1, memory_order_relaxed);
+    }
+
+#ifdef __linux__
+    // Best effort, a client that does not read misses replies
+    if (reply) {
+        ssize_t result = send(client.fd, reply, replyLength, MSG_DONTWAIT | MSG_NOSIGNAL);
+        (void)result;
+    }
+#else
+    (void)client;
+    (void)reply;
+    (void)replyLength;
+#endif
+}
+
+#ifdef __linux__
+/********************************************************
+* @brief    run
+* @details  This method is body of server thread. It waits
+*           on epoll for connections, command data and the
+*           wake up of stop().
+* @param    None
+* @return   None
+********************************************************/
+void ControlServer::run() {
+    epoll_event events[CONTROL_EPOLL_EVENTS];
+
+    while (!isStopRequested.load()) {
+        int count = epoll_wait(epollFd, events, CONTROL_EPOLL_EVENTS, CONTROL_POLL_MS);
+        if (count < 0 && errno != EINTR) {
+            cerr << "Control epoll failed: " << strerror(errno) << endl;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            uint64_t id = events[i].data.u64;
+
+            if (id == CONTROL_LISTEN_ID) {
+                acceptClients();
+                continue;
+            }
+            if (id == CONTROL_WAKE_ID) {
+                continue;
+            }
+
+            // Event of a connection closed earlier in this pass
+            int index = (int)(id & 0xFFFFFFFFu);
+            ControlClient& client = clients[index];
+            if (client.fd < 0 || client.generation != (uint32_t)(id >> 32)) {
+                continue;
+            }
+
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP)) {
+                readCommands(index);
+            }
+        }
+    }
+}
+
+/********************************************************
+* @brief    acceptClients
+* @details  This method accepts all pending connections, a
+*           connection is closed at once if all slots are
+*           used.
+* @param    None
+* @return   None
+********************************************************/
+void ControlServer::acceptClients() {
+    while (true) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        int index = -1;
+        for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+            if (clients[i].fd < 0) {
+                index = i;
+                break;
+            }
+        }
+        if (index < 0) {
+            close(fd);
+            continue;
+        }
+
+        ControlClient& client = clients[index];
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = ((uint64_t)client.generation << 32) | (uint32_t)index;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+
+        client.fd = fd;
+        client.lineLength = 0;
+        client.isLineTooLong = false;
+        accepted.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+/********************************************************
+* @brief    readCommands
+* @details  This method reads all available data, each
+*           complete line is a command. Part of a line is
+*           kept until the rest arrives, a line longer than
+*           CONTROL_LINE_SIZE is invalid.
+* @param    index   Index of client
+* @return   None
+********************************************************/
+void ControlServer::readCommands(int index) {
+    ControlClient& client = clients[index];
+    char buffer[CONTROL_READ_SIZE];
+
+    while (client.fd >= 0) {
+        ssize_t count = read(client.fd, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        if (count <= 0) {
+            closeClient(index);
+            return;
+        }
+
+        const char* cursor = buffer;
+        const char* end = buffer + count;
+        while (cursor < end) {
+            const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+            const char* partEnd = lineEnd ? lineEnd : end;
+            size_t partLength = partEnd - cursor;
+
+            // Whole line in buffer, parse it in place
+            if (lineEnd && client.lineLength == 0 && !client.isLineTooLong) {
+                handleLine(client, cursor, lineEnd);
+                cursor = lineEnd + 1;
+                continue;
+            }
+
+            // Line continues from an earlier read
+            if (client.lineLength + partLength > CONTROL_LINE_SIZE) {
+                client.isLineTooLong = true;
+            } else if (!client.isLineTooLong) {
+                memcpy(client.line + client.lineLength, cursor, partLength);
+                client.lineLength += partLength;
+            }
+
+            if (lineEnd) {
+                if (client.isLineTooLong) {
+                    invalid.fetch_add(1, memory_order_relaxed);
+                } else {
+                    handleLine(client, client.line, client.line + client.lineLength);
+                }
+                client.lineLength = 0;
+                client.isLineTooLong = false;
+                cursor = lineEnd + 1;
+            } else {
+                cursor = end;
+            }
+        }
+    }
+}
+
+/********************************************************
+* @brief    closeClient
+* @details  This method closes a connection, later events of
+*           the slot are ignored by generation.
+* @param    index   Index of client
+* @return   None
+********************************************************/
+void ControlServer::closeClient(int index) {
+    ControlClient& client = clients[index];
+    if (client.fd < 0) {
+        return;
+    }
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, NULL);
+    close(client.fd);
+    client.fd = -1;
+    client.lineLength = 0;
+    client.isLineTooLong = false;
+    client.generation++;
+}
+#else
+void ControlServer::run() {}
+void ControlServer::acceptClients() {}
+void ControlServer::readCommands(int) {}
+void ControlServer::closeClient(int) {}
+#endif
@@ -3,12 +3,16 @@
 * @brief    Define methods related to dashboard controller
 * @details  This file contains methods definition related
 *           to dashboard controller includes getters, setters,
-*           update data and notify to all registered observers.
+*           update data and publish state to all subscribers.
 * @version  1.0
 * @date     2024-11-10
 * @author   Tran Quang Khai
 ********************************************************/
 #include "DashboardController.hpp"
+#include "TelemetryParser.hpp"
+#include "FileBuffer.hpp"
+#include <chrono>
+#include <cstring>
 
 using namespace std;
 
@@ -16,14 +20,13 @@ using namespace std;
 * @brief Constructor 
 ********************************************************/
 DashboardController::DashboardController() : speed(0), driveMode(ECO), 
-    batteryLevel(100), remainingRange(400.0), acTemp(25), windLevel(0) {}
+    batteryLevel(100), remainingRange(400.0), acTemp(25), windLevel(0),
+    hasPublishedState(false), tickClock(getTickTimeUs) {}
 
 /********************************************************
 * @brief Destructor
 ********************************************************/
-DashboardController::~DashboardController() {
-    observers.clear();
-}
+DashboardController::~DashboardController() {}
 
 /********************************************************
 * @brief    getSpeed
@@ -87,15 +90,28 @@ int DashboardController::getWindLevel() const {
 
 /********************************************************
 * @brief    setSpeed
-* @details  This method sets new speed.
+* @details  This method sets new speed, negative speed is
+*           set to 0. Subscribers of onSpeedChanged are
+*           notified if speed is changed.
 * @param    newSpeed    Value to set new speed  
 * @return   None
 ********************************************************/
 void DashboardController::setSpeed(int newSpeed) {
     if (newSpeed < 0) {
-        speed = 0;
+        newSpeed = 0;
+    }
+
+    if (newSpeed == speed) {
+        return;
     }
+
+    SpeedChanged event;
+    event.oldSpeed = speed;
+    event.newSpeed = newSpeed;
+    event.tickTimeUs = tickClock();
+
     speed = newSpeed;
+    speedChanged.emit(event);
 }
 
 /********************************************************
@@ -160,134 +176,172 @@ void DashboardController::setWindLevel(int newLevel) {
 /********************************************************
 * @brief    updateData
 * @details  This method reads data from CSV file, updates
-*           new data to system parameters and notifies to
-*           observers to update new data.
+*           new data to system parameters and publishes new
+*           state to subscribers.
 * @param    None
 * @return   None
 ********************************************************/
 void DashboardController::updateData()
 {
-    ifstream file(DATABASE_PATH);
-    if (!file.is_open()) {
+    char buffer[DATABASE_MAX_SIZE];
+    size_t length;
+    if (!readFileToBuffer(DATABASE_PATH, buffer, sizeof(buffer), length)) {
         cerr << "Cannot open file " << DATABASE_PATH << endl;
         return;
     }
 
-    // Map stores system parameters and its values
-    unordered_map<string, string> data;
-    string line, key, value;
+    const char* cursor = buffer;
+    const char* end = buffer + length;
+    TelemetryValue parsed;
 
-    // Read each line and save the parameters and values ​​into the map as string
-    while (getline(file, line)) {
-        stringstream ss(line);
-        if (getline(ss, key, ',') && getline(ss, value, ',')) { 
-            data[key] = value;
+    // Read each line and save the value of the parameter it contains
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (!lineEnd) {
+            lineEnd = end;
         }
-    }
-
-    file.close();
-
-    /* Find paramters and save the correspond value */  
-
-    // Speed
-    if (data.find("SPEED") != data.end()) {
-        int newSpeed = stoi(data["SPEED"]);
-
-        if (newSpeed >= 0) {
-            speed = newSpeed;
-        }
-    }
+        const char* line = cursor;
+        cursor = lineEnd + 1;
 
-    // Drive mode
-    if (data.find("DRIVE MODE") != data.end()) {
-        string newDriveMode = data["DRIVE MODE"];
-        
-        if (newDriveMode == "ECO") {
-            driveMode = ECO;
+        if (!parseTelemetryLine(line, lineEnd, parsed)) {
+            continue;
         }
 
-        if (newDriveMode == "SPORT") {
-            driveMode = SPORT;
+        switch (parsed.field) {
+        case FIELD_SPEED:
+            if (parsed.value >= 0) {
+                setSpeed((int)parsed.value);
+            }
+            break;
+
+        case FIELD_DRIVE_MODE:
+            driveMode = parsed.driveMode;
+            break;
+
+        case FIELD_BATTERY_LEVEL:
+            if (parsed.value >= 0 && parsed.value <= 100) {
+                batteryLevel = (int)parsed.value;
+            }
+            break;
+
+        case FIELD_AC_TEMPERATURE:
+            if (parsed.value >= 0) {
+                acTemp = (int)parsed.value;
+            }
+            break;
+
+        case FIELD_WIND_LEVEL:
+            if (parsed.value >= 0) {
+                windLevel = (int)parsed.value;
+            }
+            break;
+
+        case FIELD_REMAINING_RANGE:
+            if (parsed.value >= 0.0) {
+                remainingRange = parsed.value;
+            }
+            break;
+
+        default:
+            break;
         }
     }
 
-    // Battery level
-    if (data.find("BATTERY LEVEL") != data.end()) {
-        int newBatteryLevel = stoi(data["BATTERY LEVEL"]);
-
-        if (newBatteryLevel >= 0 && newBatteryLevel <= 100) {
-            batteryLevel = newBatteryLevel;
-        }
-    }
-
-    // AC temperature
-    if (data.find("AC TEMPERATURE") != data.end()) {
-        int newTemp = stoi(data["AC TEMPERATURE"]);
+    // Publish new state to all subscribers
+    publishState();
+}
 
-        if (newTemp >= 0) {
-            acTemp = newTemp;
-        }
-    }
+/********************************************************
+* @brief    getState
+* @details  This method gets all system parameters at once.
+* @param    None
+* @return   DashboardState  Return current state
+********************************************************/
+DashboardState DashboardController::getState() const {
+    DashboardState state;
+    state.speed = speed;
+    state.driveMode = driveMode;
+    state.batteryLevel = batteryLevel;
+    state.remainingRange = remainingRange;
+    state.acTemp = acTemp;
+    state.windLevel = windLevel;
+    return state;
+}
 
-    // Wind level
-    if (data.find("WIND LEVEL") != data.end()) {
-        int newLevel = stoi(data["WIND LEVEL"]);
+/********************************************************
+* @brief    onSpeedChanged
+* @details  This method gets signal emitted when speed is
+*           changed.
+* @param    None
+* @return   Signal<SpeedChanged>&   Return signal to subscribe
+********************************************************/
+Signal<SpeedChanged>& DashboardController::onSpeedChanged() {
+    return speedChanged;
+}
 
-        if (newLevel >= 0) {
-            windLevel = newLevel;
-        }
-    }
+/********************************************************
+* @brief    onStateChanged
+* @details  This method gets signal emitted when state is
+*           published.
+* @param    None
+* @return   Signal<StateSnapshot>&  Return signal to subscribe
+********************************************************/
+Signal<StateSnapshot>& DashboardController::onStateChanged() {
+    return stateChanged;
+}
 
-    // Remaining range
-    if (data.find("REMAINING RANGE") != data.end()) {
-        double newRemainingRange = stod(data["REMAINING RANGE"]);
+/********************************************************
+* @brief    publishState
+* @details  This method builds one snapshot of current state
+*           and previous published state, then passes it to
+*           all subscribers, so every subscriber sees the
+*           same values.
+* @param    None
+* @return   None
+********************************************************/
+void DashboardController::publishState() {
+    StateSnapshot snapshot;
+    snapshot.newState = getState();
+    snapshot.oldState = hasPublishedState ? publishedState : snapshot.newState;
+    snapshot.tickTimeUs = tickClock();
 
-        if (newRemainingRange >= 0.0) {
-            remainingRange = newRemainingRange;
-        }
-    }
+    publishedState = snapshot.newState;
+    hasPublishedState = true;
 
-    // Notify to all observers
-    notifyObservers();
+    stateChanged.emit(snapshot);
 }
 
 /********************************************************
-* @brief    registerObserver
-* @details  This method registers observer to the list of 
-*           observes.
-* @param    observer  Pointer to object to register observer
-* @return   None
+* @brief    getTickTimeUs
+* @details  This method gets current monotonic time used in
+*           events.
+* @param    None
+* @return   uint64_t    Return time (us)
 ********************************************************/
-void DashboardController::registerObserver(Observer *observer) {
-    observers.push_back(observer);
+uint64_t DashboardController::getTickTimeUs() {
+    return chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 /********************************************************
-* @brief    removeObserver
-* @details  This method removes observer from the list of 
-*           observes.
-* @param    observer  Pointer to object to remove observer
-* @return   None
+* @brief    getTickTime
+* @details  This method gets time of the clock used for
+*           events, so other managers stamp the same time.
+* @param    None
+* @return   uint64_t    Return time (us)
 ********************************************************/
-void DashboardController::removeObserver(Observer *observer) {
-    vector<Observer*>::iterator it;
-
-    for (it = observers.begin(); it != observers.end(); it++) {
-        if (*it == observer) {
-            observers.erase(it);
-        }
-    }
+uint64_t DashboardController::getTickTime() const {
+    return tickClock();
 }
 
 /********************************************************
-* @brief    notifyObservers
-* @details  This method notifies to all observes in the 
-*           list about new updated data.
-* @param    None
+* @brief    setTickClock
+* @details  This method replaces clock used for time of
+*           events.
+* @param    clock   Clock function, NULL restores
+*                   getTickTimeUs
 * @return   None
 ********************************************************/
-void DashboardController::notifyObservers() const {
-    for (auto observer : observers) {
-        observer->update();
-    }
-}
\ No newline at end of file
+void DashboardController::setTickClock(TickClock clock) {
+    tickClock = clock ? clock : getTickTimeUs;
+}
@@ -0,0 +1,762 @@
+/********************************************************
+* @file     DashboardServer.cpp
+* @brief    Define methods related to the HTTP dashboard
+* @details  This file contains methods definition related to
+*           the HTTP server, includes accept connections,
+*           parse requests, serialize state into shared
+*           frames and write them to all viewers.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "DashboardServer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Epoll ids of listen socket and wake up eventfd,
+*        clients use (generation << 32) | index
+********************************************************/
+#define HTTP_LISTEN_ID      0xFFFFFFFFFFFFFFFFull
+#define HTTP_WAKE_ID        0xFFFFFFFFFFFFFFFEull
+#define HTTP_EPOLL_EVENTS   64
+
+/********************************************************
+* Static responses
+********************************************************/
+static const char pageHeader[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/html; charset=utf-8\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: close\r\n\r\n";
+
+static const char pageBody[] =
+    "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>Car Dashboard</title>"
+    "<style>body{font-family:sans-serif;background:#111;color:#eee}td{padding:4px 12px}</style>"
+    "</head><body><h1>Car Dashboard</h1><table>"
+    "<tr><td>Drive mode</td><td id=\"driveMode\">-</td></tr>"
+    "<tr><td>Speed (km/h)</td><td id=\"speed\">-</td></tr>"
+    "<tr><td>Battery level (%)</td><td id=\"batteryLevel\">-</td></tr>"
+    "<tr><td>A/C temperature (&deg;C)</td><td id=\"acTemp\">-</td></tr>"
+    "<tr><td>Wind level</td><td id=\"windLevel\">-</td></tr>"
+    "<tr><td>Remaining range (km)</td><td id=\"remainingRange\">-</td></tr>"
+    "</table><p id=\"status\">Connecting...</p><script>"
+    "var source=new EventSource(\"/events\");"
+    "source.addEventListener(\"state\",function(e){var s=JSON.parse(e.data);"
+    "for(var k in s){var c=document.getElementById(k);if(c)c.textContent=s[k];}"
+    "document.getElementById(\"status\").textContent=\"Live\";});"
+    "source.onerror=function(){document.getElementById(\"status\").textContent=\"Disconnected, retrying...\";};"
+    "</script></body></html>\n";
+
+static const char streamHeader[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: keep-alive\r\n\r\n";
+
+static const char notFoundResponse[] =
+    "HTTP/1.1 404 Not Found\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: 10\r\n"
+    "Connection: close\r\n\r\n"
+    "Not found\n";
+
+static const char badRequestResponse[] =
+    "HTTP/1.1 400 Bad Request\r\n"
+    "Content-Length: 0\r\n"
+    "Connection: close\r\n\r\n";
+
+/********************************************************
+* @brief Constructor
+* @param address  Listen address
+* @param port     Listen port
+********************************************************/
+DashboardServer::DashboardServer(const string& address, uint16_t port)
+    : address(address), port(port), isNotified(false), isStopRequested(false),
+      listenFd(-1), epollFd(-1), wakeFd(-1), latestFrame(-1), latestVersion(0), activeClients(0),
+      accepted(0), streams(0), frameCount(0), coalesced(0), dropped(0) {
+    for (int i = 0; i < HTTP_FRAME_POOL; i++) {
+        frames[i].length = 0;
+        frames[i].version = 0;
+        frames[i].references = 0;
+    }
+}
+
+/********************************************************
+* @brief Destructor, stops the server
+********************************************************/
+DashboardServer::~DashboardServer() {
+    stop();
+}
+
+/********************************************************
+* @brief    parseListen
+* @details  This method parses listen option, address is
+*           HTTP_DEFAULT_ADDRESS if only port is given.
+* @param    text        "<port>" or "<address>:<port>"
+* @param    address     Parsed address
+* @param    port        Parsed port
+* @return   bool        Return false if text is invalid
+********************************************************/
+bool DashboardServer::parseListen(const string& text, string& address, uint16_t& port) {
+    size_t colon = text.rfind(':');
+    string portText = (colon == string::npos) ? text : text.substr(colon + 1);
+    address = (colon == string::npos) ? string(HTTP_DEFAULT_ADDRESS) : text.substr(0, colon);
+
+    char* end = NULL;
+    long value = strtol(portText.c_str(), &end, 10);
+    if (portText.empty() || *end != '\0' || value <= 0 || value > 65535 || address.empty()) {
+        return false;
+    }
+    port = (uint16_t)value;
+    return true;
+}
+
+/********************************************************
+* @brief    start
+* @details  This method opens listen socket, epoll and the
+*           wake up eventfd, reserves all client slots, then
+*           starts server thread. Nothing is allocated after
+*           start.
+* @param    None
+* @return   bool        Return false if server cannot start
+********************************************************/
+bool DashboardServer::start() {
+#ifdef __linux__
+    if (worker.joinable()) {
+        return true;
+    }
+
+    // A viewer closing its connection must not stop the program
+    signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_in socketAddress;
+    memset(&socketAddress, 0, sizeof(socketAddress));
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) {
+        cerr << "Invalid HTTP address " << address << endl;
+        return false;
+    }
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int reuse = 1;
+    if (listenFd < 0
+        || setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0
+        || bind(listenFd, (sockaddr*)&socketAddress, sizeof(socketAddress)) != 0
+        || listen(listenFd, SOMAXCONN) != 0) {
+        cerr << "Cannot listen on " << address << ":" << port << ": " << strerror(errno) << endl;
+        stop();
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        cerr << "Cannot create epoll: " << strerror(errno) << endl;
+        stop();
+        return false;
+    }
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = HTTP_LISTEN_ID;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.u64 = HTTP_WAKE_ID;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    // All slots are reserved now, accept does not allocate
+    clients.resize(HTTP_MAX_CLIENTS);
+    for (size_t i = 0; i < clients.size(); i++) {
+        clients[i].fd = -1;
+        clients[i].state = HTTP_CLIENT_FREE;
+        clients[i].generation = 0;
+        clients[i].segmentCount = 0;
+    }
+
+    isStopRequested.store(false);
+    worker = thread(&DashboardServer::run, this);
+    cout << "Dashboard at http://" << address << ":" << port << "/" << endl;
+    return true;
+#else
+    cerr << "HTTP dashboard is only available on Linux" << endl;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    stop
+* @details  This method wakes server thread to exit, then
+*           closes all connections and descriptors.
+* @param    None
+* @return   None
+********************************************************/
+void DashboardServer::stop() {
+#ifdef __linux__
+    if (worker.joinable()) {
+        isStopRequested.store(true);
+        uint64_t one = 1;
+        ssize_t result = write(wakeFd, &one, sizeof(one));
+        (void)result;
+        worker.join();
+    }
+
+    for (size_t i = 0; i < clients.size(); i++) {
+        if (clients[i].state != HTTP_CLIENT_FREE) {
+            closeClient((int)i);
+        }
+    }
+
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+#endif
+}
+
+/********************************************************
+* @brief    update
+* @details  This method stores latest state and writes the
+*           eventfd only if the server has not been woken
+*           yet, many updates before the server runs cost
+*           one system call.
+* @param    snapshot    State published by DashboardController
+* @return   None
+********************************************************/
+void DashboardServer::update(const StateSnapshot& snapshot) {
+    latestState.store(snapshot.newState);
+
+#ifdef __linux__
+    if (wakeFd >= 0 && !isNotified.exchange(true)) {
+        uint64_t one = 1;
+        ssize_t result = write(wakeFd, &one, sizeof(one));
+        (void)result;
+    }
+#endif
+}
+
+/********************************************************
+* @brief    getStats
+* @details  This method reads counters of the server.
+* @param    None
+* @return   DashboardServerStats    Return counters
+********************************************************/
+DashboardServerStats DashboardServer::getStats() const {
+    DashboardServerStats stats;
+    stats.accepted = accepted.load(memory_order_relaxed);
+    stats.streams = streams.load(memory_order_relaxed);
+    stats.frames = frameCount.load(memory_order_relaxed);
+    stats.coalesced = coalesced.load(memory_order_relaxed);
+    stats.dropped = dropped.load(memory_order_relaxed);
+    return stats;
+}
+
+/********************************************************
+* @brief    nowMs
+* @details  This method gets monotonic time of the server
+*           loop.
+* @param    None
+* @return   uint64_t    Return time (ms)
+********************************************************/
+uint64_t DashboardServer::nowMs() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef __linux__
+/********************************************************
+* @brief    run
+* @details  This method is body of server thread. It waits
+*           on epoll for connections, requests, writable
+*           sockets and wake ups from update(), then drops
+*           clients that stopped reading.
+* @param    None
+* @return   None
+********************************************************/
+void DashboardServer::run() {
+    epoll_event events[HTTP_EPOLL_EVENTS];
+
+    while (!isStopRequested.load()) {
+        int count = epoll_wait(epollFd, events, HTTP_EPOLL_EVENTS, HTTP_POLL_MS);
+        if (count < 0 && errno != EINTR) {
+            cerr << "HTTP epoll failed: " << strerror(errno) << endl;
+            break;
+        }
+
+        uint64_t now = nowMs();
+        bool isWoken = false;
+
+        for (int i = 0; i < count; i++) {
+            uint64_t id = events[i].data.u64;
+
+            if (id == HTTP_LISTEN_ID) {
+                acceptClients(now);
+                continue;
+            }
+            if (id == HTTP_WAKE_ID) {
+                uint64_t value;
+                ssize_t result = read(wakeFd, &value, sizeof(value));
+                (void)result;
+                isWoken = true;
+                continue;
+            }
+
+            // Event of a connection closed earlier in this pass
+            int index = (int)(id & 0xFFFFFFFFu);
+            HttpClient& client = clients[index];
+            if (client.state == HTTP_CLIENT_FREE || client.generation != (uint32_t)(id >> 32)) {
+                continue;
+            }
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeClient(index);
+                continue;
+            }
+
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+                if (client.state == HTTP_CLIENT_REQUEST) {
+                    readRequest(index, now);
+                } else {
+                    // Viewers send nothing after request, read end of stream
+                    char scratch[256];
+                    ssize_t result = read(client.fd, scratch, sizeof(scratch));
+                    if (result == 0 || (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        closeClient(index);
+                    }
+                }
+            }
+
+            if (client.state != HTTP_CLIENT_FREE && (events[i].events & EPOLLOUT)) {
+                flushClient(index, now);
+            }
+        }
+
+        // Clear before reading state, an update after this wakes again
+        if (isWoken) {
+            isNotified.store(false);
+            broadcastLatest(now);
+        }
+
+        dropSlowClients(now);
+    }
+}
+
+/********************************************************
+* @brief    acceptClients
+* @details  This method accepts all pending connections, a
+*           connection is closed at once if all slots are
+*           used.
+* @param    nowMs   Current time (ms)
+* @return   None
+********************************************************/
+void DashboardServer::acceptClients(uint64_t nowMs) {
+    while (true) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        int index = -1;
+        if (activeClients < (int)clients.size()) {
+            for (size_t i = 0; i < clients.size(); i++) {
+                if (clients[i].state == HTTP_CLIENT_FREE) {
+                    index = (int)i;
+                    break;
+                }
+            }
+        }
+        if (index < 0) {
+            close(fd);
+            continue;
+        }
+
+        HttpClient& client = clients[index];
+        client.fd = fd;
+        client.state = HTTP_CLIENT_REQUEST;
+        client.requestLength = 0;
+        client.segmentCount = 0;
+        client.sentOffset = 0;
+        client.stalledSinceMs = nowMs;
+        client.isWaitingWritable = false;
+
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = ((uint64_t)client.generation << 32) | (uint32_t)index;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            client.fd = -1;
+            client.state = HTTP_CLIENT_FREE;
+            continue;
+        }
+
+        activeClients++;
+        accepted.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+/********************************************************
+* @brief    readRequest
+* @details  This method reads request header until the empty
+*           line, then queues the page, the event stream
+*           header with latest event, or an error response.
+* @param    index   Index of client
+* @param    nowMs   Current time (ms)
+* @return   None
+********************************************************/
+void DashboardServer::readRequest(int index, uint64_t nowMs) {
+    HttpClient& client = clients[index];
+
+    ssize_t count = read(client.fd, client.request + client.requestLength,
+        HTTP_REQUEST_SIZE - 1 - client.requestLength);
+    if (count == 0 || (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        closeClient(index);
+        return;
+    }
+    if (count < 0) {
+        return;
+    }
+
+    client.requestLength += (size_t)count;
+    client.request[client.requestLength] = '\0';
+
+    if (!strstr(client.request, "\r\n\r\n")) {
+        if (client.requestLength >= HTTP_REQUEST_SIZE - 1) {
+            client.state = HTTP_CLIENT_RESPONSE;
+            queueSegment(client, badRequestResponse, sizeof(badRequestResponse) - 1, -1);
+            flushClient(index, nowMs);
+        }
+        return;
+    }
+
+    // Request line: GET <path>[?query] HTTP/1.1
+    client.stalledSinceMs = 0;
+    const char* path = client.request + 4;
+    size_t pathLength = strcspn(path, " ?\r\n");
+
+    if (strncmp(client.request, "GET ", 4) != 0) {
+        client.state = HTTP_CLIENT_RESPONSE;
+        queueSegment(client, badRequestResponse, sizeof(badRequestResponse) - 1, -1);
+    } else if ((pathLength == 1 && path[0] == '/')
+        || (pathLength == 11 && strncmp(path, "/index.html", 11) == 0)) {
+        client.state = HTTP_CLIENT_RESPONSE;
+        queueSegment(client, pageHeader, sizeof(pageHeader) - 1, -1);
+        queueSegment(client, pageBody, sizeof(pageBody) - 1, -1);
+    } else if (pathLength == 7 && strncmp(path, "/events", 7) == 0) {
+        client.state = HTTP_CLIENT_STREAM;
+        streams.fetch_add(1, memory_order_relaxed);
+        queueSegment(client, streamHeader, sizeof(streamHeader) - 1, -1);
+        if (latestFrame >= 0) {
+            queueSegment(client, frames[latestFrame].data, frames[latestFrame].length, latestFrame);
+        }
+    } else {
+        client.state = HTTP_CLIENT_RESPONSE;
+        queueSegment(client, notFoundResponse, sizeof(notFoundResponse) - 1, -1);
+    }
+
+    flushClient(index, nowMs);
+}
+
+/********************************************************
+* @brief    broadcastLatest
+* @details  This method serializes latest state once into a
+*           frame and queues the same frame to every stream.
+*           Clients still waiting for their socket get the
+*           frame when it becomes writable.
+* @param    nowMs   Current time (ms)
+* @return   None
+********************************************************/
+void DashboardServer::broadcastLatest(uint64_t nowMs) {
+    DashboardState state;
+    uint64_t version = latestState.load(state);
+    if (latestFrame >= 0 && version == latestVersion) {
+        return;
+    }
+
+    int frame = acquireFrame();
+    HttpFrame& target = frames[frame];
+    int length = snprintf(target.data, sizeof(target.data),
+        "id: %llu\nevent: state\ndata: {\"driveMode\":\"%s\",\"speed\":%d,\"batteryLevel\":%d,"
+        "\"acTemp\":%d,\"windLevel\":%d,\"remainingRange\":%.1f}\n\n",
+        (unsigned long long)version, (state.driveMode == ECO ? "ECO" : "SPORT"), state.speed,
+        state.batteryLevel, state.acTemp, state.windLevel, state.remainingRange);
+    if (length < 0 || length >= (int)sizeof(target.data)) {
+        return;
+    }
+
+    // Server keeps one reference to the latest frame
+    target.length = (size_t)length;
+    target.version = version;
+    target.references = 1;
+    releaseFrame(latestFrame);
+    latestFrame = frame;
+    latestVersion = version;
+    frameCount.fetch_add(1, memory_order_relaxed);
+
+    for (size_t i = 0; i < clients.size(); i++) {
+        HttpClient& client = clients[i];
+        if (client.state != HTTP_CLIENT_STREAM) {
+            continue;
+        }
+
+        queueSegment(client, target.data, target.length, frame);
+        if (!client.isWaitingWritable) {
+            flushClient((int)i, nowMs);
+        }
+    }
+}
+
+/********************************************************
+* @brief    queueSegment
+* @details  This method adds a write to a client. A frame
+*           queued after another frame that is not started
+*           replaces it, so a slow client only gets the
+*           latest event.
+* @param    client  Client to write to
+* @param    data    Start of data
+* @param    length  Length of data
+* @param    frame   Index of frame, -1 for static data
+* @return   None
+********************************************************/
+void DashboardServer::queueSegment(HttpClient& client, const char* data, size_t length, int frame) {
+    if (frame >= 0) {
+        frames[frame].references++;
+    }
+
+    if (frame >= 0 && client.segmentCount > 0) {
+        HttpSegment& last = client.segments[client.segmentCount - 1];
+        bool isStarted = client.segmentCount == 1 && client.sentOffset > 0;
+        if (last.frame >= 0 && !isStarted) {
+            releaseFrame(last.frame);
+            last.data = data;
+            last.length = length;
+            last.frame = frame;
+            coalesced.fetch_add(1, memory_order_relaxed);
+            return;
+        }
+    }
+
+    if (client.segmentCount >= HTTP_MAX_SEGMENTS) {
+        releaseFrame(frame);
+        coalesced.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+
+    HttpSegment& segment = client.segments[client.segmentCount++];
+    segment.data = data;
+    segment.length = length;
+    segment.frame = frame;
+}
+
+/********************************************************
+* @brief    flushClient
+* @details  This method writes all queued segments with one
+*           writev per pass, releases finished frames and
+*           waits for EPOLLOUT if the socket is full. A
+*           response is closed when it is sent.
+* @param    index   Index of client
+* @param    nowMs   Current time (ms)
+* @return   None
+********************************************************/
+void DashboardServer::flushClient(int index, uint64_t nowMs) {
+    HttpClient& client = clients[index];
+    bool isProgress = false;
+
+    while (client.segmentCount > 0) {
+        iovec vectors[HTTP_MAX_SEGMENTS];
+        for (int i = 0; i < client.segmentCount; i++) {
+            size_t offset = (i == 0) ? client.sentOffset : 0;
+            vectors[i].iov_base = (void*)(client.segments[i].data + offset);
+            vectors[i].iov_len = client.segments[i].length - offset;
+        }
+
+        ssize_t written = writev(client.fd, vectors, client.segmentCount);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            closeClient(index);
+            return;
+        }
+
+        // Remove finished segments
+        isProgress = true;
+        size_t left = (size_t)written;
+        while (left > 0 && client.segmentCount > 0) {
+            size_t remaining = client.segments[0].length - client.sentOffset;
+            if (left < remaining) {
+                client.sentOffset += left;
+                break;
+            }
+
+            left -= remaining;
+            releaseFrame(client.segments[0].frame);
+            for (int i = 1; i < client.segmentCount; i++) {
+                client.segments[i - 1] = client.segments[i];
+            }
+            client.segmentCount--;
+            client.sentOffset = 0;
+        }
+    }
+
+    if (client.segmentCount == 0) {
+        client.stalledSinceMs = 0;
+        if (client.state == HTTP_CLIENT_RESPONSE) {
+            closeClient(index);
+            return;
+        }
+    } else if (isProgress || client.stalledSinceMs == 0) {
+        client.stalledSinceMs = nowMs;
+    }
+
+    // Wait for writable socket only while data is queued
+    bool isWaiting = client.segmentCount > 0;
+    if (isWaiting != client.isWaitingWritable) {
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP;
+        if (isWaiting) {
+            event.events |= EPOLLOUT;
+        }
+        event.data.u64 = ((uint64_t)client.generation << 32) | (uint32_t)index;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &event);
+        client.isWaitingWritable = isWaiting;
+    }
+}
+
+/********************************************************
+* @brief    closeClient
+* @details  This method closes connection, releases its
+*           frames and frees the slot. Old epoll events of
+*           the slot are ignored by generation.
+* @param    index   Index of client
+* @return   None
+********************************************************/
+void DashboardServer::closeClient(int index) {
+    HttpClient& client = clients[index];
+    if (client.state == HTTP_CLIENT_FREE) {
+        return;
+    }
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, NULL);
+    close(client.fd);
+
+    for (int i = 0; i < client.segmentCount; i++) {
+        releaseFrame(client.segments[i].frame);
+    }
+
+    client.fd = -1;
+    client.state = HTTP_CLIENT_FREE;
+    client.segmentCount = 0;
+    client.generation++;
+    activeClients--;
+}
+
+/********************************************************
+* @brief    dropSlowClients
+* @details  This method closes clients that have data queued,
+*           or have not sent a full request, without progress
+*           for HTTP_SLOW_CLIENT_MS.
+* @param    nowMs   Current time (ms)
+* @return   None
+********************************************************/
+void DashboardServer::dropSlowClients(uint64_t nowMs) {
+    for (size_t i = 0; i < clients.size(); i++) {
+        HttpClient& client = clients[i];
+        if (client.state == HTTP_CLIENT_FREE || client.stalledSinceMs == 0) {
+            continue;
+        }
+
+        if (nowMs - client.stalledSinceMs >= HTTP_SLOW_CLIENT_MS) {
+            closeClient((int)i);
+            dropped.fetch_add(1, memory_order_relaxed);
+        }
+    }
+}
+
+/********************************************************
+* @brief    acquireFrame
+* @details  This method finds a frame no one uses. If all
+*           frames are used by clients stuck on old events,
+*           clients holding the oldest frame are dropped.
+* @param    None
+* @return   int     Return index of frame
+********************************************************/
+int DashboardServer::acquireFrame() {
+    while (true) {
+        int oldest = -1;
+        for (int i = 0; i < HTTP_FRAME_POOL; i++) {
+            if (frames[i].references == 0) {
+                return i;
+            }
+            if (i != latestFrame && (oldest < 0 || frames[i].version < frames[oldest].version)) {
+                oldest = i;
+            }
+        }
+
+        for (size_t i = 0; i < clients.size(); i++) {
+            HttpClient& client = clients[i];
+            for (int j = 0; j < client.segmentCount; j++) {
+                if (client.segments[j].frame == oldest) {
+                    closeClient((int)i);
+                    dropped.fetch_add(1, memory_order_relaxed);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/********************************************************
+* @brief    releaseFrame
+* @details  This method releases one reference to a frame,
+*           the frame is free when no one uses it.
+* @param    frame   Index of frame, -1 is ignored
+* @return   None
+********************************************************/
+void DashboardServer::releaseFrame(int frame) {
+    if (frame >= 0) {
+        frames[frame].references--;
+    }
+}
+#else
+void DashboardServer::run() {}
+void DashboardServer::acceptClients(uint64_t) {}
+void DashboardServer::broadcastLatest(uint64_t) {}
+void DashboardServer::readRequest(int, uint64_t) {}
+void DashboardServer::flushClient(int, uint64_t) {}
+void DashboardServer::queueSegment(HttpClient&, const char*, size_t, int) {}
+void DashboardServer::closeClient(int) {}
+void DashboardServer::dropSlowClients(uint64_t) {}
+int DashboardServer::acquireFrame() { return 0; }
+void DashboardServer::releaseFrame(int) {}
+#endif
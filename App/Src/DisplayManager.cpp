@@ -14,11 +14,9 @@ using namespace std;
 
 /********************************************************
 * @brief Constructor
-* @param dashboardController  Pointer to dashboard controller
-*                             to get update data and display    
+* @param output   Stream to display on
 ********************************************************/
-DisplayManager::DisplayManager(DashboardController* dashboardController) 
-    : dashboardController(dashboardController) {}
+DisplayManager::DisplayManager(ostream& output) : state(), output(&output) {}
 
 /********************************************************
 * @brief Destructor
@@ -40,7 +38,7 @@ void DisplayManager::updateDisplay() {
     showClimateStatus();
     showWindLevel();
     showRemainingRange();
-    cout << endl;
+    *output << endl;
 }
 
 /********************************************************
@@ -50,7 +48,7 @@ void DisplayManager::updateDisplay() {
 * @return   None
 ********************************************************/
 void DisplayManager::showSpeed() {
-    cout << "Speed: " << dashboardController->getSpeed() << " km/h" << endl;
+    *output << "Speed: " << state.speed << " km/h" << endl;
 }
 
 /********************************************************
@@ -60,7 +58,7 @@ void DisplayManager::showSpeed() {
 * @return   None
 ********************************************************/
 void DisplayManager::showDriveMode() {
-    cout << "Drive mode: " << (dashboardController->getDriveMode() == ECO ? "ECO" : "SPORT") << endl;
+    *output << "Drive mode: " << (state.driveMode == ECO ? "ECO" : "SPORT") << endl;
 }
 
 /********************************************************
@@ -70,7 +68,7 @@ void DisplayManager::showDriveMode() {
 * @return   None
 ********************************************************/
 void DisplayManager::showBatteryStatus() {
-    cout << "Battery level: " << dashboardController->getBatteryLevel() << " %" << endl;
+    *output << "Battery level: " << state.batteryLevel << " %" << endl;
 }
 
 /********************************************************
@@ -80,7 +78,7 @@ void DisplayManager::showBatteryStatus() {
 * @return   None
 ********************************************************/
 void DisplayManager::showClimateStatus() {
-    cout << "A/C temperature: " << dashboardController->getAcTemp() << " °C" << endl;
+    *output << "A/C temperature: " << state.acTemp << " °C" << endl;
 }
 
 /********************************************************
@@ -90,7 +88,7 @@ void DisplayManager::showClimateStatus() {
 * @return   None
 ********************************************************/
 void DisplayManager::showWindLevel() {
-    cout << "Wind level: " << dashboardController->getWindLevel() << endl;
+    *output << "Wind level: " << state.windLevel << endl;
 }
 
 /********************************************************
@@ -100,17 +98,18 @@ void DisplayManager::showWindLevel() {
 * @return   None
 ********************************************************/
 void DisplayManager::showRemainingRange() {
-    cout << "Remaining range: " << dashboardController->getRemainingRange() << " km" << endl;
+    *output << "Remaining range: " << state.remainingRange << " km" << endl;
 }
 
 /********************************************************
 * @brief    update
 * @details  This method will be called when Dashboard
-*           Controller update data and notify to observer  
-*           Display Manager.
-* @param    None
+*           Controller publishes new state, all values are
+*           taken from the same snapshot.
+* @param    snapshot    State published by DashboardController
 * @return   None
 ********************************************************/
-void DisplayManager::update() {
+void DisplayManager::update(const StateSnapshot& snapshot) {
+    state = snapshot.newState;
     updateDisplay();
 }
\ No newline at end of file
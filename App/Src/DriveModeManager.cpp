@@ -16,13 +16,27 @@ using namespace std;
 * @brief Constructor
 ********************************************************/
 DriveModeManager::DriveModeManager() : currentDriveMode(ECO), 
-    powerOutputSport(300), powerOutputEco(220), maxEcoSpeed(150) {}
+    powerOutputSport(DEFAULT_POWER_OUTPUT_SPORT), powerOutputEco(DEFAULT_POWER_OUTPUT_ECO),
+    maxEcoSpeed(DEFAULT_MAX_ECO_SPEED) {}
 
 /********************************************************
 * @brief Destructor
 ********************************************************/
 DriveModeManager::~DriveModeManager() {}
 
+/********************************************************
+* @brief    applyProfile
+* @details  This method applies power output and Eco speed
+*           limit of vehicle profile, drive mode is kept.
+* @param    profile     Parameters of vehicle variant
+* @return   None
+********************************************************/
+void DriveModeManager::applyProfile(const VehicleProfile& profile) {
+    powerOutputSport = profile.powerOutputSport;
+    powerOutputEco = profile.powerOutputEco;
+    maxEcoSpeed = profile.maxEcoSpeed;
+}
+
 /********************************************************
 * @brief    setDriveMode
 * @details  This method sets drive mode.
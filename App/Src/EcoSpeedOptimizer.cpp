@@ -0,0 +1,434 @@
+/********************************************************
+* @file     EcoSpeedOptimizer.cpp
+* @brief    Define methods related to eco driving speed
+*           advice
+* @details  This file contains methods definition related
+*           to the speed profile optimizer, includes building
+*           the grid of a route, dynamic programming over
+*           the grid on several threads and bisection of the
+*           price of time until the budget is met.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "EcoSpeedOptimizer.hpp"
+#include "ParallelFor.hpp"
+#include <barrier>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+/********************************************************
+* @brief Cost of a grid point that cannot be reached
+********************************************************/
+static const double UNREACHABLE = numeric_limits<double>::infinity();
+
+/********************************************************
+* @brief Constructor
+* @param batteryManager   Pointer to battery manager with
+*                         the drain model and capacity
+********************************************************/
+EcoSpeedOptimizer::EcoSpeedOptimizer(const BatteryManager* batteryManager)
+    : batteryManager(batteryManager), costOffset(0), columnCount(0), startIndex(0), speedCount(0), rowStride(0),
+      drainBase(0), drainSlope(0), lambda(0), lambdaLow(0), lambdaHigh(-1), column(0), isDone(true),
+      plan(), budgetHours(0) {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+EcoSpeedOptimizer::~EcoSpeedOptimizer() {}
+
+/********************************************************
+* @brief    optimize
+* @details  This method cuts the route into steps of at
+*           most ECO_STEP_KM and runs dynamic programming,
+*           each run minimizes energy + lambda * time. A
+*           higher lambda gives a faster profile, lambda is
+*           raised until the budget is met, then bisected to
+*           the slowest profile that still meets it. Each
+*           thread owns a block of grid speeds that starts
+*           on a cache line, the last thread to reach the
+*           barrier moves all threads to the next position.
+* @param    query       Route, budget and conditions
+* @param    workers     Number of threads (0 use hardware
+*                       threads, limited by grid size)
+* @return   EcoPlan     Return energy and time of the plan
+********************************************************/
+EcoPlan EcoSpeedOptimizer::optimize(const EcoQuery& query, unsigned int workers) {
+    plan = EcoPlan();
+    plan.isFeasible = false;
+    columnCount = 0;
+    bestProfile.clear();
+
+    if (query.segmentCount == 0 || query.budgetHours <= 0.0) {
+        cerr << "Route and time budget are needed to plan speed" << endl;
+        return plan;
+    }
+
+    // Positions, start is position 0
+    columnKm.assign(1, 0.0);
+    columnGrade.assign(1, 1.0);
+    columnLimit.assign(1, 0);
+    columnSegment.assign(1, 0);
+    int highestLimit = 0;
+
+    for (size_t i = 0; i < query.segmentCount; i++) {
+        const RouteSegment& segment = query.segments[i];
+        if (segment.lengthKm <= 0.0) {
+            continue;
+        }
+
+        double gradeFactor = 1.0 + segment.gradePercent * ROUTE_GRADE_FACTOR;
+        if (gradeFactor < ROUTE_MIN_GRADE_FACTOR) {
+            gradeFactor = ROUTE_MIN_GRADE_FACTOR;
+        }
+
+        size_t steps = (size_t)ceil(segment.lengthKm / ECO_STEP_KM);
+        uint16_t limit = (uint16_t)(segment.speedLimit / ECO_SPEED_STEP);
+
+        // Speed at the boundary obeys limits of both segments
+        if (limit < columnLimit.back() || columnKm.size() == 1) {
+            columnLimit.back() = limit;
+        }
+        for (size_t step = 0; step < steps; step++) {
+            columnKm.push_back(segment.lengthKm / steps);
+            columnGrade.push_back(gradeFactor);
+            columnLimit.push_back(limit);
+            columnSegment.push_back((uint32_t)i);
+        }
+
+        highestLimit = max(highestLimit, segment.speedLimit);
+        plan.distanceKm += segment.lengthKm;
+    }
+
+    columnCount = columnKm.size();
+    if (columnCount < 2) {
+        cerr << "Route has no length to plan speed" << endl;
+        columnCount = 0;
+        return plan;
+    }
+
+    // Grid speeds, start speed may be above all limits
+    int startSpeed = max(query.startSpeed, 0);
+    speedCount = (size_t)(max(highestLimit, startSpeed) / ECO_SPEED_STEP) + 1;
+    speeds.resize(speedCount);
+    for (size_t i = 0; i < speedCount; i++) {
+        speeds[i] = i * ECO_SPEED_STEP;
+    }
+    columnLimit[0] = (uint16_t)(speedCount - 1);
+    startIndex = (size_t)(startSpeed / ECO_SPEED_STEP + 0.5);
+
+    // 2 rows of costs, each row starts on a cache line
+    rowStride = (speedCount + ECO_CACHE_LINE_COSTS - 1) / ECO_CACHE_LINE_COSTS * ECO_CACHE_LINE_COSTS;
+    costs.resize(2 * rowStride + ECO_CACHE_LINE_COSTS);
+    uintptr_t address = (uintptr_t)costs.data();
+    size_t lineBytes = ECO_CACHE_LINE_COSTS * sizeof(double);
+    costOffset = ((lineBytes - address % lineBytes) % lineBytes) / sizeof(double);
+
+    previous.resize(columnCount * rowStride);
+    profile.resize(columnCount);
+    stepCosts.resize(2 * speedCount - 1);
+
+    // Drain model is linear in speed, take it from BatteryManager
+    drainBase = numericToDouble(batteryManager->calculateBatteryDrain(0, query.acTemp, query.windLevel));
+    drainSlope = (numericToDouble(batteryManager->calculateBatteryDrain(100, query.acTemp, query.windLevel))
+        - drainBase) / 100.0;
+
+    // Threads, each gets whole cache lines of speeds
+    if (workers == 0) {
+        workers = defaultWorkerCount();
+    }
+    unsigned int maxWorkers = (unsigned int)max((size_t)1, speedCount / ECO_SPEEDS_PER_WORKER);
+    if (workers > maxWorkers) {
+        workers = maxWorkers;
+    }
+    size_t lines = rowStride / ECO_CACHE_LINE_COSTS;
+
+    // First multiplier: marginal energy of the average
+    // speed that meets the budget
+    budgetHours = query.budgetHours;
+    double averageSpeed = plan.distanceKm / budgetHours;
+    lambdaLow = 0.0;
+    lambdaHigh = -1.0;
+    isDone = false;
+    startRun(max(drainSlope * averageSpeed * averageSpeed, 1e-6));
+
+    auto completion = [this]() noexcept { advance(); };
+    barrier<decltype(completion)> sync(workers, completion);
+
+    parallelFor(workers, workers, [this, &sync, lines, workers](size_t, size_t, unsigned int worker) {
+        size_t begin = min(lines * worker / workers * ECO_CACHE_LINE_COSTS, speedCount);
+        size_t end = min(lines * (worker + 1) / workers * ECO_CACHE_LINE_COSTS, speedCount);
+
+        while (!isDone) {
+            relaxColumn(begin, end);
+            sync.arrive_and_wait();
+        }
+    });
+
+    if (bestProfile.empty()) {
+        cerr << "Cannot slow down from " << startSpeed << " km/h to the speed limit" << endl;
+        columnCount = 0;
+        return plan;
+    }
+
+    double capacity = numericToDouble(batteryManager->getBatteryCapacity());
+    plan.finalSoc = query.startSoc;
+    if (capacity > 0.0) {
+        plan.finalSoc -= plan.energyKwh / capacity * 100.0;
+    }
+    return plan;
+}
+
+/********************************************************
+* @brief    relaxColumn
+* @details  This method finds the best previous speed for
+*           each speed of the block. Previous speeds are
+*           limited by acceleration and deceleration over the
+*           step, v^2 changes by at most 2 * a * distance.
+*           Cost of a step is read from the table of
+*           prepareColumn().
+* @param    begin   First speed index
+* @param    end     Speed index after the last one
+* @return   None
+********************************************************/
+void EcoSpeedOptimizer::relaxColumn(size_t begin, size_t end) {
+    const double* previousCosts = costs.data() + costOffset + ((column - 1) & 1) * rowStride;
+    double* currentCosts = costs.data() + costOffset + (column & 1) * rowStride;
+    uint16_t* best = previous.data() + column * rowStride;
+
+    double accelReach = 2.0 * ECO_MAX_ACCEL * columnKm[column] * 1000.0 * 3.6 * 3.6;
+    double decelReach = 2.0 * ECO_MAX_DECEL * columnKm[column] * 1000.0 * 3.6 * 3.6;
+    size_t minIndex = (size_t)ceil(ECO_MIN_SPEED / ECO_SPEED_STEP);
+    size_t limit = columnLimit[column];
+
+    // Only speeds reached at previous position are read
+    size_t previousFirst = (column == 1) ? startIndex : minIndex;
+    size_t previousLast = (column == 1) ? startIndex : columnLimit[column - 1];
+
+    for (size_t j = begin; j < end; j++) {
+        if (j < minIndex || j > limit) {
+            currentCosts[j] = UNREACHABLE;
+            best[j] = 0;
+            continue;
+        }
+
+        // Previous speeds that reach speed j in this step
+        double speed = speeds[j];
+        double lowest = sqrt(max(speed * speed - accelReach, 0.0));
+        double highest = sqrt(speed * speed + decelReach);
+        size_t first = max((size_t)ceil(lowest / ECO_SPEED_STEP), previousFirst);
+        size_t last = min((size_t)(highest / ECO_SPEED_STEP), previousLast);
+
+        // Cost of step only depends on i + j
+        const double* stepCost = stepCosts.data() + j;
+        double bestCost = UNREACHABLE;
+        uint16_t bestIndex = 0;
+        for (size_t i = first; i <= last; i++) {
+            double cost = previousCosts[i] + stepCost[i];
+            bool isBetter = cost < bestCost;
+            bestCost = isBetter ? cost : bestCost;
+            bestIndex = isBetter ? (uint16_t)i : bestIndex;
+        }
+
+        currentCosts[j] = bestCost;
+        best[j] = bestIndex;
+    }
+}
+
+/********************************************************
+* @brief    prepareColumn
+* @details  This method fills cost of the step before the
+*           current position for each sum of 2 speed indexes.
+*           Energy uses the average speed of the step, like
+*           RoutePredictor uses speed of a segment, time is
+*           priced by lambda.
+* @param    None
+* @return   None
+********************************************************/
+void EcoSpeedOptimizer::prepareColumn() {
+    double distanceKm = columnKm[column];
+    double energyBase = distanceKm * columnGrade[column] * drainBase;
+    double energySlope = distanceKm * columnGrade[column] * drainSlope * 0.5;
+    double timeCost = distanceKm * lambda * 2.0;
+
+    stepCosts[0] = UNREACHABLE;
+    for (size_t k = 1; k < stepCosts.size(); k++) {
+        double sum = k * ECO_SPEED_STEP;
+        stepCosts[k] = energyBase + energySlope * sum + timeCost / sum;
+    }
+}
+
+/********************************************************
+* @brief    startRun
+* @details  This method starts dynamic programming with a
+*           new multiplier, only the start speed has a cost
+*           at position 0.
+* @param    value   Multiplier (kWh/h)
+* @return   None
+********************************************************/
+void EcoSpeedOptimizer::startRun(double value) {
+    lambda = value;
+    column = 1;
+
+    double* startCosts = costs.data() + costOffset;
+    for (size_t i = 0; i < rowStride; i++) {
+        startCosts[i] = UNREACHABLE;
+    }
+
+    startCosts[startIndex] = 0.0;
+    prepareColumn();
+}
+
+/********************************************************
+* @brief    advance
+* @details  This method moves workers to the next position.
+*           After the destination, the profile is traced and
+*           the multiplier is raised while the budget is not
+*           met, then bisected between the fastest profile
+*           known too slow and the slowest one in budget.
+* @param    None
+* @return   None
+********************************************************/
+void EcoSpeedOptimizer::advance() {
+    if (++column < columnCount) {
+        prepareColumn();
+        return;
+    }
+
+    double energyKwh = 0.0;
+    double durationHours = 0.0;
+    traceProfile(energyKwh, durationHours);
+    plan.iterations++;
+
+    // Destination cannot be reached, start speed is too
+    // high to slow down to the first speed limit
+    if (durationHours == UNREACHABLE) {
+        isDone = true;
+        return;
+    }
+
+    bool isInBudget = durationHours <= budgetHours;
+    if (isInBudget) {
+        lambdaHigh = lambda;
+    } else {
+        lambdaLow = lambda;
+    }
+
+    // Keep slowest profile in budget, or fastest profile if
+    // none is in budget yet
+    if (isInBudget || (!plan.isFeasible && (bestProfile.empty() || durationHours < plan.durationHours))) {
+        bestProfile = profile;
+        plan.energyKwh = energyKwh;
+        plan.durationHours = durationHours;
+        plan.lambda = lambda;
+        plan.isFeasible = isInBudget;
+    }
+
+    bool isClose = isInBudget && durationHours >= budgetHours * (1.0 - ECO_TIME_TOLERANCE);
+    if (isClose || plan.iterations >= ECO_BISECT_ITERATIONS) {
+        isDone = true;
+        return;
+    }
+
+    if (lambdaHigh < 0.0) {
+        if (lambda >= ECO_MAX_LAMBDA) {
+            isDone = true;
+            return;
+        }
+        startRun(min(lambda * 4.0, ECO_MAX_LAMBDA));
+        return;
+    }
+
+    // Price of time is known closely enough, profiles on
+    // the grid do not change any more
+    double middle = (lambdaLow + lambdaHigh) / 2.0;
+    if (lambdaHigh - lambdaLow < lambdaHigh * ECO_LAMBDA_TOLERANCE) {
+        isDone = true;
+        return;
+    }
+    startRun(middle);
+}
+
+/********************************************************
+* @brief    traceProfile
+* @details  This method picks the cheapest speed at the
+*           destination and follows best previous speeds back
+*           to the start.
+* @param    energyKwh       Energy of profile (kWh)
+* @param    durationHours   Time of profile (h)
+* @return   None
+********************************************************/
+void EcoSpeedOptimizer::traceProfile(double& energyKwh, double& durationHours) {
+    const double* lastCosts = costs.data() + costOffset + ((columnCount - 1) & 1) * rowStride;
+
+    size_t index = 0;
+    for (size_t i = 1; i < speedCount; i++) {
+        if (lastCosts[i] < lastCosts[index]) {
+            index = i;
+        }
+    }
+
+    energyKwh = 0.0;
+    durationHours = 0.0;
+    if (lastCosts[index] == UNREACHABLE) {
+        durationHours = UNREACHABLE;
+        return;
+    }
+
+    for (size_t c = columnCount - 1; c > 0; c--) {
+        profile[c] = (uint16_t)index;
+        size_t before = previous[c * rowStride + index];
+
+        double averageSpeed = (speeds[before] + speeds[index]) / 2.0;
+        energyKwh += columnKm[c] * columnGrade[c] * (drainBase + drainSlope * averageSpeed);
+        durationHours += columnKm[c] / averageSpeed;
+        index = before;
+    }
+    profile[0] = (uint16_t)index;
+}
+
+/********************************************************
+* @brief    getPositionCount
+* @details  This method gets number of positions of last
+*           plan.
+* @param    None
+* @return   size_t  Return number of positions, start included
+********************************************************/
+size_t EcoSpeedOptimizer::getPositionCount() const {
+    return bestProfile.empty() ? 0 : columnCount;
+}
+
+/********************************************************
+* @brief    getSpeed
+* @details  This method gets planned speed at a position.
+* @param    position    Index of position
+* @return   double      Return speed (km/h)
+********************************************************/
+double EcoSpeedOptimizer::getSpeed(size_t position) const {
+    return speeds[bestProfile[position]];
+}
+
+/********************************************************
+* @brief    getSegmentSpeed
+* @details  This method gets average planned speed of one
+*           segment, length of segment divided by its time.
+* @param    segment     Index of segment
+* @return   double      Return speed (km/h), 0 if segment
+*                       is not in the plan
+********************************************************/
+double EcoSpeedOptimizer::getSegmentSpeed(size_t segment) const {
+    double distanceKm = 0.0;
+    double durationHours = 0.0;
+
+    for (size_t c = 1; c < getPositionCount(); c++) {
+        if (columnSegment[c] != segment) {
+            continue;
+        }
+        distanceKm += columnKm[c];
+        durationHours += columnKm[c] / ((speeds[bestProfile[c - 1]] + speeds[bestProfile[c]]) / 2.0);
+    }
+
+    return durationHours > 0.0 ? distanceKm / durationHours : 0.0;
+}
@@ -0,0 +1,133 @@
+/********************************************************
+* @file     FileBuffer.cpp
+* @brief    Define methods related to whole file read and
+*           write with caller buffers
+* @details  This file contains methods definition related
+*           to reading a file into a caller buffer and
+*           writing a buffer to a file with native handles.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "FileBuffer.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief    readFileToBuffer
+* @details  This function reads whole file into a buffer,
+*           a file larger than the buffer is rejected.
+* @param    path        Path to file
+* @param    buffer      Buffer to fill
+* @param    capacity    Size of buffer (bytes)
+* @param    length      Number of bytes read
+* @return   bool        Return true if file is read and fits
+*                       in the buffer
+********************************************************/
+bool readFileToBuffer(const char* path, char* buffer, size_t capacity, size_t& length) {
+    length = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // Fill buffer, then check nothing is left
+    bool isRead = true;
+    while (length < capacity) {
+        DWORD count = 0;
+        if (!ReadFile(file, buffer + length, (DWORD)(capacity - length), &count, NULL)) {
+            isRead = false;
+            break;
+        }
+        if (count == 0) {
+            break;
+        }
+        length += count;
+    }
+    if (isRead && length == capacity) {
+        char extra;
+        DWORD count = 0;
+        isRead = ReadFile(file, &extra, 1, &count, NULL) && count == 0;
+    }
+    CloseHandle(file);
+#else
+    int file = open(path, O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    // Fill buffer, then check nothing is left
+    bool isRead = true;
+    while (length < capacity) {
+        ssize_t count = read(file, buffer + length, capacity - length);
+        if (count <= 0) {
+            isRead = (count == 0);
+            break;
+        }
+        length += (size_t)count;
+    }
+    if (isRead && length == capacity) {
+        char extra;
+        isRead = (read(file, &extra, 1) == 0);
+    }
+    close(file);
+#endif
+
+    return isRead;
+}
+
+/********************************************************
+* @brief    writeBufferToFile
+* @details  This function replaces content of a file with
+*           a buffer, the file is created if not exists.
+* @param    path        Path to file
+* @param    data        Content to write
+* @param    length      Number of bytes to write
+* @return   bool        Return true if all bytes are written
+********************************************************/
+bool writeBufferToFile(const char* path, const char* data, size_t length) {
+    size_t written = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_WRITE, FILE_SHARE_READ, NULL,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    while (written < length) {
+        DWORD count = 0;
+        if (!WriteFile(file, data + written, (DWORD)(length - written), &count, NULL) || count == 0) {
+            break;
+        }
+        written += count;
+    }
+    CloseHandle(file);
+#else
+    int file = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        return false;
+    }
+
+    while (written < length) {
+        ssize_t count = write(file, data + written, length - written);
+        if (count <= 0) {
+            break;
+        }
+        written += (size_t)count;
+    }
+    close(file);
+#endif
+
+    return written == length;
+}
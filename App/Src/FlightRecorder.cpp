@@ -0,0 +1,353 @@
+/********************************************************
+* @file     FlightRecorder.cpp
+* @brief    Define methods related to the flight recorder
+* @details  This file contains methods definition related to
+*           the flight recorder, includes storing a tick into
+*           the ring, the signal handler that dumps the ring
+*           and reading a dump file.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "FlightRecorder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Signal handler reads the ring without lock
+********************************************************/
+static_assert((FLIGHT_RECORDER_TICKS & (FLIGHT_RECORDER_TICKS - 1)) == 0, "Ticks must be a power of 2");
+static_assert(atomic<uint64_t>::is_always_lock_free, "Tick counter must be lock free");
+static_assert(atomic<FlightRecorder*>::is_always_lock_free, "Installed recorder must be lock free");
+
+#define FLIGHT_SIGNAL_STACK_SIZE    65536   /* Stack of handler, a stack overflow is a SIGSEGV */
+#define FLIGHT_MAX_RECORDS          (1u << 20)  /* Most records read from a dump */
+
+/********************************************************
+* @brief Recorder dumped by the signal handler
+********************************************************/
+static atomic<FlightRecorder*> installedRecorder(NULL);
+
+#ifdef __linux__
+static char signalStack[FLIGHT_SIGNAL_STACK_SIZE];
+static const int dumpSignals[] = { SIGSEGV, SIGABRT, SIGUSR2 };
+
+/********************************************************
+* @brief    writeAll
+* @details  This function writes a whole buffer, a write cut
+*           by a signal is continued. Async-signal-safe.
+* @param    fd          Open file
+* @param    data        Content to write
+* @param    length      Number of bytes to write
+* @return   bool        Return true if all bytes are written
+********************************************************/
+static bool writeAll(int fd, const void* data, size_t length) {
+    const char* cursor = static_cast<const char*>(data);
+    while (length > 0) {
+        ssize_t count = write(fd, cursor, length);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        cursor += count;
+        length -= (size_t)count;
+    }
+    return true;
+}
+#endif
+
+/********************************************************
+* @brief Constructor, all slots are empty
+********************************************************/
+FlightRecorder::FlightRecorder() : ticks(0) {
+    memset(records, 0, sizeof(records));
+    memset(dumpPath, 0, sizeof(dumpPath));
+}
+
+/********************************************************
+* @brief Destructor, removes signal handlers
+********************************************************/
+FlightRecorder::~FlightRecorder() {
+    uninstall();
+}
+
+/********************************************************
+* @brief    record
+* @details  This method stores one tick over the oldest
+*           record. The tick number goes into tickEnd before
+*           other fields and into tick after them, so a dump
+*           taken in the middle of the write is found torn.
+*           Only commands up to FLIGHT_EVENTS_PER_TICK are
+*           kept, commandCount tells how many were applied.
+* @param    state           State after the tick
+* @param    cruiseSpeed     Cruise set speed (km/h), 0 if off
+* @param    inputs          FlightInput bits of held controls
+* @param    commands        Commands applied, may be NULL
+* @param    count           Number of commands
+* @param    timestampNs     Monotonic time of tick (ns)
+* @return   None
+********************************************************/
+void FlightRecorder::record(const DashboardState& state, int cruiseSpeed, uint16_t inputs,
+    const VehicleCommand* commands, size_t count, uint64_t timestampNs) {
+    // Only the control tick writes, no read-modify-write needed
+    uint64_t tick = ticks.load(memory_order_relaxed) + 1;
+    FlightRecord& slot = records[(tick - 1) & (FLIGHT_RECORDER_TICKS - 1)];
+
+    slot.tickEnd = tick;
+    atomic_thread_fence(memory_order_release);
+
+    slot.timestampNs = timestampNs;
+    slot.remainingRange = state.remainingRange;
+    slot.speed = state.speed;
+    slot.batteryLevel = state.batteryLevel;
+    slot.acTemp = state.acTemp;
+    slot.windLevel = state.windLevel;
+    slot.cruiseSpeed = cruiseSpeed;
+    slot.commandCount = commands ? (uint32_t)count : 0;
+    slot.driveMode = (uint8_t)state.driveMode;
+    slot.inputs = inputs;
+
+    size_t kept = min(slot.commandCount, (uint32_t)FLIGHT_EVENTS_PER_TICK);
+    for (size_t i = 0; i < kept; i++) {
+        const VehicleCommand& command = commands[i];
+        uint64_t latencyUs = timestampNs > command.timestampNs ? (timestampNs - command.timestampNs) / 1000 : 0;
+
+        FlightEvent& event = slot.events[i];
+        event.type = (uint8_t)command.type;
+        event.source = (uint8_t)command.source;
+        event.latencyUs = (uint16_t)min(latencyUs, (uint64_t)UINT16_MAX);
+        event.value = command.value;
+    }
+
+    atomic_thread_fence(memory_order_release);
+    slot.tick = tick;
+    ticks.store(tick, memory_order_release);
+}
+
+/********************************************************
+* @brief    install
+* @details  This method keeps the dump path and sets handlers
+*           of SIGSEGV, SIGABRT and SIGUSR2. The handler runs
+*           on its own stack so a stack overflow is dumped
+*           too, the stack is set for the calling thread. A
+*           crash signal is raised again with default action
+*           after the dump.
+* @param    path    Dump file, replaced by each dump
+* @return   bool    Return false if handlers cannot be set
+********************************************************/
+bool FlightRecorder::install(const string& path) {
+#ifdef __linux__
+    if (path.empty() || path.size() >= sizeof(dumpPath)) {
+        cerr << "Invalid flight recorder path " << path << endl;
+        return false;
+    }
+    memset(dumpPath, 0, sizeof(dumpPath));
+    memcpy(dumpPath, path.c_str(), path.size());
+
+    stack_t stack;
+    memset(&stack, 0, sizeof(stack));
+    stack.ss_sp = signalStack;
+    stack.ss_size = sizeof(signalStack);
+    if (sigaltstack(&stack, NULL) != 0) {
+        cerr << "Cannot set signal stack: " << strerror(errno) << endl;
+        return false;
+    }
+
+    installedRecorder.store(this, memory_order_release);
+
+    for (size_t i = 0; i < sizeof(dumpSignals) / sizeof(dumpSignals[0]); i++) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = &FlightRecorder::handleSignal;
+        action.sa_flags = SA_ONSTACK | SA_RESTART;
+        if (dumpSignals[i] != SIGUSR2) {
+            action.sa_flags |= SA_RESETHAND;
+        }
+
+        // No second dump while one is written
+        sigemptyset(&action.sa_mask);
+        for (size_t j = 0; j < sizeof(dumpSignals) / sizeof(dumpSignals[0]); j++) {
+            sigaddset(&action.sa_mask, dumpSignals[j]);
+        }
+
+        if (sigaction(dumpSignals[i], &action, NULL) != 0) {
+            cerr << "Cannot set signal handler: " << strerror(errno) << endl;
+            uninstall();
+            return false;
+        }
+    }
+
+    cout << "Flight recorder dumps to " << path << " on crash or SIGUSR2 (pid " << getpid() << ")" << endl;
+    return true;
+#else
+    (void)path;
+    cerr << "Flight recorder dump is only available on Linux" << endl;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    uninstall
+* @details  This method gives default action back to the
+*           signals if this recorder is installed.
+* @param    None
+* @return   None
+********************************************************/
+void FlightRecorder::uninstall() {
+    FlightRecorder* expected = this;
+    if (!installedRecorder.compare_exchange_strong(expected, NULL)) {
+        return;
+    }
+
+#ifdef __linux__
+    for (size_t i = 0; i < sizeof(dumpSignals) / sizeof(dumpSignals[0]); i++) {
+        signal(dumpSignals[i], SIG_DFL);
+    }
+#endif
+}
+
+/********************************************************
+* @brief    dump
+* @details  This method writes header and the ring in slot
+*           order, the reader sorts records by tick. Only
+*           async-signal-safe calls are used.
+* @param    fd      Open file
+* @param    signal  Signal written in header
+* @return   bool    Return false if a write failed
+********************************************************/
+bool FlightRecorder::dump(int fd, int signal) const {
+#ifdef __linux__
+    FlightDumpHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FLIGHT_DUMP_MAGIC, sizeof(header.magic));
+    header.version = FLIGHT_DUMP_VERSION;
+    header.recordSize = sizeof(FlightRecord);
+    header.recordCount = FLIGHT_RECORDER_TICKS;
+    header.signal = signal;
+    header.ticks = ticks.load(memory_order_acquire);
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    header.dumpTimeNs = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+
+    return writeAll(fd, &header, sizeof(header)) && writeAll(fd, records, sizeof(records));
+#else
+    (void)fd;
+    (void)signal;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    getTicks
+* @details  This method gets number of ticks recorded since
+*           start, the last FLIGHT_RECORDER_TICKS are kept.
+* @param    None
+* @return   uint64_t    Return number
+********************************************************/
+uint64_t FlightRecorder::getTicks() const {
+    return ticks.load(memory_order_relaxed);
+}
+
+#ifdef __linux__
+/********************************************************
+* @brief    handleSignal
+* @details  This method dumps the installed recorder. The
+*           handler of a crash signal was reset, so raising
+*           it again ends the program with default action
+*           when the handler returns.
+* @param    signal  Received signal
+* @return   None
+********************************************************/
+void FlightRecorder::handleSignal(int signal) {
+    int savedErrno = errno;
+
+    FlightRecorder* recorder = installedRecorder.load(memory_order_acquire);
+    if (recorder) {
+        int fd = open(recorder->dumpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd >= 0) {
+            recorder->dump(fd, signal);
+            close(fd);
+        }
+    }
+
+    if (signal != SIGUSR2) {
+        raise(signal);
+    }
+    errno = savedErrno;
+}
+#else
+void FlightRecorder::handleSignal(int) {}
+#endif
+
+/********************************************************
+* @brief    readDump
+* @details  This method reads a dump file and checks its
+*           header. Empty slots are left out, a record with
+*           different tick numbers was written during the
+*           dump and is counted as torn.
+* @param    path        Dump file
+* @param    header      Header of dump
+* @param    records     Complete records, oldest first
+* @param    torn        Number of torn records
+* @return   bool        Return false if file is not a dump
+********************************************************/
+bool FlightRecorder::readDump(const string& path, FlightDumpHeader& header, vector<FlightRecord>& records,
+    size_t& torn) {
+    records.clear();
+    torn = 0;
+
+    ifstream file(path.c_str(), ios::binary);
+    if (!file.is_open()) {
+        cerr << "Cannot open " << path << endl;
+        return false;
+    }
+
+    if (!file.read((char*)&header, sizeof(header))
+        || memcmp(header.magic, FLIGHT_DUMP_MAGIC, sizeof(header.magic)) != 0) {
+        cerr << path << " is not a flight recorder dump" << endl;
+        return false;
+    }
+    if (header.version != FLIGHT_DUMP_VERSION || header.recordSize != sizeof(FlightRecord)
+        || header.recordCount > FLIGHT_MAX_RECORDS) {
+        cerr << path << " has unsupported version " << header.version << " or record size "
+             << header.recordSize << endl;
+        return false;
+    }
+
+    vector<FlightRecord> slots(header.recordCount);
+    if (!file.read((char*)slots.data(), (streamsize)(slots.size() * sizeof(FlightRecord)))) {
+        cerr << path << " is truncated" << endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (slots[i].tick == 0 && slots[i].tickEnd == 0) {
+            continue;
+        }
+        if (slots[i].tick != slots[i].tickEnd) {
+            torn++;
+            continue;
+        }
+        records.push_back(slots[i]);
+    }
+
+    sort(records.begin(), records.end(), [](const FlightRecord& a, const FlightRecord& b) {
+        return a.tick < b.tick;
+    });
+    return true;
+}
@@ -2,10 +2,10 @@
 * @file     Main.cpp
 * @brief    Main program
 * @details  This file contains the main program use 
-*           multithreading to display data (speed, mode, 
-*           battery level,...), data will be updated to
-*           display when use keyboard to adjust parameters
-*           (accelerator, brake, ...).
+*           cooperative tasks on one thread to display data
+*           (speed, mode, battery level,...), data will be
+*           updated to display when use keyboard to adjust
+*           parameters (accelerator, brake, ...).
 * @version  1.0
 * @date     2024-11-10
 * @author   Tran Quang Khai
@@ -15,371 +15,1288 @@
 using namespace std;
 
 /********************************************************
-* @brief Variable mutex ensures only one thread can access 
-*        DashboardController object at a time
+* @brief Variable in the functions that run as tasks and
+*        can stop the loop when this variable is false
 ********************************************************/
+bool isRunning = true;
 
-mutex mtx;
+/********************************************************
+* @brief Variable is true when data comes from a CAN log
+*        instead of Database.csv
+********************************************************/
+bool isReplayingCAN = false;
+
+/********************************************************
+* @brief Number of keyboard ticks before the program stops,
+*        0 runs until stopped
+********************************************************/
+long tickLimit = 0;
+
+/********************************************************
+* @brief Number of keyboard ticks run
+********************************************************/
+long keyboardTicks = 0;
+
+/********************************************************
+* @brief Stage timing and counters of --perf, NULL when
+*        not requested. Stages of the control tick are
+*        registered by VehiclePipeline
+********************************************************/
+PerfStats* perfStats = NULL;
+int stageCsv = -1;
+int stageDisplay = -1;
 
 /********************************************************
-* @brief Variable in the functions that use for create 
-*        thread and can stop the loop when this variable 
-*        is false 
+* @brief Record of last keyboard ticks, dumped on crash or
+*        SIGUSR2. Kept out of the stack of main because of
+*        its size
 ********************************************************/
-atomic<bool> isRunning(true);
-void readCSV(DashboardController* dashboardController);
-void keyboardInputHandler(DashboardController* dashboardController, SpeedCalculator* speedCalculator, 
-    DriveModeManager* driveMode, SafetyManager* safetyManager, BatteryManager* batteryManager);
-void display(DashboardController *dashboardController);
-void saveToCSV(DashboardController* dashboardController);
+FlightRecorder mainFlightRecorder;
+FlightRecorder* flightRecorder = NULL;
+
+/********************************************************
+* @brief Export of tick history as Arrow IPC, NULL when
+*        not requested
+********************************************************/
+TelemetryExporter* telemetryExporter = NULL;
+
+Task readCSV(TaskExecutor* executor, DashboardController* dashboardController, StateEstimator* stateEstimator);
+Task replayCAN(TaskExecutor* executor, DashboardController* dashboardController,
+    CanLogReplayer* canLogReplayer, ReplayMode mode, StateEstimator* stateEstimator);
+Task keyboardInputHandler(TaskExecutor* executor, DashboardController* dashboardController,
+    SpeedCalculator* speedCalculator, DriveModeManager* driveMode, SafetyManager* safetyManager,
+    BatteryManager* batteryManager, TripComputer* tripComputer, const VehicleProfileStore* profileStore,
+    PersistenceWriter* persistenceWriter, ClimateAdvisor* climateAdvisor, RuleEngine* ruleEngine,
+    CommandQueue* commandQueue, CommandStats* commandStats);
+DriverInput readKeys();
+void submitKeyCommands(CommandQueue* commandQueue, const DriverInput& keys, const DriverInput& previousKeys);
+Task runScript(TaskExecutor* executor, CommandQueue* commandQueue, const string* path);
+#ifdef __linux__
+Task readConsole(TaskExecutor* executor, CommandQueue* commandQueue);
+#endif
+Task watchProfile(TaskExecutor* executor, VehicleProfileStore* profileStore);
+Task display(TaskExecutor* executor, DashboardController *dashboardController, TripComputer* tripComputer,
+    const RoutePredictor* routePredictor, const vector<RouteSegment>* route,
+    const ChargingStationIndex* stationIndex, const PositionSimulator* positionSimulator,
+    const BatteryManager* batteryManager, const SpeedCalculator* speedCalculator, RuleEngine* ruleEngine,
+    const ClimateAdvisor* climateAdvisor, const StateEstimator* stateEstimator);
+Task cruiseControl(TaskExecutor* executor, SpeedCalculator* speedCalculator,
+    const DriveModeManager* driveMode, CruiseLoopStats* stats);
+void startSteadyState(bool isAllocationCheck);
+bool reportAllocations(bool isAllocationCheck);
+void stopDashboardServer(DashboardServer* dashboardServer);
+void stopTelemetryExporter(TelemetryExporter* exporter, const string& path);
+void dumpPerfStats(const char* unit, uint64_t ticks);
 /********************************************************
 * @brief Main function
+* @details Run without arguments to simulate the vehicle
+*          with keyboard, or replay a candump log with:
+*          Main.exe --can <log> [--map <signal map>] [--fast]
+*          Vehicle parameters are read from a profile file,
+*          selected with --profile <profile>, state of charge
+*          at destination is predicted with --route <route>,
+*          charging stations are read from --stations <file>,
+*          alarms and derived signals from --rules <file>,
+*          cell level pack model is used with --pack <layout>
+*          --durability <none|writes:N|interval:MS> selects
+*          when saved data is synced to disk,
+*          --http <[address:]port> serves the dashboard to
+*          browsers on this address,
+*          --cruise-rate <Hz> sets steps per second of the
+*          cruise control loop,
+*          --perf times the control tick, CSV parse and
+*          display render with hardware counters,
+*          --raw shows samples as read instead of the
+*          filtered speed and state of charge,
+*          --control <socket> takes command lines from test
+*          automation on a Unix domain socket,
+*          --script <file> runs a file of command lines,
+*          command lines can also be typed or piped on
+*          stdin on Linux,
+*          --record <file> sets the file of the flight
+*          recorder dump,
+*          --arrow <file> exports tick history as Arrow IPC,
+*          stream format for a .arrows file, with
+*          --arrow-rows <N> rows in each record batch,
+*          --ticks <N> stops after N keyboard ticks and
+*          --alloc-check reports heap allocations after
+*          startup, exit code is 1 if there is any
 ********************************************************/
-int main() 
+int main(int argc, char* argv[]) 
 {
+    /* Parse command line */
+    string canLogPath;
+    string signalMapPath = CAN_SIGNAL_MAP_PATH;
+    string profilePath = VEHICLE_PROFILE_PATH;
+    string routePath;
+    string stationPath = CHARGING_STATION_PATH;
+    string packLayout;
+    string durability = PERSIST_DEFAULT_DURABILITY;
+    string httpListen;
+    string rulesPath = RULES_PATH;
+    string controlPath;
+    string scriptPath;
+    string recordPath = FLIGHT_RECORDER_PATH;
+    string arrowPath;
+    long arrowRows = ARROW_DEFAULT_BATCH_ROWS;
+    int cruiseRate = CRUISE_DEFAULT_RATE_HZ;
+    ReplayMode replayMode = REPLAY_REAL_TIME;
+    bool isAllocationCheck = false;
+    bool isPerf = false;
+    bool isRaw = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--can" && i + 1 < argc) {
+            canLogPath = argv[++i];
+        } else if (arg == "--map" && i + 1 < argc) {
+            signalMapPath = argv[++i];
+        } else if (arg == "--fast") {
+            replayMode = REPLAY_FAST;
+        } else if (arg == "--profile" && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else if (arg == "--route" && i + 1 < argc) {
+            routePath = argv[++i];
+        } else if (arg == "--stations" && i + 1 < argc) {
+            stationPath = argv[++i];
+        } else if (arg == "--pack" && i + 1 < argc) {
+            packLayout = argv[++i];
+        } else if (arg == "--durability" && i + 1 < argc) {
+            durability = argv[++i];
+        } else if (arg == "--rules" && i + 1 < argc) {
+            rulesPath = argv[++i];
+        } else if (arg == "--http" && i + 1 < argc) {
+            httpListen = argv[++i];
+        } else if (arg == "--cruise-rate" && i + 1 < argc) {
+            cruiseRate = atoi(argv[++i]);
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            tickLimit = atol(argv[++i]);
+        } else if (arg == "--alloc-check") {
+            isAllocationCheck = true;
+        } else if (arg == "--perf") {
+            isPerf = true;
+        } else if (arg == "--raw") {
+            isRaw = true;
+        } else if (arg == "--control" && i + 1 < argc) {
+            controlPath = argv[++i];
+        } else if (arg == "--script" && i + 1 < argc) {
+            scriptPath = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--arrow" && i + 1 < argc) {
+            arrowPath = argv[++i];
+        } else if (arg == "--arrow-rows" && i + 1 < argc) {
+            arrowRows = atol(argv[++i]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--profile <profile>] [--route <route>] [--stations <file>]"
+                 << " [--rules <file>]"
+                 << " [--pack <layout such as " << PACK_DEFAULT_LAYOUT << ">]"
+                 << " [--durability <none|writes:N|interval:MS>] [--http <[address:]port>]"
+                 << " [--cruise-rate <1-" << CRUISE_MAX_RATE_HZ << ">]"
+                 << " [--control <socket>] [--script <file>] [--record <file>]"
+                 << " [--arrow <file> [--arrow-rows N]]"
+                 << " [--can <log> [--map <signal map>] [--fast]] [--ticks N] [--alloc-check] [--perf] [--raw]" << endl;
+            return 1;
+        }
+    }
+
+    DurabilityPolicy durabilityPolicy;
+    if (!PersistenceWriter::parseDurability(durability, durabilityPolicy)) {
+        cerr << "Invalid durability " << durability << endl;
+        return 1;
+    }
+
+    string httpAddress;
+    uint16_t httpPort = 0;
+    if (!httpListen.empty() && !DashboardServer::parseListen(httpListen, httpAddress, httpPort)) {
+        cerr << "Invalid HTTP address " << httpListen << endl;
+        return 1;
+    }
+
+    if (arrowRows <= 0) {
+        cerr << "Invalid Arrow batch rows " << arrowRows << endl;
+        return 1;
+    }
+
+    if (isAllocationCheck && !AllocationTracker::isEnabled()) {
+        cerr << "Allocation check needs a build with DASHBOARD_ALLOC_TRACKING" << endl;
+        return 1;
+    }
+
+    /* Time stages, counters are left out if the system has none */
+    PerfStats mainPerfStats;
+    if (isPerf) {
+        if (!mainPerfStats.openCounters()) {
+            cerr << "Stages are timed without counters" << endl;
+        }
+        perfStats = &mainPerfStats;
+        stageCsv = perfStats->addStage("csv");
+        stageDisplay = perfStats->addStage("display");
+    }
+
     /* Initialize system component object */ 
     DashboardController dashboardController;
-    DisplayManager displayManager(&dashboardController);
+    DisplayManager displayManager;
     SpeedCalculator speedCalculator;
     BatteryManager batteryManager;
     DriveModeManager driveModeManager;
     SafetyManager safetyManager;
+    TripComputer tripComputer(&batteryManager);
+    TaskExecutor executor;
+    VehicleProfileStore profileStore(profilePath);
+    RoutePredictor routePredictor(&batteryManager);
+    ClimateAdvisor climateAdvisor(&batteryManager);
+    StateEstimator stateEstimator(&batteryManager);
+    vector<RouteSegment> route;
 
-    /* Register DisplayManager object to Observer */  
-    dashboardController.registerObserver(&displayManager);
+    /* Samples are filtered unless raw values are requested */
+    StateEstimator* sampleFilter = isRaw ? NULL : &stateEstimator;
 
-    /* Create threads */ 
-    thread t1(readCSV, &dashboardController);
-    
-    thread t2(keyboardInputHandler, &dashboardController, 
+    /* Cruise loop rate, each step uses the same dt */
+    if (!speedCalculator.setCruiseRate(cruiseRate)) {
+        cerr << "Invalid cruise rate " << cruiseRate << endl;
+        return 1;
+    }
+
+    /* Load route to predict, display skips prediction without route */
+    if (!routePath.empty() && !loadRoute(routePath, route)) {
+        return 1;
+    }
+
+    /* Load charging stations, warning shows no station without them */
+    ChargingStationIndex stationIndex;
+    PositionSimulator positionSimulator;
+    stationIndex.load(stationPath);
+
+    /* Load vehicle parameters, defaults are used if profile is invalid */
+    profileStore.load();
+    applyVehicleProfile(&profileStore, &speedCalculator, &driveModeManager, &batteryManager);
+
+    /* Cell level pack model, sized for the loaded battery capacity */
+    unsigned int packSeries, packParallel;
+    BatteryPack::parseLayout(PACK_DEFAULT_LAYOUT, packSeries, packParallel);
+    if (!packLayout.empty() && !BatteryPack::parseLayout(packLayout, packSeries, packParallel)) {
+        cerr << "Invalid pack layout " << packLayout << endl;
+        return 1;
+    }
+    BatteryPack batteryPack(packSeries, packParallel, numericToDouble(batteryManager.getBatteryCapacity()));
+    if (!packLayout.empty()) {
+        batteryManager.attachPack(&batteryPack);
+    }
+
+    /* Compile rules, only low battery warning without rule file */
+    RuleEngine ruleEngine;
+    if (!ruleEngine.load(rulesPath)) {
+        ruleEngine.addRule(RULE_DEFAULT_LOW_BATTERY);
+    }
+
+    /* Subscribe DisplayManager object to state changes */  
+    dashboardController.onStateChanged().subscribe<DisplayManager, &DisplayManager::update>(&displayManager);
+
+    /* Subscribe PositionSimulator object to state changes */
+    dashboardController.onStateChanged().subscribe<PositionSimulator, &PositionSimulator::update>(&positionSimulator);
+
+    /* Serve dashboard to browsers, server thread only wakes on state changes */
+    DashboardServer dashboardServer(httpAddress, httpPort);
+    if (!httpListen.empty()) {
+        if (!dashboardServer.start()) {
+            return 1;
+        }
+        dashboardController.onStateChanged().subscribe<DashboardServer, &DashboardServer::update>(&dashboardServer);
+    }
+
+    /* Tick history for analysis tools, exporter thread writes the batches */
+    TelemetryExporter exporter(arrowPath, (size_t)arrowRows);
+    if (!arrowPath.empty()) {
+        if (!exporter.start()) {
+            return 1;
+        }
+        telemetryExporter = &exporter;
+    }
+
+    /* Replay CAN log, data comes only from the log */
+    if (!canLogPath.empty()) {
+        CanLogReplayer canLogReplayer;
+        if (!canLogReplayer.loadSignalMap(signalMapPath) || !canLogReplayer.open(canLogPath)) {
+            return 1;
+        }
+        isReplayingCAN = true;
+
+        // No control tick, trip and rules run on published states
+        dashboardController.onStateChanged().subscribe<TripComputer, &TripComputer::update>(&tripComputer);
+        dashboardController.onStateChanged().subscribe<RuleEngine, &RuleEngine::update>(&ruleEngine);
+
+        // No keyboard ticks, each published state is a row
+        if (telemetryExporter) {
+            dashboardController.onStateChanged().subscribe<TelemetryExporter, &TelemetryExporter::update>(
+                telemetryExporter);
+        }
+
+        executor.spawn(replayCAN(&executor, &dashboardController, &canLogReplayer, replayMode, sampleFilter));
+        executor.spawn(display(&executor, &dashboardController, &tripComputer, &routePredictor, &route,
+            &stationIndex, &positionSimulator, &batteryManager, &speedCalculator, &ruleEngine, &climateAdvisor,
+            sampleFilter));
+        startSteadyState(isAllocationCheck);
+        executor.run();
+
+        cout << "Replayed " << canLogReplayer.getFramesDecoded() << " frames, skipped "
+             << canLogReplayer.getFramesSkipped() << " lines" << endl;
+        if (sampleFilter) {
+            cout << "Filtered " << sampleFilter->getSamples() << " samples, "
+                 << sampleFilter->getOutliers() << " outliers" << endl;
+        }
+        if (telemetryExporter) {
+            stopTelemetryExporter(telemetryExporter, arrowPath);
+        }
+        if (perfStats) {
+            dumpPerfStats("displays", perfStats->getStage(stageDisplay).calls);
+        }
+        if (!httpListen.empty()) {
+            stopDashboardServer(&dashboardServer);
+        }
+        return reportAllocations(isAllocationCheck) ? 0 : 1;
+    }
+
+    /* Save data on writer thread, control loop only queues it */
+    PersistenceWriter persistenceWriter(DATABASE_PATH, durabilityPolicy);
+    if (!persistenceWriter.start()) {
+        return 1;
+    }
+
+    /* Commands of keyboard, control socket and script, applied by the control tick */
+    CommandQueue commandQueue;
+    CommandStats commandStats = {};
+    ControlServer controlServer(controlPath, &commandQueue);
+    if (!controlPath.empty() && !controlServer.start()) {
+        return 1;
+    }
+
+    /* Always-on record of last ticks, dump is only written by a signal */
+    if (mainFlightRecorder.install(recordPath)) {
+        flightRecorder = &mainFlightRecorder;
+    }
+
+    /* Create tasks, all run on this thread */ 
+    executor.spawn(readCSV(&executor, &dashboardController, sampleFilter));
+
+    executor.spawn(keyboardInputHandler(&executor, &dashboardController, 
                 &speedCalculator, &driveModeManager, 
-                &safetyManager, &batteryManager);
+                &safetyManager, &batteryManager, &tripComputer, &profileStore,
+                &persistenceWriter, &climateAdvisor, &ruleEngine, &commandQueue, &commandStats));
+
+    if (!scriptPath.empty()) {
+        executor.spawn(runScript(&executor, &commandQueue, &scriptPath));
+    }
+
+#ifdef __linux__
+    // Command lines typed or piped on stdin
+    executor.spawn(readConsole(&executor, &commandQueue));
+#endif
+
+    // Holds set speed between keyboard ticks
+    CruiseLoopStats cruiseStats = {};
+    executor.spawn(cruiseControl(&executor, &speedCalculator, &driveModeManager, &cruiseStats));
+
+#ifndef DASHBOARD_STATIC_ALLOC
+    // Reload allocates a new parameter block, profile is
+    // fixed at startup in the static allocation build
+    executor.spawn(watchProfile(&executor, &profileStore));
+#endif
+
+    executor.spawn(display(&executor, &dashboardController, &tripComputer, &routePredictor, &route,
+            &stationIndex, &positionSimulator, &batteryManager, &speedCalculator, &ruleEngine, &climateAdvisor,
+            sampleFilter));
 
-    thread mainTask(display, &dashboardController);
+    startSteadyState(isAllocationCheck);
+    executor.run();
 
-    t1.join();
-    t2.join();
-    mainTask.join();
+    persistenceWriter.stop();
+    PersistenceStats persistStats = persistenceWriter.getStats();
+    cout << "Saved " << persistStats.writes << " of " << persistStats.submitted << " snapshots with "
+         << persistenceWriter.getBackendName() << " (" << persistStats.coalesced << " coalesced, "
+         << persistStats.dropped << " dropped, " << persistStats.syncs << " syncs, "
+         << persistStats.errors << " errors)" << endl;
+    if (telemetryExporter) {
+        stopTelemetryExporter(telemetryExporter, arrowPath);
+    }
+    cout << "Cruise loop: " << cruiseStats.steps << " steps at " << speedCalculator.getCruiseRate()
+         << " Hz, " << cruiseStats.skipped << " skipped, max lateness " << cruiseStats.maxLatenessUs
+         << " us" << endl;
+    if (sampleFilter) {
+        cout << "Filtered " << sampleFilter->getSamples() << " samples, "
+             << sampleFilter->getOutliers() << " outliers" << endl;
+    }
+    controlServer.stop();
+    cout << "Commands: " << commandQueue.getSubmitted(COMMAND_SOURCE_KEYBOARD) << " keyboard, "
+         << commandQueue.getSubmitted(COMMAND_SOURCE_SOCKET) << " socket, "
+         << commandQueue.getSubmitted(COMMAND_SOURCE_SCRIPT) << " script, " << commandStats.applied
+         << " applied in " << commandStats.batches << " batches (largest " << commandStats.largestBatch
+         << "), max latency " << commandStats.maxLatencyUs << " us, " << commandQueue.getDropped()
+         << " refused by full queue" << endl;
+    if (!controlPath.empty()) {
+        ControlServerStats controlStats = controlServer.getStats();
+        cout << "Control socket: " << controlStats.accepted << " connections, " << controlStats.commands
+             << " commands, " << controlStats.invalid << " invalid, " << controlStats.dropped
+             << " dropped" << endl;
+    }
+    if (flightRecorder) {
+        flightRecorder->uninstall();
+        cout << "Flight recorder: " << flightRecorder->getTicks() << " ticks, last "
+             << min(flightRecorder->getTicks(), (uint64_t)FLIGHT_RECORDER_TICKS) << " kept for dump" << endl;
+    }
+    if (perfStats) {
+        dumpPerfStats("keyboard ticks", (uint64_t)keyboardTicks);
+    }
+    if (!httpListen.empty()) {
+        stopDashboardServer(&dashboardServer);
+    }
 	
-    return 0;
+    return reportAllocations(isAllocationCheck) ? 0 : 1;
+}
+
+/********************************************************
+* @brief    stopDashboardServer
+* @details  This function stops HTTP dashboard and prints
+*           its counters.
+* @param    dashboardServer     Pointer to DashboardServer object
+* @return   None
+********************************************************/
+void stopDashboardServer(DashboardServer* dashboardServer) {
+    dashboardServer->stop();
+    DashboardServerStats serverStats = dashboardServer->getStats();
+    cout << "Served " << serverStats.frames << " events to " << serverStats.streams << " viewers of "
+         << serverStats.accepted << " connections (" << serverStats.coalesced << " coalesced, "
+         << serverStats.dropped << " dropped)" << endl;
+}
+
+/********************************************************
+* @brief    stopTelemetryExporter
+* @details  This function writes the last Arrow batch and
+*           prints counters of the exporter.
+* @param    exporter    Pointer to TelemetryExporter object
+* @param    path        Exported file
+* @return   None
+********************************************************/
+void stopTelemetryExporter(TelemetryExporter* exporter, const string& path) {
+    exporter->stop();
+    TelemetryExportStats exportStats = exporter->getStats();
+    cout << "Exported " << exportStats.rows << " rows in " << exportStats.batches << " Arrow batches ("
+         << exportStats.bytes << " bytes) to " << path << ", " << exportStats.dropped << " dropped, "
+         << exportStats.errors << " errors" << endl;
+}
+
+/********************************************************
+* @brief    dumpPerfStats
+* @details  This function prints time and counters of the
+*           stages of --perf.
+* @param    unit        Name of what the stages are spread over
+* @param    ticks       Number of units
+* @return   None
+********************************************************/
+void dumpPerfStats(const char* unit, uint64_t ticks) {
+    cout << "Stages over " << ticks << " " << unit << ":" << endl;
+    perfStats->dump(cout, ticks);
+}
+
+/********************************************************
+* @brief    startSteadyState
+* @details  This function marks end of startup, all objects
+*           and tasks exist. The static allocation build
+*           stops at the first heap allocation from now on,
+*           unless allocations are only counted for a check.
+* @param    isAllocationCheck   Count allocations instead of
+*                               stopping the program
+* @return   None
+********************************************************/
+void startSteadyState(bool isAllocationCheck) {
+#ifdef DASHBOARD_STATIC_ALLOC
+    const bool isStaticBuild = true;
+#else
+    const bool isStaticBuild = false;
+#endif
+    AllocationTracker::markInitDone(isStaticBuild && !isAllocationCheck);
+}
+
+/********************************************************
+* @brief    reportAllocations
+* @details  This function prints heap allocations after
+*           startup for an allocation check.
+* @param    isAllocationCheck   Allocation check is requested
+* @return   bool    Return false if check found allocations
+********************************************************/
+bool reportAllocations(bool isAllocationCheck) {
+    if (!isAllocationCheck) {
+        return true;
+    }
+
+    unsigned long allocations = AllocationTracker::getAllocationsAfterInit();
+    cout << "Heap allocations after init: " << allocations << " (total "
+         << AllocationTracker::getTotalAllocations() << ")" << endl;
+    return allocations == 0;
 }
 
 /********************************************************
 * @brief    readCSV
-* @details  This function reads data from CSV file and 
-*           update data to DashboardController.
+* @details  This task reads data from CSV file and 
+*           update data to DashboardController every 1s.
+*           Speed and battery level go through the filter,
+*           at the TIMESTAMP of the file if it has one or at
+*           time of reading.
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
 * @param    dashboardController Pointer to DashboardController 
 *                               object that receive updated data
-* @return   None 
+* @param    stateEstimator      Pointer to StateEstimator object
+*                               that filters samples, NULL sets
+*                               samples as read
+* @return   Task 
 ********************************************************/
-void readCSV(DashboardController* dashboardController) {
+Task readCSV(TaskExecutor* executor, DashboardController* dashboardController, StateEstimator* stateEstimator) {
     // Check NULL pointer 
-    if (!dashboardController) {
-        return;
+    if (!executor || !dashboardController) {
+        co_return;
     }
 
     while(isRunning)
     {
-        // Lock
-        unique_lock<mutex> lock(mtx);
+        PerfMark mark;
+        if (perfStats) {
+            perfStats->mark(mark);
+        }
 
-        ifstream file(DATABASE_PATH);
-        if (!file.is_open()) {
+        char buffer[DATABASE_MAX_SIZE];
+        size_t length;
+        if (!readFileToBuffer(DATABASE_PATH, buffer, sizeof(buffer), length)) {
             cerr << "Cannot open file " << DATABASE_PATH << endl;
-            return;
+            co_return;
         }
 
-        // Map stores system parameters and its values 
-        unordered_map<string, string> data; 
-        string line, key, value;
+        const char* cursor = buffer;
+        const char* end = buffer + length;
+        TelemetryValue parsed;
+        double sampleTime = chrono::duration<double>(TaskClock::now().time_since_epoch()).count();
+        double speed = -1.0;
+        double batteryLevel = -1.0;
 
-        // Read each line and save the parameters and values ​​into the map as string
-        while (getline(file, line)) {
-            stringstream ss(line);
-            if (getline(ss, key, ',') && getline(ss, value, ',')) { 
-                data[key] = value;
+        // Read each line and update the parameter it contains
+        while (cursor < end) {
+            const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+            if (!lineEnd) {
+                lineEnd = end;
             }
-        }
+            const char* line = cursor;
+            cursor = lineEnd + 1;
 
-        file.close();
+            if (!parseTelemetryLine(line, lineEnd, parsed)) {
+                continue;
+            }
 
-        /* Find paramters and save the correspond value */
+            switch (parsed.field) {
+            case FIELD_SPEED:
+                speed = parsed.value;
+                break;
 
-        // Speed
-        if (data.find("SPEED") != data.end()) {
-            int newSpeed = stoi(data["SPEED"]);
+            case FIELD_DRIVE_MODE:
+                dashboardController->setDriveMode(parsed.driveMode);
+                break;
 
-            if (newSpeed >= 0) {
-                dashboardController->setSpeed(newSpeed);
-            }
-        }
+            case FIELD_BATTERY_LEVEL:
+                batteryLevel = parsed.value;
+                break;
 
-        // Drive mode
-        if (data.find("DRIVE MODE") != data.end()) {
-            string newDriveMode = data["DRIVE MODE"];
-            
-            if (newDriveMode == "ECO") {
-                dashboardController->setDriveMode(ECO);
-            }
+            case FIELD_AC_TEMPERATURE:
+                if (parsed.value >= 0) {
+                    dashboardController->setAcTemp((int)parsed.value);
+                }
+                break;
 
-            if (newDriveMode == "SPORT") {
-                dashboardController->setDriveMode(SPORT);
-            }
-        }
+            case FIELD_WIND_LEVEL:
+                if (parsed.value >= 0) {
+                    dashboardController->setWindLevel((int)parsed.value);
+                }
+                break;
 
-        // Battery level
-        if (data.find("BATTERY LEVEL") != data.end()) {
-            int newLevel = stoi(data["BATTERY LEVEL"]);
+            case FIELD_REMAINING_RANGE:
+                if (parsed.value >= 0.0) {
+                    dashboardController->setRemainingRange(parsed.value);
+                }
+                break;
+
+            case FIELD_TIMESTAMP:
+                if (parsed.value >= 0.0) {
+                    sampleTime = parsed.value / 1000.0;
+                }
+                break;
 
-            if (newLevel >= 0 && newLevel <= 100) {
-                dashboardController->setBatteryLevel(newLevel);
+            default:
+                break;
             }
         }
 
-        // AC temperature
-        if (data.find("AC TEMPERATURE") != data.end()) {
-            int newTemp = stoi(data["AC TEMPERATURE"]);
-
-            if (newTemp >= 0) {
-                dashboardController->setAcTemp(newTemp);
+        // Samples are used after the whole file, climate and
+        // time may come after them
+        if (stateEstimator) {
+            stateEstimator->setClimate(dashboardController->getAcTemp(), dashboardController->getWindLevel());
+            if (speed >= 0) {
+                stateEstimator->updateSpeed(sampleTime, speed);
+                dashboardController->setSpeed((int)floor(stateEstimator->getSpeed() + 0.5));
+            }
+            if (batteryLevel >= 0 && batteryLevel <= 100) {
+                stateEstimator->updateSoc(sampleTime, batteryLevel);
+                dashboardController->setBatteryLevel((int)floor(stateEstimator->getSoc() + 0.5));
+            }
+        } else {
+            if (speed >= 0) {
+                dashboardController->setSpeed((int)speed);
+            }
+            if (batteryLevel >= 0 && batteryLevel <= 100) {
+                dashboardController->setBatteryLevel((int)batteryLevel);
             }
         }
 
-        // Wind level
-        if (data.find("WIND LEVEL") != data.end()) {
-            int newLevel = stoi(data["WIND LEVEL"]);
-
-            if (newLevel >= 0) {
-                dashboardController->setAcTemp(newLevel);
-            }
+        if (perfStats) {
+            perfStats->record(stageCsv, mark);
         }
+        co_await executor->sleepFor(1000);
+    }
+}
+
+/********************************************************
+* @brief    replayCAN
+* @details  This task replays CAN log to DashboardController
+*           and stops the program when the log is finished.
+*           Real time replay waits for the timestamp of each
+*           frame, fast replay lets other tasks run after
+*           each batch of frames.
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
+* @param    dashboardController Pointer to DashboardController 
+*                               object that receive replayed data
+* @param    canLogReplayer      Pointer to CanLogReplayer object
+*                               with opened log and signal map
+* @param    mode                Real time or fast replay
+* @param    stateEstimator      Pointer to StateEstimator object
+*                               that filters samples, NULL sets
+*                               samples as decoded
+* @return   Task 
+********************************************************/
+Task replayCAN(TaskExecutor* executor, DashboardController* dashboardController,
+    CanLogReplayer* canLogReplayer, ReplayMode mode, StateEstimator* stateEstimator) {
+    // Check NULL pointer 
+    if (!executor || !dashboardController || !canLogReplayer) {
+        co_return;
+    }
 
-        // Remaining range
-        if (data.find("REMAINING RANGE") != data.end()) {
-            double newRemainingRange = stod(data["REMAINING RANGE"]);
+    CanFrame frame;
+    bool isFirstFrame = true;
+    int64_t firstTimestampUs = 0;
+    TaskClock::time_point startTime;
+    unsigned int framesInBatch = 0;
 
-            if (newRemainingRange >= 0.0) {
-                dashboardController->setRemainingRange(newRemainingRange);
+    while (isRunning && canLogReplayer->nextFrame(frame)) {
+        if (mode == REPLAY_REAL_TIME) {
+            if (isFirstFrame) {
+                firstTimestampUs = frame.timestampUs;
+                startTime = TaskClock::now();
+                isFirstFrame = false;
             }
-        }
 
-        delay_ms(1000);
+            TaskClock::time_point frameTime =
+                startTime + chrono::microseconds(frame.timestampUs - firstTimestampUs);
+            if (frameTime > TaskClock::now()) {
+                co_await executor->sleepUntil(frameTime);
+            }
+        } else if (++framesInBatch == CAN_REPLAY_BATCH) {
+            framesInBatch = 0;
+            co_await executor->yield();
+        }
 
-        // Unlock
-        lock.unlock();
+        canLogReplayer->applyFrame(frame, dashboardController, stateEstimator);
     }
+
+    isRunning = false;
 }
 
 /********************************************************
 * @brief    keyboardInputHandler
-* @details  This function handles input from keyboard, 
-*           new data will updated to DashboardController
-*           and save this data to CSV file.
+* @details  This task handles input from keyboard every
+*           100ms, new data will updated to DashboardController
+*           and queued to be saved to CSV file. Keys become
+*           commands in the same queue as the control socket
+*           and scripts, each tick applies all queued commands
+*           in one batch.
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
 * @param    dashboardController Pointer to DashboardController object
 * @param    speedCalculator     Pointer to SpeedCalculator object    
 * @param    driveMode           Pointer to DriveModeManager object
 * @param    safetyManager       Pointer to SafetyManager object    
 * @param    batteryManager      Pointer to BatteryManager object
-* @return   None
+* @param    tripComputer        Pointer to TripComputer object
+* @param    profileStore        Pointer to VehicleProfileStore object
+*                               that publishes vehicle parameters
+* @param    persistenceWriter   Pointer to PersistenceWriter object
+*                               that saves data to CSV file
+* @param    climateAdvisor      Pointer to ClimateAdvisor object
+*                               run after each tick
+* @param    ruleEngine          Pointer to RuleEngine object
+*                               evaluated each tick
+* @param    commandQueue        Pointer to CommandQueue object
+*                               with commands of all producers
+* @param    commandStats        Pointer to counters of applied
+*                               commands
+* @return   Task
 ********************************************************/
-void keyboardInputHandler(DashboardController* dashboardController, SpeedCalculator* speedCalculator, 
-    DriveModeManager* driveMode, SafetyManager* safetyManager, BatteryManager* batteryManager) {
+Task keyboardInputHandler(TaskExecutor* executor, DashboardController* dashboardController,
+    SpeedCalculator* speedCalculator, DriveModeManager* driveMode, SafetyManager* safetyManager,
+    BatteryManager* batteryManager, TripComputer* tripComputer, const VehicleProfileStore* profileStore,
+    PersistenceWriter* persistenceWriter, ClimateAdvisor* climateAdvisor, RuleEngine* ruleEngine,
+    CommandQueue* commandQueue, CommandStats* commandStats) {
     
     // Check NULL pointer
-    if (!dashboardController || !speedCalculator || !driveMode || !safetyManager) {
-        return;
+    if (!executor || !dashboardController || !speedCalculator || !driveMode || !safetyManager
+        || !batteryManager || !tripComputer || !profileStore || !persistenceWriter || !climateAdvisor
+        || !ruleEngine || !commandQueue || !commandStats) {
+        co_return;
     }
 
-    // Map stores state of keys that use for change data
-    unordered_map<char, bool> keyStates; 
+    // Same tick runs in the pipeline benchmark
+    VehiclePipeline pipeline(dashboardController, speedCalculator, driveMode, safetyManager,
+        batteryManager, tripComputer, profileStore);
+    pipeline.start();
+    pipeline.setPerfStats(perfStats);
+    pipeline.setClimateAdvisor(climateAdvisor);
+    pipeline.setFlightRecorder(flightRecorder);
+    pipeline.setRuleEngine(ruleEngine);
 
-    // Initial variables use for calculate data per 100ms and save into DashboardController
-    bool isAccelerating = false;
-    bool isBraking = false;  
-    int acTemp = dashboardController->getAcTemp();
-    int windLevel = dashboardController->getWindLevel();
-    int speed = dashboardController->getSpeed();
-    DriveMode mode = dashboardController->getDriveMode();
-    int batteryLevel = dashboardController->getBatteryLevel();
-    double remainingRange = dashboardController->getRemainingRange();
-
-    speedCalculator->setCurrentSpeed(speed);
-    driveMode->setDriveMode(mode);
+    DriverInput previousKeys = {};
+    VehicleCommand commands[COMMAND_BATCH_SIZE];
 
     while (isRunning)
     {
-        /* Check key states and process paramters remotely change via keyboard */ 
-
-        // Accelerator
-        if (GetAsyncKeyState('A') & 0x8000) {  // Key 'a' is pressed
-            keyStates['a'] = true;  // Mark key 'a' is pressed
-            isAccelerating = true;
-            isBraking = false;
-            
-            // Accelerator is pressed, brake is not pressed
-            speed = speedCalculator->calculateSpeed(true, false);   
-
-            if (driveMode->getCurrentDriveMode() == ECO) {
-                speedCalculator->adjustSpeedForDriveMode(ECO);
-            } else {
-                speedCalculator->adjustSpeedForDriveMode(SPORT);
+        /* Check key states, paramters are changed remotely via keyboard */
+        DriverInput keys = readKeys();
+        submitKeyCommands(commandQueue, keys, previousKeys);
+        previousKeys = keys;
+
+        // All commands since last tick, in order of submit
+        size_t count = commandQueue->drain(commands, COMMAND_BATCH_SIZE);
+        if (count > 0) {
+            uint64_t nowNs = PerfStats::nowNs();
+            uint64_t latencyUs = (nowNs - commands[0].timestampNs) / 1000;
+            if (latencyUs > commandStats->maxLatencyUs) {
+                commandStats->maxLatencyUs = latencyUs;
             }
-            
-            speed = speedCalculator->getCurrentSpeed();
-        } else {
-            keyStates['a'] = false; // Reset state if key is not pressed
-            isAccelerating = false;
-        }
-
-        // Brake
-        if (GetAsyncKeyState('B') & 0x8000) {  // Key 'b' is pressed
-            keyStates['b'] = true;  // Mark key 'b' is pressed
-            isBraking = true;
-            isAccelerating = false;
-            
-            // Accelerator is not pressed, brake is pressed
-            speed = speedCalculator->calculateSpeed(false, true);   
-        } else {
-            keyStates['b'] = false; // Reset state if key is not pressed
-            isBraking = false;
+            if (count > commandStats->largestBatch) {
+                commandStats->largestBatch = count;
+            }
+            commandStats->applied += count;
+            commandStats->batches++;
         }
-        
-        // Accelerator and brake are both not pressed 
-        if (!keyStates['a'] && !keyStates['b']) {   // Key 'a' and 'b' are both not pressed
-            isAccelerating = false;
-            isBraking = false;
 
-            // Accelerator and brake are both not pressed
-            speed = speedCalculator->calculateSpeed(false, false);  
+        // Speed, drive mode, climate, battery level and range
+        pipeline.tick(commands, count);
+
+        // Queue new data to save into CSV file, writer thread
+        // does the disk I/O
+        DashboardState state = dashboardController->getState();
+        persistenceWriter->submit(state);
+
+        // Tick history for analysis tools
+        if (telemetryExporter) {
+            telemetryExporter->submit(state);
         }
 
-        // Drive mode
-        if (GetAsyncKeyState('M') & 0x8000) {  // Key 'b' is pressed
-                keyStates['m'] = true;  // Mark key 'm' is pressed
+        // Stop all tasks after requested number of ticks
+        if (++keyboardTicks >= tickLimit && tickLimit > 0) {
+            isRunning = false;
+        }
 
-                if (driveMode->getCurrentDriveMode() == ECO) {
-                    driveMode->setDriveMode(SPORT);
-                } else {
-                    driveMode->setDriveMode(ECO);
-                }
-                mode = driveMode->getCurrentDriveMode();
-            
-        } else {
-            keyStates['m'] = false; // Reset state if key is not pressed
+        co_await executor->sleepFor(100);
+    }
+
+}
+
+/********************************************************
+* @brief    readKeys
+* @details  This function reads the keys held now. Windows
+*           polls the keyboard, other systems have no key
+*           polling and take command lines on stdin instead,
+*           see readConsole.
+* @param    None
+* @return   DriverInput     Return keys held now, none held
+*                           without keyboard polling
+********************************************************/
+DriverInput readKeys() {
+    DriverInput keys = {};
+#ifdef _WIN32
+    keys.isAccelerating = (GetAsyncKeyState('A') & 0x8000) != 0;
+    keys.isBraking = (GetAsyncKeyState('B') & 0x8000) != 0;
+    keys.isModeToggled = (GetAsyncKeyState('M') & 0x8000) != 0;
+    keys.isAcUp = (GetAsyncKeyState(VK_UP) & 0x8000) != 0;
+    keys.isAcDown = (GetAsyncKeyState(VK_DOWN) & 0x8000) != 0;
+    keys.isWindUp = (GetAsyncKeyState(VK_RIGHT) & 0x8000) != 0;
+    keys.isWindDown = (GetAsyncKeyState(VK_LEFT) & 0x8000) != 0;
+    keys.isTripReset = (GetAsyncKeyState('R') & 0x8000) != 0;
+    keys.isCruiseToggled = (GetAsyncKeyState('C') & 0x8000) != 0;
+    keys.isCruiseUp = (GetAsyncKeyState(VK_PRIOR) & 0x8000) != 0;
+    keys.isCruiseDown = (GetAsyncKeyState(VK_NEXT) & 0x8000) != 0;
+#endif
+    return keys;
+}
+
+/********************************************************
+* @brief    submitKeyCommands
+* @details  This function turns key states into commands.
+*           Pedals are sent when they are pressed or released,
+*           drive mode toggles at every poll while M is held,
+*           other keys act once per press.
+* @param    commandQueue        Pointer to CommandQueue object
+* @param    keys                Keys held now
+* @param    previousKeys        Keys held at previous poll
+* @return   None
+********************************************************/
+void submitKeyCommands(CommandQueue* commandQueue, const DriverInput& keys, const DriverInput& previousKeys) {
+    if (keys.isAccelerating != previousKeys.isAccelerating) {
+        commandQueue->submit(COMMAND_ACCELERATOR, keys.isAccelerating, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isBraking != previousKeys.isBraking) {
+        commandQueue->submit(COMMAND_BRAKE, keys.isBraking, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isModeToggled) {
+        commandQueue->submit(COMMAND_MODE_TOGGLE, 0, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isAcUp && !previousKeys.isAcUp) {
+        commandQueue->submit(COMMAND_AC_STEP, 1, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isAcDown && !previousKeys.isAcDown) {
+        commandQueue->submit(COMMAND_AC_STEP, -1, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isWindUp && !previousKeys.isWindUp) {
+        commandQueue->submit(COMMAND_WIND_STEP, 1, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isWindDown && !previousKeys.isWindDown) {
+        commandQueue->submit(COMMAND_WIND_STEP, -1, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isTripReset && !previousKeys.isTripReset) {
+        commandQueue->submit(COMMAND_TRIP_RESET, 0, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isCruiseToggled && !previousKeys.isCruiseToggled) {
+        commandQueue->submit(COMMAND_CRUISE_TOGGLE, 0, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isCruiseUp && !previousKeys.isCruiseUp) {
+        commandQueue->submit(COMMAND_CRUISE_ADJUST, CRUISE_SPEED_STEP, COMMAND_SOURCE_KEYBOARD);
+    }
+    if (keys.isCruiseDown && !previousKeys.isCruiseDown) {
+        commandQueue->submit(COMMAND_CRUISE_ADJUST, -CRUISE_SPEED_STEP, COMMAND_SOURCE_KEYBOARD);
+    }
+}
+
+/********************************************************
+* @brief    runScript
+* @details  This task submits the command lines of a script
+*           file in order. "WAIT, <ms>" pauses the script,
+*           empty lines and lines starting with '#' are
+*           ignored. A full queue is retried after 1 ms, so a
+*           script never loses a command.
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
+* @param    commandQueue        Pointer to CommandQueue object
+*                               that receives commands
+* @param    path                Path to script of command lines
+* @return   Task
+********************************************************/
+Task runScript(TaskExecutor* executor, CommandQueue* commandQueue, const string* path) {
+    // Check NULL pointer
+    if (!executor || !commandQueue || !path) {
+        co_return;
+    }
+
+    char buffer[COMMAND_SCRIPT_MAX_SIZE];
+    size_t length;
+    if (!readFileToBuffer(path->c_str(), buffer, sizeof(buffer), length)) {
+        cerr << "Cannot read script " << *path << endl;
+        co_return;
+    }
+
+    const char* cursor = buffer;
+    const char* end = buffer + length;
+    int lineNumber = 0;
+
+    while (isRunning && cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (!lineEnd) {
+            lineEnd = end;
         }
+        const char* line = cursor;
+        const char* trimmedEnd = (lineEnd > line && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+        cursor = lineEnd + 1;
+        lineNumber++;
 
-        // Turn up AC temperature
-        if (GetAsyncKeyState(VK_UP) & 0x8000) {  // Key UP arrow is pressed
-            if (!keyStates[VK_UP]) {  
-                acTemp = min(acTemp + 1, 30);  // Turn up AC temperature, max 30°C
-                keyStates[VK_UP] = true;  
-            }
-        } else {
-            keyStates[VK_UP] = false;  // Reset state if key is not pressed
+        if (line == trimmedEnd || *line == '#') {
+            continue;
         }
 
-        // Turn down AC temperature
-        if (GetAsyncKeyState(VK_DOWN) & 0x8000) {  // Key DOWN arrow is pressed
-            if (!keyStates[VK_DOWN]) { 
-                acTemp = max(acTemp - 1, 16);  // Turn down AC temperature, min 16°C
-                keyStates[VK_DOWN] = true;  
+        // Pause
+        if (trimmedEnd - line > 5 && memcmp(line, "WAIT,", 5) == 0) {
+            double waitMs;
+            const char* value = line + 5;
+            while (value < trimmedEnd && *value == ' ') {
+                value++;
             }
-        } else {
-            keyStates[VK_DOWN] = false;  // Reset state if key is not pressed
+            if (parseNumber(value, trimmedEnd, waitMs) && waitMs >= 0) {
+                co_await executor->sleepFor((int)waitMs);
+            } else {
+                cerr << "Invalid wait in " << *path << " line " << lineNumber << endl;
+            }
+            continue;
         }
 
-        // Turn up wind level
-        if (GetAsyncKeyState(VK_RIGHT) & 0x8000) {  // Key RIGHT arrow is pressed
-            if (!keyStates[VK_RIGHT]) { 
-                windLevel = min(windLevel + 1, 5);  // Turn up wind level, max level 5
-                keyStates[VK_RIGHT] = true;  
-            }
-        } else {
-            keyStates[VK_RIGHT] = false;  // Reset state if key is not pressed
+        CommandType type;
+        int value;
+        if (!parseCommand(line, trimmedEnd, type, value)) {
+            cerr << "Invalid command in " << *path << " line " << lineNumber << endl;
+            continue;
+        }
+        while (isRunning && !commandQueue->submit(type, value, COMMAND_SOURCE_SCRIPT)) {
+            co_await executor->sleepFor(1);
         }
+    }
+}
 
-        // Turn down wind level
-        if (GetAsyncKeyState(VK_LEFT) & 0x8000) {  // Key LEFT arrow is pressed
-            if (!keyStates[VK_LEFT]) {  
-                windLevel = max(windLevel - 1, 1);  // Turn down wind level, min level 1
-                keyStates[VK_LEFT] = true;  
-            }
-        } else {
-            keyStates[VK_LEFT] = false;  // Reset state if key is not pressed
+#ifdef __linux__
+/********************************************************
+* @brief    readConsole
+* @details  This task submits command lines typed or piped
+*           on stdin, as "KEY, value" like the control
+*           socket. It waits for stdin with epoll, with a
+*           time limit to see the end of run. The task ends
+*           at end of input, or at once if stdin is a file or
+*           /dev/null that epoll does not support.
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
+* @param    commandQueue        Pointer to CommandQueue object
+*                               that receives commands
+* @return   Task
+********************************************************/
+Task readConsole(TaskExecutor* executor, CommandQueue* commandQueue) {
+    // Check NULL pointer
+    if (!executor || !commandQueue) {
+        co_return;
+    }
+
+    char line[CONSOLE_LINE_SIZE];
+    size_t lineLength = 0;
+    bool isLineTooLong = false;
+
+    while (isRunning) {
+        WaitResult result = co_await executor->waitReadable(STDIN_FILENO, CONSOLE_POLL_MS);
+        if (result == WAIT_ERROR) {
+            co_return;
+        }
+        if (result == WAIT_TIMEOUT) {
+            continue;
         }
-        
-        /* Other paramters */
 
-        // Battery level 
-        batteryManager->updateBatteryLevel(speed, acTemp, windLevel);
-        batteryLevel = batteryManager->getBatteryLevel();
-        
-        if (batteryLevel == 0) {
-            speed = 0;
+        char buffer[CONSOLE_LINE_SIZE];
+        ssize_t count = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (count <= 0) {
+            co_return;
         }
 
-        // Remaining range
-        remainingRange = batteryManager->calculateRamainingRange();
+        for (ssize_t i = 0; i < count; i++) {
+            if (buffer[i] != '\n') {
+                if (lineLength < sizeof(line)) {
+                    line[lineLength++] = buffer[i];
+                } else {
+                    isLineTooLong = true;
+                }
+                continue;
+            }
 
-        // Update new data to DashboardController
-        dashboardController->setDriveMode(mode);
-        dashboardController->setSpeed(speed);
-        dashboardController->setAcTemp(acTemp);
-        dashboardController->setWindLevel(windLevel);
-        dashboardController->setBatteryLevel(batteryLevel);
-        dashboardController->setRemainingRange(remainingRange);
+            const char* end = line + lineLength;
+            if (end > line && end[-1] == '\r') {
+                end--;
+            }
+            lineLength = 0;
 
-        // Save new data into CSV file
-        saveToCSV(dashboardController);
+            if (isLineTooLong) {
+                cerr << "Console command is too long" << endl;
+                isLineTooLong = false;
+                continue;
+            }
+            if (end == line || *line == '#') {
+                continue;
+            }
 
-        delay_ms(100);
+            CommandType type;
+            int value;
+            if (!parseCommand(line, end, type, value)) {
+                cerr << "Invalid console command" << endl;
+                continue;
+            }
+            while (isRunning && !commandQueue->submit(type, value, COMMAND_SOURCE_KEYBOARD)) {
+                co_await executor->sleepFor(1);
+            }
+        }
     }
-
 }
+#endif
 
 /********************************************************
-* @brief    display
-* @details  This function calls DashboardController update
-*           data methods to display data from DisplayManager. 
-* @param    dashboardController Pointer to DashboardController 
-*                               object to display updated data
-* @return   None
+* @brief    cruiseControl
+* @details  This task runs cruise control at the rate set in
+*           SpeedCalculator. Deadlines are absolute, so the
+*           loop does not drift, and every step uses the same
+*           dt. A late wake up runs the steps that are due, up
+*           to CRUISE_MAX_CATCH_UP, older steps are skipped and
+*           counted. While cruise control is off, the task only
+*           checks it every CRUISE_IDLE_MS.
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
+* @param    speedCalculator     Pointer to SpeedCalculator object
+*                               with cruise control
+* @param    driveMode           Pointer to DriveModeManager object
+* @param    stats               Pointer to timing of the loop
+* @return   Task
 ********************************************************/
-void display(DashboardController *dashboardController) {
+Task cruiseControl(TaskExecutor* executor, SpeedCalculator* speedCalculator,
+    const DriveModeManager* driveMode, CruiseLoopStats* stats) {
+    // Check NULL pointer
+    if (!executor || !speedCalculator || !driveMode || !stats) {
+        co_return;
+    }
+
+    const TaskClock::duration period = chrono::nanoseconds(1000000000L / speedCalculator->getCruiseRate());
+
     while (isRunning)
     {
-        dashboardController->updateData();
+        if (!speedCalculator->isCruiseActive()) {
+            co_await executor->sleepFor(CRUISE_IDLE_MS);
+            continue;
+        }
 
-        // Warning if battery level is low
-        if (dashboardController->getBatteryLevel() <= 20) {
-            cout << "Warning: Low Battery. Find a Charging Station!" << endl << endl;
+        TaskClock::time_point next = TaskClock::now() + period;
+        while (isRunning && speedCalculator->isCruiseActive()) {
+            co_await executor->sleepUntil(next);
+
+            TaskClock::time_point now = TaskClock::now();
+            uint64_t latenessUs = chrono::duration_cast<chrono::microseconds>(now - next).count();
+            if (latenessUs > stats->maxLatenessUs) {
+                stats->maxLatenessUs = latenessUs;
+            }
+
+            // Steps that are due, same dt for each
+            int steps = 0;
+            while (next <= now && steps < CRUISE_MAX_CATCH_UP) {
+                speedCalculator->stepCruise(driveMode->getCurrentDriveMode());
+                next += period;
+                steps++;
+            }
+            stats->steps += steps;
+
+            // Too late, skip instead of running a burst
+            if (next <= now) {
+                long missed = (now - next) / period + 1;
+                next += period * missed;
+                stats->skipped += missed;
+            }
         }
+    }
+}
+
+/********************************************************
+* @brief    watchProfile
+* @details  This task checks vehicle profile file every
+*           PROFILE_CHECK_PERIOD_MS, a changed file is loaded
+*           into a new parameter block.
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
+* @param    profileStore        Pointer to VehicleProfileStore
+*                               object to reload
+* @return   Task
+********************************************************/
+Task watchProfile(TaskExecutor* executor, VehicleProfileStore* profileStore) {
+    // Check NULL pointer
+    if (!executor || !profileStore) {
+        co_return;
+    }
 
-        delay_ms(1000);
+    while (isRunning)
+    {
+        co_await executor->sleepFor(PROFILE_CHECK_PERIOD_MS);
+
+        if (profileStore->reloadIfChanged()) {
+            cout << "Vehicle profile reloaded" << endl << endl;
+        }
     }
-    
 }
 
 /********************************************************
-* @brief    saveToCSV
-* @details  This functions save data into CSV file, include
-*           drive mode, speed, battery level,...
+* @brief    display
+* @details  This task calls DashboardController update
+*           data methods to display data from DisplayManager
+*           every 1s. 
+* @param    executor            Pointer to TaskExecutor object
+*                               that runs this task
 * @param    dashboardController Pointer to DashboardController 
-*                               object to read and save data
-* @return   None
+*                               object to display updated data
+* @param    tripComputer        Pointer to TripComputer object
+*                               to display trip values
+* @param    routePredictor      Pointer to RoutePredictor object
+* @param    route               Pointer to route to predict,
+*                               prediction is skipped if empty
+* @param    stationIndex        Pointer to ChargingStationIndex
+*                               object to find charging stations
+* @param    positionSimulator   Pointer to PositionSimulator
+*                               object with vehicle position
+* @param    batteryManager      Pointer to BatteryManager object
+*                               to display cell level pack model
+* @param    speedCalculator     Pointer to SpeedCalculator object
+*                               to display cruise control
+* @param    ruleEngine          Pointer to RuleEngine object with
+*                               derived signals and alarms
+* @param    climateAdvisor      Pointer to ClimateAdvisor object
+*                               with range advice
+* @param    stateEstimator      Pointer to StateEstimator object
+*                               with filtered values, NULL when
+*                               samples are not filtered
+* @return   Task
 ********************************************************/
-void saveToCSV(DashboardController* dashboardController) {
-    ofstream file(DATABASE_PATH);
-    if (file.is_open()) {
-        file << "DRIVE MODE, " << (dashboardController->getDriveMode() == ECO ? "ECO" : "SPORT")  << endl;
-        file << "SPEED, " << dashboardController->getSpeed() << endl;
-        file << "BATTERY LEVEL, " << dashboardController->getBatteryLevel() << endl;
-        file << "AC TEMPERATURE, " << dashboardController->getAcTemp() << endl;
-        file << "WIND LEVEL, " << dashboardController->getWindLevel() << endl;
-        file << "REMAINING RANGE, " << dashboardController->getRemainingRange() << endl;
-
-        file.close();
-    } else {
-        cerr << "Failed to open Database.csv for writing." << endl;
+Task display(TaskExecutor* executor, DashboardController *dashboardController, TripComputer* tripComputer,
+    const RoutePredictor* routePredictor, const vector<RouteSegment>* route,
+    const ChargingStationIndex* stationIndex, const PositionSimulator* positionSimulator,
+    const BatteryManager* batteryManager, const SpeedCalculator* speedCalculator, RuleEngine* ruleEngine,
+    const ClimateAdvisor* climateAdvisor, const StateEstimator* stateEstimator) {
+    // Check NULL pointer
+    if (!executor || !dashboardController || !tripComputer || !routePredictor || !route
+        || !stationIndex || !positionSimulator || !batteryManager || !speedCalculator || !ruleEngine
+        || !climateAdvisor) {
+        co_return;
     }
+
+    while (isRunning)
+    {
+        PerfMark mark;
+        if (perfStats) {
+            perfStats->mark(mark);
+        }
+
+        if (isReplayingCAN) {
+            // Data is already updated by replayed frames
+            dashboardController->publishState();
+        } else {
+            dashboardController->updateData();
+        }
+
+        // Trip values
+        TripSnapshot trip = tripComputer->getSnapshot();
+        cout << "Trip: " << trip.distanceKm << " km, average " << trip.averageSpeed
+             << " km/h, max " << trip.maxSpeed << " km/h, energy " << trip.energyUsed
+             << " %, consumption " << trip.averageConsumption << " %/km" << endl << endl;
+
+        // Filtered values and their uncertainty
+        if (stateEstimator && stateEstimator->isReady()) {
+            // One decimal is enough to see the uncertainty
+            cout << "Estimate: speed " << floor(stateEstimator->getSpeed() * 10 + 0.5) / 10 << " ± "
+                 << floor(stateEstimator->getSpeedUncertainty() * 10 + 0.5) / 10 << " km/h, SOC "
+                 << floor(stateEstimator->getSoc() * 10 + 0.5) / 10 << " ± "
+                 << floor(stateEstimator->getSocUncertainty() * 10 + 0.5) / 10 << " %" << endl << endl;
+        }
+
+        // Cruise control
+        if (speedCalculator->isCruiseActive()) {
+            cout << "Cruise: set " << speedCalculator->getCruiseSpeed() << " km/h" << endl << endl;
+        }
+
+        // Range gained by other climate settings or a speed cap
+        if (climateAdvisor->getAlternativeCount() > 0) {
+            cout << "Advice:";
+            for (size_t i = 0; i < climateAdvisor->getAlternativeCount(); i++) {
+                const ClimateAlternative& alternative = climateAdvisor->getAlternative(i);
+                cout << (i > 0 ? "," : "") << " AC " << alternative.acTemp << " °C wind "
+                     << alternative.windLevel;
+                if (alternative.speedCap > 0) {
+                    cout << " at " << alternative.speedCap << " km/h";
+                }
+                cout << " +" << (int)(alternative.gainKm + 0.5) << " km";
+            }
+            cout << endl << endl;
+        }
+
+        // Cell level pack model
+        const BatteryPack* pack = batteryManager->getPack();
+        if (pack) {
+            cout << "Pack: " << pack->getCellCount() << " cells, weakest " << pack->getPackSoc()
+                 << " %, mean " << pack->getMeanSoc() << " %, imbalance " << pack->getImbalance()
+                 << " %, hottest " << pack->getMaxTemperature() << " °C" << endl << endl;
+        }
+
+        // State of charge at destination with current climate settings
+        if (!route->empty()) {
+            RouteQuery query;
+            query.segments = route->data();
+            query.segmentCount = route->size();
+            query.startSoc = dashboardController->getBatteryLevel();
+            query.scenario.acTemp = dashboardController->getAcTemp();
+            query.scenario.windLevel = dashboardController->getWindLevel();
+            query.scenario.speedCap = 0;
+
+            RoutePrediction prediction = routePredictor->predict(query);
+            cout << "Route: " << prediction.distanceKm << " km, arrive with "
+                 << prediction.finalSoc << " %";
+            if (!prediction.isReachable) {
+                cout << ", battery empty on segment " << prediction.emptySegment + 1;
+            }
+            cout << endl << endl;
+        }
+
+        // Derived signals, rules ran when state was published
+        if (ruleEngine->getSignalCount() > 0) {
+            cout << "Signals:";
+            for (size_t i = 0; i < ruleEngine->getSignalCount(); i++) {
+                cout << " " << ruleEngine->getSignalName(i) << " " << ruleEngine->getSignalValue(i);
+            }
+            cout << endl << endl;
+        }
+
+        // Alarms raised or cleared since last display
+        RuleEvent events[RULE_MAX_EVENTS];
+        size_t eventCount = ruleEngine->takeEvents(events, RULE_MAX_EVENTS);
+        for (size_t i = 0; i < eventCount; i++) {
+            cout << "Alarm " << ruleEngine->getAlarm(events[i].alarm).name
+                 << (events[i].type == RULE_EVENT_RAISED ? " raised" : " cleared") << endl;
+        }
+
+        // Warning for each active alarm
+        for (size_t i = 0; i < ruleEngine->getAlarmCount(); i++) {
+            if (ruleEngine->getAlarm(i).isActive) {
+                cout << "Warning: " << ruleEngine->getAlarm(i).message << endl;
+            }
+        }
+
+        // Nearest stations the vehicle can still reach
+        int lowBattery = ruleEngine->findAlarm(RULE_LOW_BATTERY_ALARM);
+        if (lowBattery >= 0 && ruleEngine->getAlarm(lowBattery).isActive) {
+            StationMatch stations[LOW_BATTERY_STATIONS];
+            size_t count = stationIndex->findNearest(positionSimulator->getLatitude(),
+                positionSimulator->getLongitude(), LOW_BATTERY_STATIONS,
+                dashboardController->getRemainingRange(), stations);
+
+            if (count == 0) {
+                cout << "No charging station within remaining range" << endl;
+            }
+            for (size_t i = 0; i < count; i++) {
+                cout << "  " << stations[i].station->name << ": " << stations[i].distanceKm << " km" << endl;
+            }
+            cout << endl;
+        }
+
+        if (perfStats) {
+            perfStats->record(stageDisplay, mark);
+        }
+        co_await executor->sleepFor(1000);
+    }
+    
 }
@@ -0,0 +1,178 @@
+/********************************************************
+* @file     MappedFile.cpp
+* @brief    Define methods related to memory mapped files
+* @details  This file contains methods definition related
+*           to mapping a file read-only into memory, uses
+*           MapViewOfFile on Windows and mmap on other
+*           platforms.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* Content used for empty files, which can not be mapped
+********************************************************/
+static const char emptyContent[1] = { 0 };
+
+/********************************************************
+* @brief Constructor
+********************************************************/
+MappedFile::MappedFile() : mappedData(NULL), mappedSize(0),
+    fileHandle(NULL), mappingHandle(NULL) {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+MappedFile::~MappedFile() {
+    close();
+}
+
+/********************************************************
+* @brief    open
+* @details  This method maps whole file read-only into
+*           memory, previous mapped file will be closed.
+* @param    path    Path to file that want to map
+* @return   bool    Return true if file is mapped, else
+*                   return false
+********************************************************/
+bool MappedFile::open(const string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        mappedData = emptyContent;
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedData = static_cast<const char*>(view);
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    if (fileStat.st_size == 0) {
+        ::close(fd);
+        mappedData = emptyContent;
+        return true;
+    }
+
+    void* view = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // Mapping keeps its own reference to the file
+    ::close(fd);
+
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    // Logs are parsed front to back, let the kernel read ahead aggressively
+    madvise(view, fileStat.st_size, MADV_SEQUENTIAL);
+
+    mappedData = static_cast<const char*>(view);
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+/********************************************************
+* @brief    close
+* @details  This method unmaps current file.
+* @param    None
+* @return   None
+********************************************************/
+void MappedFile::close() {
+    if (mappedData != NULL && mappedData != emptyContent) {
+#ifdef _WIN32
+        UnmapViewOfFile(mappedData);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+#else
+        munmap(const_cast<char*>(mappedData), mappedSize);
+#endif
+    }
+
+    mappedData = NULL;
+    mappedSize = 0;
+    fileHandle = NULL;
+    mappingHandle = NULL;
+}
+
+/********************************************************
+* @brief    data
+* @details  This method gets start of mapped content.
+* @param    None
+* @return   const char*     Return pointer to first byte
+********************************************************/
+const char* MappedFile::data() const {
+    return mappedData;
+}
+
+/********************************************************
+* @brief    size
+* @details  This method gets size of mapped content.
+* @param    None
+* @return   size_t  Return size of file (bytes)
+********************************************************/
+size_t MappedFile::size() const {
+    return mappedSize;
+}
+
+/********************************************************
+* @brief    isOpen
+* @details  This method checks if a file is mapped.
+* @param    None
+* @return   bool    Return true if a file is mapped
+********************************************************/
+bool MappedFile::isOpen() const {
+    return mappedData != NULL;
+}
@@ -0,0 +1,421 @@
+/********************************************************
+* @file     PerfStats.cpp
+* @brief    Define methods related to timing of processing
+*           stages
+* @details  This file contains methods definition related to
+*           performance statistics, includes register stages,
+*           sum elapsed time and counters, print the tables
+*           and read resident memory. Counters use
+*           perf_event_open on Linux.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "PerfStats.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Names of counters in the dump, by PerfCounter
+********************************************************/
+static const char* const COUNTER_NAMES[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "cache misses", "branch misses", "ctx switches"
+};
+
+#ifdef __linux__
+/********************************************************
+* @brief Event type and config of each counter, by PerfCounter
+********************************************************/
+static const uint32_t COUNTER_TYPES[PERF_COUNTER_COUNT] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE
+};
+static const uint64_t COUNTER_CONFIGS[PERF_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_CONTEXT_SWITCHES
+};
+
+/********************************************************
+* @brief    openEvent
+* @details  This function opens one counter of the calling
+*           thread on any CPU. Hardware counters count user
+*           space only, which needs no privilege. Context
+*           switches happen in the kernel, so they are
+*           counted with kernel included.
+* @param    counter     Counter to open
+* @param    groupFd     Leader of group, -1 to open a leader
+* @return   int         Return file of counter, -1 on error
+********************************************************/
+static int openEvent(int counter, int groupFd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = COUNTER_TYPES[counter];
+    attr.config = COUNTER_CONFIGS[counter];
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    attr.exclude_kernel = attr.type == PERF_TYPE_HARDWARE ? 1 : 0;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+#endif
+
+/********************************************************
+* @brief Constructor, no stage is registered and no
+*        counter is open
+********************************************************/
+PerfStats::PerfStats() : stageCount(0), groupFd(-1), openCount(0), timeEnabledNs(0), timeRunningNs(0) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counterFds[i] = -1;
+        counterSlots[i] = -1;
+    }
+}
+
+/********************************************************
+* @brief Destructor, closes counters
+********************************************************/
+PerfStats::~PerfStats() {
+#ifdef __linux__
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counterFds[i] >= 0 && counterFds[i] != groupFd) {
+            close(counterFds[i]);
+        }
+    }
+    if (groupFd >= 0) {
+        close(groupFd);
+    }
+#endif
+}
+
+/********************************************************
+* @brief    openCounters
+* @details  This method opens the counters in one group, so
+*           they are scheduled together and read with one
+*           system call. The first counter that opens leads
+*           the group, counters that fail are left out and
+*           shown as missing in the dump.
+* @param    None
+* @return   bool    Return false if no counter could be opened
+********************************************************/
+bool PerfStats::openCounters() {
+    if (groupFd >= 0) {
+        return true;
+    }
+
+#ifdef __linux__
+    int firstError = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        int fd = openEvent(i, groupFd);
+        if (fd < 0) {
+            firstError = firstError ? firstError : errno;
+            continue;
+        }
+
+        counterFds[i] = fd;
+        counterSlots[i] = openCount++;
+        if (groupFd < 0) {
+            groupFd = fd;
+        }
+    }
+
+    if (groupFd < 0) {
+        cerr << "Cannot open performance counters: " << strerror(firstError)
+             << ", check /proc/sys/kernel/perf_event_paranoid" << endl;
+        return false;
+    }
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counterFds[i] < 0) {
+            cerr << "Counter " << COUNTER_NAMES[i] << " is not available" << endl;
+        }
+    }
+
+    ioctl(groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    cerr << "Performance counters need Linux perf_event_open" << endl;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    hasCounter
+* @details  This method checks a counter is in the group.
+* @param    counter     Counter to check
+* @return   bool        Return true if counter is counted
+********************************************************/
+bool PerfStats::hasCounter(PerfCounter counter) const {
+    return counter >= 0 && counter < PERF_COUNTER_COUNT && counterFds[counter] >= 0;
+}
+
+/********************************************************
+* @brief    mark
+* @details  This method reads time and all counters of the
+*           group, counters that are not open stay 0.
+* @param    mark    Mark to fill
+* @return   None
+********************************************************/
+void PerfStats::mark(PerfMark& mark) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        mark.counts[i] = 0;
+    }
+
+#ifdef __linux__
+    if (groupFd >= 0) {
+        // Number of counters, time enabled, time running, values
+        uint64_t values[3 + PERF_COUNTER_COUNT];
+        if (read(groupFd, values, sizeof(values)) >= (ssize_t)((3 + openCount) * sizeof(uint64_t))) {
+            timeEnabledNs = values[1];
+            timeRunningNs = values[2];
+            for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                if (counterSlots[i] >= 0) {
+                    mark.counts[i] = values[3 + counterSlots[i]];
+                }
+            }
+        }
+    }
+#endif
+
+    mark.ns = nowNs();
+}
+
+/********************************************************
+* @brief    record
+* @details  This method adds time and counter deltas since
+*           mark as one run, then moves mark to now. An
+*           invalid index only moves the mark.
+* @param    stage   Index returned by addStage
+* @param    mark    Mark of stage start, set to now
+* @return   None
+********************************************************/
+void PerfStats::record(int stage, PerfMark& mark) {
+    PerfMark start = mark;
+    this->mark(mark);
+
+    if (stage < 0 || stage >= stageCount) {
+        return;
+    }
+
+    record(stage, mark.ns - start.ns);
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        stages[stage].counts[i] += mark.counts[i] - start.counts[i];
+    }
+}
+
+/********************************************************
+* @brief    addStage
+* @details  This method registers a stage with no recorded
+*           time.
+* @param    name    Name of stage, must outlive this object
+* @return   int     Return index of stage, -1 if table is full
+********************************************************/
+int PerfStats::addStage(const char* name) {
+    if (stageCount >= PERF_MAX_STAGES) {
+        return -1;
+    }
+
+    PerfStage& stage = stages[stageCount];
+    stage.name = name;
+    stage.totalNs = 0;
+    stage.maxNs = 0;
+    stage.calls = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        stage.counts[i] = 0;
+    }
+    return stageCount++;
+}
+
+/********************************************************
+* @brief    record
+* @details  This method adds elapsed time of one run, an
+*           invalid index is ignored.
+* @param    stage   Index returned by addStage
+* @param    ns      Elapsed time (ns)
+* @return   None
+********************************************************/
+void PerfStats::record(int stage, uint64_t ns) {
+    if (stage < 0 || stage >= stageCount) {
+        return;
+    }
+
+    PerfStage& entry = stages[stage];
+    entry.totalNs += ns;
+    entry.calls++;
+    if (ns > entry.maxNs) {
+        entry.maxNs = ns;
+    }
+}
+
+/********************************************************
+* @brief    reset
+* @details  This method clears recorded time of all stages.
+* @param    None
+* @return   None
+********************************************************/
+void PerfStats::reset() {
+    for (int i = 0; i < stageCount; i++) {
+        stages[i].totalNs = 0;
+        stages[i].maxNs = 0;
+        stages[i].calls = 0;
+        for (int j = 0; j < PERF_COUNTER_COUNT; j++) {
+            stages[i].counts[j] = 0;
+        }
+    }
+}
+
+/********************************************************
+* @brief    getStageCount
+* @details  This method gets number of registered stages.
+* @param    None
+* @return   int     Return number of stages
+********************************************************/
+int PerfStats::getStageCount() const {
+    return stageCount;
+}
+
+/********************************************************
+* @brief    getStage
+* @details  This method gets recorded time of a stage.
+* @param    stage           Index of stage
+* @return   const PerfStage&    Return stage
+********************************************************/
+const PerfStage& PerfStats::getStage(int stage) const {
+    return stages[stage];
+}
+
+/********************************************************
+* @brief    dump
+* @details  This method prints one line per stage: time per
+*           tick, longest run and share of time of all
+*           stages. With counters open, a second table has
+*           counters per tick and instructions per cycle,
+*           missing counters are shown as -.
+* @param    output  Stream to print on
+* @param    ticks   Number of ticks the time is spread over
+* @return   None
+********************************************************/
+void PerfStats::dump(ostream& output, uint64_t ticks) const {
+    uint64_t totalNs = 0;
+    for (int i = 0; i < stageCount; i++) {
+        totalNs += stages[i].totalNs;
+    }
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    output << left << setw(14) << "Stage" << right << setw(12) << "ns/tick"
+           << setw(12) << "max ns" << setw(10) << "share" << endl;
+    for (int i = 0; i < stageCount; i++) {
+        const PerfStage& stage = stages[i];
+        double share = totalNs > 0 ? 100.0 * (double)stage.totalNs / (double)totalNs : 0.0;
+
+        output << left << setw(14) << stage.name << right << fixed << setprecision(1)
+               << setw(12) << (double)stage.totalNs / (double)ticks
+               << setw(12) << stage.maxNs
+               << setw(9) << share << "%" << endl;
+    }
+    output << left << setw(14) << "Total" << right
+           << setw(12) << (double)totalNs / (double)ticks << endl;
+
+    if (groupFd >= 0) {
+        output << left << setw(14) << "Stage" << right;
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            output << setw(15) << COUNTER_NAMES[i];
+        }
+        output << setw(8) << "IPC" << endl;
+
+        for (int i = 0; i < stageCount; i++) {
+            const PerfStage& stage = stages[i];
+            output << left << setw(14) << stage.name << right;
+            for (int j = 0; j < PERF_COUNTER_COUNT; j++) {
+                if (counterFds[j] >= 0) {
+                    output << setw(15) << (double)stage.counts[j] / (double)ticks;
+                } else {
+                    output << setw(15) << "-";
+                }
+            }
+
+            if (counterFds[PERF_CYCLES] >= 0 && counterFds[PERF_INSTRUCTIONS] >= 0
+                && stage.counts[PERF_CYCLES] > 0) {
+                output << setprecision(2) << setw(8)
+                       << (double)stage.counts[PERF_INSTRUCTIONS] / (double)stage.counts[PERF_CYCLES]
+                       << setprecision(1);
+            } else {
+                output << setw(8) << "-";
+            }
+            output << endl;
+        }
+
+        // Group shared the PMU with other groups, counts are low
+        if (timeRunningNs < timeEnabledNs && timeEnabledNs > 0) {
+            output << "Counters ran " << 100.0 * (double)timeRunningNs / (double)timeEnabledNs
+                   << "% of the time, counts are partial" << endl;
+        }
+    }
+    output.unsetf(ios::floatfield);
+    output << setprecision(6);
+}
+
+/********************************************************
+* @brief    nowNs
+* @details  This method gets monotonic time to measure a
+*           stage.
+* @param    None
+* @return   uint64_t    Return time (ns)
+********************************************************/
+uint64_t PerfStats::nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/********************************************************
+* @brief    getResidentKb
+* @details  This method reads resident memory of this
+*           process from the operating system.
+* @param    None
+* @return   long    Return resident set size (KB), -1 if
+*                   not available
+********************************************************/
+long PerfStats::getResidentKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return -1;
+    }
+    return (long)(counters.WorkingSetSize / 1024);
+#else
+    // Second field of statm is resident pages
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return -1;
+    }
+
+    long totalPages = 0;
+    long residentPages = 0;
+    int count = fscanf(file, "%ld %ld", &totalPages, &residentPages);
+    fclose(file);
+    if (count != 2) {
+        return -1;
+    }
+    return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+}
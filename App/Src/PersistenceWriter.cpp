@@ -0,0 +1,391 @@
+/********************************************************
+* @file     PersistenceWriter.cpp
+* @brief    Define methods related to write behind
+*           persistence of system parameters
+* @details  This file contains methods definition related
+*           to the writer thread, includes queue snapshots,
+*           keep only the latest one, write it and sync data
+*           by durability policy.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "PersistenceWriter.hpp"
+#include "TelemetryParser.hpp"
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Constructor
+* @param path     File to write
+* @param policy   When written data is synced
+********************************************************/
+PersistenceWriter::PersistenceWriter(const string& path, const DurabilityPolicy& policy)
+    : path(path), policy(policy), wakeup(0), isStopRequested(false),
+      submitted(0), dropped(0), coalesced(0), writes(0), syncs(0), errors(0),
+      isLatestDropped(false), isUringUsed(false), fileLength(0) {
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    fileFd = -1;
+#endif
+}
+
+/********************************************************
+* @brief Destructor, stops the writer thread
+********************************************************/
+PersistenceWriter::~PersistenceWriter() {
+    stop();
+}
+
+/********************************************************
+* @brief    parseDurability
+* @details  This method parses durability option, the
+*           number after "writes:" or "interval:" must be
+*           greater than 0.
+* @param    text        "none", "writes:<N>" or
+*                       "interval:<milliseconds>"
+* @param    policy      Parsed policy
+* @return   bool        Return false if text is invalid
+********************************************************/
+bool PersistenceWriter::parseDurability(const string& text, DurabilityPolicy& policy) {
+    policy.mode = DURABILITY_NONE;
+    policy.writesPerSync = 0;
+    policy.intervalMs = 0;
+
+    if (text == "none") {
+        return true;
+    }
+
+    size_t colon = text.find(':');
+    if (colon == string::npos) {
+        return false;
+    }
+
+    string name = text.substr(0, colon);
+    string number = text.substr(colon + 1);
+    char* end = NULL;
+    long value = strtol(number.c_str(), &end, 10);
+    if (number.empty() || *end != '\0' || value <= 0) {
+        return false;
+    }
+
+    if (name == "writes") {
+        policy.mode = DURABILITY_WRITES;
+        policy.writesPerSync = (unsigned int)value;
+    } else if (name == "interval") {
+        policy.mode = DURABILITY_INTERVAL;
+        policy.intervalMs = (unsigned int)value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/********************************************************
+* @brief    start
+* @details  This method opens file once for the whole run,
+*           sets up io_uring if the system has it and
+*           starts writer thread.
+* @param    None
+* @return   bool        Return false if file cannot be opened
+********************************************************/
+bool PersistenceWriter::start() {
+    if (worker.joinable()) {
+        return true;
+    }
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        cerr << "Failed to open " << path << " for writing." << endl;
+        return false;
+    }
+    fileLength = (size_t)GetFileSize(fileHandle, NULL);
+#else
+    fileFd = open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fileFd < 0) {
+        cerr << "Failed to open " << path << " for writing." << endl;
+        return false;
+    }
+    struct stat info;
+    fileLength = (fstat(fileFd, &info) == 0) ? (size_t)info.st_size : 0;
+    isUringUsed = uring.setup(PERSIST_URING_ENTRIES);
+#endif
+
+    isStopRequested.store(false);
+    worker = thread(&PersistenceWriter::run, this);
+    return true;
+}
+
+/********************************************************
+* @brief    submit
+* @details  This method pushes a snapshot to the queue and
+*           wakes up writer thread. If the queue is full
+*           because disk is slow, snapshot is dropped and
+*           kept to be queued by stop().
+* @param    state       Snapshot of system parameters
+* @return   bool        Return false if snapshot is dropped
+********************************************************/
+bool PersistenceWriter::submit(const DashboardState& state) {
+    if (!worker.joinable()) {
+        return false;
+    }
+
+    if (!queue.tryPush(state)) {
+        dropped.fetch_add(1, memory_order_relaxed);
+        latestDropped = state;
+        isLatestDropped = true;
+        return false;
+    }
+
+    isLatestDropped = false;
+    submitted.fetch_add(1, memory_order_relaxed);
+    wakeup.release();
+    return true;
+}
+
+/********************************************************
+* @brief    stop
+* @details  This method queues the last dropped snapshot,
+*           then asks writer thread to write what is queued,
+*           sync it unless durability is none, and exit.
+* @param    None
+* @return   None
+********************************************************/
+void PersistenceWriter::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+
+    // Latest snapshot must reach the file, wait for room
+    if (isLatestDropped) {
+        while (!queue.tryPush(latestDropped)) {
+            this_thread::yield();
+        }
+        isLatestDropped = false;
+        submitted.fetch_add(1, memory_order_relaxed);
+        wakeup.release();
+    }
+
+    isStopRequested.store(true, memory_order_release);
+    wakeup.release();
+    worker.join();
+
+    uring.close();
+#ifdef _WIN32
+    CloseHandle(fileHandle);
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    close(fileFd);
+    fileFd = -1;
+#endif
+}
+
+/********************************************************
+* @brief    run
+* @details  This method is body of writer thread. It waits
+*           for snapshots, or for sync time in interval
+*           mode, takes all queued snapshots and writes only
+*           the latest one.
+* @param    None
+* @return   None
+********************************************************/
+void PersistenceWriter::run() {
+    const chrono::milliseconds interval(policy.intervalMs);
+    chrono::steady_clock::time_point dirtySince = chrono::steady_clock::now();
+    unsigned int writesSinceSync = 0;
+    bool isDirty = false;
+
+    while (true) {
+        if (policy.mode == DURABILITY_INTERVAL && isDirty) {
+            wakeup.try_acquire_until(dirtySince + interval);
+        } else {
+            wakeup.acquire();
+        }
+
+        // Read stop request before draining, snapshots queued
+        // before stop() are written in this pass
+        bool isStopping = isStopRequested.load(memory_order_acquire);
+
+        // Keep only the latest snapshot
+        DashboardState state;
+        unsigned long count = 0;
+        while (queue.tryPop(state)) {
+            count++;
+        }
+        if (count > 1) {
+            coalesced.fetch_add(count - 1, memory_order_relaxed);
+        }
+
+        bool hasState = count > 0;
+        if (hasState) {
+            if (!isDirty) {
+                dirtySince = chrono::steady_clock::now();
+            }
+            isDirty = true;
+            writesSinceSync++;
+        }
+
+        // Decide if written data is synced now
+        bool isSync = false;
+        if (policy.mode == DURABILITY_WRITES) {
+            isSync = isDirty && (writesSinceSync >= policy.writesPerSync || isStopping);
+        } else if (policy.mode == DURABILITY_INTERVAL) {
+            isSync = isDirty && (chrono::steady_clock::now() - dirtySince >= interval || isStopping);
+        }
+
+        if (hasState || isSync) {
+            bool isDone = hasState ? writeState(state, isSync) : syncFile();
+            if (!isDone) {
+                errors.fetch_add(1, memory_order_relaxed);
+                cerr << "Failed to write " << path << endl;
+            } else {
+                if (hasState) {
+                    writes.fetch_add(1, memory_order_relaxed);
+                }
+                if (isSync) {
+                    syncs.fetch_add(1, memory_order_relaxed);
+                }
+            }
+        }
+
+        if (isSync) {
+            writesSinceSync = 0;
+            isDirty = false;
+        }
+
+        if (isStopping) {
+            break;
+        }
+    }
+}
+
+/********************************************************
+* @brief    writeState
+* @details  This method overwrites file from offset 0, then
+*           cuts old content left after a shorter record.
+*           If io_uring write fails, this and next writes
+*           use pwrite.
+* @param    state       Snapshot to write
+* @param    isSync      Sync data after the write
+* @return   bool        Return true if written and synced
+********************************************************/
+bool PersistenceWriter::writeState(const DashboardState& state, bool isSync) {
+    size_t length = formatTelemetryRecord(state, buffer, sizeof(buffer));
+    if (length == 0) {
+        return false;
+    }
+    bool isShrinking = length < fileLength;
+
+#ifdef _WIN32
+    if (SetFilePointer(fileHandle, 0, NULL, FILE_BEGIN) == INVALID_SET_FILE_POINTER) {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < length) {
+        DWORD count = 0;
+        if (!WriteFile(fileHandle, buffer + written, (DWORD)(length - written), &count, NULL) || count == 0) {
+            return false;
+        }
+        written += count;
+    }
+    if (isShrinking && !SetEndOfFile(fileHandle)) {
+        return false;
+    }
+    fileLength = length;
+    return !isSync || FlushFileBuffers(fileHandle);
+#else
+    // Sync is linked to the write, unless size must change first
+    bool isWritten = false;
+    if (isUringUsed) {
+        isWritten = uring.write(fileFd, buffer, length, 0, isSync && !isShrinking);
+        if (!isWritten) {
+            cerr << "io_uring write failed, using pwrite" << endl;
+            isUringUsed = false;
+            uring.close();
+        } else if (!isShrinking) {
+            fileLength = length;
+            return true;
+        }
+    }
+
+    if (!isWritten) {
+        size_t written = 0;
+        while (written < length) {
+            ssize_t count = pwrite(fileFd, buffer + written, length - written, (off_t)written);
+            if (count <= 0) {
+                return false;
+            }
+            written += (size_t)count;
+        }
+    }
+
+    if (isShrinking && ftruncate(fileFd, (off_t)length) != 0) {
+        return false;
+    }
+    fileLength = length;
+    return !isSync || syncFile();
+#endif
+}
+
+/********************************************************
+* @brief    syncFile
+* @details  This method syncs file data through io_uring,
+*           or fdatasync if io_uring is not used.
+* @param    None
+* @return   bool        Return true if synced
+********************************************************/
+bool PersistenceWriter::syncFile() {
+#ifdef _WIN32
+    return FlushFileBuffers(fileHandle) != 0;
+#else
+    if (isUringUsed) {
+        return uring.sync(fileFd);
+    }
+    return fdatasync(fileFd) == 0;
+#endif
+}
+
+/********************************************************
+* @brief    getStats
+* @details  This method reads counters of the writer.
+* @param    None
+* @return   PersistenceStats    Return counters
+********************************************************/
+PersistenceStats PersistenceWriter::getStats() const {
+    PersistenceStats stats;
+    stats.submitted = submitted.load(memory_order_relaxed);
+    stats.dropped = dropped.load(memory_order_relaxed);
+    stats.coalesced = coalesced.load(memory_order_relaxed);
+    stats.writes = writes.load(memory_order_relaxed);
+    stats.syncs = syncs.load(memory_order_relaxed);
+    stats.errors = errors.load(memory_order_relaxed);
+    return stats;
+}
+
+/********************************************************
+* @brief    getBackendName
+* @details  This method gets name of write backend.
+* @param    None
+* @return   const char*     Return "io_uring", "pwrite" or
+*                           "WriteFile"
+********************************************************/
+const char* PersistenceWriter::getBackendName() const {
+#ifdef _WIN32
+    return "WriteFile";
+#else
+    return isUringUsed ? "io_uring" : "pwrite";
+#endif
+}
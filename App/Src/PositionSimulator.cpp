@@ -0,0 +1,100 @@
+/********************************************************
+* @file     PositionSimulator.cpp
+* @brief    Define methods related to simulated vehicle
+*           position
+* @details  This file contains methods definition related
+*           to simulated vehicle position, includes move on
+*           the heading and integrate published speed.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "PositionSimulator.hpp"
+#include "ChargingStationIndex.hpp"
+#include <cmath>
+
+using namespace std;
+
+/********************************************************
+* @brief Degree to radian
+********************************************************/
+static const double DEGREE_TO_RADIAN = 3.14159265358979323846 / 180.0;
+
+/********************************************************
+* @brief Constructor
+* @param latitude     Start latitude (degree)
+* @param longitude    Start longitude (degree)
+* @param heading      Heading (degree)
+********************************************************/
+PositionSimulator::PositionSimulator(double latitude, double longitude, double heading)
+    : latitude(latitude), longitude(longitude), heading(heading),
+    hasPreviousUpdate(false), previousTickTimeUs(0) {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+PositionSimulator::~PositionSimulator() {}
+
+/********************************************************
+* @brief    advance
+* @details  This method moves the vehicle on a great circle
+*           from current position with current heading.
+* @param    distanceKm  Driven distance (km)
+* @return   None
+********************************************************/
+void PositionSimulator::advance(double distanceKm) {
+    if (distanceKm <= 0.0) {
+        return;
+    }
+
+    double angle = distanceKm / EARTH_RADIUS_KM;
+    double lat = latitude * DEGREE_TO_RADIAN;
+    double lon = longitude * DEGREE_TO_RADIAN;
+    double bearing = heading * DEGREE_TO_RADIAN;
+
+    double newLat = asin(sin(lat) * cos(angle) + cos(lat) * sin(angle) * cos(bearing));
+    double newLon = lon + atan2(sin(bearing) * sin(angle) * cos(lat),
+        cos(angle) - sin(lat) * sin(newLat));
+
+    latitude = newLat / DEGREE_TO_RADIAN;
+    longitude = remainder(newLon / DEGREE_TO_RADIAN, 360.0);
+}
+
+/********************************************************
+* @brief    getLatitude
+* @details  This method gets current latitude.
+* @param    None
+* @return   double  Return latitude (degree)
+********************************************************/
+double PositionSimulator::getLatitude() const {
+    return latitude;
+}
+
+/********************************************************
+* @brief    getLongitude
+* @details  This method gets current longitude.
+* @param    None
+* @return   double  Return longitude (degree)
+********************************************************/
+double PositionSimulator::getLongitude() const {
+    return longitude;
+}
+
+/********************************************************
+* @brief    update
+* @details  This method will be called when Dashboard
+*           Controller publishes new state, the vehicle
+*           moves with the previous speed for the time
+*           between both updates.
+* @param    snapshot    State published by DashboardController
+* @return   None
+********************************************************/
+void PositionSimulator::update(const StateSnapshot& snapshot) {
+    if (hasPreviousUpdate && snapshot.tickTimeUs > previousTickTimeUs) {
+        double dt = (snapshot.tickTimeUs - previousTickTimeUs) / 1000000.0;
+        advance(snapshot.oldState.speed * dt / 3600.0);
+    }
+
+    previousTickTimeUs = snapshot.tickTimeUs;
+    hasPreviousUpdate = true;
+}
@@ -0,0 +1,198 @@
+/********************************************************
+* @file     RoutePredictor.cpp
+* @brief    Define methods related to route based battery
+*           prediction
+* @details  This file contains methods definition related
+*           to route prediction, includes load route file,
+*           integrate battery drain along segments and
+*           predict batches on several threads.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "RoutePredictor.hpp"
+#include "ParallelFor.hpp"
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+/********************************************************
+* @brief    loadRoute
+* @details  This function loads route segments from CSV
+*           file, invalid lines are reported and skipped.
+* @param    path    Path to route file
+* @param    route   Loaded segments
+* @return   bool    Return true if at least 1 segment is loaded
+********************************************************/
+bool loadRoute(const string& path, vector<RouteSegment>& route) {
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        cerr << "Cannot open file " << path << endl;
+        return false;
+    }
+
+    route.clear();
+    string line, field;
+    int lineNumber = 0;
+
+    while (getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // Length, speed limit, grade
+        stringstream ss(line);
+        double values[3];
+        int count = 0;
+        while (count < 3 && getline(ss, field, ',')) {
+            try {
+                values[count] = stod(field);
+            } catch (...) {
+                break;
+            }
+            count++;
+        }
+
+        if (count < 3 || values[0] < 0.0 || values[1] <= 0.0) {
+            cerr << "Invalid segment at line " << lineNumber << " in " << path << endl;
+            continue;
+        }
+
+        RouteSegment segment;
+        segment.lengthKm = values[0];
+        segment.speedLimit = (int)values[1];
+        segment.gradePercent = values[2];
+        route.push_back(segment);
+    }
+
+    return !route.empty();
+}
+
+/********************************************************
+* @brief Constructor
+* @param batteryManager   Pointer to battery manager with
+*                         the drain model and capacity
+********************************************************/
+RoutePredictor::RoutePredictor(const BatteryManager* batteryManager)
+    : batteryManager(batteryManager) {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+RoutePredictor::~RoutePredictor() {}
+
+/********************************************************
+* @brief    integrate
+* @details  This method integrates battery drain segment by
+*           segment. Drain of calculateBatteryDrain is used
+*           per km like calculateRamainingRange, so state of
+*           charge drops by drain / capacity * 100 per km,
+*           scaled by the grade of the segment.
+* @param    query           Route, start and conditions
+* @param    socAtWaypoint   Filled with segmentCount + 1
+*                           values, can be NULL
+* @return   RoutePrediction Return prediction
+********************************************************/
+RoutePrediction RoutePredictor::integrate(const RouteQuery& query, double* socAtWaypoint) const {
+    RoutePrediction result;
+    result.energyKwh = 0.0;
+    result.distanceKm = 0.0;
+    result.durationHours = 0.0;
+    result.emptySegment = -1;
+
+    double capacity = numericToDouble(batteryManager->getBatteryCapacity());
+    double soc = query.startSoc;
+    double minSoc = soc;
+
+    if (socAtWaypoint) {
+        socAtWaypoint[0] = soc;
+    }
+
+    for (size_t i = 0; i < query.segmentCount; i++) {
+        const RouteSegment& segment = query.segments[i];
+
+        int speed = segment.speedLimit;
+        if (query.scenario.speedCap > 0 && speed > query.scenario.speedCap) {
+            speed = query.scenario.speedCap;
+        }
+
+        double gradeFactor = 1.0 + segment.gradePercent * ROUTE_GRADE_FACTOR;
+        if (gradeFactor < ROUTE_MIN_GRADE_FACTOR) {
+            gradeFactor = ROUTE_MIN_GRADE_FACTOR;
+        }
+
+        double drainPerKm = numericToDouble(batteryManager->calculateBatteryDrain(speed,
+            query.scenario.acTemp, query.scenario.windLevel)) * gradeFactor;
+        double energy = drainPerKm * segment.lengthKm;
+
+        result.energyKwh += energy;
+        result.distanceKm += segment.lengthKm;
+        if (speed > 0) {
+            result.durationHours += segment.lengthKm / speed;
+        }
+
+        if (capacity > 0.0) {
+            soc -= energy / capacity * 100.0;
+        }
+        if (soc < minSoc) {
+            minSoc = soc;
+        }
+        if (soc <= 0.0 && result.emptySegment < 0) {
+            result.emptySegment = (long)i;
+        }
+
+        if (socAtWaypoint) {
+            socAtWaypoint[i + 1] = soc;
+        }
+    }
+
+    result.finalSoc = soc;
+    result.minSoc = minSoc;
+    result.isReachable = (result.emptySegment < 0);
+    return result;
+}
+
+/********************************************************
+* @brief    predict
+* @details  This method predicts result of a route.
+* @param    query           Route, start and conditions
+* @return   RoutePrediction Return prediction
+********************************************************/
+RoutePrediction RoutePredictor::predict(const RouteQuery& query) const {
+    return integrate(query, NULL);
+}
+
+/********************************************************
+* @brief    predictWaypoints
+* @details  This method predicts state of charge at every
+*           waypoint of a route.
+* @param    query           Route, start and conditions
+* @param    socAtWaypoint   Filled with segmentCount + 1
+*                           values, first is start (%)
+* @return   RoutePrediction Return prediction
+********************************************************/
+RoutePrediction RoutePredictor::predictWaypoints(const RouteQuery& query, double* socAtWaypoint) const {
+    return integrate(query, socAtWaypoint);
+}
+
+/********************************************************
+* @brief    predictBatch
+* @details  This method splits queries into contiguous
+*           chunks, one chunk per thread. Each result is
+*           written by one thread only.
+* @param    queries     Queries to predict
+* @param    count       Number of queries
+* @param    results     Filled with count predictions
+* @param    workers     Number of threads (0 use hardware threads)
+* @return   None
+********************************************************/
+void RoutePredictor::predictBatch(const RouteQuery* queries, size_t count, RoutePrediction* results,
+    unsigned int workers) const {
+    parallelFor(count, workers, [this, queries, results](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; i++) {
+            results[i] = integrate(queries[i], NULL);
+        }
+    });
+}
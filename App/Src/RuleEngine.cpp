@@ -0,0 +1,907 @@
+/********************************************************
+* @file     RuleEngine.cpp
+* @brief    Define methods related to derived signals and
+*           alarms
+* @details  This file contains methods definition related
+*           to the rule engine, includes load rule file,
+*           compile expressions into bytecode, run the
+*           bytecode and update alarm state.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "RuleEngine.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+/********************************************************
+* Layout of values: fields of DashboardState, then registers
+* shared by all rules, then signals, conditions and
+* constants in order they are compiled
+********************************************************/
+#define RULE_SLOT_SPEED     0
+#define RULE_SLOT_MODE      1
+#define RULE_SLOT_BATTERY   2
+#define RULE_SLOT_RANGE     3
+#define RULE_SLOT_AC_TEMP   4
+#define RULE_SLOT_WIND      5
+#define RULE_SLOT_DT        6
+#define RULE_FIELD_COUNT    7
+#define RULE_TEMP_BASE      RULE_FIELD_COUNT
+
+/********************************************************
+* @brief Names of fields, index is slot
+********************************************************/
+static const char* fieldNames[RULE_FIELD_COUNT] = {
+    "speed", "mode", "battery", "range", "acTemp", "wind", "dt"
+};
+
+/********************************************************
+* @brief    isRegister
+* @details  This function checks a value is a register, its
+*           content is only valid inside one rule.
+* @param    slot    Index of value
+* @return   bool    Return true if it is a register
+********************************************************/
+static inline bool isRegister(int slot) {
+    return slot >= RULE_TEMP_BASE && slot < RULE_TEMP_BASE + RULE_MAX_TEMPS;
+}
+
+/********************************************************
+* @brief    applyOperation
+* @details  This function runs one operation, it is used by
+*           the interpreter and by constant folding.
+* @param    op      Operation
+* @param    a       First operand
+* @param    b       Second operand
+* @return   double  Return result, comparisons give 1 or 0
+********************************************************/
+static inline double applyOperation(int op, double a, double b) {
+    switch (op) {
+    case RULE_OP_MOV:   return a;
+    case RULE_OP_ADD:   return a + b;
+    case RULE_OP_SUB:   return a - b;
+    case RULE_OP_MUL:   return a * b;
+    case RULE_OP_DIV:   return b != 0.0 ? a / b : 0.0;
+    case RULE_OP_MIN:   return a < b ? a : b;
+    case RULE_OP_MAX:   return a > b ? a : b;
+    case RULE_OP_LT:    return a < b;
+    case RULE_OP_LE:    return a <= b;
+    case RULE_OP_GT:    return a > b;
+    case RULE_OP_GE:    return a >= b;
+    case RULE_OP_EQ:    return a == b;
+    case RULE_OP_NE:    return a != b;
+    case RULE_OP_AND:   return a != 0.0 && b != 0.0;
+    case RULE_OP_OR:    return a != 0.0 || b != 0.0;
+    case RULE_OP_NOT:   return a == 0.0;
+    case RULE_OP_NEG:   return -a;
+    case RULE_OP_ABS:   return fabs(a);
+    default:            return 0.0;
+    }
+}
+
+/********************************************************
+* @brief Constructor, engine has no rule
+********************************************************/
+RuleEngine::RuleEngine()
+    : values(RULE_FIELD_COUNT + RULE_MAX_TEMPS, 0.0), isConstantSlot(RULE_FIELD_COUNT + RULE_MAX_TEMPS, 0),
+      eventCount(0), droppedEvents(0), lastTickTimeUs(0), hasLastTick(false), hasEvaluated(false),
+      cursor(NULL), tempTop(RULE_TEMP_BASE) {}
+
+/********************************************************
+* @brief    load
+* @details  This method loads rules from file, one rule per
+*           line, lines start with '#' are comments. Invalid
+*           rules are reported and skipped.
+* @param    path    Path to rule file
+* @return   bool    Return true if at least 1 rule is loaded
+********************************************************/
+bool RuleEngine::load(const string& path) {
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        cerr << "Cannot open file " << path << endl;
+        return false;
+    }
+
+    string line;
+    int lineNumber = 0;
+    int loaded = 0;
+
+    while (getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+
+        size_t start = line.find_first_not_of(" \t");
+        if (start == string::npos || line[start] == '#') {
+            continue;
+        }
+
+        if (addRule(line)) {
+            loaded++;
+        } else {
+            cerr << "Invalid rule at line " << lineNumber << " of " << path << ": " << compileError << endl;
+        }
+    }
+
+    return loaded > 0;
+}
+
+/********************************************************
+* @brief    addRule
+* @details  This method compiles one rule. Instructions are
+*           added after instructions of earlier rules, so a
+*           rule can use signals defined before it. Nothing
+*           is kept if the rule is invalid.
+* @param    text    Rule, see RuleEngine.hpp
+* @return   bool    Return false if rule is invalid
+********************************************************/
+bool RuleEngine::addRule(const string& text) {
+    size_t programSize = program.size();
+    size_t valueCount = values.size();
+    size_t previousCount = previousSlots.size();
+    size_t sharedCount = sharedSlots.size();
+
+    compileError.clear();
+    cursor = text.c_str();
+
+    string kind, name;
+    bool isValid = readName(kind) && readName(name) && accept('=');
+
+    if (!isValid) {
+        compileError = "expected signal or alarm, name and '='";
+    } else if (findVariable(name) >= 0 || findAlarm(name) >= 0 || name == "ECO" || name == "SPORT") {
+        compileError = "name " + name + " is already used";
+        isValid = false;
+    } else if (kind == "signal") {
+        int slot = compileExpression();
+        while (isspace((unsigned char)*cursor)) {
+            cursor++;
+        }
+
+        isValid = slot >= 0 && *cursor == '\0';
+        if (slot >= 0 && *cursor != '\0') {
+            compileError = string("unexpected ") + cursor;
+        }
+        if (isValid) {
+            RuleSignal signal;
+            signal.name = name;
+            signal.slot = (uint16_t)slot;
+            signals.push_back(signal);
+        }
+    } else if (kind == "alarm") {
+        RuleAlarm alarm;
+        alarm.name = name;
+        alarm.clearSlot = -1;
+        alarm.delaySeconds = 0.0;
+        alarm.notify = RULE_NOTIFY_BOTH;
+        alarm.isActive = false;
+        alarm.heldSeconds = 0.0;
+
+        int condition = compileExpression();
+        isValid = condition >= 0;
+        alarm.conditionSlot = (uint16_t)(isValid ? condition : 0);
+
+        // Options in any order, then message
+        while (isValid) {
+            if (acceptWord("for")) {
+                while (isspace((unsigned char)*cursor)) {
+                    cursor++;
+                }
+                char* end = NULL;
+                alarm.delaySeconds = strtod(cursor, &end);
+                if (end == cursor || alarm.delaySeconds < 0) {
+                    compileError = "expected time after for";
+                    isValid = false;
+                    break;
+                }
+                cursor = end;
+                if (acceptWord("ms")) {
+                    alarm.delaySeconds /= 1000.0;
+                } else {
+                    acceptWord("s");
+                }
+            } else if (acceptWord("clear")) {
+                alarm.clearSlot = compileExpression();
+                isValid = alarm.clearSlot >= 0;
+            } else if (acceptWord("notify")) {
+                string edges;
+                readName(edges);
+                if (edges == "rise") {
+                    alarm.notify = RULE_NOTIFY_RISE;
+                } else if (edges == "fall") {
+                    alarm.notify = RULE_NOTIFY_FALL;
+                } else if (edges == "both") {
+                    alarm.notify = RULE_NOTIFY_BOTH;
+                } else if (edges == "none") {
+                    alarm.notify = RULE_NOTIFY_NONE;
+                } else {
+                    compileError = "expected rise, fall, both or none after notify";
+                    isValid = false;
+                }
+            } else if (accept(':')) {
+                alarm.message = cursor;
+                size_t start = alarm.message.find_first_not_of(" \t");
+                alarm.message = (start == string::npos) ? name : alarm.message.substr(start);
+                break;
+            } else if (accept('\0')) {
+                alarm.message = name;
+                break;
+            } else {
+                compileError = string("unexpected ") + cursor;
+                isValid = false;
+            }
+        }
+
+        if (isValid) {
+            alarms.push_back(alarm);
+        }
+    } else {
+        compileError = "unknown rule " + kind;
+        isValid = false;
+    }
+
+    if (!isValid) {
+        program.resize(programSize);
+        values.resize(valueCount);
+        isConstantSlot.resize(valueCount);
+        previousSlots.resize(previousCount);
+        previousSources.resize(previousCount);
+        sharedKeys.resize(sharedCount);
+        sharedSlots.resize(sharedCount);
+    }
+    cursor = NULL;
+    return isValid;
+}
+
+/********************************************************
+* @brief    evaluate
+* @details  This method copies the state into the fields,
+*           runs the program of all rules, then updates
+*           alarms. Registers and results are in one array,
+*           each instruction is one switch on the opcode.
+* @param    state       State to evaluate
+* @param    dtSeconds   Time since last evaluation (s)
+* @param    tickTimeUs  Time of state, kept in events
+* @return   None
+********************************************************/
+void RuleEngine::evaluate(const DashboardState& state, double dtSeconds, uint64_t tickTimeUs) {
+    double* value = values.data();
+    value[RULE_SLOT_SPEED] = state.speed;
+    value[RULE_SLOT_MODE] = state.driveMode;
+    value[RULE_SLOT_BATTERY] = state.batteryLevel;
+    value[RULE_SLOT_RANGE] = state.remainingRange;
+    value[RULE_SLOT_AC_TEMP] = state.acTemp;
+    value[RULE_SLOT_WIND] = state.windLevel;
+    value[RULE_SLOT_DT] = dtSeconds;
+
+    // prev() of fields is the current value on first run
+    size_t previousCount = previousSlots.size();
+    if (!hasEvaluated) {
+        for (size_t i = 0; i < previousCount; i++) {
+            value[previousSlots[i]] = value[previousSources[i]];
+        }
+    }
+
+    const RuleInstruction* code = program.data();
+    size_t count = program.size();
+    for (size_t i = 0; i < count; i++) {
+        const RuleInstruction& instruction = code[i];
+        value[instruction.dst] = applyOperation(instruction.op, value[instruction.a], value[instruction.b]);
+    }
+
+    // Alarms: raise after condition holds for delay, clear
+    // on clear condition or when condition is false
+    for (size_t i = 0; i < alarms.size(); i++) {
+        RuleAlarm& alarm = alarms[i];
+        bool isCondition = value[alarm.conditionSlot] != 0.0;
+
+        if (!alarm.isActive) {
+            alarm.heldSeconds = isCondition ? alarm.heldSeconds + dtSeconds : 0.0;
+            if (isCondition && alarm.heldSeconds >= alarm.delaySeconds) {
+                alarm.isActive = true;
+                pushEvent(i, RULE_EVENT_RAISED, tickTimeUs);
+            }
+        } else {
+            bool isClear = (alarm.clearSlot >= 0) ? value[alarm.clearSlot] != 0.0 : !isCondition;
+            if (isClear) {
+                alarm.isActive = false;
+                alarm.heldSeconds = 0.0;
+                pushEvent(i, RULE_EVENT_CLEARED, tickTimeUs);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < previousCount; i++) {
+        value[previousSlots[i]] = value[previousSources[i]];
+    }
+    hasEvaluated = true;
+}
+
+/********************************************************
+* @brief    update
+* @details  This method runs all rules on a published state,
+*           time between states is taken from the snapshot.
+* @param    snapshot    State published by DashboardController
+* @return   None
+********************************************************/
+void RuleEngine::update(const StateSnapshot& snapshot) {
+    double dtSeconds = 0.0;
+    if (hasLastTick && snapshot.tickTimeUs > lastTickTimeUs) {
+        dtSeconds = (double)(snapshot.tickTimeUs - lastTickTimeUs) / 1e6;
+    }
+    lastTickTimeUs = snapshot.tickTimeUs;
+    hasLastTick = true;
+
+    evaluate(snapshot.newState, dtSeconds, snapshot.tickTimeUs);
+}
+
+/********************************************************
+* @brief    takeEvents
+* @details  This method copies events in order they happened
+*           and removes them from the engine.
+* @param    out         Array to copy events into
+* @param    maxEvents   Size of out
+* @return   size_t      Return number of events copied
+********************************************************/
+size_t RuleEngine::takeEvents(RuleEvent* out, size_t maxEvents) {
+    size_t count = eventCount < maxEvents ? eventCount : maxEvents;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = events[i];
+    }
+    for (size_t i = count; i < eventCount; i++) {
+        events[i - count] = events[i];
+    }
+    eventCount -= count;
+    return count;
+}
+
+/********************************************************
+* @brief    findAlarm
+* @details  This method finds an alarm by name.
+* @param    name    Name of alarm
+* @return   int     Return index of alarm, -1 if not found
+********************************************************/
+int RuleEngine::findAlarm(const string& name) const {
+    for (size_t i = 0; i < alarms.size(); i++) {
+        if (alarms[i].name == name) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+size_t RuleEngine::getAlarmCount() const {
+    return alarms.size();
+}
+
+const RuleAlarm& RuleEngine::getAlarm(size_t index) const {
+    return alarms[index];
+}
+
+size_t RuleEngine::getSignalCount() const {
+    return signals.size();
+}
+
+const string& RuleEngine::getSignalName(size_t index) const {
+    return signals[index].name;
+}
+
+double RuleEngine::getSignalValue(size_t index) const {
+    return values[signals[index].slot];
+}
+
+size_t RuleEngine::getInstructionCount() const {
+    return program.size();
+}
+
+unsigned long RuleEngine::getDroppedEvents() const {
+    return droppedEvents;
+}
+
+/********************************************************
+* @brief    pushEvent
+* @details  This method stores an alarm edge if the alarm
+*           notifies it, the event is lost if the list is
+*           full.
+* @param    alarm       Index of alarm
+* @param    type        Edge
+* @param    tickTimeUs  Time of publish
+* @return   None
+********************************************************/
+void RuleEngine::pushEvent(size_t alarm, RuleEventType type, uint64_t tickTimeUs) {
+    int edge = (type == RULE_EVENT_RAISED) ? RULE_NOTIFY_RISE : RULE_NOTIFY_FALL;
+    if ((alarms[alarm].notify & edge) == 0) {
+        return;
+    }
+
+    if (eventCount >= RULE_MAX_EVENTS) {
+        droppedEvents++;
+        return;
+    }
+
+    RuleEvent& event = events[eventCount++];
+    event.type = type;
+    event.alarm = alarm;
+    event.tickTimeUs = tickTimeUs;
+}
+
+/********************************************************
+* @brief    accept
+* @details  This method skips spaces and the given character
+*           if it is next. '\0' matches end of rule.
+* @param    ch      Character to match
+* @return   bool    Return true if it matches
+********************************************************/
+bool RuleEngine::accept(char ch) {
+    while (isspace((unsigned char)*cursor)) {
+        cursor++;
+    }
+    if (*cursor != ch) {
+        return false;
+    }
+    if (ch != '\0') {
+        cursor++;
+    }
+    return true;
+}
+
+/********************************************************
+* @brief    acceptPair
+* @details  This method skips spaces and the given 2
+*           characters if they are next.
+* @param    text    2 characters to match
+* @return   bool    Return true if they match
+********************************************************/
+bool RuleEngine::acceptPair(const char* text) {
+    while (isspace((unsigned char)*cursor)) {
+        cursor++;
+    }
+    if (cursor[0] != text[0] || cursor[1] != text[1]) {
+        return false;
+    }
+    cursor += 2;
+    return true;
+}
+
+/********************************************************
+* @brief    readName
+* @details  This method reads a name made of letters, digits
+*           and '_', it does not start with a digit.
+* @param    name    Read name, empty if none
+* @return   bool    Return false if there is no name
+********************************************************/
+bool RuleEngine::readName(string& name) {
+    while (isspace((unsigned char)*cursor)) {
+        cursor++;
+    }
+
+    const char* start = cursor;
+    if (isalpha((unsigned char)*cursor) || *cursor == '_') {
+        while (isalnum((unsigned char)*cursor) || *cursor == '_') {
+            cursor++;
+        }
+    }
+    name.assign(start, cursor - start);
+    return !name.empty();
+}
+
+/********************************************************
+* @brief    acceptWord
+* @details  This method skips the given word if it is next
+*           and is not the start of a longer name.
+* @param    word    Word to match
+* @return   bool    Return true if it matches
+********************************************************/
+bool RuleEngine::acceptWord(const char* word) {
+    while (isspace((unsigned char)*cursor)) {
+        cursor++;
+    }
+
+    size_t length = strlen(word);
+    if (strncmp(cursor, word, length) != 0
+        || isalnum((unsigned char)cursor[length]) || cursor[length] == '_') {
+        return false;
+    }
+    cursor += length;
+    return true;
+}
+
+/********************************************************
+* @brief    compileExpression
+* @details  This method compiles an expression at cursor.
+*           A result in a register is moved to its own slot
+*           by changing the last instruction, so registers
+*           are free for next rule. Other results (field,
+*           signal, constant or shared result) are used as
+*           they are.
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::compileExpression() {
+    tempTop = RULE_TEMP_BASE;
+    int result = parseOr();
+    if (result < 0 || !isRegister(result)) {
+        return result;
+    }
+
+    // Last instruction computed the result
+    int slot = addValue(0.0);
+    if (slot >= 0) {
+        program.back().dst = (uint16_t)slot;
+    }
+    return slot;
+}
+
+/********************************************************
+* @brief    emit
+* @details  This method adds one instruction writing to the
+*           first free register, operand registers are free
+*           again. If all operands are constants the result
+*           is a constant and no instruction is added. If no
+*           operand is a register the result does not depend
+*           on the rule, it gets its own slot and later rules
+*           with the same operation reuse it.
+* @param    op      Operation
+* @param    base    First register free before operands
+* @param    a       Index of first operand
+* @param    b       Index of second operand
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::emit(RuleOpcode op, int base, int a, int b) {
+    tempTop = base;
+    if (isConstantSlot[a] && isConstantSlot[b]) {
+        return addConstant(applyOperation(op, values[a], values[b]));
+    }
+
+    if (!isRegister(a) && !isRegister(b)) {
+        bool isCommutative = op == RULE_OP_ADD || op == RULE_OP_MUL || op == RULE_OP_MIN || op == RULE_OP_MAX
+            || op == RULE_OP_EQ || op == RULE_OP_NE || op == RULE_OP_AND || op == RULE_OP_OR;
+        if (isCommutative && a > b) {
+            int swap = a;
+            a = b;
+            b = swap;
+        }
+
+        uint64_t key = ((uint64_t)op << 32) | ((uint64_t)a << 16) | (uint64_t)b;
+        for (size_t i = 0; i < sharedKeys.size(); i++) {
+            if (sharedKeys[i] == key) {
+                return sharedSlots[i];
+            }
+        }
+
+        int dst = addValue(0.0);
+        if (dst < 0) {
+            return -1;
+        }
+        sharedKeys.push_back(key);
+        sharedSlots.push_back((uint16_t)dst);
+        RuleInstruction instruction = { (uint16_t)op, (uint16_t)dst, (uint16_t)a, (uint16_t)b };
+        program.push_back(instruction);
+        return dst;
+    }
+
+    if (tempTop >= RULE_TEMP_BASE + RULE_MAX_TEMPS) {
+        compileError = "expression is too long";
+        return -1;
+    }
+
+    int dst = tempTop++;
+    RuleInstruction instruction = { (uint16_t)op, (uint16_t)dst, (uint16_t)a, (uint16_t)b };
+    program.push_back(instruction);
+    return dst;
+}
+
+/********************************************************
+* @brief    parseOr
+* @details  or := and { "||" and }
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parseOr() {
+    int base = tempTop;
+    int left = parseAnd();
+    while (left >= 0 && acceptPair("||")) {
+        int right = parseAnd();
+        left = (right < 0) ? -1 : emit(RULE_OP_OR, base, left, right);
+    }
+    return left;
+}
+
+/********************************************************
+* @brief    parseAnd
+* @details  and := equality { "&&" equality }
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parseAnd() {
+    int base = tempTop;
+    int left = parseEquality();
+    while (left >= 0 && acceptPair("&&")) {
+        int right = parseEquality();
+        left = (right < 0) ? -1 : emit(RULE_OP_AND, base, left, right);
+    }
+    return left;
+}
+
+/********************************************************
+* @brief    parseEquality
+* @details  equality := relational { ("==" | "!=") relational }
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parseEquality() {
+    int base = tempTop;
+    int left = parseRelational();
+    while (left >= 0) {
+        RuleOpcode op;
+        if (acceptPair("==")) {
+            op = RULE_OP_EQ;
+        } else if (acceptPair("!=")) {
+            op = RULE_OP_NE;
+        } else {
+            break;
+        }
+        int right = parseRelational();
+        left = (right < 0) ? -1 : emit(op, base, left, right);
+    }
+    return left;
+}
+
+/********************************************************
+* @brief    parseRelational
+* @details  relational := additive { ("<" | "<=" | ">" |
+*           ">=") additive }
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parseRelational() {
+    int base = tempTop;
+    int left = parseAdditive();
+    while (left >= 0) {
+        RuleOpcode op;
+        if (acceptPair("<=")) {
+            op = RULE_OP_LE;
+        } else if (acceptPair(">=")) {
+            op = RULE_OP_GE;
+        } else if (accept('<')) {
+            op = RULE_OP_LT;
+        } else if (accept('>')) {
+            op = RULE_OP_GT;
+        } else {
+            break;
+        }
+        int right = parseAdditive();
+        left = (right < 0) ? -1 : emit(op, base, left, right);
+    }
+    return left;
+}
+
+/********************************************************
+* @brief    parseAdditive
+* @details  additive := multiplicative { ("+" | "-")
+*           multiplicative }
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parseAdditive() {
+    int base = tempTop;
+    int left = parseMultiplicative();
+    while (left >= 0) {
+        RuleOpcode op;
+        if (accept('+')) {
+            op = RULE_OP_ADD;
+        } else if (accept('-')) {
+            op = RULE_OP_SUB;
+        } else {
+            break;
+        }
+        int right = parseMultiplicative();
+        left = (right < 0) ? -1 : emit(op, base, left, right);
+    }
+    return left;
+}
+
+/********************************************************
+* @brief    parseMultiplicative
+* @details  multiplicative := unary { ("*" | "/") unary }
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parseMultiplicative() {
+    int base = tempTop;
+    int left = parseUnary();
+    while (left >= 0) {
+        RuleOpcode op;
+        if (accept('*')) {
+            op = RULE_OP_MUL;
+        } else if (accept('/')) {
+            op = RULE_OP_DIV;
+        } else {
+            break;
+        }
+        int right = parseUnary();
+        left = (right < 0) ? -1 : emit(op, base, left, right);
+    }
+    return left;
+}
+
+/********************************************************
+* @brief    parseUnary
+* @details  unary := ("!" | "-") unary | primary
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parseUnary() {
+    int base = tempTop;
+    if (accept('!')) {
+        int operand = parseUnary();
+        return (operand < 0) ? -1 : emit(RULE_OP_NOT, base, operand, operand);
+    }
+    if (accept('-')) {
+        int operand = parseUnary();
+        return (operand < 0) ? -1 : emit(RULE_OP_NEG, base, operand, operand);
+    }
+    return parsePrimary();
+}
+
+/********************************************************
+* @brief    parsePrimary
+* @details  primary := number | field | signal | ECO | SPORT
+*           | "(" or ")" | min(or, or) | max(or, or)
+*           | abs(or) | prev(field or signal)
+* @param    None
+* @return   int     Return index of result, -1 on error
+********************************************************/
+int RuleEngine::parsePrimary() {
+    int base = tempTop;
+
+    if (accept('(')) {
+        int inner = parseOr();
+        if (inner >= 0 && !accept(')')) {
+            compileError = "expected ')'";
+            return -1;
+        }
+        return inner;
+    }
+
+    if (isdigit((unsigned char)*cursor) || *cursor == '.') {
+        char* end = NULL;
+        double number = strtod(cursor, &end);
+        if (end == cursor) {
+            compileError = string("invalid number ") + cursor;
+            return -1;
+        }
+        cursor = end;
+        return addConstant(number);
+    }
+
+    string name;
+    if (!readName(name)) {
+        compileError = (*cursor == '\0') ? string("unexpected end of rule") : string("unexpected ") + cursor;
+        return -1;
+    }
+
+    if (name == "ECO") {
+        return addConstant(ECO);
+    }
+    if (name == "SPORT") {
+        return addConstant(SPORT);
+    }
+
+    if (!accept('(')) {
+        int slot = findVariable(name);
+        if (slot < 0) {
+            compileError = "unknown name " + name;
+        }
+        return slot;
+    }
+
+    // Functions
+    if (name == "prev") {
+        string variable;
+        int source = readName(variable) ? findVariable(variable) : -1;
+        if (source < 0 || !accept(')')) {
+            compileError = "prev() needs a field or signal";
+            return -1;
+        }
+
+        for (size_t i = 0; i < previousSources.size(); i++) {
+            if (previousSources[i] == source) {
+                return previousSlots[i];
+            }
+        }
+        int slot = addValue(0.0);
+        if (slot >= 0) {
+            previousSlots.push_back((uint16_t)slot);
+            previousSources.push_back((uint16_t)source);
+        }
+        return slot;
+    }
+
+    bool isBinary = (name == "min" || name == "max");
+    if (!isBinary && name != "abs") {
+        compileError = "unknown function " + name;
+        return -1;
+    }
+
+    int a = parseOr();
+    int b = a;
+    if (a >= 0 && isBinary) {
+        b = accept(',') ? parseOr() : -1;
+    }
+    if (a < 0 || b < 0 || !accept(')')) {
+        if (compileError.empty()) {
+            compileError = "invalid arguments of " + name;
+        }
+        return -1;
+    }
+
+    RuleOpcode op = (name == "min") ? RULE_OP_MIN : (name == "max") ? RULE_OP_MAX : RULE_OP_ABS;
+    return emit(op, base, a, b);
+}
+
+/********************************************************
+* @brief    addConstant
+* @details  This method gets index of a constant, constants
+*           with the same value share one index.
+* @param    value   Constant
+* @return   int     Return index of value, -1 if full
+********************************************************/
+int RuleEngine::addConstant(double value) {
+    for (size_t i = RULE_FIELD_COUNT + RULE_MAX_TEMPS; i < values.size(); i++) {
+        if (isConstantSlot[i] && values[i] == value) {
+            return (int)i;
+        }
+    }
+
+    int slot = addValue(value);
+    if (slot >= 0) {
+        isConstantSlot[slot] = 1;
+    }
+    return slot;
+}
+
+/********************************************************
+* @brief    addValue
+* @details  This method adds a value that is not constant.
+* @param    value   Initial value
+* @return   int     Return index of value, -1 if full
+********************************************************/
+int RuleEngine::addValue(double value) {
+    if (values.size() >= RULE_MAX_VALUES) {
+        compileError = "too many values";
+        return -1;
+    }
+
+    values.push_back(value);
+    isConstantSlot.push_back(0);
+    return (int)values.size() - 1;
+}
+
+/********************************************************
+* @brief    findVariable
+* @details  This method finds a field or a signal by name.
+* @param    name    Name of field or signal
+* @return   int     Return index of value, -1 if not found
+********************************************************/
+int RuleEngine::findVariable(const string& name) const {
+    for (int i = 0; i < RULE_FIELD_COUNT; i++) {
+        if (name == fieldNames[i]) {
+            return i;
+        }
+    }
+    for (size_t i = 0; i < signals.size(); i++) {
+        if (signals[i].name == name) {
+            return signals[i].slot;
+        }
+    }
+    return -1;
+}
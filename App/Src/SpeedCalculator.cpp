@@ -3,7 +3,9 @@
 * @brief    Define methods related to speed calculation
 * @details  This file contains methods definition related
 *           to speed calculation, include calculate speed
-*           and adjust speed.
+*           and adjust speed. Methods are instantiated for
+*           double and fixed-point numbers at the end of
+*           this file.
 * @version  1.0
 * @date     2024-11-10
 * @author   Tran Quang Khai
@@ -15,41 +17,69 @@ using namespace std;
 /********************************************************
 * @brief Constructor
 ********************************************************/
-SpeedCalculator::SpeedCalculator() 
-    : currentSpeed(0), maxSpeedSport(200), maxSpeedEco(150) {}
+template <typename Num>
+BasicSpeedCalculator<Num>::BasicSpeedCalculator() 
+    : currentSpeed(0), maxSpeedSport(DEFAULT_MAX_SPEED_SPORT), maxSpeedEco(DEFAULT_MAX_SPEED_ECO),
+      isCruiseOn(false), isCruiseOverridden(false), cruiseSetSpeed(0), cruiseIntegral(0), cruiseCommand(0),
+      cruiseLastSpeed(0), cruiseDt(0), cruiseKiDt(0), cruiseJerkDt(0), cruiseRateHz(0) {
+    setCruiseRate(CRUISE_DEFAULT_RATE_HZ);
+}
 
 /********************************************************
 * @brief Destructor
 ********************************************************/
-SpeedCalculator::~SpeedCalculator() {}
+template <typename Num>
+BasicSpeedCalculator<Num>::~BasicSpeedCalculator() {}
+
+/********************************************************
+* @brief    applyProfile
+* @details  This method applies speed limits of vehicle
+*           profile.
+* @param    profile     Parameters of vehicle variant
+* @return   None
+********************************************************/
+template <typename Num>
+void BasicSpeedCalculator<Num>::applyProfile(const VehicleProfile& profile) {
+    maxSpeedSport = Num(profile.maxSpeedSport);
+    maxSpeedEco = Num(profile.maxSpeedEco);
+}
 
 /********************************************************
 * @brief    calculateSpeed
 * @details  This method calculates speed base on brake 
-*           and accelerator state.
+*           and accelerator state. Brake cancels cruise
+*           control, accelerator overrides it while pressed.
 * @param    isAccelerating  Accelerator state
 * @param    isBraking       Brake state
 * @return   int     Return speed after check accelerator
 *                   and brake state
 ********************************************************/
-int SpeedCalculator::calculateSpeed(bool isAccelerating, bool isBraking) {
+template <typename Num>
+int BasicSpeedCalculator<Num>::calculateSpeed(bool isAccelerating, bool isBraking) {
+    // Brake cancels cruise control, accelerator overrides it
+    if (isBraking) {
+        cancelCruise();
+    }
+    isCruiseOverridden = isCruiseOn && isAccelerating;
+
     if (isAccelerating && !isBraking) {
-        currentSpeed += 2;
+        currentSpeed += Num(2);
     }
 
     if (isBraking && !isAccelerating) {
-        currentSpeed -= 2;
+        currentSpeed -= Num(2);
     }
 
-    if (!isBraking && !isAccelerating) {
-        currentSpeed -= 1;
+    // Cruise loop holds speed while pedals are released
+    if (!isBraking && !isAccelerating && !isCruiseOn) {
+        currentSpeed -= Num(1);
     }
 
-    if (currentSpeed < 0) {
-        currentSpeed = 0;
+    if (currentSpeed < Num(0)) {
+        currentSpeed = Num(0);
     }
     
-    return currentSpeed;
+    return getCurrentSpeed();
 }
 
 /********************************************************
@@ -58,11 +88,12 @@ int SpeedCalculator::calculateSpeed(bool isAccelerating, bool isBraking) {
 * @param    driveMode   Drive mode to get max speed
 * @return   int     Max speed
 ********************************************************/
-int SpeedCalculator::getMaxSpeed(const DriveMode driveMode) const {
+template <typename Num>
+int BasicSpeedCalculator<Num>::getMaxSpeed(const DriveMode driveMode) const {
     if (driveMode == ECO) {
-        return maxSpeedEco;
+        return numericToInt(maxSpeedEco);
     } 
-    return maxSpeedSport;
+    return numericToInt(maxSpeedSport);
 }
 
 /********************************************************
@@ -71,7 +102,8 @@ int SpeedCalculator::getMaxSpeed(const DriveMode driveMode) const {
 * @param    driveMode   Drive mode to adjust speed
 * @return   int     Speed after adjust 
 ********************************************************/
-void SpeedCalculator::adjustSpeedForDriveMode(const DriveMode driveMode) {
+template <typename Num>
+void BasicSpeedCalculator<Num>::adjustSpeedForDriveMode(const DriveMode driveMode) {
     if (driveMode == ECO) {
         if (currentSpeed > maxSpeedEco) {
             currentSpeed = maxSpeedEco;
@@ -87,11 +119,26 @@ void SpeedCalculator::adjustSpeedForDriveMode(const DriveMode driveMode) {
 
 /********************************************************
 * @brief    getCurrentSpeed
-* @details  This method gets current speed
+* @details  This method gets current speed, rounded to
+*           km/h. Speed only has a fraction after cruise
+*           control moved it.
 * @param    None
 * @return   int     Return current speed
 ********************************************************/
-int SpeedCalculator::getCurrentSpeed() const {
+template <typename Num>
+int BasicSpeedCalculator<Num>::getCurrentSpeed() const {
+    return numericToInt(currentSpeed + Num(0.5));
+}
+
+/********************************************************
+* @brief    getSpeedValue
+* @details  This method gets current speed without rounding,
+*           used to measure the cruise controller.
+* @param    None
+* @return   Num     Return current speed
+********************************************************/
+template <typename Num>
+Num BasicSpeedCalculator<Num>::getSpeedValue() const {
     return currentSpeed;
 }
 
@@ -101,6 +148,221 @@ int SpeedCalculator::getCurrentSpeed() const {
 * @param    newSpeed    Value to set speed
 * @return   None
 ********************************************************/
-void SpeedCalculator::setCurrentSpeed(int newSpeed) {
-    currentSpeed = newSpeed;
-}
\ No newline at end of file
+template <typename Num>
+void BasicSpeedCalculator<Num>::setCurrentSpeed(int newSpeed) {
+    currentSpeed = Num(newSpeed);
+}
+
+/********************************************************
+* @brief    getMaxSpeedNum
+* @details  This method gets max speed base on drive mode
+*           without rounding.
+* @param    driveMode   Drive mode to get max speed
+* @return   Num     Max speed
+********************************************************/
+template <typename Num>
+Num BasicSpeedCalculator<Num>::getMaxSpeedNum(const DriveMode driveMode) const {
+    return (driveMode == ECO) ? maxSpeedEco : maxSpeedSport;
+}
+
+/********************************************************
+* @brief    setCruiseRate
+* @details  This method sets rate of cruise loop. Each step
+*           uses the same time, so the result only depends
+*           on the number of steps, not on when they run.
+* @param    rateHz      Steps per second (1 - CRUISE_MAX_RATE_HZ)
+* @return   bool        Return false if rate is invalid
+********************************************************/
+template <typename Num>
+bool BasicSpeedCalculator<Num>::setCruiseRate(int rateHz) {
+    if (rateHz < 1 || rateHz > CRUISE_MAX_RATE_HZ) {
+        return false;
+    }
+
+    cruiseRateHz = rateHz;
+    cruiseDt = Num(1) / rateHz;
+    cruiseKiDt = Num(CRUISE_KI) / rateHz;
+    cruiseJerkDt = Num(CRUISE_MAX_JERK) / rateHz;
+    return true;
+}
+
+/********************************************************
+* @brief    getCruiseRate
+* @details  This method gets rate of cruise loop.
+* @param    None
+* @return   int     Return steps per second
+********************************************************/
+template <typename Num>
+int BasicSpeedCalculator<Num>::getCruiseRate() const {
+    return cruiseRateHz;
+}
+
+/********************************************************
+* @brief    engageCruise
+* @details  This method holds current speed, rounded to
+*           km/h. The integral starts at the command that
+*           cancels coasting loss, so speed does not jump.
+* @param    driveMode   Drive mode to limit set speed
+* @return   bool        Return false if speed is below
+*                       CRUISE_MIN_SPEED
+********************************************************/
+template <typename Num>
+bool BasicSpeedCalculator<Num>::engageCruise(const DriveMode driveMode) {
+    if (currentSpeed < Num(CRUISE_MIN_SPEED)) {
+        return false;
+    }
+
+    Num maxSpeed = getMaxSpeedNum(driveMode);
+    cruiseSetSpeed = Num(getCurrentSpeed());
+    if (cruiseSetSpeed > maxSpeed) {
+        cruiseSetSpeed = maxSpeed;
+    }
+
+    cruiseIntegral = Num(CRUISE_COAST_DECEL);
+    cruiseCommand = Num(CRUISE_COAST_DECEL);
+    cruiseLastSpeed = currentSpeed;
+    isCruiseOverridden = false;
+    isCruiseOn = true;
+    return true;
+}
+
+/********************************************************
+* @brief    adjustCruiseSpeed
+* @details  This method changes set speed, it stays between
+*           CRUISE_MIN_SPEED and max speed of drive mode.
+* @param    delta       Change of set speed (km/h)
+* @param    driveMode   Drive mode to limit set speed
+* @return   None
+********************************************************/
+template <typename Num>
+void BasicSpeedCalculator<Num>::adjustCruiseSpeed(int delta, const DriveMode driveMode) {
+    if (!isCruiseOn) {
+        return;
+    }
+
+    Num maxSpeed = getMaxSpeedNum(driveMode);
+    cruiseSetSpeed += Num(delta);
+    if (cruiseSetSpeed < Num(CRUISE_MIN_SPEED)) {
+        cruiseSetSpeed = Num(CRUISE_MIN_SPEED);
+    }
+    if (cruiseSetSpeed > maxSpeed) {
+        cruiseSetSpeed = maxSpeed;
+    }
+}
+
+/********************************************************
+* @brief    cancelCruise
+* @details  This method stops holding speed, the vehicle
+*           coasts from current speed.
+* @param    None
+* @return   None
+********************************************************/
+template <typename Num>
+void BasicSpeedCalculator<Num>::cancelCruise() {
+    isCruiseOn = false;
+    isCruiseOverridden = false;
+}
+
+/********************************************************
+* @brief    isCruiseActive
+* @details  This method checks cruise control holds speed.
+* @param    None
+* @return   bool    Return true if active
+********************************************************/
+template <typename Num>
+bool BasicSpeedCalculator<Num>::isCruiseActive() const {
+    return isCruiseOn;
+}
+
+/********************************************************
+* @brief    getCruiseSpeed
+* @details  This method gets set speed.
+* @param    None
+* @return   int     Return set speed
+********************************************************/
+template <typename Num>
+int BasicSpeedCalculator<Num>::getCruiseSpeed() const {
+    return numericToInt(cruiseSetSpeed);
+}
+
+/********************************************************
+* @brief    stepCruise
+* @details  This method runs one step of cruise control:
+*           PI on speed error with derivative on measured
+*           speed. The command is limited to strongest drive
+*           and brake and to CRUISE_MAX_JERK per second, the
+*           integral stops while a limit holds it back
+*           (anti-windup). The command drives the speed
+*           against coasting loss.
+*           Set speed is limited by max speed of drive mode.
+* @param    driveMode   Drive mode to limit speed
+* @return   None
+********************************************************/
+template <typename Num>
+void BasicSpeedCalculator<Num>::stepCruise(const DriveMode driveMode) {
+    if (!isCruiseOn) {
+        return;
+    }
+
+    // Accelerator sets speed, controller starts again from it
+    if (isCruiseOverridden) {
+        cruiseIntegral = Num(CRUISE_COAST_DECEL);
+        cruiseCommand = Num(CRUISE_COAST_DECEL);
+        cruiseLastSpeed = currentSpeed;
+        return;
+    }
+
+    Num maxSpeed = getMaxSpeedNum(driveMode);
+    Num target = (cruiseSetSpeed > maxSpeed) ? maxSpeed : cruiseSetSpeed;
+    Num error = target - currentSpeed;
+
+    Num derivative = (cruiseLastSpeed - currentSpeed) * cruiseRateHz;
+    Num demand = Num(CRUISE_KP) * error + cruiseIntegral + Num(CRUISE_KD) * derivative;
+
+    // Limit to strongest drive and brake, then to jerk
+    Num command = demand;
+    if (command > Num(CRUISE_MAX_ACCEL)) {
+        command = Num(CRUISE_MAX_ACCEL);
+    }
+    if (command < Num(-CRUISE_MAX_DECEL)) {
+        command = Num(-CRUISE_MAX_DECEL);
+    }
+    if (command > cruiseCommand + cruiseJerkDt) {
+        command = cruiseCommand + cruiseJerkDt;
+    }
+    if (command < cruiseCommand - cruiseJerkDt) {
+        command = cruiseCommand - cruiseJerkDt;
+    }
+
+    // Anti-windup, integral does not grow while a limit
+    // holds the command back in the direction of the error
+    bool isLimitedHigh = command < demand && error > Num(0);
+    bool isLimitedLow = command > demand && error < Num(0);
+    if (!isLimitedHigh && !isLimitedLow) {
+        cruiseIntegral += cruiseKiDt * error;
+        if (cruiseIntegral > Num(CRUISE_MAX_ACCEL)) {
+            cruiseIntegral = Num(CRUISE_MAX_ACCEL);
+        }
+        if (cruiseIntegral < Num(-CRUISE_MAX_DECEL)) {
+            cruiseIntegral = Num(-CRUISE_MAX_DECEL);
+        }
+    }
+    cruiseCommand = command;
+
+    // Vehicle answers command minus coasting loss
+    cruiseLastSpeed = currentSpeed;
+    currentSpeed += (cruiseCommand - Num(CRUISE_COAST_DECEL)) * cruiseDt;
+    if (currentSpeed < Num(0)) {
+        currentSpeed = Num(0);
+    }
+    if (currentSpeed > maxSpeed) {
+        currentSpeed = maxSpeed;
+    }
+}
+
+/********************************************************
+* Numeric types of the speed model
+********************************************************/
+template class BasicSpeedCalculator<double>;
+template class BasicSpeedCalculator<Q16_16>;
+template class BasicSpeedCalculator<Q32_32>;
\ No newline at end of file
@@ -0,0 +1,276 @@
+/********************************************************
+* @file     StateEstimator.cpp
+* @brief    Define methods related to speed and state of
+*           charge estimation
+* @details  This file contains methods definition related to
+*           the Kalman filter, includes prediction over an
+*           irregular time step with the drain model and
+*           scalar correction of each sample with outlier
+*           rejection.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "StateEstimator.hpp"
+#include <cmath>
+
+using namespace std;
+
+/********************************************************
+* @brief Constructor
+* @param batteryManager   Pointer to battery manager with
+*                         the drain model
+********************************************************/
+StateEstimator::StateEstimator(const BatteryManager* batteryManager)
+    : batteryManager(batteryManager), stateTime(0.0), hasTime(false), hasSpeed(false), hasSoc(false),
+      acTemp(0), windLevel(0), samples(0), outliers(0) {
+    for (int i = 0; i < ESTIMATE_COUNT; i++) {
+        rejectCount[i] = 0;
+    }
+    covariance(ESTIMATE_ACCEL, ESTIMATE_ACCEL) = ESTIMATOR_INITIAL_ACCEL;
+}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+StateEstimator::~StateEstimator() {}
+
+/********************************************************
+* @brief    setClimate
+* @details  This method sets climate used by the drain model
+*           when state of charge is predicted.
+* @param    acTemp      AC temperature (°C)
+* @param    windLevel   Wind level
+* @return   None
+********************************************************/
+void StateEstimator::setClimate(int acTemp, int windLevel) {
+    this->acTemp = acTemp;
+    this->windLevel = windLevel;
+}
+
+/********************************************************
+* @brief    predict
+* @details  This method moves the estimate by the time since
+*           the last sample. Speed follows acceleration and
+*           state of charge falls by the drain at estimated
+*           speed. Uncertainty grows with the time step, so
+*           samples after a long wait move the estimate more.
+*           Samples at the same time or older than the
+*           estimate are used without prediction, a gap longer
+*           than ESTIMATOR_MAX_GAP_S starts again from the
+*           next samples.
+* @param    time    Time of sample (s)
+* @return   None
+********************************************************/
+void StateEstimator::predict(double time) {
+    if (!hasTime) {
+        stateTime = time;
+        hasTime = true;
+        return;
+    }
+
+    double dt = time - stateTime;
+    if (dt <= 0.0) {
+        return;
+    }
+    stateTime = time;
+
+    if (dt > ESTIMATOR_MAX_GAP_S) {
+        hasSpeed = false;
+        hasSoc = false;
+        covariance = Matrix<ESTIMATE_COUNT, ESTIMATE_COUNT>();
+        covariance(ESTIMATE_ACCEL, ESTIMATE_ACCEL) = ESTIMATOR_INITIAL_ACCEL;
+        state(ESTIMATE_ACCEL, 0) = 0.0;
+        return;
+    }
+
+    // Drain and its change with speed, drain model takes whole km/h
+    double drain = 0.0;
+    double drainSlope = 0.0;
+    if (batteryManager && hasSoc) {
+        double speed = state(ESTIMATE_SPEED, 0) > 0.0 ? state(ESTIMATE_SPEED, 0) : 0.0;
+        int wholeSpeed = (int)speed;
+        double low = numericToDouble(batteryManager->calculateBatteryDrain(wholeSpeed, acTemp, windLevel));
+        double high = numericToDouble(batteryManager->calculateBatteryDrain(wholeSpeed + 1, acTemp, windLevel));
+        drainSlope = high - low;
+        drain = low + drainSlope * (speed - wholeSpeed);
+    }
+
+    Matrix<ESTIMATE_COUNT, ESTIMATE_COUNT> transition = Matrix<ESTIMATE_COUNT, ESTIMATE_COUNT>::identity();
+    transition(ESTIMATE_SPEED, ESTIMATE_ACCEL) = dt;
+    transition(ESTIMATE_SOC, ESTIMATE_SPEED) = -drainSlope * dt;
+
+    // Acceleration changes as white noise, drain model drifts
+    Matrix<ESTIMATE_COUNT, ESTIMATE_COUNT> noise;
+    double dt2 = dt * dt;
+    noise(ESTIMATE_SPEED, ESTIMATE_SPEED) = ESTIMATOR_JERK_NOISE * dt2 * dt / 3.0;
+    noise(ESTIMATE_SPEED, ESTIMATE_ACCEL) = ESTIMATOR_JERK_NOISE * dt2 / 2.0;
+    noise(ESTIMATE_ACCEL, ESTIMATE_SPEED) = ESTIMATOR_JERK_NOISE * dt2 / 2.0;
+    noise(ESTIMATE_ACCEL, ESTIMATE_ACCEL) = ESTIMATOR_JERK_NOISE * dt;
+    noise(ESTIMATE_SOC, ESTIMATE_SOC) = ESTIMATOR_SOC_DRIFT * dt;
+
+    state(ESTIMATE_SPEED, 0) += state(ESTIMATE_ACCEL, 0) * dt;
+    state(ESTIMATE_SOC, 0) -= drain * dt;
+    if (state(ESTIMATE_SPEED, 0) < 0.0) {
+        state(ESTIMATE_SPEED, 0) = 0.0;
+    }
+
+    covariance = transition * covariance * transition.transpose() + noise;
+    covariance.symmetrize();
+}
+
+/********************************************************
+* @brief    correct
+* @details  This method corrects the estimate with one sample
+*           of one value. The first sample of a value sets it
+*           directly. A sample more than ESTIMATOR_GATE_SIGMA
+*           deviations away is rejected, unless it happens
+*           ESTIMATOR_MAX_REJECTS times in a row, then the
+*           value really changed and is set again.
+* @param    index       Value that is sampled
+* @param    value       Sampled value
+* @param    variance    Variance of sample
+* @return   None
+********************************************************/
+void StateEstimator::correct(EstimateIndex index, double value, double variance) {
+    bool& hasValue = index == ESTIMATE_SPEED ? hasSpeed : hasSoc;
+    double innovation = value - state(index, 0);
+    double innovationVariance = covariance(index, index) + variance;
+
+    if (hasValue && innovation * innovation > ESTIMATOR_GATE_SIGMA * ESTIMATOR_GATE_SIGMA * innovationVariance) {
+        if (++rejectCount[index] < ESTIMATOR_MAX_REJECTS) {
+            outliers++;
+            return;
+        }
+        hasValue = false;
+    }
+    rejectCount[index] = 0;
+    samples++;
+
+    // Set value, it is not related to other values yet
+    if (!hasValue) {
+        state(index, 0) = value;
+        for (int i = 0; i < ESTIMATE_COUNT; i++) {
+            covariance(index, i) = 0.0;
+            covariance(i, index) = 0.0;
+        }
+        covariance(index, index) = variance;
+        hasValue = true;
+        return;
+    }
+
+    // Scalar update, gain is a column of covariance over
+    // variance of innovation
+    Matrix<ESTIMATE_COUNT, 1> gain;
+    Matrix<1, ESTIMATE_COUNT> row;
+    for (int i = 0; i < ESTIMATE_COUNT; i++) {
+        gain(i, 0) = covariance(i, index) / innovationVariance;
+        row(0, i) = covariance(index, i);
+    }
+
+    state = state + gain * innovation;
+    covariance = covariance - gain * row;
+    covariance.symmetrize();
+}
+
+/********************************************************
+* @brief    updateSpeed
+* @details  This method moves the estimate to time of a speed
+*           sample and corrects it.
+* @param    time    Time of sample (s)
+* @param    speed   Sampled speed (km/h)
+* @return   None
+********************************************************/
+void StateEstimator::updateSpeed(double time, double speed) {
+    predict(time);
+    correct(ESTIMATE_SPEED, speed, ESTIMATOR_SPEED_NOISE);
+}
+
+/********************************************************
+* @brief    updateSoc
+* @details  This method moves the estimate to time of a
+*           battery level sample and corrects it.
+* @param    time    Time of sample (s)
+* @param    soc     Sampled battery level (%)
+* @return   None
+********************************************************/
+void StateEstimator::updateSoc(double time, double soc) {
+    predict(time);
+    correct(ESTIMATE_SOC, soc, ESTIMATOR_SOC_NOISE);
+}
+
+/********************************************************
+* @brief    isReady
+* @details  This method checks if both speed and battery
+*           level were sampled.
+* @param    None
+* @return   bool    Return true if estimate is usable
+********************************************************/
+bool StateEstimator::isReady() const {
+    return hasSpeed && hasSoc;
+}
+
+/********************************************************
+* @brief    getSpeed
+* @details  This method gets estimated speed.
+* @param    None
+* @return   double  Return speed (km/h)
+********************************************************/
+double StateEstimator::getSpeed() const {
+    return state(ESTIMATE_SPEED, 0);
+}
+
+/********************************************************
+* @brief    getSoc
+* @details  This method gets estimated state of charge,
+*           limited to 0 - 100 %.
+* @param    None
+* @return   double  Return state of charge (%)
+********************************************************/
+double StateEstimator::getSoc() const {
+    double soc = state(ESTIMATE_SOC, 0);
+    return soc < 0.0 ? 0.0 : (soc > 100.0 ? 100.0 : soc);
+}
+
+/********************************************************
+* @brief    getSpeedUncertainty
+* @details  This method gets standard deviation of estimated
+*           speed.
+* @param    None
+* @return   double  Return uncertainty (km/h)
+********************************************************/
+double StateEstimator::getSpeedUncertainty() const {
+    return sqrt(covariance(ESTIMATE_SPEED, ESTIMATE_SPEED));
+}
+
+/********************************************************
+* @brief    getSocUncertainty
+* @details  This method gets standard deviation of estimated
+*           state of charge.
+* @param    None
+* @return   double  Return uncertainty (%)
+********************************************************/
+double StateEstimator::getSocUncertainty() const {
+    return sqrt(covariance(ESTIMATE_SOC, ESTIMATE_SOC));
+}
+
+/********************************************************
+* @brief    getSamples
+* @details  This method gets number of used samples.
+* @param    None
+* @return   unsigned long   Return number
+********************************************************/
+unsigned long StateEstimator::getSamples() const {
+    return samples;
+}
+
+/********************************************************
+* @brief    getOutliers
+* @details  This method gets number of samples rejected as
+*           outliers.
+* @param    None
+* @return   unsigned long   Return number
+********************************************************/
+unsigned long StateEstimator::getOutliers() const {
+    return outliers;
+}
@@ -0,0 +1,369 @@
+/********************************************************
+* @file     TaskExecutor.cpp
+* @brief    Define methods related to cooperative tasks
+* @details  This file contains methods definition related
+*           to the single-threaded executor, includes spawn
+*           tasks, timers, file descriptor readiness and the
+*           run loop.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include "TaskExecutor.hpp"
+
+#ifdef __linux__
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Constructor
+********************************************************/
+TaskExecutor::TaskExecutor() : timerSequence(0), isStopRequested(false) {
+    // Reserve memory once, running tasks do not allocate
+    tasks.reserve(EXECUTOR_RESERVED_TASKS);
+    ready.reserve(EXECUTOR_RESERVED_TASKS);
+    running.reserve(EXECUTOR_RESERVED_TASKS);
+    timers.reserve(EXECUTOR_RESERVED_TASKS);
+
+#ifdef __linux__
+    ioWaiters = 0;
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    if (epollFd < 0 || timerFd < 0) {
+        cerr << "Cannot create epoll: " << strerror(errno) << endl;
+    } else {
+        // Timer is identified by a NULL pointer
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = NULL;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event);
+    }
+#endif
+}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+TaskExecutor::~TaskExecutor() {
+    for (size_t i = 0; i < tasks.size(); i++) {
+        tasks[i].destroy();
+    }
+
+#ifdef __linux__
+    if (timerFd >= 0) {
+        close(timerFd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+#endif
+}
+
+/********************************************************
+* @brief    isLater
+* @details  This method orders timers by deadline, then by
+*           the order they were set.
+* @param    a   First timer
+* @param    b   Second timer
+* @return   bool    Return true if a expires after b
+********************************************************/
+bool TaskExecutor::isLater(const Timer& a, const Timer& b) {
+    if (a.due != b.due) {
+        return a.due > b.due;
+    }
+    return a.sequence > b.sequence;
+}
+
+/********************************************************
+* @brief    removeTimer
+* @details  This method removes the timer of a task from the
+*           min-heap, used when the task is resumed by its
+*           file descriptor first.
+* @param    handle  Task of the timer
+* @return   bool    Return false if task has no timer
+********************************************************/
+bool TaskExecutor::removeTimer(coroutine_handle<> handle) {
+    for (size_t i = 0; i < timers.size(); i++) {
+        if (timers[i].handle == handle) {
+            timers[i] = timers[timers.size() - 1];
+            timers.pop_back();
+            make_heap(timers.begin(), timers.end(), isLater);
+            return true;
+        }
+    }
+    return false;
+}
+
+/********************************************************
+* @brief    spawn
+* @details  This method takes ownership of a task, it is
+*           started on next pass of run().
+* @param    task    Task to run
+* @return   None
+********************************************************/
+void TaskExecutor::spawn(Task task) {
+    coroutine_handle<> handle = task.release();
+    if (!handle) {
+        return;
+    }
+
+    tasks.push_back(handle);
+    ready.push_back(handle);
+}
+
+/********************************************************
+* @brief    resume
+* @details  This method resumes a task until its next
+*           co_await, destroys the task if it finished.
+* @param    handle  Task to resume
+* @return   None
+********************************************************/
+void TaskExecutor::resume(coroutine_handle<> handle) {
+    handle.resume();
+
+    if (handle.done()) {
+        tasks.erase(find(tasks.begin(), tasks.end(), handle));
+        handle.destroy();
+    }
+}
+
+/********************************************************
+* @brief    addTimer
+* @details  This method adds a deadline to the min-heap.
+* @param    due     Deadline
+* @param    handle  Task to resume
+* @return   None
+********************************************************/
+void TaskExecutor::addTimer(TaskClock::time_point due, coroutine_handle<> handle) {
+    Timer timer;
+    timer.due = due;
+    timer.sequence = timerSequence++;
+    timer.handle = handle;
+
+    timers.push_back(timer);
+    push_heap(timers.begin(), timers.end(), isLater);
+}
+
+/********************************************************
+* @brief    expireTimers
+* @details  This method moves tasks of expired deadlines to
+*           ready list, in deadline order.
+* @param    now     Current time
+* @return   None
+********************************************************/
+void TaskExecutor::expireTimers(TaskClock::time_point now) {
+    while (!timers.empty() && timers.front().due <= now) {
+        ready.push_back(timers.front().handle);
+        pop_heap(timers.begin(), timers.end(), isLater);
+        timers.pop_back();
+    }
+}
+
+/********************************************************
+* @brief    waitForEvents
+* @details  This method blocks the thread until earliest
+*           deadline. On Linux, timerfd is armed to the
+*           deadline and epoll also wakes up tasks waiting
+*           for file descriptors. A task woken by its file
+*           descriptor loses its time limit, so it is resumed
+*           only once.
+* @param    None
+* @return   None
+********************************************************/
+void TaskExecutor::waitForEvents() {
+#ifdef __linux__
+    if (ioWaiters > 0 && epollFd >= 0) {
+        // Arm timerfd to earliest deadline, zero disarms it
+        itimerspec spec = {};
+        if (!timers.empty()) {
+            chrono::nanoseconds due = chrono::duration_cast<chrono::nanoseconds>(
+                timers.front().due.time_since_epoch());
+            spec.it_value.tv_sec = (time_t)(due.count() / 1000000000);
+            spec.it_value.tv_nsec = (long)(due.count() % 1000000000);
+            if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+                spec.it_value.tv_nsec = 1;
+            }
+        }
+        timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, NULL);
+
+        epoll_event events[EXECUTOR_RESERVED_TASKS];
+        int count = epoll_wait(epollFd, events, EXECUTOR_RESERVED_TASKS, -1);
+
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.ptr == NULL) {
+                uint64_t expirations;
+                ssize_t unused = read(timerFd, &expirations, sizeof(expirations));
+                (void)unused;
+            } else {
+                ReadableAwaiter* awaiter = static_cast<ReadableAwaiter*>(events[i].data.ptr);
+                awaiter->isReadable = true;
+                removeTimer(awaiter->handle);
+                ready.push_back(awaiter->handle);
+            }
+        }
+        return;
+    }
+#endif
+
+    if (!timers.empty()) {
+        this_thread::sleep_until(timers.front().due);
+    }
+}
+
+/********************************************************
+* @brief    run
+* @details  This method resumes ready tasks, then waits for
+*           the next deadline or file descriptor, until all
+*           tasks finished or stop() is called.
+* @param    None
+* @return   None
+********************************************************/
+void TaskExecutor::run() {
+    isStopRequested = false;
+
+    while (!isStopRequested && !tasks.empty()) {
+        // Tasks made ready during this pass run on next pass
+        running.swap(ready);
+        for (size_t i = 0; i < running.size() && !isStopRequested; i++) {
+            resume(running[i]);
+        }
+        running.clear();
+
+        if (isStopRequested || tasks.empty()) {
+            break;
+        }
+
+        if (ready.empty()) {
+            // Nothing can make progress, all tasks wait forever
+            if (timers.empty()
+#ifdef __linux__
+                && ioWaiters == 0
+#endif
+            ) {
+                cerr << "All tasks are blocked" << endl;
+                break;
+            }
+            waitForEvents();
+        }
+
+        expireTimers(TaskClock::now());
+    }
+}
+
+/********************************************************
+* @brief    stop
+* @details  This method requests run() to return after the
+*           running task suspends.
+* @param    None
+* @return   None
+********************************************************/
+void TaskExecutor::stop() {
+    isStopRequested = true;
+}
+
+/********************************************************
+* @brief    sleepUntil
+* @details  This method makes awaitable that resumes the
+*           calling task at a deadline.
+* @param    due     Deadline
+* @return   TimerAwaiter    Return awaitable
+********************************************************/
+TaskExecutor::TimerAwaiter TaskExecutor::sleepUntil(TaskClock::time_point due) {
+    TimerAwaiter awaiter = { this, due };
+    return awaiter;
+}
+
+/********************************************************
+* @brief    sleepFor
+* @details  This method makes awaitable that resumes the
+*           calling task after a delay.
+* @param    milliseconds    Delay (ms)
+* @return   TimerAwaiter    Return awaitable
+********************************************************/
+TaskExecutor::TimerAwaiter TaskExecutor::sleepFor(int milliseconds) {
+    return sleepUntil(TaskClock::now() + chrono::milliseconds(milliseconds));
+}
+
+/********************************************************
+* @brief    yield
+* @details  This method makes awaitable that resumes the
+*           calling task after other ready tasks.
+* @param    None
+* @return   TimerAwaiter    Return awaitable
+********************************************************/
+TaskExecutor::TimerAwaiter TaskExecutor::yield() {
+    return sleepUntil(TaskClock::now());
+}
+
+#ifdef __linux__
+/********************************************************
+* @brief    waitReadable
+* @details  This method makes awaitable that resumes the
+*           calling task when file descriptor can be read or
+*           after a time limit.
+* @param    fd              File descriptor
+* @param    milliseconds    Time limit (ms), negative waits
+*                           forever
+* @return   ReadableAwaiter Return awaitable
+********************************************************/
+TaskExecutor::ReadableAwaiter TaskExecutor::waitReadable(int fd, int milliseconds) {
+    ReadableAwaiter awaiter = { this, fd, milliseconds, false, false, nullptr };
+    return awaiter;
+}
+
+/********************************************************
+* @brief    addReader
+* @details  This method adds file descriptor to epoll for
+*           one event and sets a timer for the time limit,
+*           the task is resumed from run() by whichever comes
+*           first.
+* @param    awaiter     Wait of the task
+* @param    handle      Task to resume
+* @return   bool        Return true if task must be suspended
+********************************************************/
+bool TaskExecutor::addReader(ReadableAwaiter* awaiter, coroutine_handle<> handle) {
+    epoll_event event;
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.ptr = awaiter;
+
+    if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, awaiter->fd, &event) != 0) {
+        // Task continues at once and sees the error, such
+        // as a regular file that epoll does not support
+        return false;
+    }
+
+    awaiter->handle = handle;
+    if (awaiter->milliseconds >= 0) {
+        addTimer(TaskClock::now() + chrono::milliseconds(awaiter->milliseconds), handle);
+    }
+    ioWaiters++;
+    return true;
+}
+
+/********************************************************
+* @brief    removeReader
+* @details  This method removes file descriptor from epoll
+*           after the task was resumed.
+* @param    awaiter     Wait of the task
+* @return   WaitResult  Return why the task was resumed
+********************************************************/
+WaitResult TaskExecutor::removeReader(ReadableAwaiter* awaiter) {
+    if (!awaiter->isWaiting) {
+        return WAIT_ERROR;
+    }
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, awaiter->fd, NULL);
+    ioWaiters--;
+    return awaiter->isReadable ? WAIT_READABLE : WAIT_TIMEOUT;
+}
+#endif
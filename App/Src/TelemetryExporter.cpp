@@ -0,0 +1,167 @@
+/********************************************************
+* @file     TelemetryExporter.cpp
+* @brief    Define methods related to export of tick
+*           history
+* @details  This file contains methods definition related
+*           to the exporter thread, includes stamping and
+*           queueing rows and writing them into Arrow record
+*           batches.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "TelemetryExporter.hpp"
+#include "PerfStats.hpp"
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+/********************************************************
+* @brief Constructor
+* @param path         File to write, ARROW_STREAM_EXTENSION
+*                     selects stream format
+* @param batchRows    Rows of one record batch
+********************************************************/
+TelemetryExporter::TelemetryExporter(const string& path, size_t batchRows)
+    : path(path), arrowWriter(batchRows), wakeup(0), isStopRequested(false),
+      submitted(0), dropped(0), errors(0), ticks(0) {}
+
+/********************************************************
+* @brief Destructor, stops the exporter thread
+********************************************************/
+TelemetryExporter::~TelemetryExporter() {
+    stop();
+}
+
+/********************************************************
+* @brief    start
+* @details  This method creates the file in the format of
+*           its extension, writes the schema and starts
+*           exporter thread.
+* @param    None
+* @return   bool        Return false if file cannot be written
+********************************************************/
+bool TelemetryExporter::start() {
+    if (worker.joinable()) {
+        return true;
+    }
+    if (!arrowWriter.open(path, ArrowWriter::getFormat(path))) {
+        return false;
+    }
+
+    isStopRequested.store(false);
+    worker = thread(&TelemetryExporter::run, this);
+    return true;
+}
+
+/********************************************************
+* @brief    submit
+* @details  This method stamps a state with tick number,
+*           wall clock and monotonic time, pushes it to the
+*           queue and wakes up exporter thread. If the queue
+*           is full because disk is slow, the row is dropped.
+* @param    state       State of this tick
+* @return   bool        Return false if row is dropped
+********************************************************/
+bool TelemetryExporter::submit(const DashboardState& state) {
+    if (!worker.joinable()) {
+        return false;
+    }
+
+    TelemetryRow row;
+    row.tick = ++ticks;
+    row.timestampUs = chrono::duration_cast<chrono::microseconds>(
+        chrono::system_clock::now().time_since_epoch()).count();
+    row.monotonicNs = PerfStats::nowNs();
+    row.state = state;
+
+    if (!queue.tryPush(row)) {
+        dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    submitted.fetch_add(1, memory_order_relaxed);
+    wakeup.release();
+    return true;
+}
+
+/********************************************************
+* @brief    update
+* @details  This method queues each published state, used
+*           when data comes from a CAN log instead of the
+*           keyboard ticks.
+* @param    snapshot    State published by DashboardController
+* @return   None
+********************************************************/
+void TelemetryExporter::update(const StateSnapshot& snapshot) {
+    submit(snapshot.newState);
+}
+
+/********************************************************
+* @brief    stop
+* @details  This method asks exporter thread to write what
+*           is queued and exit, then writes the last batch
+*           and closes the file.
+* @param    None
+* @return   None
+********************************************************/
+void TelemetryExporter::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+
+    isStopRequested.store(true, memory_order_release);
+    wakeup.release();
+    worker.join();
+
+    if (!arrowWriter.close()) {
+        errors.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+/********************************************************
+* @brief    run
+* @details  This method is body of exporter thread. It takes
+*           all queued rows at each wake up, ArrowWriter
+*           writes a batch each time it is full.
+* @param    None
+* @return   None
+********************************************************/
+void TelemetryExporter::run() {
+    while (true) {
+        wakeup.acquire();
+
+        // Read stop request before draining, rows queued
+        // before stop() are written in this pass
+        bool isStopping = isStopRequested.load(memory_order_acquire);
+
+        TelemetryRow row;
+        while (queue.tryPop(row)) {
+            if (!arrowWriter.append(row)) {
+                errors.fetch_add(1, memory_order_relaxed);
+            }
+        }
+
+        if (isStopping) {
+            break;
+        }
+    }
+}
+
+/********************************************************
+* @brief    getStats
+* @details  This method reads counters of the exporter.
+* @param    None
+* @return   TelemetryExportStats    Return counters
+********************************************************/
+TelemetryExportStats TelemetryExporter::getStats() const {
+    TelemetryExportStats stats;
+    stats.submitted = submitted.load(memory_order_relaxed);
+    stats.dropped = dropped.load(memory_order_relaxed);
+    stats.rows = (unsigned long)arrowWriter.getRows();
+    stats.batches = (unsigned long)arrowWriter.getBatches();
+    stats.bytes = (unsigned long)arrowWriter.getBytes();
+    stats.errors = errors.load(memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,206 @@
+/********************************************************
+* @file     TelemetryParser.cpp
+* @brief    Define functions related to parsing telemetry
+*           records
+* @details  This file contains functions definition related
+*           to parsing "KEY, value" lines, includes match
+*           keys and convert numbers without allocation, and
+*           formatting a record.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "TelemetryParser.hpp"
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+/********************************************************
+* @brief Keys of telemetry record, same order as
+*        TelemetryField
+********************************************************/
+static const char* const fieldKeys[] = {
+    "DRIVE MODE",
+    "SPEED",
+    "BATTERY LEVEL",
+    "AC TEMPERATURE",
+    "WIND LEVEL",
+    "REMAINING RANGE",
+    "TIMESTAMP"
+};
+
+/********************************************************
+* @brief    isSpace
+* @details  This function checks white space characters
+*           around keys and values.
+* @param    c       Character to check
+* @return   bool    Return true if c is white space
+********************************************************/
+static inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/********************************************************
+* @brief    parseNumber
+* @details  This function converts decimal number with
+*           optional sign and fraction.
+* @param    begin   Start of number
+* @param    end     End of number
+* @param    value   Converted number
+* @return   bool    Return true if whole text is a number
+********************************************************/
+bool parseNumber(const char* begin, const char* end, double& value) {
+    const char* p = begin;
+    bool isNegative = false;
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        isNegative = (*p == '-');
+        p++;
+    }
+
+    double result = 0.0;
+    bool hasDigits = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10.0 + (*p - '0');
+        hasDigits = true;
+        p++;
+    }
+
+    if (p < end && *p == '.') {
+        p++;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result += (*p - '0') * scale;
+            scale *= 0.1;
+            hasDigits = true;
+            p++;
+        }
+    }
+
+    if (!hasDigits || p != end) {
+        return false;
+    }
+
+    value = isNegative ? -result : result;
+    return true;
+}
+
+/********************************************************
+* @brief    splitKeyValueLine
+* @details  This function splits one "KEY, value" line and
+*           finds the key in a list of known keys, white
+*           space around key and value is ignored.
+* @param    line        Start of line
+* @param    end         End of line (without new line)
+* @param    keys        Known keys
+* @param    keyCount    Number of known keys
+* @param    key         Index of the key in keys
+* @param    valueBegin  Start of value
+* @param    valueEnd    End of value
+* @return   bool        Return true if key is known
+********************************************************/
+bool splitKeyValueLine(const char* line, const char* end, const char* const keys[], size_t keyCount,
+    size_t& key, const char*& valueBegin, const char*& valueEnd) {
+    const char* comma = static_cast<const char*>(memchr(line, ',', end - line));
+    if (comma == NULL) {
+        return false;
+    }
+
+    // Trim key
+    const char* keyBegin = line;
+    const char* keyEnd = comma;
+    while (keyBegin < keyEnd && isSpace(*keyBegin)) {
+        keyBegin++;
+    }
+    while (keyEnd > keyBegin && isSpace(keyEnd[-1])) {
+        keyEnd--;
+    }
+
+    // Trim value, ignore next columns if any
+    valueBegin = comma + 1;
+    valueEnd = static_cast<const char*>(memchr(valueBegin, ',', end - valueBegin));
+    if (valueEnd == NULL) {
+        valueEnd = end;
+    }
+    while (valueBegin < valueEnd && isSpace(*valueBegin)) {
+        valueBegin++;
+    }
+    while (valueEnd > valueBegin && isSpace(valueEnd[-1])) {
+        valueEnd--;
+    }
+
+    // Find key
+    size_t keyLength = keyEnd - keyBegin;
+    for (size_t i = 0; i < keyCount; i++) {
+        if (strlen(keys[i]) == keyLength && memcmp(keys[i], keyBegin, keyLength) == 0) {
+            key = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/********************************************************
+* @brief    parseTelemetryLine
+* @details  This function parses one "KEY, value" line of
+*           telemetry record.
+* @param    line    Start of line
+* @param    end     End of line (without new line)
+* @param    result  Parsed key and value
+* @return   bool    Return true if key is known and value
+*                   is valid
+********************************************************/
+bool parseTelemetryLine(const char* line, const char* end, TelemetryValue& result) {
+    size_t field;
+    const char* valueBegin;
+    const char* valueEnd;
+
+    if (!splitKeyValueLine(line, end, fieldKeys, sizeof(fieldKeys) / sizeof(fieldKeys[0]),
+        field, valueBegin, valueEnd)) {
+        return false;
+    }
+    result.field = (TelemetryField)field;
+
+    // Drive mode
+    if (result.field == FIELD_DRIVE_MODE) {
+        size_t valueLength = valueEnd - valueBegin;
+        if (valueLength == 3 && memcmp(valueBegin, "ECO", 3) == 0) {
+            result.driveMode = ECO;
+            return true;
+        }
+        if (valueLength == 5 && memcmp(valueBegin, "SPORT", 5) == 0) {
+            result.driveMode = SPORT;
+            return true;
+        }
+        return false;
+    }
+
+    return parseNumber(valueBegin, valueEnd, result.value);
+}
+
+/********************************************************
+* @brief    formatTelemetryRecord
+* @details  This function writes system parameters as
+*           "KEY, value" lines in the order of Database.csv.
+* @param    state       System parameters
+* @param    buffer      Buffer to fill
+* @param    capacity    Size of buffer (bytes)
+* @return   size_t      Return length of record, 0 if
+*                       buffer is too small
+********************************************************/
+size_t formatTelemetryRecord(const DashboardState& state, char* buffer, size_t capacity) {
+    int length = snprintf(buffer, capacity,
+        "%s, %s\n%s, %d\n%s, %d\n%s, %d\n%s, %d\n%s, %g\n",
+        fieldKeys[FIELD_DRIVE_MODE], (state.driveMode == ECO ? "ECO" : "SPORT"),
+        fieldKeys[FIELD_SPEED], state.speed,
+        fieldKeys[FIELD_BATTERY_LEVEL], state.batteryLevel,
+        fieldKeys[FIELD_AC_TEMPERATURE], state.acTemp,
+        fieldKeys[FIELD_WIND_LEVEL], state.windLevel,
+        fieldKeys[FIELD_REMAINING_RANGE], state.remainingRange);
+
+    if (length < 0 || (size_t)length >= capacity) {
+        return 0;
+    }
+    return (size_t)length;
+}
@@ -0,0 +1,332 @@
+/********************************************************
+* @file     TripAnalyzer.cpp
+* @brief    Define methods related to offline trip analysis
+* @details  This file contains methods definition related
+*           to trip analysis, includes split log at record
+*           boundaries, analyse each part on its own thread
+*           and merge statistics of all parts.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "TripAnalyzer.hpp"
+#include "TelemetryParser.hpp"
+#include "ParallelFor.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+/********************************************************
+* Key that starts every record
+********************************************************/
+static const char recordKey[] = "DRIVE MODE";
+
+/********************************************************
+* @brief Constructor
+********************************************************/
+TripAnalyzer::TripAnalyzer() {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+TripAnalyzer::~TripAnalyzer() {}
+
+/********************************************************
+* @brief    open
+* @details  This method maps telemetry log.
+* @param    path    Path to telemetry log
+* @return   bool    Return true if log is mapped
+********************************************************/
+bool TripAnalyzer::open(const string& path) {
+    if (!logFile.open(path)) {
+        cerr << "Cannot open file " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+/********************************************************
+* @brief    resetStatistics
+* @details  This method resets statistics to empty.
+* @param    stats   Statistics to reset
+* @return   None
+********************************************************/
+void TripAnalyzer::resetStatistics(TripStatistics& stats) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+/********************************************************
+* @brief    addRecord
+* @details  This method adds one record to statistics. The
+*           record lasts from the previous record to its own
+*           timestamp, or one tick when timestamps are not
+*           logged.
+* @param    stats           Statistics that receive record
+* @param    record          Record to add
+* @param    previous        Record before it, NULL if none
+* @param    batteryManager  Drain model
+* @return   None
+********************************************************/
+void TripAnalyzer::addRecord(TripStatistics& stats, const TripRecord& record,
+    const TripRecord* previous, const BatteryManager& batteryManager) {
+
+    double dt = DEFAULT_TICK_PERIOD_MS / 1000.0;
+    if (previous && previous->hasTimestamp && record.hasTimestamp
+        && record.timestampMs >= previous->timestampMs) {
+        dt = (record.timestampMs - previous->timestampMs) / 1000.0;
+    }
+
+    stats.durationSec += dt;
+    stats.distanceKm += record.speed * dt / 3600.0;
+    stats.energyUsed += numericToDouble(
+        batteryManager.calculateBatteryDrain(record.speed, record.acTemp, record.windLevel)) * dt;
+    stats.timeInModeSec[record.driveMode == ECO ? ECO : SPORT] += dt;
+
+    int bin = record.speed / SPEED_HISTOGRAM_BIN_WIDTH;
+    if (bin < 0) {
+        bin = 0;
+    }
+    if (bin >= SPEED_HISTOGRAM_BINS) {
+        bin = SPEED_HISTOGRAM_BINS - 1;
+    }
+    stats.speedHistogramSec[bin] += dt;
+
+    // Count each time battery drops to low level
+    bool isLow = record.batteryLevel <= LOW_BATTERY_LEVEL;
+    bool wasLow = previous && previous->batteryLevel <= LOW_BATTERY_LEVEL;
+    if (isLow && !wasLow) {
+        stats.lowBatteryEvents++;
+    }
+}
+
+/********************************************************
+* @brief    findRecordStart
+* @details  This method finds the first line that starts
+*           with DRIVE MODE at or after offset.
+* @param    data    Start of log
+* @param    size    Size of log
+* @param    offset  Offset to start search
+* @return   size_t  Return offset of record start, size if
+*                   there is no more record
+********************************************************/
+size_t TripAnalyzer::findRecordStart(const char* data, size_t size, size_t offset) {
+    size_t keyLength = sizeof(recordKey) - 1;
+
+    // Offset 0 or right after a new line is a line start
+    size_t position = offset;
+    if (position > 0 && data[position - 1] != '\n') {
+        const char* newLine = static_cast<const char*>(memchr(data + position, '\n', size - position));
+        if (newLine == NULL) {
+            return size;
+        }
+        position = newLine - data + 1;
+    }
+
+    while (position < size) {
+        if (size - position >= keyLength && memcmp(data + position, recordKey, keyLength) == 0) {
+            return position;
+        }
+
+        const char* newLine = static_cast<const char*>(memchr(data + position, '\n', size - position));
+        if (newLine == NULL) {
+            return size;
+        }
+        position = newLine - data + 1;
+    }
+    return size;
+}
+
+/********************************************************
+* @brief    analyzeRange
+* @details  This method analyses a part of a log, values
+*           missing in a record keep the value of the
+*           previous record.
+* @param    begin   Start of part
+* @param    end     End of part
+* @param    stats   Statistics of part
+* @return   None
+********************************************************/
+void TripAnalyzer::analyzeRange(const char* begin, const char* end, TripStatistics& stats) {
+    BatteryManager batteryManager;
+    TripRecord record;
+    TelemetryValue parsed;
+    bool isInRecord = false;
+
+    resetStatistics(stats);
+    memset(&record, 0, sizeof(record));
+    record.driveMode = ECO;
+
+    const char* line = begin;
+    while (line < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+        if (lineEnd == NULL) {
+            lineEnd = end;
+        }
+
+        if (parseTelemetryLine(line, lineEnd, parsed)) {
+            // DRIVE MODE starts the next record
+            if (parsed.field == FIELD_DRIVE_MODE && isInRecord) {
+                if (!stats.hasRecords) {
+                    stats.first = record;
+                    stats.hasRecords = true;
+                } else {
+                    addRecord(stats, record, &stats.last, batteryManager);
+                }
+                stats.last = record;
+                stats.records++;
+                record.hasTimestamp = false;
+            }
+            isInRecord = true;
+
+            switch (parsed.field) {
+            case FIELD_DRIVE_MODE:
+                record.driveMode = parsed.driveMode;
+                break;
+            case FIELD_SPEED:
+                record.speed = (int)parsed.value;
+                break;
+            case FIELD_BATTERY_LEVEL:
+                record.batteryLevel = (int)parsed.value;
+                break;
+            case FIELD_AC_TEMPERATURE:
+                record.acTemp = (int)parsed.value;
+                break;
+            case FIELD_WIND_LEVEL:
+                record.windLevel = (int)parsed.value;
+                break;
+            case FIELD_TIMESTAMP:
+                record.timestampMs = parsed.value;
+                record.hasTimestamp = true;
+                break;
+            default:
+                break;
+            }
+        }
+
+        line = lineEnd + 1;
+    }
+
+    // Last record of part
+    if (isInRecord) {
+        if (!stats.hasRecords) {
+            stats.first = record;
+            stats.hasRecords = true;
+        } else {
+            addRecord(stats, record, &stats.last, batteryManager);
+        }
+        stats.last = record;
+        stats.records++;
+    }
+}
+
+/********************************************************
+* @brief    mergeStatistics
+* @details  This method merges statistics of the next part
+*           of a log, counts the first record of the part
+*           against the last record of previous parts.
+* @param    total   Statistics of previous parts
+* @param    part    Statistics of next part
+* @return   None
+********************************************************/
+void TripAnalyzer::mergeStatistics(TripStatistics& total, const TripStatistics& part) {
+    if (!part.hasRecords) {
+        return;
+    }
+
+    BatteryManager batteryManager;
+    addRecord(total, part.first, total.hasRecords ? &total.last : NULL, batteryManager);
+
+    if (!total.hasRecords) {
+        total.first = part.first;
+        total.hasRecords = true;
+    }
+
+    total.records += part.records;
+    total.durationSec += part.durationSec;
+    total.distanceKm += part.distanceKm;
+    total.energyUsed += part.energyUsed;
+    total.timeInModeSec[0] += part.timeInModeSec[0];
+    total.timeInModeSec[1] += part.timeInModeSec[1];
+    for (int i = 0; i < SPEED_HISTOGRAM_BINS; i++) {
+        total.speedHistogramSec[i] += part.speedHistogramSec[i];
+    }
+    total.lowBatteryEvents += part.lowBatteryEvents;
+    total.last = part.last;
+}
+
+/********************************************************
+* @brief    analyze
+* @details  This method splits log into one part per thread
+*           at record boundaries, analyses parts in parallel
+*           and merges them in log order.
+* @param    workers         Number of threads (0 use default)
+* @return   TripStatistics  Return statistics of whole log
+********************************************************/
+TripStatistics TripAnalyzer::analyze(unsigned int workers) {
+    TripStatistics total;
+    resetStatistics(total);
+
+    const char* data = logFile.data();
+    size_t size = logFile.size();
+    if (data == NULL || size == 0) {
+        return total;
+    }
+
+    if (workers == 0) {
+        workers = defaultWorkerCount();
+    }
+
+    // Part boundaries, each part starts at a record
+    vector<size_t> bounds(workers + 1);
+    bounds[0] = 0;
+    for (unsigned int i = 1; i < workers; i++) {
+        size_t start = findRecordStart(data, size, size / workers * i);
+        bounds[i] = max(start, bounds[i - 1]);
+    }
+    bounds[workers] = size;
+
+    vector<TripStatistics> parts(workers);
+    parallelFor(workers, workers, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; i++) {
+            analyzeRange(data + bounds[i], data + bounds[i + 1], parts[i]);
+        }
+    });
+
+    for (unsigned int i = 0; i < workers; i++) {
+        mergeStatistics(total, parts[i]);
+    }
+    return total;
+}
+
+/********************************************************
+* @brief    printStatistics
+* @details  This method prints statistics as text report.
+* @param    out     Stream to print
+* @param    stats   Statistics to print
+* @return   None
+********************************************************/
+void TripAnalyzer::printStatistics(ostream& out, const TripStatistics& stats) {
+    out << "Records: " << stats.records << endl;
+    out << "Duration: " << stats.durationSec << " s" << endl;
+    out << "Distance: " << stats.distanceKm << " km" << endl;
+    out << "Energy used: " << stats.energyUsed << " % of battery" << endl;
+    out << "Time in ECO mode: " << stats.timeInModeSec[ECO] << " s" << endl;
+    out << "Time in SPORT mode: " << stats.timeInModeSec[SPORT] << " s" << endl;
+    out << "Low battery events: " << stats.lowBatteryEvents << endl;
+
+    out << "Speed histogram:" << endl;
+    for (int i = 0; i < SPEED_HISTOGRAM_BINS; i++) {
+        if (stats.speedHistogramSec[i] <= 0.0) {
+            continue;
+        }
+        if (i == SPEED_HISTOGRAM_BINS - 1) {
+            out << "  >= " << i * SPEED_HISTOGRAM_BIN_WIDTH << " km/h: ";
+        } else {
+            out << "  " << i * SPEED_HISTOGRAM_BIN_WIDTH << " - "
+                << (i + 1) * SPEED_HISTOGRAM_BIN_WIDTH - 1 << " km/h: ";
+        }
+        out << stats.speedHistogramSec[i] << " s" << endl;
+    }
+}
@@ -0,0 +1,139 @@
+/********************************************************
+* @file     TripComputer.cpp
+* @brief    Define methods related to trip computer
+* @details  This file contains methods definition related
+*           to trip computer, includes add samples to trip
+*           aggregates, reset trip and publish snapshot.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "TripComputer.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Constructor
+* @param batteryManager   Pointer to battery manager to
+*                         calculate drain
+********************************************************/
+TripComputer::TripComputer(const BatteryManager* batteryManager)
+    : batteryManager(batteryManager), maxSpeed(0), hasPreviousUpdate(false),
+    previousTickTimeUs(0), isResetRequested(false) {
+    clearAggregates();
+}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+TripComputer::~TripComputer() {}
+
+/********************************************************
+* @brief    clearAggregates
+* @details  This method resets all aggregates and the
+*           published snapshot.
+* @param    None
+* @return   None
+********************************************************/
+void TripComputer::clearAggregates() {
+    distanceKm.reset();
+    durationSec.reset();
+    energyUsed.reset();
+    timeInModeSec[0].reset();
+    timeInModeSec[1].reset();
+    maxSpeed = 0;
+
+    lock_guard<mutex> lock(snapshotMutex);
+    snapshot = TripSnapshot();
+}
+
+/********************************************************
+* @brief    addSample
+* @details  This method adds one sample to trip aggregates,
+*           takes constant time whatever the trip length.
+* @param    speed   Speed during the sample (km/h)
+* @param    drain   Battery drain per 1 second during the sample
+* @param    mode    Drive mode during the sample
+* @param    dt      Length of the sample (s)
+* @return   None
+********************************************************/
+void TripComputer::addSample(int speed, double drain, DriveMode mode, double dt) {
+    // Requested reset starts the new trip from this sample
+    if (isResetRequested.exchange(false)) {
+        clearAggregates();
+        return;
+    }
+
+    if (dt <= 0.0) {
+        return;
+    }
+
+    distanceKm.add(speed * dt / 3600.0);
+    durationSec.add(dt);
+    energyUsed.add(drain * dt);
+    timeInModeSec[mode == ECO ? ECO : SPORT].add(dt);
+    if (speed > maxSpeed) {
+        maxSpeed = speed;
+    }
+
+    // Publish snapshot
+    TripSnapshot next;
+    next.distanceKm = distanceKm.value();
+    next.durationSec = durationSec.value();
+    next.averageSpeed = next.distanceKm / (next.durationSec / 3600.0);
+    next.maxSpeed = maxSpeed;
+    next.energyUsed = energyUsed.value();
+    next.averageConsumption = (next.distanceKm > 0.0) ? next.energyUsed / next.distanceKm : 0.0;
+    next.timeInModeSec[0] = timeInModeSec[0].value();
+    next.timeInModeSec[1] = timeInModeSec[1].value();
+
+    lock_guard<mutex> lock(snapshotMutex);
+    snapshot = next;
+}
+
+/********************************************************
+* @brief    resetTrip
+* @details  This method requests a new trip, aggregates are
+*           cleared by the thread that adds samples.
+* @param    None
+* @return   None
+********************************************************/
+void TripComputer::resetTrip() {
+    isResetRequested = true;
+}
+
+/********************************************************
+* @brief    getSnapshot
+* @details  This method gets trip values at the last update.
+* @param    None
+* @return   TripSnapshot    Return copy of trip values
+********************************************************/
+TripSnapshot TripComputer::getSnapshot() const {
+    lock_guard<mutex> lock(snapshotMutex);
+    return snapshot;
+}
+
+/********************************************************
+* @brief    update
+* @details  This method will be called when Dashboard
+*           Controller publishes new state while CAN frames
+*           are replayed, the control tick adds samples
+*           otherwise. The previous state was held since the
+*           previous update, so it is counted for the time
+*           between both updates.
+* @param    snapshot    State published by DashboardController
+* @return   None
+********************************************************/
+void TripComputer::update(const StateSnapshot& snapshot) {
+    if (hasPreviousUpdate && snapshot.tickTimeUs > previousTickTimeUs) {
+        const DashboardState& held = snapshot.oldState;
+        double dt = (snapshot.tickTimeUs - previousTickTimeUs) / 1000000.0;
+        double drain = numericToDouble(
+            batteryManager->calculateBatteryDrain(held.speed, held.acTemp, held.windLevel));
+
+        addSample(held.speed, drain, held.driveMode, dt);
+    }
+
+    previousTickTimeUs = snapshot.tickTimeUs;
+    hasPreviousUpdate = true;
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+/********************************************************
+* @file     UringFile.cpp
+* @brief    Define methods related to file writes through
+*           io_uring
+* @details  This file contains methods definition related
+*           to io_uring, includes map the rings, queue write
+*           and sync entries and reap completions.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "UringFile.hpp"
+#include <cstring>
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* @brief Constructor
+********************************************************/
+UringFile::UringFile() : ringFd(-1), sqRing(NULL), sqRingSize(0), cqRing(NULL), cqRingSize(0),
+    sqes(NULL), sqesSize(0), sqTail(NULL), sqMask(NULL), sqArray(NULL),
+    cqHead(NULL), cqTail(NULL), cqMask(NULL), cqes(NULL) {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+UringFile::~UringFile() {
+    close();
+}
+
+/********************************************************
+* @brief    setup
+* @details  This method creates the ring and maps the
+*           submission ring, completion ring and entries.
+* @param    entries     Size of submission ring
+* @return   bool        Return true if io_uring is available
+********************************************************/
+bool UringFile::setup(unsigned int entries) {
+    close();
+
+#ifdef __linux__
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+        return false;
+    }
+    ringFd = fd;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    // Both rings share one mapping on kernels with single mmap
+    bool isSingleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (isSingleMapping) {
+        sqRingSize = (cqRingSize > sqRingSize) ? cqRingSize : sqRingSize;
+        cqRingSize = sqRingSize;
+    }
+
+    void* sq = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ringFd, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) {
+        close();
+        return false;
+    }
+    sqRing = sq;
+
+    void* cq = sq;
+    if (!isSingleMapping) {
+        cq = mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            ringFd, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED) {
+            close();
+            return false;
+        }
+    }
+    cqRing = cq;
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* entriesMap = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ringFd, IORING_OFF_SQES);
+    if (entriesMap == MAP_FAILED) {
+        close();
+        return false;
+    }
+    sqes = entriesMap;
+
+    char* sqBase = static_cast<char*>(sqRing);
+    char* cqBase = static_cast<char*>(cqRing);
+    sqTail = reinterpret_cast<unsigned int*>(sqBase + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned int*>(sqBase + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned int*>(sqBase + params.sq_off.array);
+    cqHead = reinterpret_cast<unsigned int*>(cqBase + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned int*>(cqBase + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned int*>(cqBase + params.cq_off.ring_mask);
+    cqes = cqBase + params.cq_off.cqes;
+    return true;
+#else
+    (void)entries;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    close
+* @details  This method unmaps the rings and closes the
+*           io_uring file descriptor.
+* @param    None
+* @return   None
+********************************************************/
+void UringFile::close() {
+#ifdef __linux__
+    if (sqes) {
+        munmap(sqes, sqesSize);
+    }
+    if (cqRing && cqRing != sqRing) {
+        munmap(cqRing, cqRingSize);
+    }
+    if (sqRing) {
+        munmap(sqRing, sqRingSize);
+    }
+    if (ringFd >= 0) {
+        ::close(ringFd);
+    }
+#endif
+
+    ringFd = -1;
+    sqRing = NULL;
+    cqRing = NULL;
+    sqes = NULL;
+    cqes = NULL;
+}
+
+/********************************************************
+* @brief    submitAndWait
+* @details  This method publishes queued entries to the
+*           kernel, waits until all of them complete and
+*           checks results.
+* @param    count   Number of queued entries
+* @return   bool    Return true if all requests succeeded
+********************************************************/
+bool UringFile::submitAndWait(unsigned int count) {
+#ifdef __linux__
+    unsigned int submitted = 0;
+    while (submitted < count) {
+        int result = (int)syscall(__NR_io_uring_enter, ringFd, count - submitted, count - submitted,
+            IORING_ENTER_GETEVENTS, NULL, 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        submitted += (unsigned int)result;
+    }
+
+    // Reap all completions, a failed write cancels the sync linked to it
+    bool isSuccess = true;
+    unsigned int reaped = 0;
+    while (reaped < count) {
+        unsigned int head = *cqHead;
+        unsigned int tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            // Wait for completions of submitted requests
+            syscall(__NR_io_uring_enter, ringFd, 0, count - reaped, IORING_ENTER_GETEVENTS, NULL, 0);
+            continue;
+        }
+
+        while (head != tail) {
+            const io_uring_cqe& cqe = static_cast<const io_uring_cqe*>(cqes)[head & *cqMask];
+            if (cqe.res < 0 || (cqe.user_data != 0 && (uint64_t)cqe.res != cqe.user_data)) {
+                isSuccess = false;
+            }
+            head++;
+            reaped++;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+    return isSuccess;
+#else
+    (void)count;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    write
+* @details  This method queues a write entry and, if sync
+*           is requested, a data sync entry linked to it.
+*           Expected byte count is kept in user data to
+*           detect short writes.
+* @param    fd          File descriptor
+* @param    data        Content to write
+* @param    length      Number of bytes to write
+* @param    offset      Offset in file
+* @param    isSync      Sync data after the write
+* @return   bool        Return true if all bytes are written
+*                       and synced
+********************************************************/
+bool UringFile::write(int fd, const char* data, size_t length, uint64_t offset, bool isSync) {
+#ifdef __linux__
+    if (ringFd < 0) {
+        return false;
+    }
+
+    io_uring_sqe* entries = static_cast<io_uring_sqe*>(sqes);
+    unsigned int tail = *sqTail;
+
+    io_uring_sqe* sqe = &entries[tail & *sqMask];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)data;
+    sqe->len = (uint32_t)length;
+    sqe->off = offset;
+    sqe->user_data = length;
+    sqe->flags = isSync ? IOSQE_IO_LINK : 0;
+    sqArray[tail & *sqMask] = tail & *sqMask;
+    tail++;
+
+    if (isSync) {
+        sqe = &entries[tail & *sqMask];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_FSYNC;
+        sqe->fd = fd;
+        sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+        sqArray[tail & *sqMask] = tail & *sqMask;
+        tail++;
+    }
+
+    __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+    return submitAndWait(isSync ? 2 : 1);
+#else
+    (void)fd;
+    (void)data;
+    (void)length;
+    (void)offset;
+    (void)isSync;
+    return false;
+#endif
+}
+
+/********************************************************
+* @brief    sync
+* @details  This method queues one data sync entry.
+* @param    fd      File descriptor
+* @return   bool    Return true if data is synced
+********************************************************/
+bool UringFile::sync(int fd) {
+#ifdef __linux__
+    if (ringFd < 0) {
+        return false;
+    }
+
+    io_uring_sqe* entries = static_cast<io_uring_sqe*>(sqes);
+    unsigned int tail = *sqTail;
+
+    io_uring_sqe* sqe = &entries[tail & *sqMask];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = fd;
+    sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+    sqArray[tail & *sqMask] = tail & *sqMask;
+
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    return submitAndWait(1);
+#else
+    (void)fd;
+    return false;
+#endif
+}
@@ -0,0 +1,187 @@
+/********************************************************
+* @file     VehicleCommand.cpp
+* @brief    Define methods related to driver commands
+* @details  This file contains methods definition related to
+*           commands, includes parsing command lines and
+*           queueing commands of all producers.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "VehicleCommand.hpp"
+#include "TelemetryParser.hpp"
+#include "PerfStats.hpp"
+#include <cstring>
+
+using namespace std;
+
+/********************************************************
+* @brief Keys of commands, same order as CommandType
+********************************************************/
+static const char* const commandKeys[] = {
+    "ACCELERATOR",
+    "BRAKE",
+    "DRIVE MODE",
+    "MODE TOGGLE",
+    "AC TEMPERATURE",
+    "AC STEP",
+    "WIND LEVEL",
+    "WIND STEP",
+    "CRUISE",
+    "CRUISE TOGGLE",
+    "CRUISE ADJUST",
+    "TRIP RESET"
+};
+
+/********************************************************
+* @brief    parseCommand
+* @details  This function parses one "KEY, value" command
+*           line. Drive mode takes ECO or SPORT, other values
+*           are whole numbers, the value of a command without
+*           one may be left out.
+* @param    line        Start of line
+* @param    end         End of line (without new line)
+* @param    type        Parsed kind of command
+* @param    value       Parsed value
+* @return   bool        Return true if key is known and value
+*                       is valid
+********************************************************/
+bool parseCommand(const char* line, const char* end, CommandType& type, int& value) {
+    // Command without value may have no comma
+    const char* comma = static_cast<const char*>(memchr(line, ',', end - line));
+    char key[32];
+    if (!comma) {
+        size_t length = end - line;
+        while (length > 0 && (line[length - 1] == ' ' || line[length - 1] == '\r')) {
+            length--;
+        }
+        if (length + 2 > sizeof(key)) {
+            return false;
+        }
+        memcpy(key, line, length);
+        key[length] = ',';
+        line = key;
+        end = key + length + 1;
+    }
+
+    size_t index;
+    const char* valueBegin;
+    const char* valueEnd;
+    if (!splitKeyValueLine(line, end, commandKeys, sizeof(commandKeys) / sizeof(commandKeys[0]),
+        index, valueBegin, valueEnd)) {
+        return false;
+    }
+    type = (CommandType)index;
+
+    if (type == COMMAND_MODE_TOGGLE || type == COMMAND_CRUISE_TOGGLE || type == COMMAND_TRIP_RESET) {
+        value = 0;
+        return true;
+    }
+
+    if (type == COMMAND_DRIVE_MODE) {
+        size_t valueLength = valueEnd - valueBegin;
+        if (valueLength == 3 && memcmp(valueBegin, "ECO", 3) == 0) {
+            value = ECO;
+            return true;
+        }
+        if (valueLength == 5 && memcmp(valueBegin, "SPORT", 5) == 0) {
+            value = SPORT;
+            return true;
+        }
+        return false;
+    }
+
+    double number;
+    if (!parseNumber(valueBegin, valueEnd, number) || number < -1000.0 || number > 1000.0
+        || number != (int)number) {
+        return false;
+    }
+    value = (int)number;
+    return true;
+}
+
+/********************************************************
+* @brief    getCommandKey
+* @details  This function gets the key of a kind of command,
+*           as written in command lines.
+* @param    type        Kind of command
+* @return   const char* Return key, "UNKNOWN" if type is
+*                       invalid
+********************************************************/
+const char* getCommandKey(CommandType type) {
+    if (type < 0 || type >= COMMAND_TYPE_COUNT) {
+        return "UNKNOWN";
+    }
+    return commandKeys[type];
+}
+
+/********************************************************
+* @brief Constructor
+* @param capacity     Most commands kept at the same time
+********************************************************/
+CommandQueue::CommandQueue(size_t capacity) : queue(capacity), dropped(0) {
+    for (int i = 0; i < COMMAND_SOURCE_COUNT; i++) {
+        submitted[i].store(0, memory_order_relaxed);
+    }
+}
+
+/********************************************************
+* @brief    submit
+* @details  This method stamps a command with monotonic time
+*           and pushes it, a full queue refuses the command
+*           and counts it.
+* @param    type    Kind of command
+* @param    value   Value of command
+* @param    source  Producer
+* @return   bool    Return false if queue is full
+********************************************************/
+bool CommandQueue::submit(CommandType type, int value, CommandSource source) {
+    VehicleCommand command;
+    command.type = type;
+    command.value = value;
+    command.source = source;
+    command.timestampNs = PerfStats::nowNs();
+
+    if (!queue.push(command)) {
+        dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    submitted[source].fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+/********************************************************
+* @brief    drain
+* @details  This method takes queued commands in order of
+*           submit, commands over maxCount stay for the next
+*           call.
+* @param    commands    Array for commands
+* @param    maxCount    Size of array
+* @return   size_t      Return number of commands
+********************************************************/
+size_t CommandQueue::drain(VehicleCommand* commands, size_t maxCount) {
+    return queue.popBatch(commands, maxCount);
+}
+
+/********************************************************
+* @brief    getSubmitted
+* @details  This method gets number of queued commands of a
+*           producer.
+* @param    source  Producer
+* @return   unsigned long   Return number
+********************************************************/
+unsigned long CommandQueue::getSubmitted(CommandSource source) const {
+    return submitted[source].load(memory_order_relaxed);
+}
+
+/********************************************************
+* @brief    getDropped
+* @details  This method gets number of commands refused
+*           because queue was full, a producer may submit
+*           them again.
+* @param    None
+* @return   unsigned long   Return number
+********************************************************/
+unsigned long CommandQueue::getDropped() const {
+    return dropped.load(memory_order_relaxed);
+}
@@ -0,0 +1,467 @@
+/********************************************************
+* @file     VehiclePipeline.cpp
+* @brief    Define methods related to one control tick of
+*           the vehicle
+* @details  This file contains methods definition related
+*           to the vehicle pipeline, includes process driver
+*           input, update speed, drive mode, climate, battery
+*           level and range, and time each stage.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "VehiclePipeline.hpp"
+#include <algorithm>
+
+using namespace std;
+
+/********************************************************
+* @brief    packInput
+* @details  This function packs held driver controls into
+*           FlightInput bits.
+* @param    input       State of driver controls
+* @return   uint16_t    Return bits
+********************************************************/
+static uint16_t packInput(const DriverInput& input) {
+    uint16_t bits = 0;
+    bits |= input.isAccelerating ? FLIGHT_INPUT_ACCELERATOR : 0;
+    bits |= input.isBraking ? FLIGHT_INPUT_BRAKE : 0;
+    bits |= input.isModeToggled ? FLIGHT_INPUT_MODE : 0;
+    bits |= input.isAcUp ? FLIGHT_INPUT_AC_UP : 0;
+    bits |= input.isAcDown ? FLIGHT_INPUT_AC_DOWN : 0;
+    bits |= input.isWindUp ? FLIGHT_INPUT_WIND_UP : 0;
+    bits |= input.isWindDown ? FLIGHT_INPUT_WIND_DOWN : 0;
+    bits |= input.isTripReset ? FLIGHT_INPUT_TRIP_RESET : 0;
+    bits |= input.isCruiseToggled ? FLIGHT_INPUT_CRUISE : 0;
+    bits |= input.isCruiseUp ? FLIGHT_INPUT_CRUISE_UP : 0;
+    bits |= input.isCruiseDown ? FLIGHT_INPUT_CRUISE_DOWN : 0;
+    return bits;
+}
+
+/********************************************************
+* @brief Constructor
+* @param dashboardController  Pointer to DashboardController object
+* @param speedCalculator      Pointer to SpeedCalculator object
+* @param driveMode            Pointer to DriveModeManager object
+* @param safetyManager        Pointer to SafetyManager object
+* @param batteryManager       Pointer to BatteryManager object
+* @param tripComputer         Pointer to TripComputer object
+* @param profileStore         Pointer to VehicleProfileStore object
+*                             that publishes vehicle parameters
+********************************************************/
+VehiclePipeline::VehiclePipeline(DashboardController* dashboardController, SpeedCalculator* speedCalculator,
+    DriveModeManager* driveMode, SafetyManager* safetyManager, BatteryManager* batteryManager,
+    TripComputer* tripComputer, const VehicleProfileStore* profileStore)
+    : dashboardController(dashboardController), speedCalculator(speedCalculator), driveMode(driveMode),
+      safetyManager(safetyManager), batteryManager(batteryManager), tripComputer(tripComputer),
+      profileStore(profileStore), profileVersion(0), previousInput(), commandInput(), acTemp(0), windLevel(0), speed(0), mode(ECO),
+      climateAdvisor(NULL), flightRecorder(NULL), ruleEngine(NULL), perfStats(NULL), stageProfile(-1),
+      stageInput(-1), stageBattery(-1), stageTrip(-1), stageAdvisor(-1), stageController(-1), stageRules(-1),
+      stageRecorder(-1) {}
+
+/********************************************************
+* @brief    isValid
+* @details  This method checks all managers are given.
+* @param    None
+* @return   bool    Return false if a pointer is NULL
+********************************************************/
+bool VehiclePipeline::isValid() const {
+    return dashboardController && speedCalculator && driveMode && safetyManager
+        && batteryManager && tripComputer && profileStore;
+}
+
+/********************************************************
+* @brief    start
+* @details  This method takes initial values from
+*           DashboardController and passes speed and drive
+*           mode to the managers.
+* @param    None
+* @return   None
+********************************************************/
+void VehiclePipeline::start() {
+    acTemp = dashboardController->getAcTemp();
+    windLevel = dashboardController->getWindLevel();
+    speed = dashboardController->getSpeed();
+    mode = dashboardController->getDriveMode();
+    previousInput = DriverInput();
+    commandInput = DriverInput();
+
+    speedCalculator->setCurrentSpeed(speed);
+    driveMode->setDriveMode(mode);
+    profileVersion = applyVehicleProfile(profileStore, speedCalculator, driveMode, batteryManager);
+}
+
+/********************************************************
+* @brief    tick
+* @details  This method runs one 100 ms tick: apply vehicle
+*           parameters, process driver input, update battery
+*           level and range, advise climate settings, then
+*           update DashboardController.
+*           AC, wind, trip reset and cruise control change
+*           once per press.
+* @param    input   State of driver controls
+* @return   None
+********************************************************/
+void VehiclePipeline::tick(const DriverInput& input) {
+    runTick(input, NULL, 0);
+}
+
+/********************************************************
+* @brief    tick
+* @details  This method runs one 100 ms tick with a batch of
+*           commands. Commands are applied in order before
+*           speed is computed, pedals keep the state of the
+*           last accelerator and brake commands.
+* @param    commands    Commands to apply in order
+* @param    count       Number of commands
+* @return   None
+********************************************************/
+void VehiclePipeline::tick(const VehicleCommand* commands, size_t count) {
+    // Input is read after commands, so pedals are already updated
+    runTick(commandInput, commands, count);
+}
+
+/********************************************************
+* @brief    applyCommand
+* @details  This method applies one command. Values are
+*           limited like keys, steps and toggles act once per
+*           command.
+* @param    command     Command to apply
+* @return   None
+********************************************************/
+void VehiclePipeline::applyCommand(const VehicleCommand& command) {
+    switch (command.type) {
+    case COMMAND_ACCELERATOR:
+        commandInput.isAccelerating = command.value != 0;
+        break;
+
+    case COMMAND_BRAKE:
+        commandInput.isBraking = command.value != 0;
+        break;
+
+    case COMMAND_DRIVE_MODE:
+        driveMode->setDriveMode((DriveMode)command.value);
+        mode = driveMode->getCurrentDriveMode();
+        break;
+
+    case COMMAND_MODE_TOGGLE:
+        driveMode->setDriveMode(driveMode->getCurrentDriveMode() == ECO ? SPORT : ECO);
+        mode = driveMode->getCurrentDriveMode();
+        break;
+
+    case COMMAND_AC_TEMP:
+        acTemp = max(min(command.value, PIPELINE_AC_TEMP_MAX), PIPELINE_AC_TEMP_MIN);
+        break;
+
+    case COMMAND_AC_STEP:
+        acTemp = max(min(acTemp + command.value, PIPELINE_AC_TEMP_MAX), PIPELINE_AC_TEMP_MIN);
+        break;
+
+    case COMMAND_WIND_LEVEL:
+        windLevel = max(min(command.value, PIPELINE_WIND_MAX), PIPELINE_WIND_MIN);
+        break;
+
+    case COMMAND_WIND_STEP:
+        windLevel = max(min(windLevel + command.value, PIPELINE_WIND_MAX), PIPELINE_WIND_MIN);
+        break;
+
+    case COMMAND_CRUISE:
+        if (command.value != 0 && !speedCalculator->isCruiseActive()) {
+            speedCalculator->engageCruise(driveMode->getCurrentDriveMode());
+        } else if (command.value == 0 && speedCalculator->isCruiseActive()) {
+            speedCalculator->cancelCruise();
+        }
+        break;
+
+    case COMMAND_CRUISE_TOGGLE:
+        if (speedCalculator->isCruiseActive()) {
+            speedCalculator->cancelCruise();
+        } else {
+            speedCalculator->engageCruise(driveMode->getCurrentDriveMode());
+        }
+        break;
+
+    case COMMAND_CRUISE_ADJUST:
+        speedCalculator->adjustCruiseSpeed(command.value, driveMode->getCurrentDriveMode());
+        break;
+
+    case COMMAND_TRIP_RESET:
+        tripComputer->resetTrip();
+        break;
+
+    default:
+        break;
+    }
+}
+
+/********************************************************
+* @brief    runTick
+* @details  This method runs one tick: apply vehicle
+*           parameters, apply commands, process driver input,
+*           update battery level and range, add the tick to
+*           trip aggregates, advise climate settings, update
+*           DashboardController, then evaluate rules.
+* @param    input       State of driver controls
+* @param    commands    Commands to apply in order, may be NULL
+* @param    count       Number of commands
+* @return   None
+********************************************************/
+void VehiclePipeline::runTick(const DriverInput& input, const VehicleCommand* commands, size_t count) {
+    PerfMark mark;
+    if (perfStats) {
+        perfStats->mark(mark);
+    }
+
+    // Vehicle parameters may be reloaded between 2 ticks, a
+    // new block is converted to numbers of the models once
+    updateVehicleProfile(profileStore, speedCalculator, driveMode, batteryManager, profileVersion);
+    markStage(stageProfile, mark);
+
+    // Commands queued since last tick
+    for (size_t i = 0; i < count; i++) {
+        applyCommand(commands[i]);
+    }
+
+    // Accelerator
+    if (input.isAccelerating) {
+        speedCalculator->calculateSpeed(true, false);
+        speedCalculator->adjustSpeedForDriveMode(driveMode->getCurrentDriveMode());
+        speed = speedCalculator->getCurrentSpeed();
+    }
+
+    // Brake
+    if (input.isBraking) {
+        speed = speedCalculator->calculateSpeed(false, true);
+    }
+
+    // Accelerator and brake are both not pressed
+    if (!input.isAccelerating && !input.isBraking) {
+        speed = speedCalculator->calculateSpeed(false, false);
+    }
+
+    // Drive mode
+    if (input.isModeToggled) {
+        driveMode->setDriveMode(driveMode->getCurrentDriveMode() == ECO ? SPORT : ECO);
+        mode = driveMode->getCurrentDriveMode();
+    }
+
+    // Cruise control, speed is held by the cruise loop
+    if (input.isCruiseToggled && !previousInput.isCruiseToggled) {
+        if (speedCalculator->isCruiseActive()) {
+            speedCalculator->cancelCruise();
+        } else {
+            speedCalculator->engageCruise(driveMode->getCurrentDriveMode());
+        }
+    }
+    if (input.isCruiseUp && !previousInput.isCruiseUp) {
+        speedCalculator->adjustCruiseSpeed(CRUISE_SPEED_STEP, driveMode->getCurrentDriveMode());
+    }
+    if (input.isCruiseDown && !previousInput.isCruiseDown) {
+        speedCalculator->adjustCruiseSpeed(-CRUISE_SPEED_STEP, driveMode->getCurrentDriveMode());
+    }
+
+    // AC temperature and wind level
+    if (input.isAcUp && !previousInput.isAcUp) {
+        acTemp = min(acTemp + 1, PIPELINE_AC_TEMP_MAX);
+    }
+    if (input.isAcDown && !previousInput.isAcDown) {
+        acTemp = max(acTemp - 1, PIPELINE_AC_TEMP_MIN);
+    }
+    if (input.isWindUp && !previousInput.isWindUp) {
+        windLevel = min(windLevel + 1, PIPELINE_WIND_MAX);
+    }
+    if (input.isWindDown && !previousInput.isWindDown) {
+        windLevel = max(windLevel - 1, PIPELINE_WIND_MIN);
+    }
+
+    // Reset trip
+    if (input.isTripReset && !previousInput.isTripReset) {
+        tripComputer->resetTrip();
+    }
+    previousInput = input;
+    markStage(stageInput, mark);
+
+    // Battery level
+    batteryManager->updateBatteryLevel(speed, acTemp, windLevel);
+    int batteryLevel = batteryManager->getBatteryLevel();
+
+    if (batteryLevel == 0) {
+        speed = 0;
+    }
+
+    // Remaining range
+    double remainingRange = numericToDouble(batteryManager->calculateRamainingRange());
+    markStage(stageBattery, mark);
+
+    // Trip aggregates, same drain as the battery for this tick
+    double drain = numericToDouble(batteryManager->calculateBatteryDrain(speed, acTemp, windLevel));
+    tripComputer->addSample(speed, drain, mode, 1.0 / BATTERY_TICKS_PER_SECOND);
+    markStage(stageTrip, mark);
+
+    // Range of other climate settings and speed caps
+    if (climateAdvisor) {
+        climateAdvisor->advise(speed, acTemp, windLevel);
+        markStage(stageAdvisor, mark);
+    }
+
+    // Update new data to DashboardController
+    dashboardController->setDriveMode(mode);
+    dashboardController->setSpeed(speed);
+    dashboardController->setAcTemp(acTemp);
+    dashboardController->setWindLevel(windLevel);
+    dashboardController->setBatteryLevel(batteryLevel);
+    dashboardController->setRemainingRange(remainingRange);
+    markStage(stageController, mark);
+
+    DashboardState state;
+    state.speed = speed;
+    state.driveMode = mode;
+    state.batteryLevel = batteryLevel;
+    state.remainingRange = remainingRange;
+    state.acTemp = acTemp;
+    state.windLevel = windLevel;
+
+    // Signals and alarms, display takes the events
+    if (ruleEngine) {
+        ruleEngine->evaluate(state, 1.0 / BATTERY_TICKS_PER_SECOND, dashboardController->getTickTime());
+        markStage(stageRules, mark);
+    }
+
+    // Kept in memory, written to file only by a dump signal
+    if (flightRecorder) {
+        int cruiseSpeed = speedCalculator->isCruiseActive() ? speedCalculator->getCruiseSpeed() : 0;
+        flightRecorder->record(state, cruiseSpeed, packInput(input), commands, count, PerfStats::nowNs());
+        markStage(stageRecorder, mark);
+    }
+}
+
+/********************************************************
+* @brief    setPerfStats
+* @details  This method registers stages of a tick in a
+*           PerfStats object, then each tick records them.
+* @param    stats   Pointer to PerfStats object, NULL stops
+*                   timing
+* @return   None
+********************************************************/
+void VehiclePipeline::setPerfStats(PerfStats* stats) {
+    perfStats = stats;
+    if (!perfStats) {
+        return;
+    }
+
+    stageProfile = perfStats->addStage("profile");
+    stageInput = perfStats->addStage("input");
+    stageBattery = perfStats->addStage("battery");
+    stageTrip = perfStats->addStage("trip");
+    stageAdvisor = perfStats->addStage("advisor");
+    stageController = perfStats->addStage("controller");
+    stageRules = perfStats->addStage("rules");
+    stageRecorder = perfStats->addStage("recorder");
+}
+
+/********************************************************
+* @brief    setClimateAdvisor
+* @details  This method sets the advisor that evaluates other
+*           climate settings and speed caps after battery
+*           level is updated.
+* @param    advisor     Pointer to ClimateAdvisor object,
+*                       NULL stops advice
+* @return   None
+********************************************************/
+void VehiclePipeline::setClimateAdvisor(ClimateAdvisor* advisor) {
+    climateAdvisor = advisor;
+}
+
+/********************************************************
+* @brief    setFlightRecorder
+* @details  This method sets the recorder that keeps the
+*           last ticks, a tick is recorded after
+*           DashboardController is updated.
+* @param    recorder    Pointer to FlightRecorder object,
+*                       NULL stops recording
+* @return   None
+********************************************************/
+void VehiclePipeline::setFlightRecorder(FlightRecorder* recorder) {
+    flightRecorder = recorder;
+}
+
+/********************************************************
+* @brief    setRuleEngine
+* @details  This method sets the engine that evaluates
+*           signals and alarms after DashboardController is
+*           updated, with the tick length as dt.
+* @param    engine      Pointer to RuleEngine object, NULL
+*                       stops evaluation
+* @return   None
+********************************************************/
+void VehiclePipeline::setRuleEngine(RuleEngine* engine) {
+    ruleEngine = engine;
+}
+
+/********************************************************
+* @brief    markStage
+* @details  This method records time and counters since
+*           last mark as one stage, nothing is done without
+*           PerfStats.
+* @param    stage       Index of stage in perfStats
+* @param    mark        Last mark, set to now
+* @return   None
+********************************************************/
+void VehiclePipeline::markStage(int stage, PerfMark& mark) {
+    if (!perfStats) {
+        return;
+    }
+
+    perfStats->record(stage, mark);
+}
+
+/********************************************************
+* @brief    applyVehicleProfile
+* @details  This function applies current parameter block
+*           to the managers, the block is read without lock.
+* @param    profileStore        Pointer to VehicleProfileStore
+*                               object that publishes parameters
+* @param    speedCalculator     Pointer to SpeedCalculator object
+* @param    driveMode           Pointer to DriveModeManager object
+* @param    batteryManager      Pointer to BatteryManager object
+* @return   unsigned long       Return version of applied block
+********************************************************/
+unsigned long applyVehicleProfile(const VehicleProfileStore* profileStore, SpeedCalculator* speedCalculator,
+    DriveModeManager* driveMode, BatteryManager* batteryManager) {
+    VehicleProfileStore::Reader profile(*profileStore);
+
+    speedCalculator->applyProfile(*profile);
+    driveMode->applyProfile(*profile);
+    batteryManager->applyProfile(*profile);
+    return profile->version;
+}
+
+/********************************************************
+* @brief    updateVehicleProfile
+* @details  This function applies current parameter block
+*           only if its version is not the applied one, so
+*           parameters are converted to the number type of
+*           the models once per published block instead of
+*           every tick.
+* @param    profileStore        Pointer to VehicleProfileStore
+*                               object that publishes parameters
+* @param    speedCalculator     Pointer to SpeedCalculator object
+* @param    driveMode           Pointer to DriveModeManager object
+* @param    batteryManager      Pointer to BatteryManager object
+* @param    appliedVersion      Version applied before, set to
+*                               version of current block
+* @return   bool                Return true if a block is applied
+********************************************************/
+bool updateVehicleProfile(const VehicleProfileStore* profileStore, SpeedCalculator* speedCalculator,
+    DriveModeManager* driveMode, BatteryManager* batteryManager, unsigned long& appliedVersion) {
+    VehicleProfileStore::Reader profile(*profileStore);
+    if (profile->version == appliedVersion) {
+        return false;
+    }
+
+    speedCalculator->applyProfile(*profile);
+    driveMode->applyProfile(*profile);
+    batteryManager->applyProfile(*profile);
+    appliedVersion = profile->version;
+    return true;
+}
@@ -0,0 +1,199 @@
+/********************************************************
+* @file     VehicleProfile.cpp
+* @brief    Define methods related to vehicle profile
+* @details  This file contains methods definition related
+*           to vehicle profile, includes parse profile file,
+*           validate parameters, detect file changes and
+*           publish new parameter blocks.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include "VehicleProfile.hpp"
+#include "TelemetryParser.hpp"
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+
+using namespace std;
+
+/********************************************************
+* @brief Keys of vehicle profile file
+********************************************************/
+typedef enum {
+    PROFILE_BATTERY_CAPACITY,
+    PROFILE_DRAIN_PER_KM,
+    PROFILE_MAX_SPEED_SPORT,
+    PROFILE_MAX_SPEED_ECO,
+    PROFILE_POWER_OUTPUT_SPORT,
+    PROFILE_POWER_OUTPUT_ECO,
+    PROFILE_MAX_ECO_SPEED
+} ProfileKey;
+
+/********************************************************
+* @brief Keys of vehicle profile file, same order as
+*        ProfileKey
+********************************************************/
+static const char* const profileKeys[] = {
+    "BATTERY CAPACITY",
+    "DRAIN PER KM",
+    "MAX SPEED SPORT",
+    "MAX SPEED ECO",
+    "POWER OUTPUT SPORT",
+    "POWER OUTPUT ECO",
+    "MAX ECO SPEED"
+};
+
+/********************************************************
+* @brief    getDefaultVehicleProfile
+* @details  This function gets parameters used when profile
+*           file does not set them.
+* @param    None
+* @return   VehicleProfile  Return default parameters
+********************************************************/
+VehicleProfile getDefaultVehicleProfile() {
+    VehicleProfile profile;
+    profile.batteryCapacity = DEFAULT_BATTERY_CAPACITY;
+    profile.drainPerKm = DEFAULT_DRAIN_PER_KM;
+    profile.maxSpeedSport = DEFAULT_MAX_SPEED_SPORT;
+    profile.maxSpeedEco = DEFAULT_MAX_SPEED_ECO;
+    profile.powerOutputSport = DEFAULT_POWER_OUTPUT_SPORT;
+    profile.powerOutputEco = DEFAULT_POWER_OUTPUT_ECO;
+    profile.maxEcoSpeed = DEFAULT_MAX_ECO_SPEED;
+    profile.version = 0;
+    return profile;
+}
+
+/********************************************************
+* @brief Constructor
+* @param path     Profile file
+********************************************************/
+VehicleProfileStore::VehicleProfileStore(const string& path)
+    : path(path), profile(new VehicleProfile(getDefaultVehicleProfile())),
+    hasFileState(false), fileModifiedTime(0), fileSize(0), publishCount(0) {}
+
+/********************************************************
+* @brief Destructor
+********************************************************/
+VehicleProfileStore::~VehicleProfileStore() {}
+
+/********************************************************
+* @brief    parse
+* @details  This method parses profile file, each line is
+*           "KEY, value". Keys not in the file keep default
+*           values, any invalid line rejects the whole file.
+* @param    result  Parameters read from file
+* @return   bool    Return true if file is valid
+********************************************************/
+bool VehicleProfileStore::parse(VehicleProfile& result) const {
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        cerr << "Cannot open file " << path << endl;
+        return false;
+    }
+
+    result = getDefaultVehicleProfile();
+
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+
+        // Skip empty lines
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+
+        size_t key;
+        const char* valueBegin;
+        const char* valueEnd;
+        double value;
+        if (!splitKeyValueLine(line.data(), line.data() + line.size(), profileKeys,
+            sizeof(profileKeys) / sizeof(profileKeys[0]), key, valueBegin, valueEnd)
+            || !parseNumber(valueBegin, valueEnd, value) || value <= 0.0) {
+            cerr << "Invalid line " << lineNumber << " in " << path << endl;
+            return false;
+        }
+
+        switch ((ProfileKey)key) {
+        case PROFILE_BATTERY_CAPACITY:
+            result.batteryCapacity = value;
+            break;
+
+        case PROFILE_DRAIN_PER_KM:
+            result.drainPerKm = value;
+            break;
+
+        case PROFILE_MAX_SPEED_SPORT:
+            result.maxSpeedSport = (int)value;
+            break;
+
+        case PROFILE_MAX_SPEED_ECO:
+            result.maxSpeedEco = (int)value;
+            break;
+
+        case PROFILE_POWER_OUTPUT_SPORT:
+            result.powerOutputSport = (int)value;
+            break;
+
+        case PROFILE_POWER_OUTPUT_ECO:
+            result.powerOutputEco = (int)value;
+            break;
+
+        case PROFILE_MAX_ECO_SPEED:
+            result.maxEcoSpeed = (int)value;
+            break;
+        }
+    }
+
+    return true;
+}
+
+/********************************************************
+* @brief    load
+* @details  This method loads profile file into a new
+*           parameter block and publishes it. Old block is
+*           deleted when no reader holds it anymore.
+* @param    None
+* @return   bool    Return true if new parameters are published
+********************************************************/
+bool VehicleProfileStore::load() {
+    // Remember file state first, an invalid file is not
+    // parsed again until it changes
+    struct stat fileState;
+    if (stat(path.c_str(), &fileState) == 0) {
+        hasFileState = true;
+        fileModifiedTime = fileState.st_mtime;
+        fileSize = (long long)fileState.st_size;
+    }
+
+    VehicleProfile next;
+    if (!parse(next)) {
+        return false;
+    }
+
+    next.version = ++publishCount;
+    profile.publish(new VehicleProfile(next));
+    return true;
+}
+
+/********************************************************
+* @brief    reloadIfChanged
+* @details  This method checks modified time and size of
+*           profile file, loads it if one of them changed.
+* @param    None
+* @return   bool    Return true if new parameters are published
+********************************************************/
+bool VehicleProfileStore::reloadIfChanged() {
+    struct stat fileState;
+    if (stat(path.c_str(), &fileState) != 0) {
+        return false;
+    }
+
+    if (hasFileState && fileState.st_mtime == fileModifiedTime
+        && (long long)fileState.st_size == fileSize) {
+        return false;
+    }
+
+    return load();
+}
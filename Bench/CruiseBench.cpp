@@ -0,0 +1,328 @@
+/********************************************************
+* @file     CruiseBench.cpp
+* @brief    Benchmark of the cruise control loop
+* @details  This file contains the main program of the
+*           cruise benchmark. The report has cost of one
+*           controller step on double, Q16.16 and Q32.32,
+*           step response from 60 to 100 km/h at several
+*           loop rates (overshoot, settle time and error at
+*           the end) and lateness of a 1 kHz loop run by
+*           TaskExecutor like the main program. On Linux, a
+*           task waits on a pipe with a time limit during the
+*           loop, the run checks it is woken both by the pipe
+*           and by its time limit, and reports wake latency.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "SpeedCalculator.hpp"
+#include "TaskExecutor.hpp"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/********************************************************
+* Benchmark parameters
+********************************************************/
+#define BENCH_DEFAULT_STEPS     20000000    /* Timed controller steps */
+#define BENCH_DEFAULT_SECONDS   3           /* Run time of the loop lateness test (s) */
+#define BENCH_ADJUST_STEPS      5000        /* Steps between set speed changes of the timed run */
+#define BENCH_START_SPEED       60          /* Speed when cruise control is engaged (km/h) */
+#define BENCH_TARGET_SPEED      100         /* Set speed of the step response (km/h) */
+#define BENCH_RESPONSE_SECONDS  30          /* Simulated time of the step response (s) */
+#define BENCH_SETTLE_BAND       0.5         /* Speed is settled within this error (km/h) */
+#define BENCH_LOOP_RATE_HZ      1000        /* Rate of the loop lateness test */
+#define BENCH_PIPE_PERIOD_MS    7           /* Time between pipe writes (ms) */
+#define BENCH_PIPE_TIMEOUT_MS   20          /* Time limit of the pipe wait (ms) */
+
+/********************************************************
+* @struct ResponseResult
+* @brief  Step response of one numeric type and rate
+********************************************************/
+typedef struct {
+    double overshoot;       /* Highest speed above set speed (km/h) */
+    double settleSeconds;   /* Time until speed stays within BENCH_SETTLE_BAND (s) */
+    double finalError;      /* Set speed minus speed at the end (km/h) */
+} ResponseResult;
+
+/********************************************************
+* @brief    measureStep
+* @details  This function times many controller steps, set
+*           speed moves up and down so the controller keeps
+*           working instead of resting at the set speed.
+* @param    steps   Number of timed steps
+* @return   double  Return cost of one step (ns)
+********************************************************/
+template <typename Num>
+static double measureStep(long steps) {
+    BasicSpeedCalculator<Num> speedCalculator;
+    speedCalculator.setCurrentSpeed(BENCH_START_SPEED + 20);
+    speedCalculator.engageCruise(SPORT);
+
+    chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+    for (long step = 0; step < steps; step++) {
+        if (step % BENCH_ADJUST_STEPS == 0) {
+            speedCalculator.adjustCruiseSpeed((step / BENCH_ADJUST_STEPS) % 2 == 0 ? 10 : -10, SPORT);
+        }
+        speedCalculator.stepCruise(SPORT);
+    }
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - startTime;
+
+    volatile int sink = speedCalculator.getCurrentSpeed();
+    (void)sink;
+    return elapsed.count() / (double)steps;
+}
+
+/********************************************************
+* @brief    stepResponse
+* @details  This function engages cruise control at
+*           BENCH_START_SPEED, raises set speed to
+*           BENCH_TARGET_SPEED and runs the loop for
+*           BENCH_RESPONSE_SECONDS of simulated time.
+* @param    rateHz  Steps per second
+* @return   ResponseResult  Return overshoot, settle time
+*                           and final error
+********************************************************/
+template <typename Num>
+static ResponseResult stepResponse(int rateHz) {
+    BasicSpeedCalculator<Num> speedCalculator;
+    speedCalculator.setCruiseRate(rateHz);
+    speedCalculator.setCurrentSpeed(BENCH_START_SPEED);
+    speedCalculator.engageCruise(SPORT);
+    speedCalculator.adjustCruiseSpeed(BENCH_TARGET_SPEED - BENCH_START_SPEED, SPORT);
+
+    ResponseResult result = {0, 0, 0};
+    long steps = (long)BENCH_RESPONSE_SECONDS * rateHz;
+    long lastOutside = 0;
+
+    for (long step = 1; step <= steps; step++) {
+        speedCalculator.stepCruise(SPORT);
+        double speed = numericToDouble(speedCalculator.getSpeedValue());
+
+        result.overshoot = max(result.overshoot, speed - BENCH_TARGET_SPEED);
+        if (fabs(speed - BENCH_TARGET_SPEED) > BENCH_SETTLE_BAND) {
+            lastOutside = step;
+        }
+        result.finalError = BENCH_TARGET_SPEED - speed;
+    }
+
+    result.settleSeconds = (double)lastOutside / rateHz;
+    return result;
+}
+
+/********************************************************
+* @brief    printResponse
+* @details  This function prints one line of step response.
+* @param    name    Name of numeric type
+* @param    rateHz  Steps per second
+* @param    result  Step response
+* @return   None
+********************************************************/
+static void printResponse(const string& name, int rateHz, const ResponseResult& result) {
+    cout << name << " at " << rateHz << " Hz: overshoot " << result.overshoot << " km/h, settled in "
+         << result.settleSeconds << " s, final error " << result.finalError << " km/h" << endl;
+}
+
+/********************************************************
+* @brief    runLoop
+* @details  This task runs cruise control at a fixed rate
+*           with absolute deadlines, the same way as the
+*           main program, and keeps lateness of each wake up.
+* @param    executor        Pointer to TaskExecutor object
+*                           that runs this task
+* @param    speedCalculator Pointer to SpeedCalculator object
+*                           with cruise control engaged
+* @param    lateness        Lateness of each wake up (us),
+*                           size is the number of steps
+* @return   Task
+********************************************************/
+static Task runLoop(TaskExecutor* executor, SpeedCalculator* speedCalculator, vector<double>* lateness) {
+    const TaskClock::duration period = chrono::nanoseconds(1000000000L / speedCalculator->getCruiseRate());
+    TaskClock::time_point next = TaskClock::now() + period;
+
+    for (size_t i = 0; i < lateness->size(); i++) {
+        co_await executor->sleepUntil(next);
+        chrono::duration<double, micro> late = TaskClock::now() - next;
+        (*lateness)[i] = late.count();
+
+        speedCalculator->stepCruise(SPORT);
+        next += period;
+    }
+}
+
+#ifdef __linux__
+/********************************************************
+* @struct PipeResult
+* @brief  Wake ups of the pipe reader
+********************************************************/
+typedef struct {
+    unsigned long written;      /* Messages written */
+    unsigned long received;     /* Messages read */
+    unsigned long timeouts;     /* Wake ups by time limit */
+    vector<double> latency;     /* Time from write to wake up (us) */
+} PipeResult;
+
+/********************************************************
+* @brief    writePipe
+* @details  This task writes the time into a pipe every
+*           BENCH_PIPE_PERIOD_MS for the first half of the
+*           run, stays silent for the second half so the
+*           reader times out, then closes the pipe.
+* @param    executor        Pointer to TaskExecutor object
+*                           that runs this task
+* @param    fd              Write end of the pipe
+* @param    seconds         Run time (s)
+* @param    result          Pointer to counters
+* @return   Task
+********************************************************/
+static Task writePipe(TaskExecutor* executor, int fd, int seconds, PipeResult* result) {
+    TaskClock::time_point start = TaskClock::now();
+    TaskClock::time_point silent = start + chrono::milliseconds(seconds * 500);
+
+    while (TaskClock::now() < silent) {
+        co_await executor->sleepFor(BENCH_PIPE_PERIOD_MS);
+        int64_t nowNs = chrono::duration_cast<chrono::nanoseconds>(TaskClock::now().time_since_epoch()).count();
+        if (write(fd, &nowNs, sizeof(nowNs)) == (ssize_t)sizeof(nowNs)) {
+            result->written++;
+        }
+    }
+
+    co_await executor->sleepUntil(start + chrono::seconds(seconds));
+    close(fd);
+}
+
+/********************************************************
+* @brief    readPipe
+* @details  This task waits for the pipe with a time limit
+*           and reads the messages, until end of pipe.
+* @param    executor        Pointer to TaskExecutor object
+*                           that runs this task
+* @param    fd              Read end of the pipe
+* @param    result          Pointer to counters
+* @return   Task
+********************************************************/
+static Task readPipe(TaskExecutor* executor, int fd, PipeResult* result) {
+    while (true) {
+        WaitResult wait = co_await executor->waitReadable(fd, BENCH_PIPE_TIMEOUT_MS);
+        if (wait == WAIT_ERROR) {
+            break;
+        }
+        if (wait == WAIT_TIMEOUT) {
+            result->timeouts++;
+            continue;
+        }
+
+        int64_t wakeNs = chrono::duration_cast<chrono::nanoseconds>(TaskClock::now().time_since_epoch()).count();
+        int64_t sentNs;
+        ssize_t count = read(fd, &sentNs, sizeof(sentNs));
+        if (count != (ssize_t)sizeof(sentNs)) {
+            break;
+        }
+        result->received++;
+        result->latency.push_back((double)(wakeNs - sentNs) / 1000.0);
+    }
+    close(fd);
+}
+#endif
+
+/********************************************************
+* @brief Main function
+* @details Usage: CruiseBench.exe [--steps N] [--seconds N]
+********************************************************/
+int main(int argc, char* argv[])
+{
+    long steps = BENCH_DEFAULT_STEPS;
+    int seconds = BENCH_DEFAULT_SECONDS;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--steps" && i + 1 < argc) {
+            steps = atol(argv[++i]);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = atoi(argv[++i]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--steps N] [--seconds N]" << endl;
+            return 1;
+        }
+    }
+
+    if (steps <= 0 || seconds <= 0) {
+        cerr << "Number of steps and seconds must be positive" << endl;
+        return 1;
+    }
+
+    // Cost of one controller step
+    cout << "Timed " << steps << " steps" << endl;
+    cout << "double: " << measureStep<double>(steps) << " ns/step" << endl;
+    cout << "Q16.16: " << measureStep<Q16_16>(steps) << " ns/step" << endl;
+    cout << "Q32.32: " << measureStep<Q32_32>(steps) << " ns/step" << endl << endl;
+
+    // Step response, same controller at several rates
+    cout << "Step response " << BENCH_START_SPEED << " -> " << BENCH_TARGET_SPEED << " km/h" << endl;
+    printResponse("double", 1000, stepResponse<double>(1000));
+    printResponse("double", 100, stepResponse<double>(100));
+    printResponse("double", 10, stepResponse<double>(10));
+    printResponse("Q16.16", 1000, stepResponse<Q16_16>(1000));
+    printResponse("Q32.32", 1000, stepResponse<Q32_32>(1000));
+    cout << endl;
+
+    // Lateness of the fixed rate loop on TaskExecutor
+    SpeedCalculator speedCalculator;
+    speedCalculator.setCruiseRate(BENCH_LOOP_RATE_HZ);
+    speedCalculator.setCurrentSpeed(BENCH_TARGET_SPEED);
+    speedCalculator.engageCruise(SPORT);
+
+    vector<double> lateness((size_t)seconds * BENCH_LOOP_RATE_HZ);
+    TaskExecutor executor;
+    executor.spawn(runLoop(&executor, &speedCalculator, &lateness));
+
+#ifdef __linux__
+    // Timers and the pipe are waited together with epoll
+    PipeResult pipeResult = {};
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0) {
+        cerr << "Cannot create pipe" << endl;
+        return 1;
+    }
+    executor.spawn(readPipe(&executor, pipeFds[0], &pipeResult));
+    executor.spawn(writePipe(&executor, pipeFds[1], seconds, &pipeResult));
+#endif
+
+    executor.run();
+
+    sort(lateness.begin(), lateness.end());
+    cout << "Loop at " << BENCH_LOOP_RATE_HZ << " Hz for " << seconds << " s: lateness p50 "
+         << lateness[lateness.size() / 2] << " us, p99 " << lateness[lateness.size() * 99 / 100]
+         << " us, max " << lateness.back() << " us" << endl;
+
+#ifdef __linux__
+    vector<double>& latency = pipeResult.latency;
+    sort(latency.begin(), latency.end());
+    cout << "Pipe wait: " << pipeResult.received << " of " << pipeResult.written << " messages, "
+         << pipeResult.timeouts << " time limits";
+    if (!latency.empty()) {
+        cout << ", wake latency p50 " << latency[latency.size() / 2] << " us, max " << latency.back() << " us";
+    }
+    cout << endl;
+
+    // Each message wakes the reader and the silent half
+    // wakes it by time limit
+    if (pipeResult.written == 0 || pipeResult.received != pipeResult.written || pipeResult.timeouts == 0) {
+        cerr << "Pipe wait check failed" << endl;
+        return 1;
+    }
+#endif
+
+    return 0;
+}
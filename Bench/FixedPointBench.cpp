@@ -0,0 +1,149 @@
+/********************************************************
+* @file     FixedPointBench.cpp
+* @brief    Benchmark of numeric types of the models
+* @details  This file contains the main program of the tick
+*           benchmark. The same drive cycle runs with speed
+*           and battery models on double, Q16.16 and Q32.32,
+*           prints cost of one 100 ms tick and state of
+*           charge at the end of the cycle compared with
+*           double. Built for the host with "make bench" and
+*           for an emulated soft-float target with
+*           "make bench-softfloat".
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "BatteryManager.hpp"
+#include "SpeedCalculator.hpp"
+
+using namespace std;
+
+/********************************************************
+* Drive cycle
+********************************************************/
+#define BENCH_CYCLE_TICKS       2000    /* 200 s, battery is not empty at the end */
+#define BENCH_DEFAULT_TICKS     2000000 /* Timed ticks */
+#define BENCH_AC_TEMP           22      /* AC temperature (°C) */
+#define BENCH_WIND_LEVEL        2       /* Wind level */
+
+/********************************************************
+* @struct BenchResult
+* @brief  Result of one numeric type
+********************************************************/
+typedef struct {
+    double nsPerTick;   /* Cost of one tick (ns) */
+    double finalSoc;    /* State of charge at end of cycle (%) */
+    double finalRange;  /* Remaining range at end of cycle (km) */
+} BenchResult;
+
+/********************************************************
+* @brief    runCycle
+* @details  This function drives one cycle: accelerate for
+*           a quarter, cruise, then brake, updating speed,
+*           battery level and range every tick like the
+*           keyboard task.
+* @param    ticks   Number of ticks
+* @param    result  Filled with state at end of cycle
+* @return   int     Return sum of speeds, keeps work alive
+********************************************************/
+template <typename Num>
+static int runCycle(long ticks, BenchResult& result) {
+    BasicSpeedCalculator<Num> speedCalculator;
+    BasicBatteryManager<Num> batteryManager;
+    Num range = Num(0);
+    int speedSum = 0;
+
+    for (long tick = 0; tick < ticks; tick++) {
+        long phase = tick % BENCH_CYCLE_TICKS;
+        bool isAccelerating = phase < BENCH_CYCLE_TICKS / 4 || (phase % 10) == 0;
+        bool isBraking = phase >= BENCH_CYCLE_TICKS * 3 / 4;
+
+        int speed = speedCalculator.calculateSpeed(isAccelerating, isBraking);
+        speedCalculator.adjustSpeedForDriveMode(ECO);
+        batteryManager.updateBatteryLevel(speed, BENCH_AC_TEMP, BENCH_WIND_LEVEL);
+        range = batteryManager.calculateRamainingRange();
+        speedSum += speed;
+    }
+
+    result.finalSoc = numericToDouble(batteryManager.getStateOfCharge());
+    result.finalRange = numericToDouble(range);
+    return speedSum;
+}
+
+/********************************************************
+* @brief    measure
+* @details  This function times many ticks, cycles restart
+*           with a full battery, then runs one cycle to get
+*           the final state.
+* @param    ticks   Number of timed ticks
+* @return   BenchResult     Return cost and final state
+********************************************************/
+template <typename Num>
+static BenchResult measure(long ticks) {
+    BenchResult result;
+    volatile int sink = 0;
+
+    chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+    for (long done = 0; done < ticks; done += BENCH_CYCLE_TICKS) {
+        sink = sink + runCycle<Num>(BENCH_CYCLE_TICKS, result);
+    }
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - startTime;
+
+    long cycles = (ticks + BENCH_CYCLE_TICKS - 1) / BENCH_CYCLE_TICKS;
+    result.nsPerTick = elapsed.count() / ((double)cycles * BENCH_CYCLE_TICKS);
+    return result;
+}
+
+/********************************************************
+* @brief    printResult
+* @details  This function prints one line of the report.
+* @param    name        Name of numeric type
+* @param    result      Result of the type
+* @param    reference   Result of double
+* @return   None
+********************************************************/
+static void printResult(const string& name, const BenchResult& result, const BenchResult& reference) {
+    cout << name << ": " << result.nsPerTick << " ns/tick, SOC " << result.finalSoc
+         << " % (error " << result.finalSoc - reference.finalSoc << "), range "
+         << result.finalRange << " km" << endl;
+}
+
+/********************************************************
+* @brief Main function
+* @details Usage: FixedPointBench.exe [--ticks N]
+********************************************************/
+int main(int argc, char* argv[])
+{
+    long ticks = BENCH_DEFAULT_TICKS;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--ticks" && i + 1 < argc) {
+            ticks = atol(argv[++i]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--ticks N]" << endl;
+            return 1;
+        }
+    }
+
+    if (ticks <= 0) {
+        cerr << "Number of ticks must be positive" << endl;
+        return 1;
+    }
+
+    BenchResult reference = measure<double>(ticks);
+    BenchResult q16 = measure<Q16_16>(ticks);
+    BenchResult q32 = measure<Q32_32>(ticks);
+
+    cout << "Cycle of " << BENCH_CYCLE_TICKS << " ticks, timed " << ticks << " ticks" << endl;
+    printResult("double", reference, reference);
+    printResult("Q16.16", q16, reference);
+    printResult("Q32.32", q32, reference);
+
+    return 0;
+}
@@ -0,0 +1,573 @@
+/********************************************************
+* @file     PipelineBench.cpp
+* @brief    Benchmark of the whole control tick
+* @details  This file contains the main program of the
+*           pipeline benchmark. Managers are created and
+*           subscribed like in the main program, display
+*           output goes to a null stream. Synthetic driver
+*           input runs on a virtual clock without sleeping.
+*           The report has ticks per second, vehicles per
+*           core at 10 ticks per second, time of each stage,
+*           heap allocations per tick, resident memory over
+*           the run, time to evaluate generated rules, time
+*           of one climate advisor sweep, time of one step
+*           of the speed and state of charge filter,
+*           command throughput with one producer thread per
+*           command source, cost of one flight recorder
+*           tick and cost of one row of Arrow export.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include "DashboardController.hpp"
+#include "DisplayManager.hpp"
+#include "PositionSimulator.hpp"
+#include "VehiclePipeline.hpp"
+#include "AllocationTracker.hpp"
+#include "PerfStats.hpp"
+#include "RuleEngine.hpp"
+#include "StateEstimator.hpp"
+#include "FlightRecorder.hpp"
+#include "ArrowWriter.hpp"
+
+using namespace std;
+
+/********************************************************
+* Benchmark parameters
+********************************************************/
+#define BENCH_DEFAULT_TICKS     5000000 /* Ticks of the soak run */
+#define BENCH_STAGE_TICKS       1000000 /* Most ticks of the stage timing run */
+#define BENCH_PUBLISH_EVERY     10      /* Ticks between publishes, readCSV runs every 1 s */
+#define BENCH_RSS_SAMPLES       10      /* Resident memory samples over the soak */
+#define BENCH_TICK_US           100000  /* Virtual time of one tick (us) */
+#define BENCH_CYCLE_TICKS       3000    /* Ticks of one drive cycle */
+#define BENCH_CONTROL_TICKS     10      /* Hold time of climate and mode keys */
+#define BENCH_TICKS_PER_SECOND  10      /* Ticks a vehicle needs each second */
+#define BENCH_RULE_ALARMS       300     /* Generated alarms of the rule benchmark */
+#define BENCH_RULE_SIGNALS      100     /* Generated signals of the rule benchmark */
+#define BENCH_RULE_RUNS         100000  /* Evaluations of the rule benchmark */
+#define BENCH_ADVISOR_RUNS      1000000 /* Sweeps of the climate advisor benchmark */
+#define BENCH_ESTIMATOR_STEPS   1000000 /* Samples of the filter benchmark */
+#define BENCH_SOC_EVERY         10      /* Speed samples between battery samples */
+#define BENCH_OUTLIER_EVERY     997     /* Speed samples between spikes */
+#define BENCH_COMMANDS          200000  /* Commands of each producer of the queue benchmark */
+#define BENCH_RECORDS           10000000 /* Ticks of the flight recorder benchmark */
+#define BENCH_RECORD_COMMANDS   2       /* Commands of each recorded tick */
+#define BENCH_ARROW_ROWS        1000000 /* Rows of the Arrow export benchmark */
+#define BENCH_ARROW_PATH        "./Data/BenchTelemetry.arrow"
+
+/********************************************************
+* @class NullBuffer
+* @brief Stream buffer that formats into a small area and
+*        throws the characters away
+********************************************************/
+class NullBuffer : public streambuf {
+private:
+    char area[256];
+
+protected:
+    /********************************************************
+    * @brief  Reuse area when it is full
+    * @param  ch      Character that did not fit
+    * @return int     Return ch, never fails
+    ********************************************************/
+    int overflow(int ch) override {
+        setp(area, area + sizeof(area));
+        return traits_type::not_eof(ch);
+    }
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    NullBuffer() {
+        setp(area, area + sizeof(area));
+    }
+};
+
+/********************************************************
+* @brief Virtual time of events (us)
+********************************************************/
+static uint64_t virtualTimeUs = 0;
+
+/********************************************************
+* @brief    virtualClock
+* @details  This function is the clock of DashboardController
+*           events, it moves only when a tick is run.
+* @param    None
+* @return   uint64_t    Return virtual time (us)
+********************************************************/
+static uint64_t virtualClock() {
+    return virtualTimeUs;
+}
+
+/********************************************************
+* @brief    makeInput
+* @details  This function builds driver input of a tick:
+*           accelerate for a third of the cycle, cruise with
+*           short presses, then brake. Climate keys and drive
+*           mode are pressed a few times per cycle, trip is
+*           reset once per cycle.
+* @param    tick    Number of tick
+* @return   DriverInput     Return input of the tick
+********************************************************/
+static DriverInput makeInput(long tick) {
+    long phase = tick % BENCH_CYCLE_TICKS;
+    long control = (phase / BENCH_CONTROL_TICKS) % 64;
+    bool isHeld = (phase % BENCH_CONTROL_TICKS) < BENCH_CONTROL_TICKS / 2;
+
+    DriverInput input;
+    input.isAccelerating = phase < BENCH_CYCLE_TICKS / 3 || (phase % 10) < 3;
+    input.isBraking = phase >= BENCH_CYCLE_TICKS * 5 / 6;
+    input.isModeToggled = control == 7 && (phase % BENCH_CONTROL_TICKS) == 0;
+    input.isAcUp = control == 11 && isHeld;
+    input.isAcDown = control == 23 && isHeld;
+    input.isWindUp = control == 31 && isHeld;
+    input.isWindDown = control == 47 && isHeld;
+    input.isTripReset = phase == 0;
+    input.isCruiseToggled = false;  /* Cruise loop is measured by CruiseBench */
+    input.isCruiseUp = false;
+    input.isCruiseDown = false;
+    return input;
+}
+
+/********************************************************
+* @class BenchVehicle
+* @brief Managers of one vehicle, wired like main()
+********************************************************/
+class BenchVehicle {
+public:
+    NullBuffer nullBuffer;
+    ostream nullStream;
+    DashboardController dashboardController;
+    DisplayManager displayManager;
+    SpeedCalculator speedCalculator;
+    BatteryManager batteryManager;
+    DriveModeManager driveModeManager;
+    SafetyManager safetyManager;
+    TripComputer tripComputer;
+    PositionSimulator positionSimulator;
+    VehicleProfileStore profileStore;
+    RuleEngine ruleEngine;
+    ClimateAdvisor climateAdvisor;
+    VehiclePipeline pipeline;
+    long recharges;     /* Battery refilled when empty */
+
+    /********************************************************
+    * @brief Constructor, subscribes managers like main()
+    ********************************************************/
+    BenchVehicle() : nullStream(&nullBuffer), displayManager(nullStream), tripComputer(&batteryManager),
+        profileStore(VEHICLE_PROFILE_PATH), climateAdvisor(&batteryManager),
+        pipeline(&dashboardController, &speedCalculator, &driveModeManager, &safetyManager,
+            &batteryManager, &tripComputer, &profileStore),
+        recharges(0) {
+        profileStore.load();
+        if (!ruleEngine.load(RULES_PATH)) {
+            ruleEngine.addRule(RULE_DEFAULT_LOW_BATTERY);
+        }
+        applyVehicleProfile(&profileStore, &speedCalculator, &driveModeManager, &batteryManager);
+
+        pipeline.setClimateAdvisor(&climateAdvisor);
+        pipeline.setRuleEngine(&ruleEngine);
+        dashboardController.setTickClock(virtualClock);
+        dashboardController.onStateChanged().subscribe<DisplayManager, &DisplayManager::update>(&displayManager);
+        dashboardController.onStateChanged().subscribe<PositionSimulator, &PositionSimulator::update>(&positionSimulator);
+        pipeline.start();
+    }
+};
+
+/********************************************************
+* @brief    runTicks
+* @details  This function runs ticks on the virtual clock,
+*           publishes state like readCSV does and refills
+*           an empty battery so the soak keeps driving.
+* @param    vehicle         Vehicle to run
+* @param    firstTick       Number of first tick
+* @param    count           Number of ticks
+* @param    perfStats       Pointer to PerfStats object to
+*                           time publish and display render,
+*                           NULL skips timing
+* @param    stagePublish    Index of publish stage
+* @return   None
+********************************************************/
+static void runTicks(BenchVehicle& vehicle, long firstTick, long count, PerfStats* perfStats,
+    int stagePublish) {
+    for (long tick = firstTick; tick < firstTick + count; tick++) {
+        virtualTimeUs += BENCH_TICK_US;
+        vehicle.pipeline.tick(makeInput(tick));
+
+        if ((tick + 1) % BENCH_PUBLISH_EVERY == 0) {
+            PerfMark mark;
+            if (perfStats) {
+                perfStats->mark(mark);
+            }
+            vehicle.dashboardController.publishState();
+            if (perfStats) {
+                perfStats->record(stagePublish, mark);
+            }
+        }
+
+        if (vehicle.dashboardController.getBatteryLevel() == 0) {
+            vehicle.batteryManager = BatteryManager();
+            vehicle.recharges++;
+        }
+    }
+}
+
+/********************************************************
+* @brief    benchRules
+* @details  This function compiles generated alarms and
+*           signals over the dashboard fields, then times
+*           evaluation of all of them on changing states.
+* @param    None
+* @return   None
+********************************************************/
+static void benchRules() {
+    RuleEngine ruleEngine;
+    char rule[256];
+
+    for (int i = 0; i < BENCH_RULE_ALARMS; i++) {
+        snprintf(rule, sizeof(rule), "alarm A%d = speed > %d && battery < %d || range / max(battery, 1) < %d"
+            " for %ds clear speed < %d : alarm %d", i, i % 200, i % 100, i % 7, i % 5, i % 150, i);
+        ruleEngine.addRule(rule);
+    }
+    for (int i = 0; i < BENCH_RULE_SIGNALS; i++) {
+        snprintf(rule, sizeof(rule), "signal S%d = (range - prev(range)) / max(dt, 0.1) * %d + speed", i, i);
+        ruleEngine.addRule(rule);
+    }
+
+    DashboardState state = DashboardState();
+    state.driveMode = ECO;
+    state.remainingRange = 400.0;
+    RuleEvent events[RULE_MAX_EVENTS];
+
+    uint64_t startNs = PerfStats::nowNs();
+    for (long run = 0; run < BENCH_RULE_RUNS; run++) {
+        state.speed = (int)(run % 200);
+        state.batteryLevel = 100 - (int)(run % 100);
+        state.remainingRange = state.batteryLevel * 4.0;
+        ruleEngine.evaluate(state, 0.1, (uint64_t)run * BENCH_TICK_US);
+        ruleEngine.takeEvents(events, RULE_MAX_EVENTS);
+    }
+    uint64_t elapsedNs = PerfStats::nowNs() - startNs;
+
+    cout << "Rules: " << ruleEngine.getAlarmCount() << " alarms and " << ruleEngine.getSignalCount()
+         << " signals in " << ruleEngine.getInstructionCount() << " instructions, "
+         << (double)elapsedNs / BENCH_RULE_RUNS << " ns per evaluation" << endl;
+}
+
+/********************************************************
+* @brief    benchAdvisor
+* @details  This function times one sweep of the climate
+*           advisor over all AC temperatures, wind levels and
+*           speed caps, at speeds above every cap.
+* @param    None
+* @return   None
+********************************************************/
+static void benchAdvisor() {
+    BatteryManager batteryManager;
+    ClimateAdvisor climateAdvisor(&batteryManager);
+    size_t alternatives = 0;
+
+    uint64_t startNs = PerfStats::nowNs();
+    for (long run = 0; run < BENCH_ADVISOR_RUNS; run++) {
+        climateAdvisor.advise(120 + (int)(run % 40), 30 - (int)(run % 8), 5 - (int)(run % 3));
+        alternatives += climateAdvisor.getAlternativeCount();
+    }
+    uint64_t elapsedNs = PerfStats::nowNs() - startNs;
+
+    cout << "Advisor: " << ADVISOR_CLIMATE_COUNT * ADVISOR_SPEED_COUNT << " settings in "
+         << (double)elapsedNs / BENCH_ADVISOR_RUNS << " ns per sweep, "
+         << (double)alternatives / BENCH_ADVISOR_RUNS << " alternatives" << endl;
+}
+
+/********************************************************
+* @brief    benchEstimator
+* @details  This function times one step of the filter with
+*           noisy speed samples 10 to 200 ms apart, a battery
+*           sample every BENCH_SOC_EVERY steps and a spike now
+*           and then. Error of samples and of the estimate
+*           against the true speed shows the smoothing.
+* @param    None
+* @return   None
+********************************************************/
+static void benchEstimator() {
+    BatteryManager batteryManager;
+    StateEstimator stateEstimator(&batteryManager);
+    stateEstimator.setClimate(24, 2);
+
+    uint32_t seed = 12345;
+    double time = 0.0;
+    double soc = 80.0;
+    double sampleError = 0.0;
+    double estimateError = 0.0;
+
+    uint64_t startNs = PerfStats::nowNs();
+    for (long step = 0; step < BENCH_ESTIMATOR_STEPS; step++) {
+        // Irregular time step and noise from a small LCG,
+        // sum of 2 uniforms is close enough to a bell
+        seed = seed * 1664525u + 1013904223u;
+        double dt = 0.01 + (seed >> 8) * (0.19 / 16777216.0);
+        time += dt;
+        seed = seed * 1664525u + 1013904223u;
+        double noise = ((seed >> 8) & 0xFFF) / 1024.0 + ((seed >> 20) & 0xFFF) / 1024.0 - 4.0;
+
+        double speed = 60.0 + 30.0 * sin(time / 20.0);
+        soc -= numericToDouble(batteryManager.calculateBatteryDrain((int)speed, 24, 2)) * dt;
+        if (soc < 10.0) {
+            soc = 90.0;
+        }
+        double sample = speed + noise + (step % BENCH_OUTLIER_EVERY == 0 ? 60.0 : 0.0);
+        stateEstimator.updateSpeed(time, sample);
+        if (step % BENCH_SOC_EVERY == 0) {
+            stateEstimator.updateSoc(time, soc + noise / 4);
+        }
+
+        sampleError += (sample - speed) * (sample - speed);
+        estimateError += (stateEstimator.getSpeed() - speed) * (stateEstimator.getSpeed() - speed);
+    }
+    uint64_t elapsedNs = PerfStats::nowNs() - startNs;
+
+    cout << "Estimator: " << (double)elapsedNs / BENCH_ESTIMATOR_STEPS << " ns per sample, speed error "
+         << sqrt(sampleError / BENCH_ESTIMATOR_STEPS) << " km/h raw, "
+         << sqrt(estimateError / BENCH_ESTIMATOR_STEPS) << " km/h filtered, "
+         << stateEstimator.getOutliers() << " outliers" << endl;
+}
+
+/********************************************************
+* @brief    benchCommands
+* @details  This function runs one producer thread for each
+*           command source against one consumer that drains
+*           batches like the control tick. A refused command
+*           is submitted again. Order of each producer is
+*           checked, its values must arrive 0, 1, 2, ...
+* @param    None
+* @return   None
+********************************************************/
+static void benchCommands() {
+    CommandQueue commandQueue;
+    VehicleCommand commands[COMMAND_BATCH_SIZE];
+    int expected[COMMAND_SOURCE_COUNT] = {};
+    unsigned long received = 0;
+    unsigned long batches = 0;
+    unsigned long outOfOrder = 0;
+
+    uint64_t startNs = PerfStats::nowNs();
+    thread producers[COMMAND_SOURCE_COUNT];
+    for (int source = 0; source < COMMAND_SOURCE_COUNT; source++) {
+        producers[source] = thread([&commandQueue, source]() {
+            for (int value = 0; value < BENCH_COMMANDS; value++) {
+                while (!commandQueue.submit(COMMAND_AC_STEP, value, (CommandSource)source)) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+
+    while (received < (unsigned long)BENCH_COMMANDS * COMMAND_SOURCE_COUNT) {
+        size_t count = commandQueue.drain(commands, COMMAND_BATCH_SIZE);
+        if (count == 0) {
+            this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (commands[i].value != expected[commands[i].source]++) {
+                outOfOrder++;
+            }
+        }
+        received += count;
+        batches++;
+    }
+    uint64_t elapsedNs = PerfStats::nowNs() - startNs;
+
+    for (int source = 0; source < COMMAND_SOURCE_COUNT; source++) {
+        producers[source].join();
+    }
+
+    cout << "Commands: " << COMMAND_SOURCE_COUNT << " producers, " << (double)elapsedNs / received
+         << " ns per command, " << received / batches << " per batch, " << commandQueue.getDropped()
+         << " refused by full queue, " << outOfOrder << " out of order" << endl;
+}
+
+/********************************************************
+* @brief    benchRecorder
+* @details  This function records ticks with a few commands
+*           each, many laps over the ring, and reports time
+*           of one record.
+* @param    None
+* @return   None
+********************************************************/
+static void benchRecorder() {
+    FlightRecorder* flightRecorder = new FlightRecorder();
+    VehicleCommand commands[BENCH_RECORD_COMMANDS];
+    for (int i = 0; i < BENCH_RECORD_COMMANDS; i++) {
+        commands[i].type = COMMAND_AC_STEP;
+        commands[i].value = i;
+        commands[i].source = COMMAND_SOURCE_KEYBOARD;
+        commands[i].timestampNs = 0;
+    }
+
+    DashboardState state = {};
+    uint64_t startNs = PerfStats::nowNs();
+    for (long tick = 0; tick < BENCH_RECORDS; tick++) {
+        state.speed = (int)(tick % 160);
+        state.remainingRange = (double)(tick % 400);
+        flightRecorder->record(state, 0, (uint16_t)tick, commands, BENCH_RECORD_COMMANDS,
+            (uint64_t)tick * BENCH_TICK_US * 1000);
+    }
+    uint64_t elapsedNs = PerfStats::nowNs() - startNs;
+
+    cout << "Flight recorder: " << (double)elapsedNs / BENCH_RECORDS << " ns per tick, "
+         << sizeof(FlightRecord) << " bytes per record, " << FLIGHT_RECORDER_TICKS << " ticks kept ("
+         << sizeof(FlightRecord) * FLIGHT_RECORDER_TICKS / 1024 << " KB)" << endl;
+    delete flightRecorder;
+}
+
+/********************************************************
+* @brief    benchArrow
+* @details  This function appends rows into an Arrow file
+*           with default batch size and reports time of one
+*           row, batches written on the way are included. The
+*           file is removed at the end.
+* @param    None
+* @return   None
+********************************************************/
+static void benchArrow() {
+    ArrowWriter* arrowWriter = new ArrowWriter();
+    if (!arrowWriter->open(BENCH_ARROW_PATH, ARROW_FILE)) {
+        delete arrowWriter;
+        return;
+    }
+
+    TelemetryRow row = {};
+    uint64_t startNs = PerfStats::nowNs();
+    for (long tick = 0; tick < BENCH_ARROW_ROWS; tick++) {
+        row.tick = (uint64_t)tick + 1;
+        row.timestampUs = tick * BENCH_TICK_US;
+        row.monotonicNs = (uint64_t)tick * BENCH_TICK_US * 1000;
+        row.state.speed = (int)(tick % 160);
+        row.state.driveMode = (tick / BENCH_CYCLE_TICKS) % 2 ? SPORT : ECO;
+        row.state.remainingRange = (double)(tick % 400);
+        arrowWriter->append(row);
+    }
+    arrowWriter->close();
+    uint64_t elapsedNs = PerfStats::nowNs() - startNs;
+
+    cout << "Arrow export: " << (double)elapsedNs / BENCH_ARROW_ROWS << " ns per row, "
+         << (double)arrowWriter->getBytes() / BENCH_ARROW_ROWS << " bytes per row, "
+         << arrowWriter->getBatches() << " batches of " << ARROW_DEFAULT_BATCH_ROWS << " rows" << endl;
+    delete arrowWriter;
+    remove(BENCH_ARROW_PATH);
+}
+
+/********************************************************
+* @brief Main function
+* @details Usage: PipelineBench.exe [--ticks N] [--counters]
+*          --counters adds hardware counters to stage timing
+*          Allocations per tick need a build with
+*          DASHBOARD_ALLOC_TRACKING (make ALLOC_TRACKING=1)
+********************************************************/
+int main(int argc, char* argv[])
+{
+    long ticks = BENCH_DEFAULT_TICKS;
+    bool isCounting = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--ticks" && i + 1 < argc) {
+            ticks = atol(argv[++i]);
+        } else if (arg == "--counters") {
+            isCounting = true;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--ticks N] [--counters]" << endl;
+            return 1;
+        }
+    }
+
+    if (ticks < BENCH_RSS_SAMPLES) {
+        cerr << "Number of ticks must be at least " << BENCH_RSS_SAMPLES << endl;
+        return 1;
+    }
+
+    BenchVehicle* vehicle = new BenchVehicle();
+
+    // Warm up caches and first allocations of subscribers
+    runTicks(*vehicle, 0, BENCH_CYCLE_TICKS, NULL, -1);
+    long tick = BENCH_CYCLE_TICKS;
+
+    /* Soak: ticks per second, allocations and resident memory */
+    long rssStart = PerfStats::getResidentKb();
+    long rssMax = rssStart;
+    long rssEnd = rssStart;
+    unsigned long allocationsStart = AllocationTracker::getTotalAllocations();
+    uint64_t soakNs = 0;
+
+    cout << "Soak of " << ticks << " ticks, resident memory (KB):";
+    for (int sample = 0; sample < BENCH_RSS_SAMPLES; sample++) {
+        long count = ticks / BENCH_RSS_SAMPLES + (sample < ticks % BENCH_RSS_SAMPLES ? 1 : 0);
+
+        uint64_t startNs = PerfStats::nowNs();
+        runTicks(*vehicle, tick, count, NULL, -1);
+        soakNs += PerfStats::nowNs() - startNs;
+        tick += count;
+
+        rssEnd = PerfStats::getResidentKb();
+        rssMax = rssEnd > rssMax ? rssEnd : rssMax;
+        cout << " " << rssEnd;
+    }
+    cout << endl;
+
+    unsigned long allocations = AllocationTracker::getTotalAllocations() - allocationsStart;
+    double ticksPerSecond = (double)ticks * 1e9 / (double)soakNs;
+
+    cout << "Throughput: " << ticksPerSecond << " ticks/s, " << (double)soakNs / (double)ticks
+         << " ns/tick, " << ticksPerSecond / BENCH_TICKS_PER_SECOND << " vehicles per core at "
+         << BENCH_TICKS_PER_SECOND << " Hz" << endl;
+    cout << "Resident memory: start " << rssStart << " KB, end " << rssEnd << " KB, max "
+         << rssMax << " KB, growth " << rssEnd - rssStart << " KB" << endl;
+    if (AllocationTracker::isEnabled()) {
+        cout << "Heap allocations: " << allocations << " (" << (double)allocations / (double)ticks
+             << " per tick)" << endl;
+    } else {
+        cout << "Heap allocations: not counted, build with ALLOC_TRACKING=1" << endl;
+    }
+
+    /* Stage timing, clock reads add to the total */
+    long stageTicks = ticks < BENCH_STAGE_TICKS ? ticks : BENCH_STAGE_TICKS;
+    PerfStats perfStats;
+    if (isCounting && !perfStats.openCounters()) {
+        cerr << "Stages are timed without counters" << endl;
+    }
+    FlightRecorder* flightRecorder = new FlightRecorder();
+    vehicle->pipeline.setPerfStats(&perfStats);
+    vehicle->pipeline.setFlightRecorder(flightRecorder);
+    int stagePublish = perfStats.addStage("publish");
+
+    runTicks(*vehicle, tick, stageTicks, &perfStats, stagePublish);
+    vehicle->pipeline.setPerfStats(NULL);
+    vehicle->pipeline.setFlightRecorder(NULL);
+    delete flightRecorder;
+
+    cout << "Stages over " << stageTicks << " ticks, publish every " << BENCH_PUBLISH_EVERY << " ticks:" << endl;
+    perfStats.dump(cout, (uint64_t)stageTicks);
+    cout << "Battery refilled " << vehicle->recharges << " times, virtual time "
+         << virtualTimeUs / 1000000 << " s" << endl;
+
+    benchRules();
+    benchAdvisor();
+    benchEstimator();
+    benchCommands();
+    benchRecorder();
+    benchArrow();
+
+    delete vehicle;
+    return 0;
+}
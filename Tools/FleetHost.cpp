@@ -0,0 +1,614 @@
+/********************************************************
+* @file     FleetHost.cpp
+* @brief    Host of many vehicle pipelines on a thread pool
+* @details  This file contains the main program of the fleet
+*           host. Thousands of independent vehicles, each with
+*           its DashboardController and managers wired like
+*           main(), are ticked together at a fixed period.
+*           Every worker thread builds its home vehicles in its
+*           own arena, pushes them to its own deque at the start
+*           of a tick and runs them newest first. A worker that
+*           runs out of work steals the oldest vehicle from
+*           another worker. The report has deadline misses and
+*           the load of every worker, --scale repeats the run
+*           for 1 to N threads and prints the speedup.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "Arena.hpp"
+#include "DashboardController.hpp"
+#include "DisplayManager.hpp"
+#include "ParallelFor.hpp"
+#include "PerfStats.hpp"
+#include "PositionSimulator.hpp"
+#include "RuleEngine.hpp"
+#include "VehiclePipeline.hpp"
+#include "WorkStealingDeque.hpp"
+
+using namespace std;
+
+/********************************************************
+* Host parameters
+********************************************************/
+#define FLEET_DEFAULT_VEHICLES  2000    /* Vehicles of the fleet */
+#define FLEET_DEFAULT_TICKS     100     /* Ticks of the run */
+#define FLEET_PERIOD_MS         100     /* Tick period and deadline of a vehicle (ms) */
+#define FLEET_TICK_US           100000  /* Virtual time of one tick (us) */
+#define FLEET_PUBLISH_EVERY     10      /* Ticks between publishes of a vehicle */
+#define FLEET_CYCLE_TICKS       3000    /* Ticks of one drive cycle */
+#define FLEET_CONTROL_TICKS     10      /* Hold time of climate and mode keys */
+#define FLEET_PHASE_STRIDE      37      /* Cycle offset between 2 vehicles (ticks) */
+#define FLEET_ARENA_SLACK       4096    /* Spare bytes of each arena */
+
+/********************************************************
+* @class NullBuffer
+* @brief Stream buffer that formats into a small area and
+*        throws the characters away
+********************************************************/
+class NullBuffer : public streambuf {
+private:
+    char area[256];
+
+protected:
+    /********************************************************
+    * @brief  Reuse area when it is full
+    * @param  ch      Character that did not fit
+    * @return int     Return ch, never fails
+    ********************************************************/
+    int overflow(int ch) override {
+        setp(area, area + sizeof(area));
+        return traits_type::not_eof(ch);
+    }
+
+public:
+    /********************************************************
+    * @brief Constructor
+    ********************************************************/
+    NullBuffer() {
+        setp(area, area + sizeof(area));
+    }
+};
+
+/********************************************************
+* @brief Virtual time of events (us), moved only between
+*        2 ticks while all workers wait at the barrier
+********************************************************/
+static atomic<uint64_t> fleetTimeUs(0);
+
+/********************************************************
+* @brief    fleetClock
+* @details  This function is the clock of DashboardController
+*           events of every vehicle.
+* @param    None
+* @return   uint64_t    Return virtual time (us)
+********************************************************/
+static uint64_t fleetClock() {
+    return fleetTimeUs.load(memory_order_relaxed);
+}
+
+/********************************************************
+* @brief    makeInput
+* @details  This function builds driver input of a tick like
+*           PipelineBench: accelerate for a third of the
+*           cycle, cruise with short presses, then brake.
+*           Climate keys and drive mode are pressed a few
+*           times per cycle, trip is reset once per cycle.
+* @param    tick    Number of tick in the cycle of the vehicle
+* @return   DriverInput     Return input of the tick
+********************************************************/
+static DriverInput makeInput(long tick) {
+    long phase = tick % FLEET_CYCLE_TICKS;
+    long control = (phase / FLEET_CONTROL_TICKS) % 64;
+    bool isHeld = (phase % FLEET_CONTROL_TICKS) < FLEET_CONTROL_TICKS / 2;
+
+    DriverInput input;
+    input.isAccelerating = phase < FLEET_CYCLE_TICKS / 3 || (phase % 10) < 3;
+    input.isBraking = phase >= FLEET_CYCLE_TICKS * 5 / 6;
+    input.isModeToggled = control == 7 && (phase % FLEET_CONTROL_TICKS) == 0;
+    input.isAcUp = control == 11 && isHeld;
+    input.isAcDown = control == 23 && isHeld;
+    input.isWindUp = control == 31 && isHeld;
+    input.isWindDown = control == 47 && isHeld;
+    input.isTripReset = phase == 0;
+    input.isCruiseToggled = false;
+    input.isCruiseUp = false;
+    input.isCruiseDown = false;
+    return input;
+}
+
+/********************************************************
+* @class FleetVehicle
+* @brief Managers of one vehicle, wired like main()
+********************************************************/
+class FleetVehicle {
+public:
+    NullBuffer nullBuffer;
+    ostream nullStream;
+    DashboardController dashboardController;
+    DisplayManager displayManager;
+    SpeedCalculator speedCalculator;
+    BatteryManager batteryManager;
+    DriveModeManager driveModeManager;
+    SafetyManager safetyManager;
+    TripComputer tripComputer;
+    PositionSimulator positionSimulator;
+    VehicleProfileStore profileStore;
+    RuleEngine ruleEngine;
+    VehiclePipeline pipeline;
+    long phase;         /* Offset of the drive cycle (ticks) */
+    long recharges;     /* Battery refilled when empty */
+
+    /********************************************************
+    * @brief Constructor, subscribes managers like main()
+    * @param index    Number of vehicle in the fleet
+    ********************************************************/
+    explicit FleetVehicle(long index) : nullStream(&nullBuffer), displayManager(nullStream),
+        tripComputer(&batteryManager), profileStore(VEHICLE_PROFILE_PATH),
+        pipeline(&dashboardController, &speedCalculator, &driveModeManager, &safetyManager,
+            &batteryManager, &tripComputer, &profileStore),
+        phase(index * FLEET_PHASE_STRIDE), recharges(0) {
+        profileStore.load();
+        if (!ruleEngine.load(RULES_PATH)) {
+            ruleEngine.addRule(RULE_DEFAULT_LOW_BATTERY);
+        }
+        applyVehicleProfile(&profileStore, &speedCalculator, &driveModeManager, &batteryManager);
+
+        pipeline.setRuleEngine(&ruleEngine);
+        dashboardController.setTickClock(fleetClock);
+        dashboardController.onStateChanged().subscribe<DisplayManager, &DisplayManager::update>(&displayManager);
+        dashboardController.onStateChanged().subscribe<PositionSimulator, &PositionSimulator::update>(&positionSimulator);
+        pipeline.start();
+    }
+
+    /********************************************************
+    * @brief  Run one tick, publish state like readCSV does
+    *         and refill an empty battery so the fleet keeps
+    *         driving
+    * @param  tick    Number of fleet tick
+    * @return None
+    ********************************************************/
+    void tick(long tick) {
+        pipeline.tick(makeInput(tick + phase));
+
+        if ((tick + phase) % FLEET_PUBLISH_EVERY == 0) {
+            dashboardController.publishState();
+        }
+
+        if (dashboardController.getBatteryLevel() == 0) {
+            batteryManager = BatteryManager();
+            recharges++;
+        }
+    }
+};
+
+/********************************************************
+* @struct FleetWorkerStats
+* @brief  Load of one worker over the run
+********************************************************/
+typedef struct {
+    long vehicleTicks;  /* Vehicle ticks run */
+    long stolenTicks;   /* Vehicle ticks taken from other workers */
+    long misses;        /* Vehicle ticks finished after deadline */
+    uint64_t busyNs;    /* Time spent in vehicle ticks (ns) */
+} FleetWorkerStats;
+
+/********************************************************
+* @class FleetWorker
+* @brief Deque, arena and home vehicles of one thread,
+*        starts on its own cache line
+********************************************************/
+class alignas(DEQUE_CACHE_LINE) FleetWorker {
+public:
+    WorkStealingDeque<uint32_t> deque;  /* Vehicles of the current tick */
+    Arena arena;                        /* Memory of home vehicles */
+    uint32_t firstVehicle;              /* First home vehicle */
+    uint32_t vehicleCount;              /* Number of home vehicles */
+    uint64_t random;                    /* State of victim choice */
+    FleetWorkerStats stats;
+
+    /********************************************************
+    * @brief Constructor, arena is reserved but not touched
+    * @param firstVehicle     First home vehicle
+    * @param vehicleCount     Number of home vehicles
+    * @param fleetSize        Number of vehicles of the fleet
+    ********************************************************/
+    FleetWorker(uint32_t firstVehicle, uint32_t vehicleCount, uint32_t fleetSize)
+        : deque(fleetSize), arena((size_t)vehicleCount * (sizeof(FleetVehicle) + ARENA_ALIGNMENT * 2)
+            + FLEET_ARENA_SLACK),
+        firstVehicle(firstVehicle), vehicleCount(vehicleCount),
+        random(0x9E3779B97F4A7C15ULL * (firstVehicle + 1)), stats() {}
+
+    /********************************************************
+    * @brief  Pick a random number for victim choice
+    * @param  None
+    * @return uint64_t    Return next number of xorshift
+    ********************************************************/
+    uint64_t nextRandom() {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return random;
+    }
+};
+
+/********************************************************
+* @struct FleetResult
+* @brief  Result of one run
+********************************************************/
+typedef struct {
+    uint64_t elapsedNs;     /* Time of all ticks (ns) */
+    uint64_t maxTickNs;     /* Longest tick (ns) */
+    long lateTicks;         /* Ticks not finished within the period */
+    long misses;            /* Vehicle ticks finished after deadline */
+    long recharges;         /* Batteries refilled */
+} FleetResult;
+
+/********************************************************
+* @class FleetHost
+* @brief Class runs the fleet. Tick state is changed only
+*        by the barrier completion, while all workers wait.
+********************************************************/
+class FleetHost {
+private:
+    unsigned int workerCount;
+    uint32_t vehicleCount;
+    long tickCount;
+    bool isFast;                        /* Start next tick at once instead of next period */
+    bool isStealing;                    /* Idle workers steal from others */
+    vector<FleetWorker*> workers;
+    vector<FleetVehicle*> vehicles;     /* Vehicle by number, owned by arenas */
+
+    /* Tick state */
+    long tick;                          /* Current tick, tickCount when done */
+    uint64_t tickStartNs;
+    uint64_t deadlineNs;                /* Vehicle ticks must end before it */
+    alignas(DEQUE_CACHE_LINE) atomic<long> remaining;   /* Vehicle ticks not finished */
+    FleetResult result;
+    uint64_t runStartNs;
+
+    /* Host can not be copied */
+    FleetHost(const FleetHost&) = delete;
+    FleetHost& operator=(const FleetHost&) = delete;
+
+    /********************************************************
+    * @brief  Pin thread of a worker to one CPU so its arena
+    *         stays in local memory and warm caches
+    * @param  worker  Number of worker
+    * @return None
+    ********************************************************/
+    static void pinWorker(unsigned int worker) {
+#ifdef __linux__
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(worker % defaultWorkerCount(), &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+        (void)worker;
+#endif
+    }
+
+    /********************************************************
+    * @brief  Finish current tick and start the next one.
+    *         Called by one thread while others wait at the
+    *         barrier
+    * @param  None
+    * @return None
+    ********************************************************/
+    void advance() {
+        uint64_t nowNs = PerfStats::nowNs();
+
+        if (tick < 0) {
+            runStartNs = nowNs;
+            tickStartNs = nowNs;
+        } else {
+            uint64_t tickNs = nowNs - tickStartNs;
+            result.maxTickNs = tickNs > result.maxTickNs ? tickNs : result.maxTickNs;
+            if (nowNs > deadlineNs) {
+                result.lateTicks++;
+            }
+
+            // Next tick starts on the next period, or at once if this one was late
+            tickStartNs = isFast || nowNs > deadlineNs ? nowNs : deadlineNs;
+        }
+
+        tick++;
+        if (tick >= tickCount) {
+            result.elapsedNs = nowNs - runStartNs;
+            return;
+        }
+
+        if (!isFast) {
+            this_thread::sleep_for(chrono::nanoseconds(tickStartNs - nowNs));
+        }
+
+        deadlineNs = tickStartNs + (uint64_t)FLEET_PERIOD_MS * 1000000;
+        fleetTimeUs.fetch_add(FLEET_TICK_US, memory_order_relaxed);
+        remaining.store(vehicleCount, memory_order_relaxed);
+    }
+
+    /********************************************************
+    * @brief  Take a vehicle of another worker, victims are
+    *         tried from a random one on
+    * @param  worker  Worker that steals
+    * @param  index   Stolen vehicle
+    * @return bool    Return false if nothing was taken
+    ********************************************************/
+    bool steal(FleetWorker* worker, uint32_t& index) {
+        unsigned int start = (unsigned int)(worker->nextRandom() % workerCount);
+
+        for (unsigned int i = 0; i < workerCount; i++) {
+            FleetWorker* victim = workers[(start + i) % workerCount];
+            if (victim != worker && victim->deque.steal(index)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /********************************************************
+    * @brief  Body of one worker thread: build home vehicles,
+    *         then run ticks until the host is done
+    * @param  number      Number of worker
+    * @param  barrier     Barrier between 2 ticks
+    * @return None
+    ********************************************************/
+    template <typename Barrier>
+    void runWorker(unsigned int number, Barrier& barrier) {
+        FleetWorker* worker = workers[number];
+        pinWorker(number);
+
+        // First touch of vehicle memory is by the thread that runs it
+        for (uint32_t i = 0; i < worker->vehicleCount; i++) {
+            uint32_t index = worker->firstVehicle + i;
+            vehicles[index] = worker->arena.create<FleetVehicle>((long)index);
+        }
+
+        while (true) {
+            barrier.arrive_and_wait();
+            if (tick >= tickCount) {
+                break;
+            }
+
+            for (uint32_t i = 0; i < worker->vehicleCount; i++) {
+                worker->deque.push(worker->firstVehicle + i);
+            }
+
+            while (remaining.load(memory_order_acquire) > 0) {
+                uint32_t index;
+                bool isStolen = false;
+
+                if (!worker->deque.pop(index)) {
+                    if (!isStealing || !steal(worker, index)) {
+                        this_thread::yield();
+                        continue;
+                    }
+                    isStolen = true;
+                }
+
+                uint64_t startNs = PerfStats::nowNs();
+                vehicles[index]->tick(tick);
+                uint64_t endNs = PerfStats::nowNs();
+
+                worker->stats.busyNs += endNs - startNs;
+                worker->stats.vehicleTicks++;
+                worker->stats.stolenTicks += isStolen ? 1 : 0;
+                worker->stats.misses += endNs > deadlineNs ? 1 : 0;
+                remaining.fetch_sub(1, memory_order_release);
+            }
+        }
+    }
+
+public:
+    /********************************************************
+    * @brief Constructor, home vehicles of a worker are a
+    *        contiguous block of numbers
+    * @param workerCount      Number of threads
+    * @param vehicleCount     Number of vehicles
+    * @param tickCount        Number of ticks
+    * @param isFast           Run ticks back to back
+    * @param isStealing       Idle workers steal from others
+    ********************************************************/
+    FleetHost(unsigned int workerCount, uint32_t vehicleCount, long tickCount, bool isFast, bool isStealing)
+        : workerCount(workerCount), vehicleCount(vehicleCount), tickCount(tickCount), isFast(isFast),
+        isStealing(isStealing), vehicles(vehicleCount, NULL), tick(-1), tickStartNs(0), deadlineNs(0),
+        remaining(0), result(), runStartNs(0) {
+        for (unsigned int i = 0; i < workerCount; i++) {
+            uint32_t first = (uint32_t)((uint64_t)vehicleCount * i / workerCount);
+            uint32_t end = (uint32_t)((uint64_t)vehicleCount * (i + 1) / workerCount);
+            workers.push_back(new FleetWorker(first, end - first, vehicleCount));
+        }
+    }
+
+    /********************************************************
+    * @brief Destructor, arenas destroy their vehicles
+    ********************************************************/
+    ~FleetHost() {
+        for (size_t i = 0; i < workers.size(); i++) {
+            delete workers[i];
+        }
+    }
+
+    /********************************************************
+    * @brief  Build the fleet and run all ticks
+    * @param  None
+    * @return bool    Return false if an arena is too small
+    ********************************************************/
+    bool run() {
+        barrier tickBarrier((ptrdiff_t)workerCount, [this]() noexcept { advance(); });
+
+        parallelFor(workerCount, workerCount, [this, &tickBarrier](size_t, size_t, unsigned int worker) {
+            runWorker(worker, tickBarrier);
+        });
+
+        for (uint32_t i = 0; i < vehicleCount; i++) {
+            if (!vehicles[i]) {
+                cerr << "Arena of vehicle " << i << " is full" << endl;
+                return false;
+            }
+            result.recharges += vehicles[i]->recharges;
+        }
+        for (size_t i = 0; i < workers.size(); i++) {
+            result.misses += workers[i]->stats.misses;
+        }
+        return true;
+    }
+
+    /********************************************************
+    * @brief  Get result of the run
+    * @param  None
+    * @return FleetResult     Return result
+    ********************************************************/
+    const FleetResult& getResult() const {
+        return result;
+    }
+
+    /********************************************************
+    * @brief  Get load of one worker
+    * @param  worker  Number of worker
+    * @return FleetWorkerStats    Return load
+    ********************************************************/
+    const FleetWorkerStats& getWorkerStats(unsigned int worker) const {
+        return workers[worker]->stats;
+    }
+
+    /********************************************************
+    * @brief  Get bytes of vehicles in the arena of a worker
+    * @param  worker  Number of worker
+    * @return size_t  Return used bytes
+    ********************************************************/
+    size_t getArenaUsed(unsigned int worker) const {
+        return workers[worker]->arena.getUsed();
+    }
+};
+
+/********************************************************
+* @brief    printReport
+* @details  This function prints deadline misses, throughput
+*           and the load of every worker.
+* @param    host        Host after the run
+* @param    workers     Number of workers
+* @param    vehicles    Number of vehicles
+* @param    ticks       Number of ticks
+* @return   None
+********************************************************/
+static void printReport(const FleetHost& host, unsigned int workers, uint32_t vehicles, long ticks) {
+    const FleetResult& result = host.getResult();
+    double elapsedS = (double)result.elapsedNs / 1e9;
+    double vehicleTicks = (double)vehicles * (double)ticks;
+
+    cout << fixed << setprecision(1);
+    cout << "Fleet: " << vehicles << " vehicles, " << workers << " workers, " << ticks << " ticks of "
+         << FLEET_PERIOD_MS << " ms in " << setprecision(3) << elapsedS << " s" << setprecision(1) << endl;
+    cout << "Throughput: " << vehicleTicks / elapsedS << " vehicle ticks/s, longest tick "
+         << (double)result.maxTickNs / 1e6 << " ms" << endl;
+    cout << "Deadline misses: " << result.misses << " of " << (long)vehicleTicks << " vehicle ticks, "
+         << result.lateTicks << " of " << ticks << " ticks late" << endl;
+
+    uint64_t busyMax = 0;
+    uint64_t busySum = 0;
+    for (unsigned int i = 0; i < workers; i++) {
+        const FleetWorkerStats& stats = host.getWorkerStats(i);
+        busyMax = stats.busyNs > busyMax ? stats.busyNs : busyMax;
+        busySum += stats.busyNs;
+
+        cout << "Worker " << i << ": " << stats.vehicleTicks << " vehicle ticks (" << stats.stolenTicks
+             << " stolen), busy " << (double)stats.busyNs / 1e6 << " ms ("
+             << 100.0 * (double)stats.busyNs / (double)result.elapsedNs << "%), " << stats.misses
+             << " misses, arena " << host.getArenaUsed(i) / 1024 << " KB" << endl;
+    }
+    if (busySum > 0) {
+        cout << "Load imbalance: " << setprecision(2) << (double)busyMax * workers / (double)busySum
+             << " (busiest worker over mean)" << endl;
+    }
+    cout << "Battery refilled " << result.recharges << " times" << endl;
+    cout.unsetf(ios::floatfield);
+}
+
+/********************************************************
+* @brief Main function
+* @details Usage: FleetHost.exe [--vehicles N] [--threads N]
+*          [--ticks N] [--fast] [--no-steal] [--scale]
+*          --fast runs ticks back to back to measure the most
+*          vehicles per period, --scale runs 1 to N threads
+********************************************************/
+int main(int argc, char* argv[])
+{
+    long vehicles = FLEET_DEFAULT_VEHICLES;
+    long threads = defaultWorkerCount();
+    long ticks = FLEET_DEFAULT_TICKS;
+    bool isFast = false;
+    bool isStealing = true;
+    bool isScale = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--vehicles" && i + 1 < argc) {
+            vehicles = atol(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atol(argv[++i]);
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            ticks = atol(argv[++i]);
+        } else if (arg == "--fast") {
+            isFast = true;
+        } else if (arg == "--no-steal") {
+            isStealing = false;
+        } else if (arg == "--scale") {
+            isScale = true;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--vehicles N] [--threads N] [--ticks N] [--fast]"
+                 << " [--no-steal] [--scale]" << endl;
+            return 1;
+        }
+    }
+
+    if (vehicles < 1 || vehicles > UINT32_MAX || threads < 1 || ticks < 1) {
+        cerr << "Number of vehicles, threads and ticks must be positive" << endl;
+        return 1;
+    }
+    if (threads > vehicles) {
+        threads = vehicles;
+    }
+
+    if (!isScale) {
+        FleetHost host((unsigned int)threads, (uint32_t)vehicles, ticks, isFast, isStealing);
+        if (!host.run()) {
+            return 1;
+        }
+        printReport(host, (unsigned int)threads, (uint32_t)vehicles, ticks);
+        return 0;
+    }
+
+    // Speedup of back to back ticks over one thread
+    double baseRate = 0.0;
+    cout << fixed << setprecision(2);
+    for (long count = 1; count <= threads; count++) {
+        FleetHost host((unsigned int)count, (uint32_t)vehicles, ticks, true, isStealing);
+        if (!host.run()) {
+            return 1;
+        }
+
+        const FleetResult& result = host.getResult();
+        double rate = (double)vehicles * (double)ticks * 1e9 / (double)result.elapsedNs;
+        baseRate = count == 1 ? rate : baseRate;
+        cout << "Threads " << count << ": " << setprecision(0) << rate << " vehicle ticks/s, speedup "
+             << setprecision(2) << rate / baseRate << ", efficiency " << rate / baseRate / count * 100.0
+             << "%" << endl;
+    }
+    return 0;
+}
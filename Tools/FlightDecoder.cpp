@@ -0,0 +1,140 @@
+/********************************************************
+* @file     FlightDecoder.cpp
+* @brief    Flight recorder dump decoder program
+* @details  This file contains the main program of the dump
+*           decoder, reads a binary dump of the flight
+*           recorder and prints the kept ticks oldest first,
+*           one line per tick in CSV format.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "FlightRecorder.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Names of FlightInput bits, same order as bits
+********************************************************/
+static const char* const inputNames[] = {
+    "ACCELERATOR", "BRAKE", "MODE", "AC UP", "AC DOWN", "WIND UP", "WIND DOWN",
+    "TRIP RESET", "CRUISE", "CRUISE UP", "CRUISE DOWN"
+};
+
+/********************************************************
+* @brief Names of producers, same order as CommandSource
+********************************************************/
+static const char* const sourceNames[] = { "keyboard", "socket", "script" };
+
+/********************************************************
+* @brief    getSignalName
+* @details  This function gets name of a dump signal.
+* @param    signal      Signal number
+* @return   const char* Return name
+********************************************************/
+static const char* getSignalName(int signal) {
+    switch (signal) {
+    case SIGSEGV:
+        return "SIGSEGV";
+    case SIGABRT:
+        return "SIGABRT";
+#ifdef SIGUSR2
+    case SIGUSR2:
+        return "SIGUSR2";
+#endif
+    default:
+        return "unknown signal";
+    }
+}
+
+/********************************************************
+* @brief    printRecord
+* @details  This function prints one tick as a CSV line,
+*           time is relative to the dump. Held controls are
+*           separated by '|', commands by ';' as
+*           "KEY=value source latency".
+* @param    record      Tick to print
+* @param    dumpTimeNs  Monotonic time of dump (ns)
+* @return   None
+********************************************************/
+static void printRecord(const FlightRecord& record, uint64_t dumpTimeNs) {
+    double seconds = ((double)record.timestampNs - (double)dumpTimeNs) / 1e9;
+
+    cout << record.tick << ", " << seconds << ", " << record.speed << ", "
+         << (record.driveMode == SPORT ? "SPORT" : "ECO") << ", " << record.batteryLevel << ", "
+         << record.remainingRange << ", " << record.acTemp << ", " << record.windLevel << ", "
+         << record.cruiseSpeed << ", ";
+
+    bool isFirst = true;
+    for (size_t i = 0; i < sizeof(inputNames) / sizeof(inputNames[0]); i++) {
+        if (record.inputs & (1u << i)) {
+            cout << (isFirst ? "" : "|") << inputNames[i];
+            isFirst = false;
+        }
+    }
+    cout << ", " << record.commandCount << ", ";
+
+    uint32_t kept = record.commandCount < FLIGHT_EVENTS_PER_TICK ? record.commandCount : FLIGHT_EVENTS_PER_TICK;
+    for (uint32_t i = 0; i < kept; i++) {
+        const FlightEvent& event = record.events[i];
+        const char* source = event.source < COMMAND_SOURCE_COUNT ? sourceNames[event.source] : "unknown";
+        cout << (i == 0 ? "" : ";") << getCommandKey((CommandType)event.type) << "=" << event.value << " "
+             << source << " " << event.latencyUs << "us";
+    }
+    if (record.commandCount > kept) {
+        cout << ";+" << record.commandCount - kept << " more";
+    }
+    cout << endl;
+}
+
+/********************************************************
+* @brief Main function
+* @details Usage: FlightDecoder.exe <dump> [--last N]
+********************************************************/
+int main(int argc, char* argv[])
+{
+    string dumpPath;
+    size_t last = 0;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--last" && i + 1 < argc) {
+            last = (size_t)atol(argv[++i]);
+        } else if (dumpPath.empty()) {
+            dumpPath = arg;
+        } else {
+            dumpPath.clear();
+            break;
+        }
+    }
+
+    if (dumpPath.empty()) {
+        cerr << "Usage: " << argv[0] << " <dump> [--last N]" << endl;
+        return 1;
+    }
+
+    FlightDumpHeader header;
+    vector<FlightRecord> records;
+    size_t torn;
+    if (!FlightRecorder::readDump(dumpPath, header, records, torn)) {
+        return 1;
+    }
+
+    cout << "# Dump by " << getSignalName(header.signal) << " (" << header.signal << "), "
+         << header.ticks << " ticks recorded, " << records.size() << " kept, " << torn << " torn" << endl;
+    cout << "# tick, time (s), speed (km/h), mode, battery (%), range (km), AC (C), wind, cruise (km/h),"
+         << " held, applied, commands" << endl;
+
+    size_t first = (last > 0 && last < records.size()) ? records.size() - last : 0;
+    for (size_t i = first; i < records.size(); i++) {
+        printRecord(records[i], header.dumpTimeNs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/********************************************************
+* @file     LogAnalyzer.cpp
+* @brief    Offline telemetry log analysis program
+* @details  This file contains the main program of the log
+*           analysis tool, maps a telemetry log in the
+*           Database.csv format and prints trip statistics
+*           computed on several threads.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "TripAnalyzer.hpp"
+
+using namespace std;
+
+/********************************************************
+* @brief Main function
+* @details Usage: LogAnalyzer.exe <log> [--threads N]
+********************************************************/
+int main(int argc, char* argv[])
+{
+    string logPath;
+    unsigned int workers = 0;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--threads" && i + 1 < argc) {
+            workers = (unsigned int)atoi(argv[++i]);
+        } else if (logPath.empty()) {
+            logPath = arg;
+        } else {
+            logPath.clear();
+            break;
+        }
+    }
+
+    if (logPath.empty()) {
+        cerr << "Usage: " << argv[0] << " <log> [--threads N]" << endl;
+        return 1;
+    }
+
+    TripAnalyzer tripAnalyzer;
+    if (!tripAnalyzer.open(logPath)) {
+        return 1;
+    }
+
+    chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+    TripStatistics stats = tripAnalyzer.analyze(workers);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - startTime;
+
+    TripAnalyzer::printStatistics(cout, stats);
+    cout << "Analysed in " << elapsed.count() << " s" << endl;
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+/********************************************************
+* @file     RoutePlanner.cpp
+* @brief    Route battery prediction program
+* @details  This file contains the main program of the route
+*           planning tool, loads candidate routes and prints
+*           predicted state of charge at destination for each
+*           route, or for each AC temperature and wind level
+*           with --sweep. Predictions run on several threads.
+*           With --eco, the speed profile with least energy
+*           that arrives within a time budget is planned for
+*           each route.
+* @version  1.0
+* @date     2026-10-18
+* @author   Tran Quang Khai
+********************************************************/
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "RoutePredictor.hpp"
+#include "EcoSpeedOptimizer.hpp"
+#include "VehicleProfile.hpp"
+
+using namespace std;
+
+/********************************************************
+* Climate settings evaluated with --sweep
+********************************************************/
+#define SWEEP_MIN_AC_TEMP   16
+#define SWEEP_MAX_AC_TEMP   30
+#define SWEEP_MIN_WIND      0
+#define SWEEP_MAX_WIND      5
+
+/********************************************************
+* @brief Main function
+* @details Usage: RoutePlanner.exe <route>... [--soc N]
+*          [--ac N] [--wind N] [--cap N] [--sweep]
+*          [--threads N] [--profile <profile>]
+*          [--eco <minutes> [--speed N]]
+********************************************************/
+int main(int argc, char* argv[])
+{
+    vector<string> routePaths;
+    string profilePath;
+    double startSoc = 100.0;
+    RouteScenario scenario = { 25, 0, 0 };
+    bool isSweep = false;
+    double ecoMinutes = 0.0;
+    int startSpeed = 0;
+    unsigned int workers = 0;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--soc" && i + 1 < argc) {
+            startSoc = atof(argv[++i]);
+        } else if (arg == "--ac" && i + 1 < argc) {
+            scenario.acTemp = atoi(argv[++i]);
+        } else if (arg == "--wind" && i + 1 < argc) {
+            scenario.windLevel = atoi(argv[++i]);
+        } else if (arg == "--cap" && i + 1 < argc) {
+            scenario.speedCap = atoi(argv[++i]);
+        } else if (arg == "--sweep") {
+            isSweep = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            workers = (unsigned int)atoi(argv[++i]);
+        } else if (arg == "--eco" && i + 1 < argc) {
+            ecoMinutes = atof(argv[++i]);
+        } else if (arg == "--speed" && i + 1 < argc) {
+            startSpeed = atoi(argv[++i]);
+        } else if (arg == "--profile" && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else if (arg.compare(0, 2, "--") != 0) {
+            routePaths.push_back(arg);
+        } else {
+            routePaths.clear();
+            break;
+        }
+    }
+
+    if (routePaths.empty()) {
+        cerr << "Usage: " << argv[0] << " <route>... [--soc N] [--ac N] [--wind N] [--cap N]"
+             << " [--sweep] [--threads N] [--profile <profile>] [--eco <minutes> [--speed N]]" << endl;
+        return 1;
+    }
+
+    // Vehicle parameters
+    BatteryManager batteryManager;
+    if (!profilePath.empty()) {
+        VehicleProfileStore profileStore(profilePath);
+        if (!profileStore.load()) {
+            return 1;
+        }
+        VehicleProfileStore::Reader profile(profileStore);
+        batteryManager.applyProfile(*profile);
+    }
+
+    // Load all routes before building queries, queries point into them
+    vector<vector<RouteSegment> > routes(routePaths.size());
+    for (size_t i = 0; i < routePaths.size(); i++) {
+        if (!loadRoute(routePaths[i], routes[i])) {
+            return 1;
+        }
+    }
+
+    // One query per route, or per route and climate setting
+    vector<RouteQuery> queries;
+    vector<size_t> routeOfQuery;
+    for (size_t i = 0; i < routes.size(); i++) {
+        RouteQuery query;
+        query.segments = routes[i].data();
+        query.segmentCount = routes[i].size();
+        query.startSoc = startSoc;
+        query.scenario = scenario;
+
+        if (!isSweep) {
+            queries.push_back(query);
+            routeOfQuery.push_back(i);
+            continue;
+        }
+
+        for (int ac = SWEEP_MIN_AC_TEMP; ac <= SWEEP_MAX_AC_TEMP; ac++) {
+            for (int wind = SWEEP_MIN_WIND; wind <= SWEEP_MAX_WIND; wind++) {
+                query.scenario.acTemp = ac;
+                query.scenario.windLevel = wind;
+                queries.push_back(query);
+                routeOfQuery.push_back(i);
+            }
+        }
+    }
+
+    RoutePredictor routePredictor(&batteryManager);
+    vector<RoutePrediction> results(queries.size());
+
+    chrono::steady_clock::time_point startTime = chrono::steady_clock::now();
+    routePredictor.predictBatch(queries.data(), queries.size(), results.data(), workers);
+    chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - startTime;
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const RoutePrediction& result = results[i];
+
+        cout << routePaths[routeOfQuery[i]] << ": AC " << queries[i].scenario.acTemp
+             << " °C, wind " << queries[i].scenario.windLevel << ", "
+             << result.distanceKm << " km, " << result.energyKwh << " kWh, arrive with "
+             << result.finalSoc << " %";
+        if (!result.isReachable) {
+            cout << " (battery empty on segment " << result.emptySegment + 1 << ")";
+        }
+        cout << endl;
+    }
+
+    cout << "Predicted " << results.size() << " routes in " << elapsed.count() << " us" << endl;
+
+    // Speed advice, least energy within the time budget
+    if (ecoMinutes > 0.0) {
+        EcoSpeedOptimizer optimizer(&batteryManager);
+
+        for (size_t i = 0; i < routes.size(); i++) {
+            EcoQuery query;
+            query.segments = routes[i].data();
+            query.segmentCount = routes[i].size();
+            query.budgetHours = ecoMinutes / 60.0;
+            query.startSoc = startSoc;
+            query.startSpeed = startSpeed;
+            query.acTemp = scenario.acTemp;
+            query.windLevel = scenario.windLevel;
+
+            startTime = chrono::steady_clock::now();
+            EcoPlan plan = optimizer.optimize(query, workers);
+            elapsed = chrono::steady_clock::now() - startTime;
+            if (optimizer.getPositionCount() == 0) {
+                return 1;
+            }
+
+            cout << routePaths[i] << ": eco plan " << plan.energyKwh << " kWh, arrive in "
+                 << plan.durationHours * 60.0 << " of " << ecoMinutes << " min with " << plan.finalSoc
+                 << " %";
+            if (!plan.isFeasible) {
+                cout << " (budget cannot be met, fastest profile)";
+            }
+            cout << ", planned in " << elapsed.count() << " us with " << plan.iterations << " runs" << endl;
+
+            for (size_t segment = 0; segment < routes[i].size(); segment++) {
+                cout << "  Segment " << segment + 1 << ": limit " << routes[i][segment].speedLimit
+                     << " km/h, advise " << optimizer.getSegmentSpeed(segment) << " km/h" << endl;
+            }
+        }
+    }
+
+    return 0;
+}